@@ -0,0 +1,120 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <glengine/culling.hpp>
+#include <glengine/parallel.hpp>
+
+// Mesure le test de visibilité d’un million d’objets : boucle scalaire sur les volumes, puis passe SIMD
+// sur le gl_engine::CullingSet, seule puis répartie sur les threads du pool. Tous doivent trouver les mêmes objets.
+
+namespace {
+    constexpr std::size_t OBJECT_COUNT = 1000000;
+
+    /// Meilleur temps sur ce nombre de passes, les premières paient les défauts de cache et la création du pool.
+    constexpr int REPEAT_COUNT = 10;
+
+    /**
+     * @brief Répartit des boites de tailles et d’orientations aléatoires dans un cube de 1000 unités de côté.
+     */
+    std::vector<gl_engine::BoundingVolume> makeVolumes() {
+        std::mt19937 random(1);
+        std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+        std::uniform_real_distribution<float> size(0.2f, 3.0f);
+        std::uniform_real_distribution<float> angle(0.0f, 6.28f);
+
+        std::vector<gl_engine::BoundingVolume> volumes{};
+        volumes.reserve( OBJECT_COUNT );
+
+        for ( std::size_t i = 0; i < OBJECT_COUNT; ++i ) {
+            gl_engine::Bounds box{};
+            box.max = glm::vec3(size( random ));
+            box.min = -box.max;
+
+            const auto translation = glm::translate( glm::mat4(1.0f), glm::vec3(position( random ), position( random ), position( random )) );
+            const auto transform = glm::rotate( translation, angle( random ), glm::normalize( glm::vec3(1.0f, 2.0f, 3.0f) ) );
+
+            volumes.push_back( gl_engine::BoundingVolume::transform( box, transform ) );
+        }
+
+        return volumes;
+    }
+
+    double milliseconds( const std::chrono::steady_clock::time_point start ) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main() {
+    const auto volumes = makeVolumes();
+
+    gl_engine::CullingSet set{};
+    for ( const auto& volume : volumes ) {
+        set.add( volume );
+    }
+
+    const auto viewProjection = glm::perspective( 1.0f, 16.0f / 9.0f, 0.1f, 400.0f )
+                                * glm::lookAt( glm::vec3(0.0f), glm::vec3(1.0f, 0.2f, 0.3f), glm::vec3(0.0f, 1.0f, 0.0f) );
+    const auto frustum = gl_engine::Frustum::fromMatrix( viewProjection );
+
+    std::vector<std::uint32_t> expected{};
+    auto best = 1e9;
+
+    for ( int repeat = 0; repeat < REPEAT_COUNT; ++repeat ) {
+        const auto start = std::chrono::steady_clock::now();
+
+        expected.clear();
+        for ( std::size_t i = 0; i < volumes.size(); ++i ) {
+            if ( frustum.intersects( volumes[i] ) ) {
+                expected.push_back( static_cast<std::uint32_t>(i) );
+            }
+        }
+
+        best = std::min( best, milliseconds( start ) );
+    }
+
+    std::cout << OBJECT_COUNT << " objets, " << gl_engine::utility::hardwareThreadCount() << " cœur(s).\n";
+    std::cout << "Scalaire : " << best << " ms, " << expected.size() << " visibles.\n";
+
+    auto success = true;
+    std::vector<std::uint32_t> visible{};
+
+    for ( const unsigned threadCount : {1u, 2u, 4u, gl_engine::utility::AUTOMATIC_THREAD_COUNT} ) {
+        best = 1e9;
+
+        for ( int repeat = 0; repeat < REPEAT_COUNT; ++repeat ) {
+            best = std::min( best, gl_engine::FrustumCuller::cull( set, frustum, visible, threadCount ).milliseconds );
+        }
+
+        const auto identical = visible == expected;
+        success = success && identical;
+
+        std::cout << "SIMD, " << gl_engine::utility::resolveThreadCount( threadCount ) << " thread(s) : " << best << " ms, "
+                  << visible.size() << " visibles" << ( identical ? "" : " DIFFÉRENT" ) << ".\n";
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,260 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <glengine/model.hpp>
+#include <glengine/render_queue.hpp>
+#include <glengine/texture.hpp>
+#include <glengine/utility.hpp>
+
+// Dessine 100 000 copies du cube texturé du TP 3, une fois avec un programme classique (un dessin par copie),
+// une fois avec un programme lisant 'instanceModel' : la file regroupe alors les copies en dessins instanciés.
+// Le temps mesuré est celui du processeur pour soumettre, trier et rejouer la file, sans attendre le GPU.
+
+namespace {
+    constexpr std::size_t COPY_COUNT = 100000;
+
+    /// Meilleur temps sur ce nombre d’images, les premières paient la création des tampons.
+    constexpr int FRAME_COUNT = 8;
+
+    constexpr auto CLASSIC_VERTEX = R"(#version 330 core
+layout (location = 0) in vec3 position;
+layout (location = 2) in vec2 texCoord;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec2 vertexTexture;
+
+void main() {
+    vertexTexture = texCoord;
+    gl_Position = projection * view * model * vec4(position, 1.0f);
+})";
+
+    constexpr auto INSTANCED_VERTEX = R"(#version 330 core
+layout (location = 0) in vec3 position;
+layout (location = 2) in vec2 texCoord;
+layout (location = 3) in mat4 instanceModel;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec2 vertexTexture;
+
+void main() {
+    vertexTexture = texCoord;
+    gl_Position = projection * view * instanceModel * vec4(position, 1.0f);
+})";
+
+    constexpr auto FRAGMENT = R"(#version 330 core
+in vec2 vertexTexture;
+
+uniform sampler2D textureFrag;
+
+layout (location = 0) out vec4 fragColor;
+
+void main() {
+    fragColor = texture(textureFrag, vertexTexture);
+})";
+
+    /**
+     * @brief Compile et lie un programme, l’unité de texture diffuse est associée à 'textureFrag'.
+     */
+    gl_engine::Id makeProgram( const char* const vertexSource ) {
+        const auto vertex = gl_engine::open_gl::createShader( GL_VERTEX_SHADER );
+        gl_engine::open_gl::shaderSource( vertex, gl_engine::Content{vertexSource} );
+        gl_engine::open_gl::compileShader( vertex );
+
+        const auto fragment = gl_engine::open_gl::createShader( GL_FRAGMENT_SHADER );
+        gl_engine::open_gl::shaderSource( fragment, gl_engine::Content{FRAGMENT} );
+        gl_engine::open_gl::compileShader( fragment );
+
+        const auto program = gl_engine::open_gl::createProgram();
+        gl_engine::open_gl::attachShader( program, vertex );
+        gl_engine::open_gl::attachShader( program, fragment );
+        gl_engine::open_gl::linkProgram( program );
+        gl_engine::open_gl::deleteShader( vertex );
+        gl_engine::open_gl::deleteShader( fragment );
+
+        gl_engine::open_gl::useProgram( program );
+        glUniform1i( gl_engine::open_gl::getUniformLocation( program, "textureFrag" ),
+                     static_cast<GLint>(gl_engine::TextureSlot::DIFFUSE) );
+
+        return program;
+    }
+
+    /**
+     * @brief Le cube unité du TP 3 : 4 sommets par face pour que chacune ait sa normale et toute la texture.
+     */
+    gl_engine::Mesh makeCube() {
+        std::vector<gl_engine::Vertex> vertices{};
+        std::vector<std::uint32_t> indices{};
+
+        const std::array<glm::vec2, 4> corners{glm::vec2{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}};
+
+        for ( int face = 0; face < 6; ++face ) {
+            const auto axis = face / 2;
+
+            glm::vec3 normal(0.0f);
+            normal[axis] = face % 2 == 0 ? -0.5f : 0.5f;
+            glm::vec3 u(0.0f);
+            u[( axis + 1 ) % 3] = 0.5f;
+            glm::vec3 v(0.0f);
+            v[( axis + 2 ) % 3] = 0.5f;
+
+            const auto first = static_cast<std::uint32_t>(vertices.size());
+            for ( const auto& corner : corners ) {
+                const auto position = normal + ( corner.x * 2.0f - 1.0f ) * u + ( corner.y * 2.0f - 1.0f ) * v;
+                vertices.push_back( {position, normal * 2.0f, corner} );
+            }
+
+            for ( const auto index : {0u, 1u, 2u, 0u, 2u, 3u} ) {
+                indices.push_back( first + index );
+            }
+        }
+
+        return gl_engine::Mesh{std::move( vertices ), std::move( indices ), {gl_engine::SubMesh{"box", 0, 36}}};
+    }
+
+    struct FrameResult {
+        double milliseconds = 0.0;
+        gl_engine::RenderStatistics statistics{};
+    };
+
+    FrameResult measure( std::vector<gl_engine::Model>& copies, const gl_engine::Id program, const gl_engine::RenderView& view ) {
+        for ( auto& copy : copies ) {
+            copy.setProgram( program );
+        }
+
+        gl_engine::RenderQueue queue{};
+        FrameResult result{1e9, {}};
+
+        for ( int frame = 0; frame < FRAME_COUNT; ++frame ) {
+            glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+            glFinish();
+
+            const auto start = std::chrono::steady_clock::now();
+
+            queue.clear();
+            for ( const auto& copy : copies ) {
+                copy.submit( queue, view );
+            }
+            queue.sort();
+            queue.execute( view );
+
+            const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            result.milliseconds = std::min( result.milliseconds, elapsed );
+        }
+
+        result.statistics = queue.statistics();
+        glFinish();
+
+        return result;
+    }
+}
+
+int main() {
+    if ( GLFW_FALSE == ::glfwInit() ) {
+        std::cerr << "Impossible d’initialiser GLFW.\n";
+        return EXIT_FAILURE;
+    }
+
+    ::glfwWindowHint( GLFW_CONTEXT_VERSION_MAJOR, 3 );
+    ::glfwWindowHint( GLFW_CONTEXT_VERSION_MINOR, 3 );
+    ::glfwWindowHint( GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE );
+    ::glfwWindowHint( GLFW_VISIBLE, GLFW_FALSE );
+
+    auto* const window = ::glfwCreateWindow( 800, 600, "instancing", nullptr, nullptr );
+    if ( nullptr == window ) {
+        std::cerr << "Impossible de créer la fenêtre.\n";
+        ::glfwTerminate();
+        return EXIT_FAILURE;
+    }
+
+    ::glfwMakeContextCurrent( window );
+
+    auto success = false;
+
+    try {
+        if ( 0 == ::gladLoadGLLoader( reinterpret_cast<GLADloadproc>(::glfwGetProcAddress) ) ) {
+            throw std::runtime_error( "Impossible de charger GLAD" );
+        }
+
+        glEnable( GL_DEPTH_TEST );
+
+        gl_engine::Material box{};
+        box.name = "box";
+        box.textures[static_cast<std::size_t>(gl_engine::TextureSlot::DIFFUSE)] =
+                std::make_shared<gl_engine::Texture>( gl_engine::Path{BOX_TEXTURE} );
+
+        const gl_engine::ComplexObject cube{makeCube(), {box}};
+        const auto classic = makeProgram( CLASSIC_VERTEX );
+        const auto instanced = makeProgram( INSTANCED_VERTEX );
+
+        // Les copies forment un cube de copies espacées de deux unités, vu depuis un coin.
+        std::vector<gl_engine::Model> copies( COPY_COUNT, gl_engine::Model{cube, classic} );
+        const auto side = static_cast<std::size_t>(std::ceil( std::cbrt( static_cast<double>(COPY_COUNT) ) ));
+
+        for ( std::size_t i = 0; i < COPY_COUNT; ++i ) {
+            const glm::vec3 cell(i % side, ( i / side ) % side, i / ( side * side ));
+            copies[i].setTransform( glm::translate( glm::mat4(1.0f), cell * 2.0f ) );
+        }
+
+        gl_engine::RenderView view{};
+        view.eye = glm::vec3(-10.0f);
+        view.view = glm::lookAt( view.eye, glm::vec3(static_cast<float>(side)), glm::vec3(0.0f, 1.0f, 0.0f) );
+        view.projection = glm::perspective( 0.8f, 800.0f / 600.0f, 0.1f, 1000.0f );
+
+        const auto perCopy = measure( copies, classic, view );
+        const auto grouped = measure( copies, instanced, view );
+
+        std::cout << COPY_COUNT << " cubes texturés.\n";
+        std::cout << "Un dessin par copie : " << perCopy.milliseconds << " ms, " << perCopy.statistics.drawCount << " dessins.\n";
+        std::cout << "Instancié : " << grouped.milliseconds << " ms, " << grouped.statistics.drawCount << " dessins dont "
+                  << grouped.statistics.instancedDrawCount << " instanciés, " << grouped.statistics.instanceCount << " instances.\n";
+
+        success = perCopy.statistics.drawCount == COPY_COUNT && grouped.statistics.instanceCount == COPY_COUNT
+                  && grouped.statistics.drawCount < COPY_COUNT && glGetError() == GL_NO_ERROR;
+
+        gl_engine::open_gl::deleteProgram( classic );
+        gl_engine::open_gl::deleteProgram( instanced );
+    }
+    catch ( const std::exception& error ) {
+        std::cerr << error.what() << '\n';
+    }
+
+    ::glfwDestroyWindow( window );
+    ::glfwTerminate();
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
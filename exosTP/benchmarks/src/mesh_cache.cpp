@@ -0,0 +1,104 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <glengine/complex_object.hpp>
+#include <glengine/mesh_cache.hpp>
+#include <glengine/object_factory.hpp>
+#include <glengine/utility.hpp>
+
+// Charge une copie de bunny.obj sans cache, puis avec le cache '.glmesh' écrit par ce premier chargement.
+// Le maillage relu dans le cache doit être projeté en mémoire et identique à celui construit depuis le '.obj'.
+
+namespace {
+    /// Meilleur temps sur ce nombre de chargements à chaud.
+    constexpr int REPEAT_COUNT = 20;
+
+    /// Durée visée pour un chargement à chaud.
+    constexpr double EXPECTED_WARM_MILLISECONDS = 5.0;
+
+    double elapsedMilliseconds( const std::chrono::steady_clock::time_point start ) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    bool identical( const gl_engine::Mesh& m1, const gl_engine::Mesh& m2 ) {
+        if ( m1.vertexCount() != m2.vertexCount() || m1.indexCount() != m2.indexCount() || m1.indexSize() != m2.indexSize()
+             || m1.subMeshes().size() != m2.subMeshes().size() ) {
+            return false;
+        }
+
+        for ( std::size_t i = 0; i < m1.subMeshes().size(); ++i ) {
+            const auto& s1 = m1.subMeshes()[i];
+            const auto& s2 = m2.subMeshes()[i];
+            if ( s1.material != s2.material || s1.firstIndex != s2.firstIndex || s1.indexCount != s2.indexCount ) {
+                return false;
+            }
+        }
+
+        return std::memcmp( m1.vertices(), m2.vertices(), m1.vertexCount() * sizeof( gl_engine::Vertex ) ) == 0
+               && std::memcmp( m1.indices(), m2.indices(), m1.indexCount() * m1.indexSize() ) == 0
+               && std::memcmp( &m1.bounds(), &m2.bounds(), sizeof( gl_engine::Bounds ) ) == 0;
+    }
+
+    const gl_engine::Mesh& meshOf( const std::unique_ptr<gl_engine::Object>& object ) {
+        return static_cast<const gl_engine::ComplexObject&>(*object).mesh();
+    }
+}
+
+int main() {
+    namespace fs = std::filesystem;
+
+    // Note développeur : Le cache est écrit à côté du '.obj', on travaille sur une copie pour ne pas toucher aux ressources.
+    const auto directory = fs::temp_directory_path() / "glengine-mesh-cache";
+    fs::create_directories( directory );
+    const auto source = directory / "bunny.obj";
+    fs::copy_file( std::string{RESOURCES_DIRECTORY} + "bunny.obj", source, fs::copy_options::overwrite_existing );
+
+    const gl_engine::Path path{source.string()};
+    fs::remove( gl_engine::MeshCache::cachePath( path ) );
+
+    auto start = std::chrono::steady_clock::now();
+    const auto cold = gl_engine::ObjectFactory::load( path );
+    const auto coldMilliseconds = elapsedMilliseconds( start );
+
+    auto warmMilliseconds = 1e9;
+    std::unique_ptr<gl_engine::Object> warm{};
+    for ( int repeat = 0; repeat < REPEAT_COUNT; ++repeat ) {
+        start = std::chrono::steady_clock::now();
+        warm = gl_engine::ObjectFactory::load( path );
+        warmMilliseconds = std::min( warmMilliseconds, elapsedMilliseconds( start ) );
+    }
+
+    const auto mapped = meshOf( warm ).isMapped();
+    const auto same = identical( meshOf( cold ), meshOf( warm ) );
+
+    std::cout << "bunny.obj : sans cache " << coldMilliseconds << " ms, avec cache " << warmMilliseconds << " ms"
+              << ( warmMilliseconds < EXPECTED_WARM_MILLISECONDS ? "" : " (objectif 5 ms non atteint)" )
+              << ( mapped ? "" : ", cache NON UTILISÉ" ) << ( same ? "" : ", maillages DIFFÉRENTS" ) << ".\n";
+
+    fs::remove_all( directory );
+
+    return mapped && same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
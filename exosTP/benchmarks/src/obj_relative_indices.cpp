@@ -0,0 +1,125 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <glengine/obj_parser.hpp>
+
+// Vérifie l’analyse parallèle d’un '.obj' dont les faces utilisent des indices relatifs (négatifs) :
+// le résultat doit être identique à l’analyse séquentielle et au même fichier écrit avec des indices absolus.
+
+namespace {
+    /// Nombre de bandes de deux triangles, assez pour plusieurs mégaoctets et des dizaines de morceaux.
+    constexpr int STRIP_COUNT = 20000;
+
+    /**
+     * @brief Écrit une bande de deux triangles par groupe de 4 sommets, chaque face suit ses sommets.
+     * @param relative Écrit les indices relativement au dernier sommet déclaré.
+     *
+     * Une face sur sept référence aussi la bande précédente, parfois déclarée dans le morceau précédent.
+     */
+    std::string makeObj( const bool relative ) {
+        std::string obj{};
+
+        for ( int strip = 0; strip < STRIP_COUNT; ++strip ) {
+            for ( int corner = 0; corner < 4; ++corner ) {
+                const auto x = std::to_string( strip + ( corner == 1 || corner == 2 ? 1 : 0 ) );
+                const auto y = std::to_string( corner >= 2 ? 1 : 0 );
+
+                obj += "v " + x + ' ' + y + ' ' + std::to_string( strip % 13 ) + '\n';
+                obj += "vt " + x + ' ' + y + '\n';
+                obj += "vn 0 0 1\n";
+            }
+
+            const auto count = ( strip + 1 ) * 4;
+            const auto index = [&]( const int back ) {
+                const auto value = relative ? std::to_string( -back ) : std::to_string( count - back + 1 );
+                return value + '/' + value + '/' + value;
+            };
+
+            obj += "f " + index( 4 ) + ' ' + index( 3 ) + ' ' + index( 2 ) + '\n';
+            obj += "f " + index( 4 ) + ' ' + index( 2 ) + ' ' + index( 1 ) + '\n';
+
+            if ( strip > 0 && strip % 7 == 0 ) {
+                obj += "f " + index( 8 ) + ' ' + index( 5 ) + ' ' + index( 1 ) + '\n';
+            }
+        }
+
+        return obj;
+    }
+
+    bool same( const gl_engine::ObjData& a, const gl_engine::ObjData& b ) {
+        return a.positions == b.positions && a.texCoords == b.texCoords && a.normals == b.normals && a.corners == b.corners;
+    }
+
+    /**
+     * @brief Retourne le message de l’erreur d’analyse, vide si l’analyse réussit.
+     */
+    std::string parseError( const std::string& obj, const unsigned threadCount ) {
+        try {
+            static_cast<void>(gl_engine::ObjParser::parse( obj, threadCount ));
+        }
+        catch ( const gl_engine::ObjParseError& error ) {
+            return error.what();
+        }
+
+        return {};
+    }
+
+    /// Préfixe "Ligne N" d’un message d’erreur.
+    std::string linePrefix( const std::string& message ) {
+        return message.substr( 0, message.find( ':' ) );
+    }
+}
+
+int main() {
+    auto success = true;
+
+    const auto relative = makeObj( true );
+    const auto absolute = makeObj( false );
+
+    std::cout << "Fichier : " << relative.size() / 1024 << " Kio, " << STRIP_COUNT << " bandes.\n";
+
+    const auto expected = gl_engine::ObjParser::parse( absolute, 1 );
+
+    for ( const unsigned threadCount : {1u, 2u, 3u, 4u, 8u, 16u} ) {
+        const auto parsed = gl_engine::ObjParser::parse( relative, threadCount );
+        const auto identical = same( parsed, expected );
+
+        std::cout << threadCount << " thread(s) : " << ( identical ? "identique" : "DIFFÉRENT" ) << '\n';
+        success = success && identical;
+    }
+
+    // Une face de la fin du fichier référence un sommet précédant son début : même ligne signalée dans les deux modes.
+    const auto invalid = relative + "f -1 -2 -" + std::to_string( STRIP_COUNT * 4 + 1 ) + '\n';
+    const auto sequentialError = parseError( invalid, 1 );
+
+    for ( const unsigned threadCount : {2u, 8u, 16u} ) {
+        const auto error = parseError( invalid, threadCount );
+        const auto sameLine = !error.empty() && linePrefix( error ) == linePrefix( sequentialError );
+
+        std::cout << threadCount << " thread(s), indice invalide : " << error << '\n';
+        success = success && sameLine;
+    }
+
+    std::cout << "Séquentiel, indice invalide : " << sequentialError << '\n';
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
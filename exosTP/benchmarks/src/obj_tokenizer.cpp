@@ -0,0 +1,144 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <glengine/obj_parser.hpp>
+#include <glengine/utility.hpp>
+
+// Compare le chargement d’un '.obj' par l’ancien chemin (Content, std::stringstream puis operator>>)
+// à la lecture du fichier projeté en mémoire par gl_engine::ObjParser. Les deux doivent lire les mêmes éléments.
+
+namespace {
+    /// Meilleur temps sur ce nombre de lectures, fichier compris.
+    constexpr int REPEAT_COUNT = 10;
+
+    /// Gain demandé sur le chemin par flux.
+    constexpr double EXPECTED_SPEEDUP = 10.0;
+
+    struct Counts {
+        std::size_t positions = 0;
+        std::size_t texCoords = 0;
+        std::size_t normals = 0;
+        std::size_t triangles = 0;
+    };
+
+    bool operator==( const Counts& c1, const Counts& c2 ) noexcept {
+        return c1.positions == c2.positions && c1.texCoords == c2.texCoords && c1.normals == c2.normals
+               && c1.triangles == c2.triangles;
+    }
+
+    /**
+     * @brief Reproduit l’ancien chargement : copie du fichier dans un Content, puis dans un flux lu mot à mot.
+     *
+     * Seuls les triangles sont lus, comme dans l’ancien ObjectFactory::load.
+     */
+    Counts loadWithStream( const gl_engine::Path& path ) {
+        const gl_engine::Content content{path};
+        std::stringstream stream(content.content());
+
+        std::vector<glm::vec3> positions{};
+        std::vector<glm::vec2> texCoords{};
+        std::vector<glm::vec3> normals{};
+        std::vector<gl_engine::Corner> corners{};
+
+        std::string word{};
+        while ( stream >> word ) {
+            if ( word == "v" || word == "vn" ) {
+                glm::vec3 value{};
+                stream >> value.x >> value.y >> value.z;
+                ( word == "v" ? positions : normals ).push_back( value );
+            }
+            else if ( word == "vt" ) {
+                glm::vec2 value{};
+                stream >> value.x >> value.y;
+                texCoords.push_back( value );
+            }
+            else if ( word == "f" ) {
+                for ( int i = 0; i < 3; ++i ) {
+                    std::string token{};
+                    stream >> token;
+
+                    gl_engine::Corner corner{};
+                    std::stringstream indices(token);
+                    std::string index{};
+                    for ( int attribute = 0; std::getline( indices, index, '/' ); ++attribute ) {
+                        if ( !index.empty() ) {
+                            const auto value = static_cast<std::uint32_t>(std::stoul( index ) - 1);
+                            ( attribute == 0 ? corner.position : attribute == 1 ? corner.texture : corner.normal ) = value;
+                        }
+                    }
+
+                    corners.push_back( corner );
+                }
+            }
+            else {
+                std::getline( stream, word );
+            }
+        }
+
+        return {positions.size(), texCoords.size(), normals.size(), corners.size() / 3};
+    }
+
+    Counts loadMapped( const gl_engine::Path& path ) {
+        const gl_engine::MappedFile file{path};
+        const auto data = gl_engine::ObjParser::parse( file.view() );
+
+        return {data.positions.size(), data.texCoords.size(), data.normals.size(), data.triangleCount()};
+    }
+
+    template<typename Load>
+    double bestMilliseconds( const Load& load, Counts& counts ) {
+        auto best = 1e9;
+
+        for ( int repeat = 0; repeat < REPEAT_COUNT; ++repeat ) {
+            const auto start = std::chrono::steady_clock::now();
+            counts = load();
+            best = std::min( best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() );
+        }
+
+        return best;
+    }
+}
+
+int main() {
+    auto success = true;
+
+    for ( const auto* const name : {"bunny.obj", "dragon2_small.obj"} ) {
+        const gl_engine::Path path{std::string{RESOURCES_DIRECTORY} + name};
+
+        Counts streamCounts{};
+        Counts mappedCounts{};
+        const auto stream = bestMilliseconds( [&path]() { return loadWithStream( path ); }, streamCounts );
+        const auto mapped = bestMilliseconds( [&path]() { return loadMapped( path ); }, mappedCounts );
+
+        const auto identical = streamCounts == mappedCounts;
+        success = success && identical;
+
+        std::cout << name << " : flux " << stream << " ms, projection en mémoire " << mapped << " ms, x" << stream / mapped
+                  << ( stream / mapped >= EXPECTED_SPEEDUP ? "" : " (objectif x10 non atteint)" )
+                  << ( identical ? "" : ", éléments DIFFÉRENTS" ) << ".\n";
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,170 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <glengine/program_binary_cache.hpp>
+#include <glengine/shaderProgram.hpp>
+#include <glengine/utility.hpp>
+
+// Démarrage de PROGRAM_COUNT programmes au fragment shader coûteux, avec un gl_engine::ProgramBinaryCache vide
+// puis avec le même cache rempli par ce premier démarrage. Au second, chaque programme doit être relu dans le cache.
+// Les sources portent un numéro propre à l’exécution : le cache de shaders du pilote ne les a jamais vues,
+// le premier démarrage est donc à froid à chaque exécution.
+
+namespace {
+    constexpr int PROGRAM_COUNT = 12;
+
+    constexpr int FUNCTION_COUNT = 24;
+
+    constexpr auto VERTEX = R"(#version 330 core
+layout (location = 0) in vec3 position;
+
+uniform mat4 modelViewProjection;
+
+out vec3 fragPosition;
+
+void main() {
+    fragPosition = position;
+    gl_Position = modelViewProjection * vec4(position, 1.0f);
+})";
+
+    /**
+     * @brief Génère un fragment shader différent pour chaque variante, assez long pour que sa compilation domine.
+     */
+    std::string fragment( const int variant, const std::string& run ) {
+        std::string source = "#version 330 core\n// Exécution " + run + "\n#define VARIANT " + std::to_string( variant ) + "\n"
+                             "in vec3 fragPosition;\n"
+                             "uniform sampler2D textures[4];\n"
+                             "layout (location = 0) out vec4 fragColor;\n";
+
+        for ( int f = 0; f < FUNCTION_COUNT; ++f ) {
+            const auto index = std::to_string( f );
+            source += "vec3 f" + index + "( vec3 x ) {\n"
+                      "    vec3 r = x;\n"
+                      "    for ( int i = 0; i < VARIANT + 3; ++i ) {\n"
+                      "        r = sin( r * 1.3f + cos( r.yzx * 0.7f ) )\n"
+                      "            + texture( textures[" + std::to_string( f % 4 ) + "], r.xy ).rgb * normalize( r + vec3(0.1f) ) * dot( r, vec3(0.3f) );\n"
+                      "    }\n"
+                      "    return r;\n"
+                      "}\n";
+        }
+
+        source += "void main() {\n    vec3 a = fragPosition;\n";
+        for ( int f = 0; f < FUNCTION_COUNT; ++f ) {
+            source += "    a += f" + std::to_string( f ) + "( a * " + std::to_string( f + 1 ) + ".0f );\n";
+        }
+        source += "    fragColor = vec4(a, 1.0f);\n}\n";
+
+        return source;
+    }
+
+    /**
+     * @brief Construit tous les programmes avec le cache, retourne la durée en millisecondes.
+     * @param run Le numéro de l’exécution, inséré dans les sources.
+     * @param fromCache Reçoit le nombre de programmes relus dans le cache.
+     */
+    double startup( const gl_engine::ProgramBinaryCache& cache, const std::string& run, int& fromCache ) {
+        fromCache = 0;
+        const auto start = std::chrono::steady_clock::now();
+
+        for ( int variant = 0; variant < PROGRAM_COUNT; ++variant ) {
+            gl_engine::ShaderProgram program{gl_engine::Content{VERTEX}, gl_engine::Content{fragment( variant, run )}, cache};
+            program.use();
+            fromCache += program.fromCache() ? 1 : 0;
+        }
+
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main() {
+    if ( GLFW_FALSE == ::glfwInit() ) {
+        std::cerr << "Impossible d’initialiser GLFW.\n";
+        return EXIT_FAILURE;
+    }
+
+    // Note développeur : Les binaires de programme demandent OpenGL 4.1.
+    ::glfwWindowHint( GLFW_CONTEXT_VERSION_MAJOR, 4 );
+    ::glfwWindowHint( GLFW_CONTEXT_VERSION_MINOR, 1 );
+    ::glfwWindowHint( GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE );
+    ::glfwWindowHint( GLFW_VISIBLE, GLFW_FALSE );
+
+    auto* const window = ::glfwCreateWindow( 64, 64, "program-binary-cache", nullptr, nullptr );
+    if ( nullptr == window ) {
+        std::cerr << "Impossible de créer la fenêtre.\n";
+        ::glfwTerminate();
+        return EXIT_FAILURE;
+    }
+
+    ::glfwMakeContextCurrent( window );
+
+    auto success = false;
+    const auto directory = std::filesystem::temp_directory_path() / "glengine-program-binary-cache";
+
+    try {
+        if ( 0 == ::gladLoadGLLoader( reinterpret_cast<GLADloadproc>(::glfwGetProcAddress) ) ) {
+            throw std::runtime_error( "Impossible de charger GLAD" );
+        }
+
+        std::filesystem::remove_all( directory );
+        const gl_engine::ProgramBinaryCache cache{directory};
+
+        if ( !cache.enabled() ) {
+            // Note développeur : Le pilote peut ne proposer aucun format de binaire, il n’y a alors rien à mesurer.
+            std::cout << "Aucun format de binaire de programme dans ce contexte, rien à mesurer.\n";
+            success = true;
+        }
+        else {
+            const auto run = std::to_string( std::chrono::system_clock::now().time_since_epoch().count() );
+
+            int coldFromCache = 0;
+            int warmFromCache = 0;
+            const auto cold = startup( cache, run, coldFromCache );
+            const auto warm = startup( cache, run, warmFromCache );
+
+            std::cout << PROGRAM_COUNT << " programmes : cache vide " << cold << " ms (" << cold / PROGRAM_COUNT
+                      << " ms par programme), cache rempli " << warm << " ms (" << warm / PROGRAM_COUNT
+                      << " ms par programme), x" << cold / warm << ".\n";
+
+            if ( warmFromCache != PROGRAM_COUNT ) {
+                std::cout << "Seulement " << warmFromCache << " programme(s) relu(s) dans le cache.\n";
+            }
+
+            success = coldFromCache == 0 && warmFromCache == PROGRAM_COUNT && glGetError() == GL_NO_ERROR;
+        }
+    }
+    catch ( const std::exception& error ) {
+        std::cerr << error.what() << '\n';
+    }
+
+    std::error_code ignored{};
+    std::filesystem::remove_all( directory, ignored );
+
+    ::glfwDestroyWindow( window );
+    ::glfwTerminate();
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,162 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <glengine/shader_compiler.hpp>
+#include <glengine/utility.hpp>
+
+// Construit PROGRAM_COUNT programmes au fragment shader coûteux avec gl_engine::ShaderCompiler, d’abord un par un
+// (submit puis get), puis en soumettant tous les programmes avant de les récupérer. Avec un pilote compilant en
+// arrière-plan (KHR_parallel_shader_compile), le second démarrage devrait approcher la plus longue compilation seule.
+// Note : cet objectif n’a pas pu être vérifié, le seul pilote disponible (llvmpipe, un cœur) compile pendant submit.
+// Les sources portent un numéro propre à l’exécution et à la mesure : le cache de shaders du pilote ne les a jamais vues.
+
+namespace {
+    constexpr int PROGRAM_COUNT = 12;
+
+    constexpr int FUNCTION_COUNT = 24;
+
+    /// Écart toléré avec la plus longue compilation seule pour considérer l’objectif atteint.
+    constexpr double EXPECTED_RATIO = 1.5;
+
+    constexpr auto VERTEX = R"(#version 330 core
+layout (location = 0) in vec3 position;
+
+uniform mat4 modelViewProjection;
+
+out vec3 fragPosition;
+
+void main() {
+    fragPosition = position;
+    gl_Position = modelViewProjection * vec4(position, 1.0f);
+})";
+
+    /**
+     * @brief Génère un fragment shader différent pour chaque variante, assez long pour que sa compilation domine.
+     * @param tag Inséré dans les sources pour qu’aucun cache ne les connaisse.
+     */
+    std::string fragment( const int variant, const std::string& tag ) {
+        std::string source = "#version 330 core\n// " + tag + "\n#define VARIANT " + std::to_string( variant ) + "\n"
+                             "in vec3 fragPosition;\n"
+                             "uniform sampler2D textures[4];\n"
+                             "layout (location = 0) out vec4 fragColor;\n";
+
+        for ( int f = 0; f < FUNCTION_COUNT; ++f ) {
+            source += "vec3 f" + std::to_string( f ) + "( vec3 x ) {\n"
+                      "    vec3 r = x;\n"
+                      "    for ( int i = 0; i < VARIANT % 5 + 3; ++i ) {\n"
+                      "        r = sin( r * 1.3f + cos( r.yzx * 0.7f ) )\n"
+                      "            + texture( textures[" + std::to_string( f % 4 ) + "], r.xy ).rgb * normalize( r + vec3(0.1f) ) * dot( r, vec3(0.3f) );\n"
+                      "    }\n"
+                      "    return r;\n"
+                      "}\n";
+        }
+
+        source += "void main() {\n    vec3 a = fragPosition;\n";
+        for ( int f = 0; f < FUNCTION_COUNT; ++f ) {
+            source += "    a += f" + std::to_string( f ) + "( a * " + std::to_string( f + 1 ) + ".0f );\n";
+        }
+        source += "    fragColor = vec4(a, 1.0f);\n}\n";
+
+        return source;
+    }
+
+    double elapsedMilliseconds( const std::chrono::steady_clock::time_point start ) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main() {
+    if ( GLFW_FALSE == ::glfwInit() ) {
+        std::cerr << "Impossible d’initialiser GLFW.\n";
+        return EXIT_FAILURE;
+    }
+
+    ::glfwWindowHint( GLFW_CONTEXT_VERSION_MAJOR, 3 );
+    ::glfwWindowHint( GLFW_CONTEXT_VERSION_MINOR, 3 );
+    ::glfwWindowHint( GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE );
+    ::glfwWindowHint( GLFW_VISIBLE, GLFW_FALSE );
+
+    auto* const window = ::glfwCreateWindow( 64, 64, "shader-compiler", nullptr, nullptr );
+    if ( nullptr == window ) {
+        std::cerr << "Impossible de créer la fenêtre.\n";
+        ::glfwTerminate();
+        return EXIT_FAILURE;
+    }
+
+    ::glfwMakeContextCurrent( window );
+
+    auto success = false;
+
+    try {
+        if ( 0 == ::gladLoadGLLoader( reinterpret_cast<GLADloadproc>(::glfwGetProcAddress) ) ) {
+            throw std::runtime_error( "Impossible de charger GLAD" );
+        }
+
+        const gl_engine::ShaderCompiler compiler{};
+        const auto run = std::to_string( std::chrono::system_clock::now().time_since_epoch().count() );
+
+        // Un par un : chaque programme est attendu avant de soumettre le suivant.
+        auto longest = 0.0;
+        auto start = std::chrono::steady_clock::now();
+        for ( int variant = 0; variant < PROGRAM_COUNT; ++variant ) {
+            const auto programStart = std::chrono::steady_clock::now();
+            auto program = compiler.submit( gl_engine::Content{VERTEX}, gl_engine::Content{fragment( variant, "un par un " + run )} ).get();
+            program.use();
+            longest = std::max( longest, elapsedMilliseconds( programStart ) );
+        }
+        const auto serial = elapsedMilliseconds( start );
+
+        // Tous soumis d’abord, puis récupérés.
+        start = std::chrono::steady_clock::now();
+        std::vector<gl_engine::ProgramFuture> futures{};
+        for ( int variant = 0; variant < PROGRAM_COUNT; ++variant ) {
+            futures.push_back( compiler.submit( gl_engine::Content{VERTEX}, gl_engine::Content{fragment( variant, "par lot " + run )} ) );
+        }
+        const auto submitted = elapsedMilliseconds( start );
+        for ( auto& future : futures ) {
+            auto program = future.get();
+            program.use();
+        }
+        const auto batch = elapsedMilliseconds( start );
+
+        std::cout << PROGRAM_COUNT << " programmes, compilation parallèle " << ( compiler.parallel() ? "annoncée" : "absente" )
+                  << " : un par un " << serial << " ms (plus longue compilation " << longest << " ms), par lot " << batch
+                  << " ms dont " << submitted << " ms de soumission, x" << batch / longest << " la plus longue compilation"
+                  << ( batch <= EXPECTED_RATIO * longest ? "" : " (objectif non atteint, non vérifié sur ce pilote)" ) << ".\n";
+
+        success = glGetError() == GL_NO_ERROR;
+    }
+    catch ( const std::exception& error ) {
+        std::cerr << error.what() << '\n';
+    }
+
+    ::glfwDestroyWindow( window );
+    ::glfwTerminate();
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,170 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <glengine/shader.hpp>
+#include <glengine/shaderProgram.hpp>
+#include <glengine/utility.hpp>
+
+// Compare le coût d’un appel à ShaderProgram::setUniform selon la façon de désigner l’uniforme : par son nom,
+// par un gl_engine::UniformId, par un gl_engine::UniformHandle résolu une fois, et l’appel OpenGL seul.
+
+namespace {
+    constexpr int CALL_COUNT = 2000000;
+
+    constexpr auto VERTEX = R"(#version 330 core
+layout (location = 0) in vec3 position;
+
+uniform mat4 modelViewProjection;
+
+void main() {
+    gl_Position = modelViewProjection * vec4(position, 1.0f);
+})";
+
+    constexpr auto FRAGMENT = R"(#version 330 core
+uniform float time;
+
+layout (location = 0) out vec4 fragColor;
+
+void main() {
+    fragColor = vec4(time);
+})";
+
+    constexpr gl_engine::UniformId MODEL_VIEW_PROJECTION{"modelViewProjection"};
+    constexpr gl_engine::UniformId TIME{"time"};
+
+    /**
+     * @brief Affiche la durée moyenne d’un appel de call, en nanosecondes.
+     */
+    void measure( const char* const label, const std::function<void( int )>& call ) {
+        const auto start = std::chrono::steady_clock::now();
+
+        for ( int i = 0; i < CALL_COUNT; ++i ) {
+            call( i );
+        }
+
+        const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        std::cout << label << ' ' << elapsed / CALL_COUNT << " ns\n";
+    }
+}
+
+int main() {
+    if ( GLFW_FALSE == ::glfwInit() ) {
+        std::cerr << "Impossible d’initialiser GLFW.\n";
+        return EXIT_FAILURE;
+    }
+
+    ::glfwWindowHint( GLFW_CONTEXT_VERSION_MAJOR, 3 );
+    ::glfwWindowHint( GLFW_CONTEXT_VERSION_MINOR, 3 );
+    ::glfwWindowHint( GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE );
+    ::glfwWindowHint( GLFW_VISIBLE, GLFW_FALSE );
+
+    auto* const window = ::glfwCreateWindow( 64, 64, "uniform-handles", nullptr, nullptr );
+    if ( nullptr == window ) {
+        std::cerr << "Impossible de créer la fenêtre.\n";
+        ::glfwTerminate();
+        return EXIT_FAILURE;
+    }
+
+    ::glfwMakeContextCurrent( window );
+
+    auto success = false;
+
+    try {
+        if ( 0 == ::gladLoadGLLoader( reinterpret_cast<GLADloadproc>(::glfwGetProcAddress) ) ) {
+            throw std::runtime_error( "Impossible de charger GLAD" );
+        }
+
+        gl_engine::ShaderProgram program{gl_engine::VertexShader{gl_engine::Content{VERTEX}},
+                                         gl_engine::FragmentShader{gl_engine::Content{FRAGMENT}}};
+        program.use();
+
+        const auto matrixHandle = program.uniform( MODEL_VIEW_PROJECTION );
+        const auto timeHandle = program.uniform( TIME );
+
+        // La valeur change à chaque appel pour qu’aucune couche ne puisse ignorer un envoi identique.
+        const auto matrix = []( const int i ) {
+            return glm::mat4(static_cast<float>(i));
+        };
+        const auto time = []( const int i ) {
+            return static_cast<float>(i);
+        };
+
+        constexpr auto NO = gl_engine::ShaderProgram::TRANSPOSE::NO;
+
+        std::cout << CALL_COUNT << " appels par mesure.\n";
+
+        measure( "mat4, par nom :", [&]( const int i ) {
+            program.setUniform( "modelViewProjection", matrix( i ), NO );
+        } );
+        measure( "mat4, par UniformId :", [&]( const int i ) {
+            program.setUniform( MODEL_VIEW_PROJECTION, matrix( i ), NO );
+        } );
+        measure( "mat4, par UniformHandle :", [&]( const int i ) {
+            program.setUniform( matrixHandle, matrix( i ), NO );
+        } );
+        measure( "mat4, OpenGL seul :", [&]( const int i ) {
+            glUniformMatrix4fv( matrixHandle.location(), 1, GL_FALSE, glm::value_ptr( matrix( i ) ) );
+        } );
+
+        measure( "float, par nom :", [&]( const int i ) {
+            program.setUniform( "time", time( i ) );
+        } );
+        measure( "float, par UniformId :", [&]( const int i ) {
+            program.setUniform( TIME, time( i ) );
+        } );
+        measure( "float, par UniformHandle :", [&]( const int i ) {
+            program.setUniform( timeHandle, time( i ) );
+        } );
+        measure( "float, OpenGL seul :", [&]( const int i ) {
+            glUniform1f( timeHandle.location(), time( i ) );
+        } );
+
+        // Les deux chemins doivent écrire au même endroit.
+        GLint current = 0;
+        glGetIntegerv( GL_CURRENT_PROGRAM, &current );
+
+        program.setUniform( "time", 2.0f );
+        GLfloat byName = 0.0f;
+        glGetUniformfv( static_cast<GLuint>(current), timeHandle.location(), &byName );
+
+        program.setUniform( timeHandle, 3.0f );
+        GLfloat byHandle = 0.0f;
+        glGetUniformfv( static_cast<GLuint>(current), timeHandle.location(), &byHandle );
+
+        success = byName == 2.0f && byHandle == 3.0f && glGetError() == GL_NO_ERROR;
+    }
+    catch ( const std::exception& error ) {
+        std::cerr << error.what() << '\n';
+    }
+
+    ::glfwDestroyWindow( window );
+    ::glfwTerminate();
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
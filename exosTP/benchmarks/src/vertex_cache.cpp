@@ -0,0 +1,102 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <glengine/mesh_builder.hpp>
+#include <glengine/mesh_optimizer.hpp>
+#include <glengine/obj_parser.hpp>
+#include <glengine/utility.hpp>
+
+// Mesure l’ACMR (sommets transformés par triangle) et l’ATVR (sommets transformés par sommet) de bunny.obj et
+// dragon2_small.obj avec un cache FIFO de 16 et 32 entrées, avant et après gl_engine::MeshOptimizer::optimize.
+// L’optimisation ne doit que réordonner : chaque plage de matériau garde le même ensemble de triangles.
+
+namespace {
+    /// Un triangle par ses trois positions, en commençant par la plus petite pour garder son orientation.
+    using Triangle = std::array<float, 9>;
+
+    std::vector<Triangle> triangles( const gl_engine::Mesh& mesh, const gl_engine::SubMesh& subMesh ) {
+        std::vector<Triangle> result{};
+        result.reserve( subMesh.indexCount / 3 );
+
+        for ( std::size_t i = subMesh.firstIndex; i < subMesh.firstIndex + subMesh.indexCount; i += 3 ) {
+            std::array<glm::vec3, 3> positions{};
+            std::size_t first = 0;
+            for ( std::size_t corner = 0; corner < 3; ++corner ) {
+                positions[corner] = mesh.vertices()[mesh.index( i + corner )].position;
+                if ( std::memcmp( &positions[corner], &positions[first], sizeof( glm::vec3 ) ) < 0 ) {
+                    first = corner;
+                }
+            }
+
+            Triangle triangle{};
+            for ( std::size_t corner = 0; corner < 3; ++corner ) {
+                std::memcpy( &triangle[corner * 3], &positions[( first + corner ) % 3], sizeof( glm::vec3 ) );
+            }
+            result.push_back( triangle );
+        }
+
+        std::sort( result.begin(), result.end() );
+        return result;
+    }
+
+    bool sameTriangles( const gl_engine::Mesh& m1, const gl_engine::Mesh& m2 ) {
+        if ( m1.subMeshes().size() != m2.subMeshes().size() ) {
+            return false;
+        }
+
+        for ( std::size_t i = 0; i < m1.subMeshes().size(); ++i ) {
+            if ( triangles( m1, m1.subMeshes()[i] ) != triangles( m2, m2.subMeshes()[i] ) ) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+int main() {
+    auto success = true;
+
+    for ( const auto* const name : {"bunny.obj", "dragon2_small.obj"} ) {
+        const gl_engine::MappedFile file{gl_engine::Path{std::string{RESOURCES_DIRECTORY} + name}};
+        const auto mesh = gl_engine::MeshBuilder::build( gl_engine::ObjParser::parse( file.view() ) );
+        const auto optimized = gl_engine::MeshOptimizer::optimize( mesh );
+
+        for ( const std::size_t cacheSize : {16, 32} ) {
+            const auto before = gl_engine::MeshOptimizer::analyzeVertexCache( mesh, cacheSize );
+            const auto after = gl_engine::MeshOptimizer::analyzeVertexCache( optimized, cacheSize );
+
+            std::cout << name << " : FIFO " << cacheSize << ", ACMR " << before.acmr << " -> " << after.acmr << ", ATVR "
+                      << before.atvr << " -> " << after.atvr << ".\n";
+        }
+
+        if ( !sameTriangles( mesh, optimized ) ) {
+            std::cout << name << " : triangles DIFFÉRENTS après optimisation.\n";
+            success = false;
+        }
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
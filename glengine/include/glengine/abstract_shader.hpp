@@ -18,17 +18,27 @@
 #ifndef GLENGINE_ABSTRACT_SHADER_HPP
 #define GLENGINE_ABSTRACT_SHADER_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
 #include <glengine/utility.hpp>
 #include <glengine/shader_interface.hpp>
 
 namespace gl_engine {
+    class ShaderCache;
+
     /**
     * @brief Classe abstraite représentant un shader OpenGL. Alloue et supprime le shader OpenGL, implémente l'interface gl_engine::Shader.
     *
-    * @version 1.0
+    * Le shader OpenGL est partagé entre toutes les copies : copier un shader incrémente seulement un compteur de références,
+    * le shader OpenGL est supprimé avec la dernière copie.
+    *
+    * @version 2.0
     * @since 0.1
     *
     * @see [Shader](https://www.khronos.org/opengl/wiki/Shader)
+    * @see gl_engine::ShaderCache
     */
     class AbstractShader : public Shader {
     public:
@@ -51,73 +61,140 @@ namespace gl_engine {
          * @throws std::runtime_error Lancée s'il n'est pas possible d'allouer le shader.
          * @throws std::runtime_error Lancée si une erreur est détectée durant l'ajout du code source du shader.
          * @throws std::runtime_error Lancée si une erreur est détectée durant la compilation du shader.
-         * @exceptsafe BASE. // TODO OpenGL dans quel état
+         * @exceptsafe FORT. Le shader OpenGL est supprimé en cas d’exception.
+         *
+         * @version 2.0
+         * @since 0.1
+         *
          * @see gl_engine::Shader::Type
          * @see gl_engine::utility::Content
          * @see gl_engine::utility::Path
+         *
+         * @note Un shader de même type et de même source, déjà compilé dans le contexte courant, est réutilisé
+         * sans recompilation, voir gl_engine::ShaderCache.
          */
         explicit AbstractShader( Shader_t type, Content content );
 
         /**
-        * @brief Construit un shader en copiant la source du shader passé en copie.
-        * @param source Le shader copié.
-        * @throws TODO Faire les exceptions
-        * @exceptsafe FORT. Ne modifie pas les données en cas d'exception.
+        * @brief Construit un shader partageant le shader OpenGL de other.
+        * @param other Le shader copié.
+        * @exceptsafe NO-THROW. Incrémente seulement le compteur de références.
         */
-        AbstractShader( const AbstractShader& other );
+        AbstractShader( const AbstractShader& other ) noexcept = default;
 
         /**
         * @brief Construit un shader en déplaçant le shader passé en paramètre.
-        * @param source Le shader à déplacer.
-        * @throws TODO Faire les exceptions
-        * @exceptsafe FORT. Ne lance aucune exception.
+        * @param other Le shader à déplacer.
+        * @exceptsafe NO-THROW.
         */
-        AbstractShader( AbstractShader&& other ) noexcept;
+        AbstractShader( AbstractShader&& other ) noexcept = default;
 
-        // Suppression du précédent shader avant l’affectation du nouveau
-        AbstractShader& operator=( const AbstractShader& other );
+        // Le shader OpenGL précédent est supprimé s’il n’est plus partagé.
+        AbstractShader& operator=( const AbstractShader& other ) noexcept = default;
 
-        AbstractShader& operator=( AbstractShader&& other ) noexcept;
+        AbstractShader& operator=( AbstractShader&& other ) noexcept = default;
 
         /**
-        * @brief Détruit le shader this.
+        * @brief Détruit le shader this, le shader OpenGL est supprimé avec sa dernière copie.
         * @exceptsafe NO-THROW.
         */
-        ~AbstractShader() noexcept;
+        ~AbstractShader() noexcept = default;
 
 
     private:
-        Id privateId_;
+        friend class ShaderCache;
+
+        /// Shader OpenGL compilé, partagé par les copies et par gl_engine::ShaderCache.
+        class Object;
+
+        std::shared_ptr<const Object> object_;
 
         /**
-        * @brief Link et compile le shader avec le contenu fourni
-        * @param source Le code source
-        * @throws TODO exceptiosn
-        * @exceptsafe TODO A déterminer
+        * @brief Alloue et compile un shader OpenGL avec le contenu fourni.
+        * @param type Le type du shader.
+        * @param source Le code source.
+        * @return Le shader compilé.
+        * @throws std::runtime_error Lancée si le shader ne peut pas être alloué ou compilé.
+        * @exceptsafe FORT. Le shader OpenGL est supprimé en cas d’exception.
         */
-        void compile( Content source ) const;
+        static std::shared_ptr<const Object> compile( Shader_t type, const Content& source );
+
+        Id id_() const noexcept override;
+
+        Content source_() const override;
+
+        Shader_t type_() const override;
+
+    };
+
+    /**
+     * @brief Cache des shaders compilés, indexé par le contexte courant, le type et l’empreinte de la source.
+     *
+     * Utilisé par chaque construction d’un gl_engine::AbstractShader : une source identique n’est compilée qu’une fois
+     * par contexte, tant qu’un shader la partage encore.
+     *
+     * Un shader détruit alors qu’un autre contexte est courant est supprimé plus tard, dans son contexte ;
+     * celui d’un contexte libéré par gl_engine::open_gl::releaseState est simplement oublié.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::AbstractShader
+     * @see gl_engine::TextureCache
+     */
+    class ShaderCache final {
+    public:
+        // Note développeur : Classe purement statique, comme gl_engine::TextureCache.
+
+        ShaderCache() noexcept = delete;
+        ShaderCache( const ShaderCache& ) noexcept = delete;
+        ShaderCache( ShaderCache&& ) noexcept = delete;
+        ShaderCache& operator=( const ShaderCache& ) noexcept = delete;
+        ShaderCache& operator=( ShaderCache&& ) noexcept = delete;
+        ~ShaderCache() noexcept = delete;
 
         /**
-         * @brief Lance une exception en fonction de l’erreur de compilation du shader.
-         *
-         * @throws
-         * @throws
+         * @brief Retourne le nombre de shaders OpenGL encore utilisés, tous contextes confondus.
          *
-         * @exceptsafe FORT. Cette méthode ne modifie aucune donnée, c’est à la fonction appelante de faire le travail nécessaire.
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] static std::size_t size() noexcept;
+
+        /**
+         * @brief Oublie les shaders qui ne sont plus utilisés ou dont le contexte a été libéré,
+         * et supprime les shaders différés du contexte courant.
          *
-         * @version 1.0
-         * @since 0.1
+         * @exceptsafe NO-THROW.
          */
-        void checkCompileError() const;
+        static void purge() noexcept;
 
-        Id id_() const noexcept override {
-            return privateId_;
-        };
+    private:
+        friend class AbstractShader;
+        friend class AbstractShader::Object;
 
-        Content source_() const override;
+        struct State;
 
-        Shader_t type_() const override;
+        static State& state();
 
+        /**
+         * @brief Retourne le shader compilé de même type et de même source dans le contexte courant, le compile sinon.
+         *
+         * @throws std::runtime_error Lancée si le shader ne peut pas être alloué ou compilé.
+         *
+         * @exceptsafe FORT.
+         */
+        static std::shared_ptr<const AbstractShader::Object> acquire( Shader_t type, const Content& source );
+
+        /**
+         * @brief Supprime un shader si son contexte est courant, sinon diffère sa suppression jusqu’au prochain
+         * appel d’acquire ou de purge dans ce contexte.
+         * @param context Le contexte du shader, voir gl_engine::open_gl::currentContext.
+         * @param id Le shader.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        static void release( std::uint64_t context, Id id ) noexcept;
     };
 }
 
@@ -0,0 +1,96 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef GLENGINE_BOUNDS_HPP
+#define GLENGINE_BOUNDS_HPP
+
+#include <algorithm>
+#include <cmath>
+
+#include <glm/glm.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Boite englobante alignée sur les axes.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct Bounds {
+        glm::vec3 min{};
+        glm::vec3 max{};
+    };
+
+    /**
+     * @brief Sphère englobante.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct BoundingSphere {
+        glm::vec3 center{};
+        float radius = 0.0f;
+    };
+
+    /**
+     * @brief Volumes englobants d’un objet dans le monde : une boite alignée sur les axes et une sphère.
+     *
+     * Les deux volumes se complètent : la boite d’un objet tourné grossit, pas sa sphère ; la sphère d’un objet
+     * allongé est bien plus grande que sa boite. Un test de visibilité retient le plus serré des deux.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::Object::bounds
+     * @see gl_engine::CullingSet
+     */
+    struct BoundingVolume {
+        Bounds box{};
+        BoundingSphere sphere{};
+
+        /**
+         * @brief Calcule les volumes dans le monde d’une boite exprimée dans le repère d’un objet.
+         * @param bounds La boite, dans le repère de l’objet.
+         * @param model La matrice de l’objet, affine.
+         * @return La boite alignée sur les axes du monde contenant la boite transformée, et la sphère contenant la boite.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @note La boite est calculée depuis le centre et les demi-côtés (méthode d’Arvo), sans transformer les 8 coins.
+         */
+        [[nodiscard]] static BoundingVolume transform( const Bounds& bounds, const glm::mat4& model ) noexcept {
+            const auto center = glm::vec3(model * glm::vec4( ( bounds.min + bounds.max ) * 0.5f, 1.0f ));
+            const auto extent = ( bounds.max - bounds.min ) * 0.5f;
+
+            const auto x = glm::vec3(model[0]);
+            const auto y = glm::vec3(model[1]);
+            const auto z = glm::vec3(model[2]);
+            const auto worldExtent = glm::abs( x ) * extent.x + glm::abs( y ) * extent.y + glm::abs( z ) * extent.z;
+
+            const auto scale = std::sqrt( std::max( {glm::dot( x, x ), glm::dot( y, y ), glm::dot( z, z )} ) );
+
+            return {{center - worldExtent, center + worldExtent}, {center, glm::length( extent ) * scale}};
+        }
+    };
+}
+
+#endif // GLENGINE_BOUNDS_HPP
@@ -0,0 +1,290 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef GLENGINE_BVH_HPP
+#define GLENGINE_BVH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <glengine/bounds.hpp>
+#include <glengine/culling.hpp>
+#include <glengine/parallel.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Nœud d’une gl_engine::Bvh, 32 octets : deux nœuds par ligne de cache.
+     *
+     * Les nœuds sont rangés en profondeur d’abord : le premier enfant d’un nœud interne le suit immédiatement,
+     * seul l’indice du second est conservé. Un sous-arbre occupe donc une plage contiguë de nœuds, et ses
+     * éléments une plage contiguë de gl_engine::Bvh::items.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct alignas(32) BvhNode {
+        glm::vec3 min{};
+        /// Nœud interne : indice du second enfant. Feuille : premier élément dans gl_engine::Bvh::items.
+        std::uint32_t index = 0;
+        glm::vec3 max{};
+        /// Nombre d’éléments d’une feuille, 0 pour un nœud interne.
+        std::uint32_t count = 0;
+
+        [[nodiscard]] bool leaf() const noexcept {
+            return count > 0;
+        }
+    };
+
+    static_assert( sizeof( BvhNode ) == 32, "Deux nœuds par ligne de cache." );
+
+    /**
+     * @brief Rayon d’une requête gl_engine::Bvh::raycast.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct Ray {
+        glm::vec3 origin{};
+        /// Direction, pas nécessairement normée : les distances sont exprimées en multiples de sa longueur.
+        glm::vec3 direction{0.0f, 0.0f, -1.0f};
+        float maxDistance = std::numeric_limits<float>::infinity();
+    };
+
+    /**
+     * @brief Élément touché par un rayon.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct RayHit {
+        std::uint32_t item = 0;
+        /// Distance d’entrée du rayon dans la boite de l’élément, 0 si l’origine y est.
+        float distance = 0.0f;
+    };
+
+    /**
+     * @brief Hiérarchie de volumes englobants sur les boites d’un ensemble d’éléments (les objets d’une scène par exemple).
+     *
+     * Construction : à chaque nœud, les centres des boites sont répartis dans BIN_COUNT intervalles sur chacun des trois
+     * axes, et la coupe minimisant l’heuristique de surface (SAH) est retenue si elle coûte moins qu’une feuille.
+     * Les niveaux du haut sont coupés sur le thread appelant, les sous-arbres obtenus sont ensuite construits en parallèle
+     * puis recopiés à leur place en profondeur d’abord.
+     *
+     * Quand les éléments bougent, refit() recalcule les boites sans changer l’arbre : les sous-arbres sont mis à jour
+     * en parallèle en remontant leur plage de nœuds, puis les nœuds du haut. La qualité de l’arbre baisse avec les
+     * déplacements, cost() permet de décider d’une reconstruction.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::Scene::render
+     */
+    class Bvh final {
+    public:
+        /// Intervalles évalués par axe lors de la recherche de la meilleure coupe.
+        static constexpr std::size_t BIN_COUNT = 16;
+
+        /// Au-delà, une feuille est toujours coupée même si la SAH la préfère.
+        static constexpr std::size_t MAXIMUM_LEAF_SIZE = 8;
+
+        /// En dessous, construction et mise à jour sont faites sur le thread appelant.
+        static constexpr std::size_t PARALLEL_THRESHOLD = std::size_t{1} << 14;
+
+        /// Profondeur maximale de l’arbre : les parcours utilisent une pile de taille fixe.
+        static constexpr std::size_t MAXIMUM_DEPTH = 64;
+
+        Bvh() noexcept = default;
+
+        Bvh( const Bvh& ) = default;
+        Bvh( Bvh&& ) noexcept = default;
+        Bvh& operator=( const Bvh& ) = default;
+        Bvh& operator=( Bvh&& ) noexcept = default;
+        ~Bvh() noexcept = default;
+
+        /**
+         * @brief Construit la hiérarchie sur les boites fournies, l’élément i ayant la boite bounds[i].
+         * @param bounds Les boites des éléments, dans le monde.
+         * @param threadCount Le nombre de threads, gl_engine::utility::AUTOMATIC_THREAD_COUNT pour tous les cœurs.
+         *
+         * @exceptsafe BASE. La hiérarchie est vide en cas d’exception.
+         */
+        void build( const std::vector<Bounds>& bounds, unsigned threadCount );
+
+        /**
+         * @overload
+         * @brief Construction sur le thread appelant seulement.
+         */
+        void build( const std::vector<Bounds>& bounds );
+
+        /**
+         * @brief Recalcule les boites des nœuds après un déplacement des éléments, sans changer l’arbre.
+         * @param bounds Les nouvelles boites de tous les éléments.
+         * @param threadCount Le nombre de threads, gl_engine::utility::AUTOMATIC_THREAD_COUNT pour tous les cœurs.
+         *
+         * @exceptsafe BASE.
+         *
+         * @note Reconstruit la hiérarchie si le nombre d’éléments a changé depuis build().
+         */
+        void refit( const std::vector<Bounds>& bounds, unsigned threadCount );
+
+        /**
+         * @overload
+         * @brief Mise à jour sur le thread appelant seulement.
+         */
+        void refit( const std::vector<Bounds>& bounds );
+
+        /**
+         * @overload
+         * @brief Ne recalcule que les sous-arbres contenant les éléments déplacés, et les nœuds au-dessus d’eux.
+         * @param bounds Les nouvelles boites de tous les éléments.
+         * @param moved Les éléments dont la boite a changé depuis le dernier build() ou refit().
+         * @param threadCount Le nombre de threads, gl_engine::utility::AUTOMATIC_THREAD_COUNT pour tous les cœurs.
+         *
+         * @pre Chaque indice de moved doit être inférieur à size().
+         *
+         * @note L’arbre est découpé en environ 256 sous-arbres : quelques objets déplacés dans une grande scène
+         * coûtent une petite fraction d’une mise à jour complète.
+         */
+        void refit( const std::vector<Bounds>& bounds, const std::vector<std::uint32_t>& moved, unsigned threadCount );
+
+        /**
+         * @brief Ajoute à visible les éléments dont la boite coupe le volume de vue.
+         * @param frustum Le volume de vue.
+         * @param visible Reçoit les indices, dans l’ordre des feuilles. N’est pas vidée.
+         *
+         * @exceptsafe FORT.
+         *
+         * @note Un nœud entièrement à l’intérieur d’un plan n’est plus testé contre lui, ni ses enfants :
+         * les éléments d’un sous-arbre entièrement visible sont ajoutés sans aucun test.
+         */
+        void cull( const Frustum& frustum, std::vector<std::uint32_t>& visible ) const;
+
+        /**
+         * @brief Retourne l’élément dont la boite est touchée en premier par le rayon.
+         * @return L’élément et la distance d’entrée, std::nullopt si aucune boite n’est touchée avant ray.maxDistance.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @note Les enfants sont visités du plus proche au plus lointain, un nœud plus lointain que le meilleur
+         * élément trouvé est sauté.
+         */
+        [[nodiscard]] std::optional<RayHit> raycast( const Ray& ray ) const noexcept;
+
+        /**
+         * @brief Ajoute à hits tous les éléments dont la boite est touchée par le rayon avant ray.maxDistance.
+         *
+         * @exceptsafe FORT.
+         *
+         * @note Les éléments sont dans l’ordre des feuilles, pas dans l’ordre des distances.
+         */
+        void query( const Ray& ray, std::vector<RayHit>& hits ) const;
+
+        /**
+         * @brief Ajoute à result les éléments dont la boite coupe box.
+         *
+         * @exceptsafe FORT.
+         */
+        void query( const Bounds& box, std::vector<std::uint32_t>& result ) const;
+
+        /**
+         * @brief Retourne le coût SAH de l’arbre : coût moyen des tests d’un rayon quelconque, en tests d’élément.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @note Calculé par build() et refit(), sans parcours supplémentaire.
+         */
+        [[nodiscard]] float cost() const noexcept {
+            return cost_;
+        }
+
+        /**
+         * @brief Retourne le nombre d’éléments.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] std::size_t size() const noexcept {
+            return items_.size();
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return items_.empty();
+        }
+
+        [[nodiscard]] const std::vector<BvhNode>& nodes() const noexcept {
+            return nodes_;
+        }
+
+        /// Indices des éléments dans l’ordre des feuilles.
+        [[nodiscard]] const std::vector<std::uint32_t>& items() const noexcept {
+            return items_;
+        }
+
+    private:
+        /// Sous-arbre mis à jour d’un bloc par refit() : nœuds [first, last[ et éléments [firstItem, lastItem[.
+        struct Subtree {
+            std::uint32_t first = 0;
+            std::uint32_t last = 0;
+            std::uint32_t firstItem = 0;
+            std::uint32_t lastItem = 0;
+        };
+
+        std::vector<BvhNode> nodes_{};
+        std::vector<std::uint32_t> items_{};
+        /// Boites des éléments dans l’ordre de items_ : les feuilles sont testées sans indirection.
+        std::vector<Bounds> boxes_{};
+
+        /// Position de chaque élément dans items_.
+        std::vector<std::uint32_t> slots_{};
+
+        std::vector<Subtree> subtrees_{};
+        /// Somme des surfaces pondérées de chaque sous-arbre lors de sa dernière mise à jour, pour cost().
+        std::vector<float> subtreeAreas_{};
+        /// Nœuds hors des sous-arbres, en profondeur d’abord.
+        std::vector<std::uint32_t> topNodes_{};
+
+        float cost_ = 0.0f;
+
+        /// Découpe l’arbre en sous-arbres indépendants pour refit(), indépendamment du nombre de threads.
+        void partitionSubtrees();
+
+        /// Met à jour les sous-arbres listés en parallèle, puis les nœuds du haut et le coût.
+        void refitSubtrees( const Bounds* bounds, const std::vector<std::uint32_t>& subtrees, unsigned threadCount );
+
+        /// Recalcule un sous-arbre en remontant, retourne la somme des surfaces pondérées de ses nœuds pour la SAH.
+        float refitSubtree( const Bounds* bounds, const Subtree& subtree ) noexcept;
+        float refitNode( std::uint32_t index ) noexcept;
+
+        /// Première feuille à gauche et dernière feuille à droite du sous-arbre de node.
+        [[nodiscard]] std::pair<std::uint32_t, std::uint32_t> itemRange( std::uint32_t node ) const noexcept;
+
+        void appendSubtree( std::uint32_t node, std::vector<std::uint32_t>& result ) const;
+    };
+}
+
+#endif // GLENGINE_BVH_HPP
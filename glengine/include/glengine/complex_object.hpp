@@ -18,11 +18,121 @@
 #ifndef GLENGINE_COMPLEX_OBJECT_HPP
 #define GLENGINE_COMPLEX_OBJECT_HPP
 
+#include <cstddef>
+#include <utility>
+#include <vector>
+
 #include <glengine/abstract_object.hpp>
+#include <glengine/material.hpp>
+#include <glengine/mesh.hpp>
+#include <glengine/mesh_simplifier.hpp>
 
 namespace gl_engine {
+    /**
+     * @brief Objet décrit par un fichier '.obj'.
+     *
+     * @version 1.3
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::ObjectFactory
+     * @see gl_engine::LodSelector
+     */
     class ComplexObject final : public AbstractObject {
+    public:
+        ComplexObject() noexcept = default;
+
+        /**
+         * @brief Construit l’objet à partir de son maillage, sans matériau.
+         * @param mesh Le maillage de l’objet.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        explicit ComplexObject( Mesh mesh ) noexcept
+        : mesh_(std::move(mesh)) {}
+
+        /**
+         * @brief Construit l’objet à partir de son maillage et des matériaux de ses plages.
+         * @param mesh Le maillage de l’objet.
+         * @param materials Un matériau par plage de mesh.subMeshes(), dans le même ordre.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @version 1.2
+         * @since 0.1
+         */
+        ComplexObject( Mesh mesh, std::vector<Material> materials ) noexcept
+        : mesh_(std::move(mesh)), materials_(std::move(materials)) {}
+
+        /**
+         * @brief Construit l’objet à partir de son maillage, de ses matériaux et de ses niveaux de détail.
+         * @param mesh Le maillage de l’objet, niveau 0.
+         * @param materials Un matériau par plage de mesh.subMeshes(), dans le même ordre.
+         * @param lods Les niveaux simplifiés, d’erreur croissante, avec les mêmes plages que mesh.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @version 1.3
+         * @since 0.1
+         *
+         * @see gl_engine::MeshSimplifier::buildLodChain
+         */
+        ComplexObject( Mesh mesh, std::vector<Material> materials, std::vector<LodLevel> lods ) noexcept
+        : mesh_(std::move(mesh)), materials_(std::move(materials)), lods_(std::move(lods)) {}
+
+        /**
+         * @brief Retourne le maillage de l’objet.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] const Mesh& mesh() const noexcept {
+            return mesh_;
+        }
+
+        /**
+         * @brief Retourne les matériaux, materials()[i] est celui de mesh().subMeshes()[i].
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @note Vide si l’objet a été chargé sans ses fichiers '.mtl'.
+         */
+        [[nodiscard]] const std::vector<Material>& materials() const noexcept {
+            return materials_;
+        }
+
+        /**
+         * @brief Retourne le nombre de niveaux de détail, le maillage d’origine compris.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] std::size_t levelCount() const noexcept {
+            return lods_.size() + 1;
+        }
+
+        /**
+         * @brief Retourne le maillage du niveau de détail demandé, 0 étant le maillage d’origine.
+         *
+         * @pre level doit être inférieur à levelCount().
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] const Mesh& mesh( const std::size_t level ) const noexcept {
+            return level == 0 ? mesh_ : lods_[level - 1].mesh;
+        }
+
+        /**
+         * @brief Retourne l’écart du niveau de détail demandé au maillage d’origine, dans l’unité des positions.
+         *
+         * @pre level doit être inférieur à levelCount().
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] float lodError( const std::size_t level ) const noexcept {
+            return level == 0 ? 0.0f : lods_[level - 1].error;
+        }
 
+    private:
+        Mesh mesh_{};
+        std::vector<Material> materials_{};
+        std::vector<LodLevel> lods_{};
     };
 }
 
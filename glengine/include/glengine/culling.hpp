@@ -0,0 +1,251 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef GLENGINE_CULLING_HPP
+#define GLENGINE_CULLING_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <glengine/bounds.hpp>
+#include <glengine/parallel.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Les six plans d’un volume de vue, normales tournées vers l’intérieur.
+     *
+     * Un point p est du côté intérieur d’un plan si dot( plane.xyz, p ) + plane.w >= 0.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct Frustum {
+        /// Gauche, droite, bas, haut, proche, lointain.
+        std::array<glm::vec4, 6> planes{};
+
+        /**
+         * @brief Extrait les plans d’une matrice de projection, multipliée par la vue pour des plans dans le monde.
+         * @param viewProjection La matrice projection * vue, profondeur OpenGL [-1, 1].
+         * @return Les plans normalisés : dot( plane.xyz, p ) + plane.w est une distance.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @see [Gribb et Hartmann, Fast Extraction of Viewing Frustum Planes from the World-View-Projection Matrix](https://www.gamedevs.org/uploads/fast-extraction-viewing-frustum-planes-from-world-view-projection-matrix.pdf)
+         */
+        [[nodiscard]] static Frustum fromMatrix( const glm::mat4& viewProjection ) noexcept;
+
+        /**
+         * @brief Teste un volume englobant, version scalaire de gl_engine::FrustumCuller::cull.
+         * @return false si le volume est entièrement à l’extérieur d’un des plans.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @note Conservatif : un volume proche d’un coin du volume de vue peut être déclaré visible à tort.
+         */
+        [[nodiscard]] bool intersects( const BoundingVolume& volume ) const noexcept;
+    };
+
+    /**
+     * @brief Volumes englobants d’un ensemble d’objets rangés en SoA pour gl_engine::FrustumCuller.
+     *
+     * Chaque composante (centre et demi-côtés de la boite, rayon de la sphère) a son propre tableau :
+     * 4 ou 8 objets consécutifs sont lus en une instruction. Les tableaux sont complétés jusqu’à un multiple de
+     * LANE_COUNT par des volumes toujours éliminés, la boucle de test n’a donc pas de reste à traiter.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::FrustumCuller
+     */
+    class CullingSet final {
+    public:
+        /// Nombre d’objets testés ensemble au plus, les tableaux en sont un multiple.
+        static constexpr std::size_t LANE_COUNT = 8;
+
+        /**
+         * @brief Vide l’ensemble, la mémoire est conservée.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        void clear() noexcept;
+
+        /**
+         * @brief Change le nombre d’objets, les nouveaux objets ne sont jamais éliminés jusqu’à leur set().
+         * @param size Le nombre d’objets.
+         *
+         * @exceptsafe FORT.
+         */
+        void resize( std::size_t size );
+
+        /**
+         * @brief Ajoute un objet à la fin de l’ensemble.
+         * @param volume Ses volumes englobants dans le monde.
+         * @return L’indice de l’objet.
+         *
+         * @exceptsafe FORT.
+         */
+        std::uint32_t add( const BoundingVolume& volume );
+
+        /**
+         * @overload
+         * @brief Ajoute un objet sans volume, jamais éliminé.
+         */
+        std::uint32_t add();
+
+        /**
+         * @brief Remplace les volumes de l’objet index, après un déplacement par exemple.
+         *
+         * @pre index doit être inférieur à size().
+         * @exceptsafe NO-THROW.
+         */
+        void set( std::size_t index, const BoundingVolume& volume ) noexcept;
+
+        /**
+         * @overload
+         * @brief Retire les volumes de l’objet index : il n’est plus jamais éliminé.
+         */
+        void set( std::size_t index ) noexcept;
+
+        [[nodiscard]] std::size_t size() const noexcept {
+            return size_;
+        }
+
+        // Note développeur : Accès en lecture aux composantes pour les boucles SIMD, size() arrondi à LANE_COUNT éléments.
+
+        [[nodiscard]] const float* centerX() const noexcept {
+            return centerX_.data();
+        }
+
+        [[nodiscard]] const float* centerY() const noexcept {
+            return centerY_.data();
+        }
+
+        [[nodiscard]] const float* centerZ() const noexcept {
+            return centerZ_.data();
+        }
+
+        [[nodiscard]] const float* extentX() const noexcept {
+            return extentX_.data();
+        }
+
+        [[nodiscard]] const float* extentY() const noexcept {
+            return extentY_.data();
+        }
+
+        [[nodiscard]] const float* extentZ() const noexcept {
+            return extentZ_.data();
+        }
+
+        [[nodiscard]] const float* radius() const noexcept {
+            return radius_.data();
+        }
+
+    private:
+        std::vector<float> centerX_{};
+        std::vector<float> centerY_{};
+        std::vector<float> centerZ_{};
+        std::vector<float> extentX_{};
+        std::vector<float> extentY_{};
+        std::vector<float> extentZ_{};
+        std::vector<float> radius_{};
+
+        std::size_t size_ = 0;
+
+        void store( std::size_t index, const glm::vec3& center, const glm::vec3& extent, float radius ) noexcept;
+    };
+
+    /**
+     * @brief Compteurs d’une élimination hors champ.
+     *
+     * @version 1.1
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct CullStatistics {
+        std::size_t objectCount = 0;
+        std::size_t visibleCount = 0;
+        /// Durée du test, en millisecondes.
+        double milliseconds = 0.0;
+        /// Objets dans le volume de vue mais cachés par les occultants, voir gl_engine::OcclusionBuffer.
+        std::size_t occludedCount = 0;
+    };
+
+    /**
+     * @brief Élimination hors champ : teste les volumes d’un gl_engine::CullingSet contre les six plans d’un gl_engine::Frustum.
+     *
+     * Pour chaque plan, la distance du centre est comparée au plus petit des deux rayons : celui de la sphère et
+     * celui de la boite projetée sur la normale, |n.x| e.x + |n.y| e.y + |n.z| e.z. Un objet est éliminé s’il est
+     * entièrement derrière un plan pour l’un des deux volumes.
+     *
+     * Les objets sont testés 8 par 8 avec AVX si le moteur est compilé avec (GLENGINE_SIMD_AVX), 4 par 4 avec SSE2 sinon.
+     * Les indices visibles sont écrits sans branchement : chaque voie écrit son indice, le curseur n’avance que si
+     * elle est visible. Au-delà de PARALLEL_THRESHOLD objets, l’ensemble est découpé en tranches traitées en parallèle,
+     * chacune écrivant à sa place dans la liste, compactée ensuite : l’ordre des indices est celui de l’ensemble.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::Bvh::cull pour une scène : seuls les sous-arbres coupant le volume de vue sont parcourus.
+     */
+    class FrustumCuller final {
+    public:
+        // Note développeur : Aucun état, il est donc impossible de l’instancier.
+
+        FrustumCuller() noexcept = delete;
+        FrustumCuller( const FrustumCuller& ) noexcept = delete;
+        FrustumCuller( FrustumCuller&& ) noexcept = delete;
+        FrustumCuller& operator=( const FrustumCuller& ) noexcept = delete;
+        FrustumCuller& operator=( FrustumCuller&& ) noexcept = delete;
+        ~FrustumCuller() noexcept = delete;
+
+        /// En dessous, créer des threads coûte plus que le test : tout est traité sur le thread appelant.
+        static constexpr std::size_t PARALLEL_THRESHOLD = std::size_t{1} << 16;
+
+        /// Objets par tranche parallèle, un multiple de CullingSet::LANE_COUNT.
+        static constexpr std::size_t CHUNK_SIZE = std::size_t{1} << 14;
+
+        /**
+         * @brief Écrit dans visible les indices, croissants, des objets dont les volumes coupent le volume de vue.
+         * @param set Les volumes des objets.
+         * @param frustum Le volume de vue.
+         * @param visible Reçoit les indices visibles, sa mémoire est réutilisée d’un appel à l’autre.
+         * @param threadCount Le nombre de threads, gl_engine::utility::AUTOMATIC_THREAD_COUNT pour tous les cœurs.
+         * @return Les compteurs du test.
+         *
+         * @exceptsafe BASE. visible peut être modifiée.
+         */
+        static CullStatistics cull( const CullingSet& set, const Frustum& frustum, std::vector<std::uint32_t>& visible,
+                                    unsigned threadCount );
+
+        /**
+         * @overload
+         * @brief Test sur le thread appelant seulement.
+         */
+        static CullStatistics cull( const CullingSet& set, const Frustum& frustum, std::vector<std::uint32_t>& visible );
+    };
+}
+
+#endif // GLENGINE_CULLING_HPP
@@ -0,0 +1,365 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef GLENGINE_GL_STATE_HPP
+#define GLENGINE_GL_STATE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <glengine/utility.hpp>
+
+namespace gl_engine::open_gl {
+    /**
+     * @brief Famille d’états OpenGL suivie par le cache d’états.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::open_gl::StateStatistics
+     */
+    enum class StateCategory : std::uint8_t {
+        /// glUseProgram.
+        PROGRAM,
+        /// glBindVertexArray.
+        VERTEX_ARRAY,
+        /// glBindBuffer.
+        BUFFER,
+        /// glActiveTexture et glBindTexture.
+        TEXTURE,
+        /// glBindSampler.
+        SAMPLER,
+        /// glEnable et glDisable.
+        CAPABILITY,
+        /// glBlendFunc, glBlendFuncSeparate et glBlendEquation.
+        BLEND,
+        /// glDepthFunc et glDepthMask.
+        DEPTH,
+        /// glCullFace et glFrontFace.
+        CULL
+    };
+
+    /// Nombre de valeurs de gl_engine::open_gl::StateCategory.
+    constexpr std::size_t STATE_CATEGORY_COUNT = 9;
+
+    /**
+     * @brief Compteurs d’une famille d’états : appels transmis au pilote et appels évités.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct StateCounter {
+        std::size_t issued = 0;
+        std::size_t skipped = 0;
+    };
+
+    /**
+     * @brief Statistiques du cache d’états d’un contexte OpenGL.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::open_gl::stateStatistics
+     */
+    struct StateStatistics {
+        std::array<StateCounter, STATE_CATEGORY_COUNT> categories{};
+
+        [[nodiscard]] const StateCounter& operator[]( const StateCategory category ) const noexcept {
+            return categories[static_cast<std::size_t>(category)];
+        }
+
+        [[nodiscard]] StateCounter& operator[]( const StateCategory category ) noexcept {
+            return categories[static_cast<std::size_t>(category)];
+        }
+
+        /// Nombre total d’appels transmis au pilote.
+        [[nodiscard]] std::size_t issued() const noexcept {
+            std::size_t total = 0;
+            for ( const auto& counter : categories ) {
+                total += counter.issued;
+            }
+
+            return total;
+        }
+
+        /// Nombre total d’appels redondants évités.
+        [[nodiscard]] std::size_t skipped() const noexcept {
+            std::size_t total = 0;
+            for ( const auto& counter : categories ) {
+                total += counter.skipped;
+            }
+
+            return total;
+        }
+    };
+
+    // region State
+    // Note développeur : Chaque contexte OpenGL a sa propre copie des états, retrouvée par glfwGetCurrentContext.
+    // Un appel dont la valeur est déjà celle du contexte n’est pas transmis au pilote. Tant qu’un état n’a pas été
+    // fixé par ces fonctions, sa valeur est inconnue et le premier appel est toujours transmis.
+
+    /**
+     * @brief Lie un objet tableau de sommets, remplace glBindVertexArray.
+     * @param id Identifiant du tableau de sommets, 0 pour n’en lier aucun.
+     *
+     * @exceptsafe NO-THROW.
+     *
+     * @note Le tampon d’indices lié appartient au tableau de sommets : il redevient inconnu à chaque changement.
+     */
+    void bindVertexArray( Id id ) noexcept;
+
+    /**
+     * @brief Lie un tampon à une cible, remplace glBindBuffer.
+     * @param target Cible de liaison, GL_ARRAY_BUFFER par exemple.
+     * @param id Identifiant du tampon, 0 pour n’en lier aucun.
+     *
+     * @exceptsafe NO-THROW.
+     */
+    void bindBuffer( GLenum target, Id id ) noexcept;
+
+    /**
+     * @brief Lie un tampon à un point de liaison indexé, remplace glBindBufferBase.
+     * @param target Cible indexée, GL_UNIFORM_BUFFER par exemple.
+     * @param index Numéro du point de liaison.
+     * @param id Identifiant du tampon, 0 pour n’en lier aucun.
+     *
+     * @exceptsafe NO-THROW.
+     *
+     * @note glBindBufferBase lie aussi le tampon à la cible générique : la copie de bindBuffer est mise à jour.
+     */
+    void bindBufferBase( GLenum target, GLuint index, Id id ) noexcept;
+
+    /**
+     * @brief Sélectionne l’unité de texture active, remplace glActiveTexture.
+     * @param unit Numéro de l’unité, sans GL_TEXTURE0.
+     *
+     * @exceptsafe NO-THROW.
+     */
+    void activeTexture( unsigned unit ) noexcept;
+
+    /**
+     * @brief Lie une texture à une unité, remplace glActiveTexture suivi de glBindTexture.
+     * @param unit Numéro de l’unité, sans GL_TEXTURE0.
+     * @param target Cible de liaison, GL_TEXTURE_2D par exemple.
+     * @param id Identifiant de la texture, 0 pour n’en lier aucune.
+     *
+     * @exceptsafe NO-THROW.
+     *
+     * @note L’unité active n’est changée que si la texture doit l’être.
+     */
+    void bindTexture( unsigned unit, GLenum target, Id id ) noexcept;
+
+    /**
+     * @brief Lie un objet d’échantillonnage à une unité de texture, remplace glBindSampler.
+     * @param unit Numéro de l’unité, sans GL_TEXTURE0.
+     * @param id Identifiant de l’échantillonneur, 0 pour utiliser les paramètres de la texture.
+     *
+     * @exceptsafe NO-THROW.
+     */
+    void bindSampler( unsigned unit, Id id ) noexcept;
+
+    /**
+     * @brief Active une fonctionnalité, remplace glEnable.
+     * @param capability La fonctionnalité, GL_DEPTH_TEST par exemple.
+     *
+     * @exceptsafe NO-THROW.
+     */
+    void enable( GLenum capability ) noexcept;
+
+    /**
+     * @brief Désactive une fonctionnalité, remplace glDisable.
+     * @param capability La fonctionnalité, GL_BLEND par exemple.
+     *
+     * @exceptsafe NO-THROW.
+     */
+    void disable( GLenum capability ) noexcept;
+
+    /**
+     * @overload
+     * @brief Active ou désactive une fonctionnalité.
+     * @param capability La fonctionnalité.
+     * @param enabled true pour l’activer.
+     */
+    void enable( GLenum capability, bool enabled ) noexcept;
+
+    /**
+     * @brief Choisit les facteurs de mélange, remplace glBlendFunc.
+     * @param source Facteur de la couleur produite.
+     * @param destination Facteur de la couleur présente.
+     *
+     * @exceptsafe NO-THROW.
+     */
+    void blendFunc( GLenum source, GLenum destination ) noexcept;
+
+    /**
+     * @brief Choisit les facteurs de mélange des couleurs et de l’opacité, remplace glBlendFuncSeparate.
+     *
+     * @exceptsafe NO-THROW.
+     */
+    void blendFuncSeparate( GLenum sourceColor, GLenum destinationColor, GLenum sourceAlpha, GLenum destinationAlpha ) noexcept;
+
+    /**
+     * @brief Choisit l’opération de mélange, remplace glBlendEquation.
+     * @param mode L’opération, GL_FUNC_ADD par exemple.
+     *
+     * @exceptsafe NO-THROW.
+     */
+    void blendEquation( GLenum mode ) noexcept;
+
+    /**
+     * @brief Choisit le test de profondeur, remplace glDepthFunc.
+     * @param function La comparaison, GL_LESS par exemple.
+     *
+     * @exceptsafe NO-THROW.
+     */
+    void depthFunc( GLenum function ) noexcept;
+
+    /**
+     * @brief Autorise ou non l’écriture de la profondeur, remplace glDepthMask.
+     * @param write true pour écrire la profondeur.
+     *
+     * @exceptsafe NO-THROW.
+     */
+    void depthMask( bool write ) noexcept;
+
+    /**
+     * @brief Choisit les faces éliminées, remplace glCullFace.
+     * @param mode GL_BACK, GL_FRONT ou GL_FRONT_AND_BACK.
+     *
+     * @exceptsafe NO-THROW.
+     */
+    void cullFace( GLenum mode ) noexcept;
+
+    /**
+     * @brief Choisit l’orientation des faces avant, remplace glFrontFace.
+     * @param mode GL_CCW ou GL_CW.
+     *
+     * @exceptsafe NO-THROW.
+     */
+    void frontFace( GLenum mode ) noexcept;
+
+    /**
+     * @brief Supprime un tableau de sommets, remplace glDeleteVertexArrays.
+     * @param id Identifiant du tableau de sommets.
+     *
+     * @exceptsafe NO-THROW.
+     *
+     * @note S’il était lié, la liaison revient à 0, comme le fait OpenGL. Un identifiant réutilisé n’est donc
+     * jamais considéré comme déjà lié.
+     */
+    void deleteVertexArray( Id id ) noexcept;
+
+    /**
+     * @brief Supprime un tampon, remplace glDeleteBuffers.
+     * @param id Identifiant du tampon.
+     *
+     * @exceptsafe NO-THROW.
+     *
+     * @note Les cibles auxquelles il était lié reviennent à 0.
+     */
+    void deleteBuffer( Id id ) noexcept;
+
+    /**
+     * @brief Supprime une texture, remplace glDeleteTextures.
+     * @param id Identifiant de la texture.
+     *
+     * @exceptsafe NO-THROW.
+     *
+     * @note Les unités auxquelles elle était liée reviennent à 0.
+     */
+    void deleteTexture( Id id ) noexcept;
+
+    /**
+     * @brief Supprime un objet d’échantillonnage, remplace glDeleteSamplers.
+     * @param id Identifiant de l’échantillonneur.
+     *
+     * @exceptsafe NO-THROW.
+     */
+    void deleteSampler( Id id ) noexcept;
+
+    /**
+     * @brief Oublie tous les états connus du contexte courant.
+     *
+     * @exceptsafe NO-THROW.
+     *
+     * @note À appeler après du code modifiant les états OpenGL sans passer par ces fonctions (Dear ImGui par
+     * exemple) : chaque état sera de nouveau transmis au pilote une fois.
+     */
+    void invalidateState() noexcept;
+
+    /**
+     * @brief Libère la copie des états d’un contexte, à appeler avant de le détruire.
+     * @param context Le contexte détruit.
+     *
+     * @exceptsafe NO-THROW.
+     *
+     * @note Un contexte créé plus tard à la même adresse repart ainsi d’états inconnus.
+     */
+    void releaseState( GLFWwindow* context ) noexcept;
+
+    /**
+     * @brief Retourne l’identifiant du contexte courant.
+     * @return Un identifiant jamais réutilisé, même par un contexte créé plus tard à la même adresse,
+     * ou 0 si aucun contexte n’est courant.
+     *
+     * @exceptsafe NO-THROW.
+     *
+     * @note À préférer à l’adresse du contexte pour associer des objets OpenGL à leur contexte.
+     */
+    [[nodiscard]] std::uint64_t currentContext() noexcept;
+
+    /**
+     * @brief Indique si un contexte n’a pas encore été libéré par gl_engine::open_gl::releaseState.
+     * @param context L’identifiant retourné par gl_engine::open_gl::currentContext.
+     *
+     * @exceptsafe NO-THROW.
+     */
+    [[nodiscard]] bool isContextAlive( std::uint64_t context ) noexcept;
+
+    /**
+     * @brief Retourne le nombre de programmes détruits par gl_engine::open_gl::deleteProgram, tous contextes confondus.
+     * @return Un compteur croissant.
+     *
+     * @exceptsafe NO-THROW.
+     *
+     * @note OpenGL réutilise les identifiants libérés : une donnée associée à l’identifiant d’un programme
+     * (emplacements d’uniformes, blocs, ...) n’est plus fiable dès que ce compteur a changé.
+     */
+    [[nodiscard]] std::uint64_t programDeletions() noexcept;
+
+    /**
+     * @brief Retourne les compteurs d’appels transmis et évités du contexte courant.
+     *
+     * @exceptsafe NO-THROW.
+     */
+    [[nodiscard]] StateStatistics stateStatistics() noexcept;
+
+    /**
+     * @brief Remet à zéro les compteurs du contexte courant.
+     *
+     * @exceptsafe NO-THROW.
+     */
+    void resetStateStatistics() noexcept;
+    // endregion
+}
+
+#endif // GLENGINE_GL_STATE_HPP
@@ -0,0 +1,132 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLENGINE_HASH_HPP
+#define GLENGINE_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace gl_engine::utility {
+    /**
+     * @brief Empreinte FNV-1a 64 bits d’une chaine, utilisable à la compilation.
+     * @param text La chaine à hacher.
+     * @return L’empreinte de la chaine.
+     *
+     * @exceptsafe NO-THROW.
+     *
+     * @version 1.0
+     * @since 0.1
+     *
+     * @see [FNV](http://www.isthe.com/chongo/tech/comp/fnv/)
+     * @note Adaptée aux chaines courtes (noms, clés), trop lente pour de gros volumes de données.
+     */
+    constexpr std::uint64_t fnv1a( const std::string_view text ) noexcept {
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+
+        for ( const auto letter : text ) {
+            hash ^= static_cast<std::uint8_t>(letter);
+            hash *= 0x100000001b3ull;
+        }
+
+        return hash;
+    }
+
+    /**
+     * @brief Mélange final des bits d’une empreinte 64 bits (fmix64 de MurmurHash3).
+     *
+     * @exceptsafe NO-THROW.
+     */
+    constexpr std::uint64_t mix( std::uint64_t hash ) noexcept {
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdull;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ull;
+        hash ^= hash >> 33;
+
+        return hash;
+    }
+
+    /**
+     * @brief Combine une valeur à une empreinte existante.
+     *
+     * @exceptsafe NO-THROW.
+     */
+    constexpr std::uint64_t combine( const std::uint64_t hash, const std::uint64_t value ) noexcept {
+        return mix( hash ^ ( value + 0x9e3779b97f4a7c15ull + ( hash << 6 ) + ( hash >> 2 ) ) );
+    }
+
+    /**
+     * @brief Empreinte 64 bits d’un bloc mémoire, lu par mots de 8 octets.
+     * @param data Le début du bloc.
+     * @param size La taille du bloc en octets.
+     * @return L’empreinte du bloc.
+     *
+     * @exceptsafe NO-THROW.
+     *
+     * @version 1.0
+     * @since 0.1
+     *
+     * @note Plusieurs Go/s, destinée à détecter une modification de contenu, pas à un usage cryptographique.
+     * @note L’empreinte dépend du boutisme de la machine.
+     */
+    inline std::uint64_t hashBytes( const void* const data, const std::size_t size ) noexcept {
+        constexpr std::uint64_t MULTIPLIER = 0x9fb21c651e98df25ull;
+
+        const auto* bytes = static_cast<const unsigned char*>(data);
+
+        // Quatre accumulateurs indépendants pour ne pas être limité par la latence de la multiplication.
+        std::uint64_t lanes[4] = {0x243f6a8885a308d3ull, 0x13198a2e03707344ull, 0xa4093822299f31d0ull, 0x082efa98ec4e6c89ull};
+
+        auto remaining = size;
+        while ( remaining >= 32 ) {
+            for ( auto& lane : lanes ) {
+                std::uint64_t word = 0;
+                std::memcpy( &word, bytes, sizeof( word ) );
+                bytes += sizeof( word );
+
+                lane = ( lane ^ word ) * MULTIPLIER;
+                lane ^= lane >> 29;
+            }
+
+            remaining -= 32;
+        }
+
+        std::uint64_t hash = size;
+        for ( const auto lane : lanes ) {
+            hash = combine( hash, lane );
+        }
+
+        while ( remaining >= 8 ) {
+            std::uint64_t word = 0;
+            std::memcpy( &word, bytes, sizeof( word ) );
+            bytes += sizeof( word );
+            remaining -= 8;
+
+            hash = combine( hash, word );
+        }
+
+        std::uint64_t tail = 0;
+        std::memcpy( &tail, bytes, remaining );
+
+        return combine( hash, tail );
+    }
+}
+
+#endif // GLENGINE_HASH_HPP
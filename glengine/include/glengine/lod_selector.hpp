@@ -0,0 +1,121 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLENGINE_LOD_SELECTOR_HPP
+#define GLENGINE_LOD_SELECTOR_HPP
+
+#include <cstddef>
+
+#include <glm/glm.hpp>
+
+#include <glengine/complex_object.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Choisit le niveau de détail d’une instance d’objet d’après sa taille à l’écran.
+     *
+     * L’écart d’un niveau au maillage d’origine est projeté en pixels : le niveau retenu est le plus grossier
+     * dont l’écart projeté reste sous le seuil. Pour ne pas alterner entre deux niveaux d’une image à l’autre
+     * quand la distance oscille autour d’une limite, un niveau plus grossier n’est adopté que sous
+     * seuil × (1 - hystérésis) et le niveau courant n’est quitté pour un plus fin qu’au-delà de seuil × (1 + hystérésis).
+     *
+     * Un sélecteur conserve le niveau courant : il en faut un par instance dessinée.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::MeshSimplifier::buildLodChain
+     * @see gl_engine::ComplexObject::mesh
+     */
+    class LodSelector final {
+    public:
+        /**
+         * @brief Construit un sélecteur tolérant un pixel d’écart, avec 25 % d’hystérésis.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        LodSelector() noexcept = default;
+
+        /**
+         * @brief Construit un sélecteur avec le seuil et l’hystérésis fournis.
+         * @param pixelError L’écart toléré à l’écran, en pixels.
+         * @param hysteresis La marge relative autour du seuil, entre 0 et 1.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        LodSelector( float pixelError, float hysteresis ) noexcept;
+
+        /**
+         * @brief Retourne le facteur convertissant un écart à une distance donnée en pixels.
+         * @param viewportHeight La hauteur de la zone d’affichage en pixels.
+         * @param verticalFieldOfView L’angle de vue vertical de la projection perspective, en radians.
+         * @return viewportHeight / ( 2 tan( verticalFieldOfView / 2 ) ) : écart en pixels = écart × facteur / distance.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @note À recalculer seulement quand la fenêtre ou la projection change.
+         */
+        [[nodiscard]] static float projectionScale( float viewportHeight, float verticalFieldOfView ) noexcept;
+
+        /**
+         * @brief Retourne la distance entre l’œil et la boite englobante transformée, nulle si l’œil est dedans.
+         * @param bounds La boite englobante de l’objet, dans son repère.
+         * @param model La matrice de l’objet, sans cisaillement.
+         * @param eye La position de l’œil dans le monde.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @note La boite est approchée par sa sphère englobante, la distance est donc sous-estimée : le choix reste prudent.
+         */
+        [[nodiscard]] static float distance( const Bounds& bounds, const glm::mat4& model, const glm::vec3& eye ) noexcept;
+
+        /**
+         * @brief Met à jour et retourne le niveau de détail de l’instance.
+         * @param object L’objet dessiné.
+         * @param distance La distance entre l’œil et l’objet, voir distance().
+         * @param projectionScale Le facteur de projection, voir projectionScale().
+         * @return Un niveau inférieur à object.levelCount().
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        std::size_t select( const ComplexObject& object, float distance, float projectionScale ) noexcept;
+
+        /**
+         * @brief Retourne le dernier niveau choisi.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] std::size_t level() const noexcept {
+            return level_;
+        }
+
+    private:
+        float pixelError_ = 1.0f;
+        float hysteresis_ = 0.25f;
+
+        std::size_t level_ = 0;
+    };
+}
+
+#endif // GLENGINE_LOD_SELECTOR_HPP
@@ -0,0 +1,127 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef GLENGINE_MATERIAL_HPP
+#define GLENGINE_MATERIAL_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <glm/glm.hpp>
+
+#include <glengine/texture.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Textures d’un matériau, l’indice de chaque valeur est aussi l’unité de texture utilisée au rendu.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    enum class TextureSlot : std::uint8_t {
+        /// 'map_Ka'
+        AMBIENT,
+        /// 'map_Kd'
+        DIFFUSE,
+        /// 'map_Ks'
+        SPECULAR,
+        /// 'map_Bump', 'bump' ou 'norm'
+        NORMAL,
+        /// 'map_d'
+        OPACITY
+    };
+
+    /**
+     * @brief Nombre de valeurs de gl_engine::TextureSlot.
+     */
+    inline constexpr std::size_t TEXTURE_SLOT_COUNT = 5;
+
+    /**
+     * @brief Paramètres d’éclairage d’un matériau, valeurs par défaut de la spécification '.mtl'.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct MaterialParameters {
+        /// 'Ka'
+        glm::vec3 ambient{0.2f};
+        /// 'Kd'
+        glm::vec3 diffuse{0.8f};
+        /// 'Ks'
+        glm::vec3 specular{1.0f};
+        /// 'Ke'
+        glm::vec3 emissive{0.0f};
+        /// 'Ns'
+        float shininess = 0.0f;
+        /// 'd', ou 1 - 'Tr'
+        float opacity = 1.0f;
+        /// 'illum'
+        std::uint32_t illumination = 2;
+    };
+
+    /**
+     * @brief Matériau tel qu’il est décrit dans un fichier '.mtl', les textures sont des chemins relatifs au fichier.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::MtlParser
+     */
+    struct MaterialData {
+        std::string name{};
+        MaterialParameters parameters{};
+
+        /// Chemins des textures, vides si absentes.
+        std::array<std::string, TEXTURE_SLOT_COUNT> textures{};
+    };
+
+    /**
+     * @brief Matériau prêt au rendu, ses textures sont partagées avec tous les matériaux qui les utilisent.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::TextureCache
+     * @see gl_engine::ComplexObject
+     */
+    struct Material {
+        std::string name{};
+        MaterialParameters parameters{};
+
+        /// Textures, nullptr si absentes ou illisibles.
+        std::array<std::shared_ptr<Texture>, TEXTURE_SLOT_COUNT> textures{};
+
+        /**
+         * @brief Retourne la texture de l’emplacement slot, nullptr si absente.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] const std::shared_ptr<Texture>& texture( const TextureSlot slot ) const noexcept {
+            return textures[static_cast<std::size_t>(slot)];
+        }
+    };
+}
+
+#endif // GLENGINE_MATERIAL_HPP
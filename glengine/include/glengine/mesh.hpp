@@ -0,0 +1,225 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLENGINE_MESH_HPP
+#define GLENGINE_MESH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <glengine/bounds.hpp>
+#include <glengine/utility.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Sommet entrelacé tel qu’il est envoyé à la carte graphique.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::Mesh
+     */
+    struct Vertex {
+        glm::vec3 position{};
+        glm::vec3 normal{};
+        glm::vec2 texCoord{};
+    };
+
+    // Note développeur : La disposition est écrite telle quelle dans le cache '.glmesh'.
+    static_assert( sizeof( Vertex ) == 32, "gl_engine::Vertex doit être compact, il est écrit tel quel dans le cache." );
+
+    /**
+     * @brief Plage d’indices dessinée avec le même matériau.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct SubMesh {
+        /// Nom du matériau, vide si aucun matériau n’est utilisé.
+        std::string material{};
+        std::uint32_t firstIndex = 0;
+        std::uint32_t indexCount = 0;
+    };
+
+    /**
+     * @brief Maillage indexé prêt à être envoyé à la carte graphique.
+     *
+     * Les sommets et les indices sont soit possédés par le maillage, soit lus directement
+     * dans la projection mémoire d’un cache '.glmesh', sans aucune copie.
+     * Les indices sont stockés sur 16 ou 32 bits, voir indexSize().
+     *
+     * @version 1.2
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::MeshBuilder
+     * @see gl_engine::MeshCache
+     * @see gl_engine::MeshBuffer
+     */
+    class Mesh final {
+    public:
+        /**
+         * @brief Nombre maximal de sommets adressables par des indices sur 16 bits.
+         */
+        static constexpr std::size_t MAXIMUM_SHORT_VERTEX_COUNT = 65536;
+
+        Mesh() noexcept = default;
+
+        /**
+         * @brief Construit un maillage possédant ses données, la boite englobante est calculée.
+         * @param vertices Les sommets.
+         * @param indices Les indices, trois par triangle.
+         * @param subMeshes Les plages de matériaux.
+         *
+         * @throws std::bad_alloc Si les indices sur 16 bits ne peuvent pas être alloués.
+         * @exceptsafe FORT.
+         *
+         * @version 1.1
+         * @since 0.1
+         *
+         * @note Les indices sont convertis sur 16 bits si le maillage a au plus 65 536 sommets.
+         */
+        Mesh( std::vector<Vertex> vertices, std::vector<std::uint32_t> indices, std::vector<SubMesh> subMeshes );
+
+        /**
+         * @overload
+         * @brief Surcharge pour des indices sur 16 bits, lorsque le maillage a au plus 65 536 sommets.
+         */
+        Mesh( std::vector<Vertex> vertices, std::vector<std::uint16_t> indices, std::vector<SubMesh> subMeshes ) noexcept;
+
+        // Note développeur : Un maillage peut occuper plusieurs Mo, les copies doivent être explicites.
+        Mesh( const Mesh& ) noexcept = delete;
+        Mesh( Mesh&& ) noexcept = default;
+        Mesh& operator=( const Mesh& ) noexcept = delete;
+        Mesh& operator=( Mesh&& ) noexcept = default;
+        ~Mesh() noexcept = default;
+
+        /**
+         * @brief Retourne un pointeur vers le premier sommet.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] const Vertex* vertices() const noexcept {
+            return vertices_;
+        }
+
+        [[nodiscard]] std::size_t vertexCount() const noexcept {
+            return vertexCount_;
+        }
+
+        /**
+         * @brief Retourne un pointeur vers le premier indice, de taille indexSize().
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] const void* indices() const noexcept {
+            return indices_;
+        }
+
+        [[nodiscard]] std::size_t indexCount() const noexcept {
+            return indexCount_;
+        }
+
+        /**
+         * @brief Retourne la taille d’un indice en octets.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] std::size_t indexSize() const noexcept {
+            return indexSize_;
+        }
+
+        /**
+         * @brief Retourne l’indice numéro i, quelle que soit sa taille.
+         *
+         * @pre i doit être inférieur à indexCount().
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] std::uint32_t index( const std::size_t i ) const noexcept {
+            return indexSize_ == sizeof( std::uint16_t ) ? static_cast<const std::uint16_t*>(indices_)[i]
+                                                          : static_cast<const std::uint32_t*>(indices_)[i];
+        }
+
+        [[nodiscard]] const Bounds& bounds() const noexcept {
+            return bounds_;
+        }
+
+        [[nodiscard]] const std::vector<SubMesh>& subMeshes() const noexcept {
+            return subMeshes_;
+        }
+
+        /**
+         * @brief Retourne les fichiers '.mtl' déclarés par la source ('mtllib'), relatifs à celle-ci.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] const std::vector<std::string>& materialLibraries() const noexcept {
+            return materialLibraries_;
+        }
+
+        /**
+         * @brief Remplace les fichiers '.mtl' associés au maillage.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        void setMaterialLibraries( std::vector<std::string> libraries ) noexcept {
+            materialLibraries_ = std::move( libraries );
+        }
+
+        /**
+         * @brief Indique si les données sont lues dans un cache projeté en mémoire.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] bool isMapped() const noexcept {
+            return file_ != nullptr;
+        }
+
+        friend class MeshCache;
+
+    private:
+        std::vector<Vertex> ownedVertices_{};
+        std::vector<std::uint32_t> ownedIndices_{};
+        std::vector<std::uint16_t> ownedShortIndices_{};
+
+        /// Projection du cache, partagée par les niveaux de détail lus dans le même fichier.
+        std::shared_ptr<const MappedFile> file_{};
+
+        const Vertex* vertices_ = nullptr;
+        std::size_t vertexCount_ = 0;
+
+        const void* indices_ = nullptr;
+        std::size_t indexCount_ = 0;
+        std::size_t indexSize_ = sizeof( std::uint32_t );
+
+        Bounds bounds_{};
+
+        std::vector<SubMesh> subMeshes_{};
+        std::vector<std::string> materialLibraries_{};
+    };
+}
+
+#endif // GLENGINE_MESH_HPP
@@ -0,0 +1,186 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLENGINE_MESH_BUFFER_HPP
+#define GLENGINE_MESH_BUFFER_HPP
+
+#include <glad/glad.h>
+
+#include <glengine/mesh.hpp>
+#include <glengine/utility.hpp>
+#include <glengine/vertex_format.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Copie d’un gl_engine::Mesh dans la mémoire de la carte graphique (VAO, VBO et EBO).
+     *
+     * Les attributs sont liés aux emplacements POSITION_LOCATION, NORMAL_LOCATION et TEXCOORD_LOCATION :
+     * @code
+     * layout (location = 0) in vec3 position;
+     * layout (location = 1) in vec3 normal;
+     * layout (location = 2) in vec2 texCoord;
+     * @endcode
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::Mesh
+     */
+    class MeshBuffer final {
+    public:
+        static constexpr GLuint POSITION_LOCATION = 0;
+        static constexpr GLuint NORMAL_LOCATION = 1;
+        static constexpr GLuint TEXCOORD_LOCATION = 2;
+
+        MeshBuffer() noexcept = delete;
+
+        /**
+         * @brief Crée les buffers et y copie les sommets et les indices du maillage.
+         * @param mesh Le maillage à copier, il peut être détruit après la construction.
+         *
+         * @pre Un contexte OpenGL doit être courant sur le thread appelant.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note Les pointeurs du maillage sont passés directement à glBufferData,
+         * y compris lorsqu’ils pointent dans un cache projeté en mémoire.
+         */
+        explicit MeshBuffer( const Mesh& mesh );
+
+        /**
+         * @overload
+         * @brief Surcharge convertissant les sommets dans le format fourni avant de les envoyer.
+         * @param mesh Le maillage à copier, il peut être détruit après la construction.
+         * @param format Le format des sommets dans la mémoire de la carte graphique.
+         *
+         * @note Le vertex shader doit décoder les attributs avec le code de gl_engine::VertexFormat::glslDecoder.
+         */
+        MeshBuffer( const Mesh& mesh, const VertexFormat& format );
+
+        MeshBuffer( const MeshBuffer& ) noexcept = delete;
+        MeshBuffer( MeshBuffer&& other ) noexcept;
+        MeshBuffer& operator=( const MeshBuffer& ) noexcept = delete;
+        MeshBuffer& operator=( MeshBuffer&& other ) noexcept;
+
+        /**
+         * @brief Supprime les buffers.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        ~MeshBuffer() noexcept;
+
+        /**
+         * @brief Lie le VAO du maillage.
+         */
+        void bind() const;
+
+        /**
+         * @brief Dessine tous les triangles du maillage.
+         *
+         * @pre Un programme doit être utilisé.
+         */
+        void draw() const;
+
+        /**
+         * @brief Dessine les triangles d’une plage de matériau.
+         * @param subMesh Une plage du maillage ayant servi à construire le buffer.
+         *
+         * @pre Un programme doit être utilisé.
+         */
+        void draw( const SubMesh& subMesh ) const;
+
+        /**
+         * @brief Envoie au programme les uniformes de décodage des positions quantifiées du maillage.
+         * @param program Le programme dessinant le maillage, son vertex shader doit contenir format().glslDecoder().
+         *
+         * @pre program doit être le programme utilisé.
+         *
+         * @note Ne fait rien si les positions ne sont pas quantifiées ou si le programme ne déclare pas ces uniformes.
+         *
+         * @see gl_engine::VertexFormat::POSITION_OFFSET_UNIFORM
+         * @see gl_engine::VertexFormat::POSITION_SCALE_UNIFORM
+         */
+        void setDecoderUniforms( Id program ) const;
+
+        /**
+         * @brief Retourne le format des sommets dans la mémoire de la carte graphique.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] const VertexFormat& format() const noexcept {
+            return format_;
+        }
+
+        /**
+         * @brief Retourne la boite englobante du maillage, nécessaire au décodage des positions quantifiées.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] const Bounds& bounds() const noexcept {
+            return bounds_;
+        }
+
+        [[nodiscard]] GLsizei indexCount() const noexcept {
+            return indexCount_;
+        }
+
+        /**
+         * @brief Retourne le VAO du maillage, pour gl_engine::DrawItem.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] Id vertexArray() const noexcept {
+            return vertexArray_;
+        }
+
+        /**
+         * @brief Retourne la taille d’un indice en octets.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] GLsizei indexSize() const noexcept {
+            return indexSize_;
+        }
+
+        /**
+         * @brief Retourne le type des indices, GL_UNSIGNED_SHORT ou GL_UNSIGNED_INT.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] GLenum indexType() const noexcept {
+            return indexType_;
+        }
+
+    private:
+        Id vertexArray_ = 0;
+        Id vertexBuffer_ = 0;
+        Id indexBuffer_ = 0;
+
+        GLsizei indexCount_ = 0;
+        GLenum indexType_ = GL_UNSIGNED_INT;
+        GLsizei indexSize_ = sizeof( GLuint );
+
+        VertexFormat format_{};
+        Bounds bounds_{};
+
+        void release() noexcept;
+    };
+}
+
+#endif // GLENGINE_MESH_BUFFER_HPP
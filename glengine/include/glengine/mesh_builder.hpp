@@ -0,0 +1,117 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLENGINE_MESH_BUILDER_HPP
+#define GLENGINE_MESH_BUILDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <glengine/mesh.hpp>
+#include <glengine/obj_data.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Statistiques de la soudure des sommets d’un maillage.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::MeshBuilder
+     */
+    struct WeldStatistics {
+        /// Nombre de sommets avant la soudure, un par coin de face.
+        std::size_t cornerCount = 0;
+        /// Nombre de sommets uniques après la soudure.
+        std::size_t vertexCount = 0;
+        /// Taille d’un indice en octets, 2 ou 4.
+        std::size_t indexSize = 0;
+
+        /**
+         * @brief Retourne la taille en octets des sommets et des indices sans soudure (un sommet par coin, indices 32 bits).
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] std::size_t expandedBytes() const noexcept {
+            return cornerCount * ( sizeof( Vertex ) + sizeof( std::uint32_t ) );
+        }
+
+        /**
+         * @brief Retourne la taille en octets des sommets et des indices après la soudure.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] std::size_t weldedBytes() const noexcept {
+            return vertexCount * sizeof( Vertex ) + cornerCount * indexSize;
+        }
+    };
+
+    /**
+     * @brief Construit un gl_engine::Mesh indexé à partir des données brutes d’un fichier '.obj'.
+     *
+     * Un fichier '.obj' indexe séparément positions, coordonnées de texture et normales, alors que la carte
+     * graphique n’accepte qu’un indice par sommet. Chaque triplet (v, vt, vn) distinct devient un sommet :
+     * les triplets sont dédoublonnés par une table de hachage à adressage ouvert (sondage linéaire),
+     * dont les entrées de 16 octets contiennent la clé et la valeur pour rester dans la même ligne de cache.
+     *
+     * @version 1.2
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::ObjData
+     * @see gl_engine::Mesh
+     */
+    class MeshBuilder final {
+    public:
+        // Note développeur : Classe purement statique, comme gl_engine::ObjectFactory.
+
+        MeshBuilder() noexcept = delete;
+        MeshBuilder( const MeshBuilder& ) noexcept = delete;
+        MeshBuilder( MeshBuilder&& ) noexcept = delete;
+        MeshBuilder& operator=( const MeshBuilder& ) noexcept = delete;
+        MeshBuilder& operator=( MeshBuilder&& ) noexcept = delete;
+        ~MeshBuilder() noexcept = delete;
+
+        /**
+         * @brief Construit le maillage décrit par data, en soudant les coins identiques.
+         * @param data Les données lues dans un fichier '.obj', les indices doivent être valides.
+         * @return Le maillage, avec une plage par matériau.
+         *
+         * @exceptsafe FORT. Ne modifie aucune donnée.
+         *
+         * @version 1.2
+         * @since 0.1
+         *
+         * @note Les triangles d’un même matériau sont regroupés, même s’il est utilisé par plusieurs 'usemtl' :
+         * le maillage se dessine avec un appel par matériau.
+         * @note Les sommets sont rangés dans l’ordre de leur première utilisation, les attributs absents valent zéro.
+         * @note Les indices sont sur 16 bits si le maillage a au plus 65 536 sommets, sur 32 bits sinon.
+         */
+        [[nodiscard]] static Mesh build( const ObjData& data );
+
+        /**
+         * @overload
+         * @brief Surcharge retournant aussi le nombre de sommets avant et après la soudure.
+         * @param data Les données lues dans un fichier '.obj', les indices doivent être valides.
+         * @param statistics Reçoit les statistiques de la soudure.
+         */
+        [[nodiscard]] static Mesh build( const ObjData& data, WeldStatistics& statistics );
+    };
+}
+
+#endif // GLENGINE_MESH_BUILDER_HPP
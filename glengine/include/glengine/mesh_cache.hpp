@@ -0,0 +1,150 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLENGINE_MESH_CACHE_HPP
+#define GLENGINE_MESH_CACHE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <glengine/mesh.hpp>
+#include <glengine/mesh_simplifier.hpp>
+#include <glengine/utility.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Cache binaire '.glmesh' des maillages, écrit à côté du fichier source.
+     *
+     * Le cache contient un en-tête versionné, les sommets entrelacés, les indices, la boite englobante,
+     * la table des matériaux, les noms des bibliothèques '.mtl' et les niveaux de détail simplifiés.
+     * Les sections sont alignées sur 16 octets : un cache valide est projeté en mémoire et ses pointeurs sont passés
+     * tels quels à glBufferData, sans aucune analyse.
+     *
+     * Le cache est invalidé par la taille, la date de modification et l’empreinte du contenu du fichier source,
+     * ainsi que par un changement des options de construction du maillage.
+     * Si la taille et la date correspondent le cache est utilisé directement. Si seule la date diffère
+     * (fichier recopié, dépôt cloné, ...), l’empreinte du contenu est recalculée et comparée.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::Mesh
+     * @see gl_engine::ObjectFactory
+     */
+    class MeshCache final {
+    public:
+        // Note développeur : Classe purement statique, comme gl_engine::ObjectFactory.
+
+        MeshCache() noexcept = delete;
+        MeshCache( const MeshCache& ) noexcept = delete;
+        MeshCache( MeshCache&& ) noexcept = delete;
+        MeshCache& operator=( const MeshCache& ) noexcept = delete;
+        MeshCache& operator=( MeshCache&& ) noexcept = delete;
+        ~MeshCache() noexcept = delete;
+
+        /**
+         * @brief Taille et date de modification du fichier source, relevées avant sa lecture.
+         */
+        struct SourceStamp {
+            std::uint64_t size;
+            std::int64_t time;
+        };
+
+        /**
+         * @brief Maillage lu dans le cache et ses niveaux de détail, qui partagent sa projection en mémoire.
+         */
+        struct Entry {
+            Mesh mesh{};
+            std::vector<LodLevel> lods{};
+        };
+
+        /**
+         * @brief Version du format, à incrémenter à chaque modification de la disposition du fichier
+         * ou du maillage produit pour une même source (4 : normales calculées, 5 : bibliothèques de matériaux,
+         * 6 : niveaux de détail, 7 : normales calculées pour les seuls coins sans normale).
+         */
+        static constexpr std::uint32_t VERSION = 7;
+
+        /**
+         * @brief Extension ajoutée au nom du fichier source.
+         */
+        static constexpr std::string_view EXTENSION = ".glmesh";
+
+        /**
+         * @brief Retourne le chemin du cache associé au fichier source.
+         * @param source Le fichier source.
+         * @return Le chemin du fichier source suivi de gl_engine::MeshCache::EXTENSION.
+         *
+         * @exceptsafe FORT. Ne modifie aucune donnée.
+         */
+        [[nodiscard]] static std::filesystem::path cachePath( const Path& source );
+
+        /**
+         * @brief Charge le cache associé au fichier source, s’il existe et est à jour.
+         * @param source Le fichier source.
+         * @param options Identifiant des options de construction du maillage, un cache construit avec d’autres options est ignoré.
+         * @return Le maillage et ses niveaux de détail projetés en mémoire, ou std::nullopt si le cache est absent, corrompu ou périmé.
+         *
+         * @exceptsafe FORT. Ne modifie aucune donnée.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        [[nodiscard]] static std::optional<Entry> load( const Path& source, std::uint32_t options );
+
+        /**
+         * @brief Relève la taille et la date de modification du fichier source.
+         * @param source Le fichier source.
+         * @return La taille et la date, ou std::nullopt si le fichier ne peut pas être interrogé.
+         *
+         * @note À appeler avant de lire la source : une modification survenue pendant la lecture
+         * laisse alors dans le cache une date antérieure, et le cache sera revérifié par empreinte.
+         *
+         * @exceptsafe FORT. Ne modifie aucune donnée.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        [[nodiscard]] static std::optional<SourceStamp> stamp( const Path& source ) noexcept;
+
+        /**
+         * @brief Écrit le cache associé au fichier source.
+         * @param source Le fichier source.
+         * @param stamp La taille et la date de la source, relevées par gl_engine::MeshCache::stamp avant la lecture de content.
+         * @param content Le contenu du fichier source ayant servi à construire le maillage.
+         * @param mesh Le maillage à écrire.
+         * @param lods Les niveaux de détail du maillage, éventuellement aucun.
+         * @param options Identifiant des options ayant servi à construire le maillage et ses niveaux.
+         *
+         * @throws gl_engine::utility::ErrorWritingFile Lancée si le cache ne peut pas être écrit.
+         *
+         * @exceptsafe FORT. Le cache est écrit dans un fichier temporaire puis renommé,
+         * un cache existant n’est jamais laissé à moitié écrit.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        static void store( const Path& source, const SourceStamp& stamp, std::string_view content, const Mesh& mesh,
+                           const std::vector<LodLevel>& lods, std::uint32_t options );
+    };
+}
+
+#endif // GLENGINE_MESH_CACHE_HPP
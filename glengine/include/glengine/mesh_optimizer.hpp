@@ -0,0 +1,111 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLENGINE_MESH_OPTIMIZER_HPP
+#define GLENGINE_MESH_OPTIMIZER_HPP
+
+#include <cstddef>
+
+#include <glengine/mesh.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Efficacité d’un ordre de triangles vis-à-vis du cache de sommets transformés de la carte graphique.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::MeshOptimizer::analyzeVertexCache
+     */
+    struct VertexCacheStatistics {
+        /// Nombre de sommets transformés.
+        std::size_t transformedVertices = 0;
+        /// Average Cache Miss Ratio : sommets transformés par triangle, entre 0.5 (idéal) et 3.
+        double acmr = 0.0;
+        /// Average Transformed Vertex Ratio : sommets transformés par sommet du maillage, 1 est idéal.
+        double atvr = 0.0;
+    };
+
+    /**
+     * @brief Réordonne triangles et sommets d’un maillage pour les caches de la carte graphique.
+     *
+     * Trois passes sont appliquées, dans chaque plage de matériau séparément :
+     * - les triangles sont réordonnés pour la localité du cache de sommets transformés (algorithme de Forsyth) ;
+     * - la suite obtenue est découpée en groupes aux ruptures du cache, les groupes sont triés pour dessiner
+     * d’abord ceux tournés vers l’extérieur, ce qui réduit la surcharge de pixels (Sander et al.) ;
+     * - les sommets sont renumérotés dans l’ordre de leur première utilisation pour la localité de lecture.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::Mesh
+     * @see [Linear-Speed Vertex Cache Optimisation](https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html)
+     * @see [Fast Triangle Reordering for Vertex Locality and Reduced Overdraw](https://gfx.cs.princeton.edu/pubs/Sander_2007_%3ETR/tipsy.pdf)
+     */
+    class MeshOptimizer final {
+    public:
+        // Note développeur : Classe purement statique, comme gl_engine::ObjectFactory.
+
+        MeshOptimizer() noexcept = delete;
+        MeshOptimizer( const MeshOptimizer& ) noexcept = delete;
+        MeshOptimizer( MeshOptimizer&& ) noexcept = delete;
+        MeshOptimizer& operator=( const MeshOptimizer& ) noexcept = delete;
+        MeshOptimizer& operator=( MeshOptimizer&& ) noexcept = delete;
+        ~MeshOptimizer() noexcept = delete;
+
+        /**
+         * @brief Taille du cache LRU modélisé par l’algorithme de Forsyth.
+         */
+        static constexpr std::size_t CACHE_SIZE = 32;
+
+        /**
+         * @brief Taille du cache FIFO utilisé pour découper les groupes de triangles, proche du matériel courant.
+         */
+        static constexpr std::size_t CLUSTER_CACHE_SIZE = 16;
+
+        /**
+         * @brief Retourne une copie optimisée du maillage.
+         * @param mesh Le maillage à optimiser.
+         * @return Un maillage décrivant les mêmes triangles, avec les mêmes plages de matériaux.
+         *
+         * @exceptsafe FORT. Ne modifie aucune donnée.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note L’orientation de chaque triangle est conservée, seul l’ordre des triangles et des sommets change.
+         */
+        [[nodiscard]] static Mesh optimize( const Mesh& mesh );
+
+        /**
+         * @brief Simule un cache FIFO de sommets transformés sur l’ordre des triangles du maillage.
+         * @param mesh Le maillage à analyser.
+         * @param cacheSize La taille du cache simulé.
+         * @return L’ACMR et l’ATVR du maillage.
+         *
+         * @exceptsafe FORT. Ne modifie aucune donnée.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        [[nodiscard]] static VertexCacheStatistics analyzeVertexCache( const Mesh& mesh, std::size_t cacheSize );
+    };
+}
+
+#endif // GLENGINE_MESH_OPTIMIZER_HPP
@@ -0,0 +1,141 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef GLENGINE_MESH_POOL_HPP
+#define GLENGINE_MESH_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <glengine/mesh.hpp>
+#include <glengine/utility.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Place d’un maillage dans un gl_engine::MeshPool.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct PoolRange {
+        /// Ajouté à chaque indice du maillage : ses indices restent relatifs à son premier sommet.
+        std::int32_t baseVertex = 0;
+        /// Premier indice du maillage dans le EBO commun.
+        std::uint32_t firstIndex = 0;
+        std::uint32_t indexCount = 0;
+    };
+
+    /**
+     * @brief VAO, VBO et EBO partagés par de nombreux maillages statiques.
+     *
+     * Tous les maillages ajoutés sont dessinés avec le même VAO : la file de rendu n’a plus de VAO à changer entre eux
+     * et peut les regrouper en un seul glMultiDrawElementsIndirect, voir gl_engine::RenderQueue.
+     * Les sommets sont stockés au format gl_engine::Vertex, aux emplacements de gl_engine::MeshBuffer, et les indices
+     * sur 32 bits. Les buffers grandissent en doublant leur capacité, l’ancien contenu est copié par la carte graphique.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::MeshBuffer
+     * @see gl_engine::Model
+     */
+    class MeshPool final {
+    public:
+        /**
+         * @brief Crée le VAO et des buffers vides.
+         *
+         * @pre Un contexte OpenGL doit être courant sur le thread appelant.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        MeshPool();
+
+        /**
+         * @overload
+         * @brief Réserve la place des sommets et des indices attendus, aucun agrandissement n’aura lieu en deçà.
+         * @param vertexCapacity Le nombre de sommets.
+         * @param indexCapacity Le nombre d’indices.
+         */
+        MeshPool( std::size_t vertexCapacity, std::size_t indexCapacity );
+
+        MeshPool( const MeshPool& ) noexcept = delete;
+        MeshPool( MeshPool&& other ) noexcept;
+        MeshPool& operator=( const MeshPool& ) noexcept = delete;
+        MeshPool& operator=( MeshPool&& other ) noexcept;
+
+        /**
+         * @brief Supprime le VAO et les buffers.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        ~MeshPool() noexcept;
+
+        /**
+         * @brief Copie les sommets et les indices du maillage à la suite des précédents.
+         * @param mesh Le maillage, il peut être détruit ensuite.
+         * @return La place du maillage. Les plages de matériau du maillage sont relatives à PoolRange::firstIndex.
+         *
+         * @pre Un contexte OpenGL doit être courant sur le thread appelant.
+         * @throws std::length_error Lancée si le pool dépasserait 2^31 sommets ou 2^32 indices.
+         *
+         * @exceptsafe BASE. Le pool reste utilisable, les maillages déjà ajoutés sont intacts.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note Un maillage n’est jamais retiré : le pool est destiné aux maillages statiques d’une scène.
+         */
+        PoolRange add( const Mesh& mesh );
+
+        /**
+         * @brief Retourne le VAO commun, pour gl_engine::DrawItem.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] Id vertexArray() const noexcept {
+            return vertexArray_;
+        }
+
+        [[nodiscard]] std::size_t vertexCount() const noexcept {
+            return vertexCount_;
+        }
+
+        [[nodiscard]] std::size_t indexCount() const noexcept {
+            return indexCount_;
+        }
+
+    private:
+        Id vertexArray_ = 0;
+        Id vertexBuffer_ = 0;
+        Id indexBuffer_ = 0;
+
+        std::size_t vertexCount_ = 0;
+        std::size_t indexCount_ = 0;
+        std::size_t vertexCapacity_ = 0;
+        std::size_t indexCapacity_ = 0;
+
+        void reserve( std::size_t vertexCount, std::size_t indexCount );
+        void attach() noexcept;
+        void release() noexcept;
+    };
+}
+
+#endif // GLENGINE_MESH_POOL_HPP
@@ -0,0 +1,155 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLENGINE_MESH_SIMPLIFIER_HPP
+#define GLENGINE_MESH_SIMPLIFIER_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <glengine/mesh.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Options de gl_engine::MeshSimplifier.
+     *
+     * Les poids mesurent un écart d’attribut dans la même unité qu’un écart de position,
+     * les positions étant ramenées à une boite de côté 1 : un poids de 0 ignore l’attribut.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::MeshSimplifier
+     */
+    struct SimplifyOptions {
+        /// Poids des normales dans l’erreur d’une contraction.
+        float normalWeight = 0.5f;
+        /// Poids des coordonnées de texture dans l’erreur d’une contraction.
+        float texCoordWeight = 1.0f;
+        /// Interdit toute contraction touchant un bord ouvert du maillage.
+        bool lockBorders = false;
+        /// Nombre de threads évaluant les contractions, gl_engine::utility::AUTOMATIC_THREAD_COUNT pour tous les cœurs.
+        unsigned threadCount = 1;
+    };
+
+    /**
+     * @brief Options de gl_engine::MeshSimplifier::buildLodChain.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct LodOptions {
+        /// Nombre maximal de niveaux simplifiés, le maillage d’origine n’en fait pas partie.
+        std::size_t levelCount = 4;
+        /// Fraction des triangles du niveau précédent conservée par chaque niveau.
+        float reduction = 0.5f;
+        SimplifyOptions simplify{};
+    };
+
+    /**
+     * @brief Niveau de détail simplifié d’un maillage.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::LodSelector
+     */
+    struct LodLevel {
+        Mesh mesh{};
+        /// Écart estimé au maillage d’origine, dans l’unité des positions.
+        float error = 0.0f;
+    };
+
+    /**
+     * @brief Simplifie un maillage par contraction d’arêtes guidée par des quadriques d’erreur.
+     *
+     * Chaque position accumule la quadrique des plans de ses triangles (Garland et Heckbert), les bords ouverts
+     * ajoutent des plans perpendiculaires qui les retiennent. Chaque sommet accumule en plus une quadrique
+     * de ses attributs (Hoppe) : l’écart entre ses normale et coordonnées de texture et leur interpolation
+     * linéaire sur ses triangles d’origine. Une contraction déplace une position sur une voisine :
+     * aucun nouvel attribut n’est interpolé, les coutures de texture et les arêtes vives restent fermées.
+     *
+     * Les contractions sont appliquées par passes : toutes les arêtes sont évaluées, triées par erreur,
+     * puis contractées dans l’ordre tant qu’elles ne touchent pas une zone déjà modifiée durant la passe.
+     * Une contraction qui retournerait un triangle ou rendrait le maillage non manifold est refusée.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::Mesh
+     * @see gl_engine::LodSelector
+     * @see [Surface Simplification Using Quadric Error Metrics](https://www.cs.cmu.edu/~garland/Papers/quadrics.pdf)
+     * @see [New Quadric Metric for Simplifying Meshes with Appearance Attributes](https://hhoppe.com/newqem.pdf)
+     */
+    class MeshSimplifier final {
+    public:
+        // Note développeur : Classe purement statique, comme gl_engine::ObjectFactory.
+
+        MeshSimplifier() noexcept = delete;
+        MeshSimplifier( const MeshSimplifier& ) noexcept = delete;
+        MeshSimplifier( MeshSimplifier&& ) noexcept = delete;
+        MeshSimplifier& operator=( const MeshSimplifier& ) noexcept = delete;
+        MeshSimplifier& operator=( MeshSimplifier&& ) noexcept = delete;
+        ~MeshSimplifier() noexcept = delete;
+
+        /**
+         * @brief Retourne une copie simplifiée du maillage.
+         * @param mesh Le maillage à simplifier.
+         * @param targetIndexCount Le nombre d’indices visé, trois par triangle.
+         * @param options Les poids des attributs et le nombre de threads.
+         * @param error Reçoit l’écart estimé au maillage d’origine, dans l’unité des positions.
+         * @return Un maillage d’au plus mesh.indexCount() indices, avec les mêmes plages de matériaux.
+         *
+         * @exceptsafe FORT. Ne modifie aucune donnée.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note La cible peut ne pas être atteinte si plus aucune contraction n’est possible.
+         * @note Une plage de matériau peut devenir vide, elle est conservée pour rester alignée avec les matériaux.
+         */
+        [[nodiscard]] static Mesh simplify( const Mesh& mesh, std::size_t targetIndexCount, const SimplifyOptions& options, float& error );
+
+        /**
+         * @overload
+         * @brief Simplifie le maillage avec les options par défaut.
+         */
+        [[nodiscard]] static Mesh simplify( const Mesh& mesh, std::size_t targetIndexCount );
+
+        /**
+         * @brief Construit une chaine de niveaux de détail, chacun simplifié depuis le précédent.
+         * @param mesh Le maillage d’origine.
+         * @param options Le nombre de niveaux, la réduction entre deux niveaux et les options de simplification.
+         * @return Les niveaux, du plus détaillé au plus grossier, d’erreur croissante.
+         *
+         * @exceptsafe FORT. Ne modifie aucune donnée.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note La chaine s’arrête avant options.levelCount niveaux si le maillage ne peut plus être simplifié.
+         * @note Les niveaux sont réordonnés par gl_engine::MeshOptimizer.
+         */
+        [[nodiscard]] static std::vector<LodLevel> buildLodChain( const Mesh& mesh, const LodOptions& options );
+    };
+}
+
+#endif // GLENGINE_MESH_SIMPLIFIER_HPP
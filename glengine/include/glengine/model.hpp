@@ -0,0 +1,180 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLENGINE_MODEL_HPP
+#define GLENGINE_MODEL_HPP
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <glengine/abstract_object.hpp>
+#include <glengine/complex_object.hpp>
+#include <glengine/render_queue.hpp>
+
+namespace gl_engine {
+    class MeshBuffer;
+    class MeshPool;
+    struct VertexFormat;
+
+    /**
+     * @brief Objet dessinable : un maillage envoyé à la carte graphique, ses matériaux, un programme et une transformation.
+     *
+     * Les données sur la carte graphique sont partagées entre les copies : copier un modèle crée une nouvelle
+     * instance du même maillage, avec sa propre transformation, sans nouveau buffer. Avec un programme instancié,
+     * toutes les copies d’une scène sont dessinées en un appel par matériau, voir gl_engine::RenderQueue.
+     *
+     * @version 1.1
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::Scene
+     * @see gl_engine::RenderQueue
+     */
+    class Model final : public AbstractObject {
+    public:
+        /**
+         * @brief Envoie le maillage de l’objet à la carte graphique.
+         * @param object L’objet chargé, voir gl_engine::ObjectFactory.
+         * @param program Le programme dessinant l’objet.
+         *
+         * @pre Un contexte OpenGL doit être courant sur le thread appelant.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        Model( const ComplexObject& object, Id program );
+
+        /**
+         * @overload
+         * @brief Envoie le maillage de l’objet à la carte graphique dans un format compressé.
+         * @param object L’objet chargé, voir gl_engine::ObjectFactory.
+         * @param format Le format des sommets sur la carte graphique.
+         * @param program Le programme dessinant l’objet, son vertex shader doit contenir format.glslDecoder().
+         *
+         * @pre Un contexte OpenGL doit être courant sur le thread appelant.
+         *
+         * @note Avec des positions quantifiées, la boite englobante du maillage est envoyée aux uniformes
+         * de décodage à chaque dessin, voir gl_engine::DrawItem::positionOffset.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        Model( const ComplexObject& object, const VertexFormat& format, Id program );
+
+        /**
+         * @overload
+         * @brief Range le maillage de l’objet dans un pool partagé plutôt que dans ses propres buffers.
+         * @param object L’objet chargé, voir gl_engine::ObjectFactory.
+         * @param pool Le pool recevant le maillage, il doit survivre au modèle et à ses copies.
+         * @param program Le programme dessinant l’objet.
+         *
+         * @note Les modèles d’un même pool partagent leur VAO : avec un programme instancié, ils sont dessinés
+         * en un glMultiDrawElementsIndirect par matériau, voir gl_engine::RenderQueue.
+         */
+        Model( const ComplexObject& object, MeshPool& pool, Id program );
+
+        Model( const Model& ) = default;
+        Model( Model&& ) noexcept = default;
+        Model& operator=( const Model& ) = default;
+        Model& operator=( Model&& ) noexcept = default;
+        ~Model() noexcept override = default;
+
+        /**
+         * @brief Soumet un élément par plage de matériau.
+         *
+         * La passe est choisie d’après le matériau : BLENDED s’il est transparent, CUTOUT s’il a une texture
+         * d’opacité, SOLID sinon.
+         *
+         * @exceptsafe FORT.
+         */
+        void submit( RenderQueue& queue, const RenderView& view ) const override;
+
+        /**
+         * @brief Retourne la boite du maillage et sa sphère, transformées par la matrice de la copie.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] std::optional<BoundingVolume> bounds() const noexcept override;
+
+        /**
+         * @brief Retourne le maillage d’occultation choisi par setOccluder(), placé par la matrice de la copie.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] std::optional<Occluder> occluder() const noexcept override;
+
+        /**
+         * @brief Fait de la copie un occultant, ou ne l’est plus si mesh est nul.
+         * @param mesh Le maillage d’occultation, dans le repère de l’objet, partagé entre les copies.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @note À réserver aux grands objets opaques (murs, sols, bâtiments) : chaque occultant coûte ses triangles
+         * à chaque image.
+         */
+        void setOccluder( std::shared_ptr<const OccluderMesh> mesh ) noexcept {
+            occluder_ = std::move( mesh );
+        }
+
+        [[nodiscard]] const glm::mat4& transform() const noexcept {
+            return transform_;
+        }
+
+        void setTransform( const glm::mat4& transform ) noexcept {
+            transform_ = transform;
+        }
+
+        [[nodiscard]] Id program() const noexcept {
+            return program_;
+        }
+
+        void setProgram( const Id program ) noexcept {
+            program_ = program;
+        }
+
+        /**
+         * @brief Retourne la couleur de la copie, voir gl_engine::DrawItem::color.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] const glm::vec4& color() const noexcept {
+            return color_;
+        }
+
+        void setColor( const glm::vec4& color ) noexcept {
+            color_ = color;
+        }
+
+    private:
+        /// Données communes à toutes les copies.
+        struct Shared;
+
+        std::shared_ptr<const Shared> shared_{};
+
+        std::shared_ptr<const OccluderMesh> occluder_{};
+
+        Id program_ = 0;
+        glm::mat4 transform_{1.0f};
+        glm::vec4 color_{1.0f};
+    };
+}
+
+#endif // GLENGINE_MODEL_HPP
@@ -0,0 +1,107 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef GLENGINE_MTL_PARSER_HPP
+#define GLENGINE_MTL_PARSER_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <glengine/exception.hpp>
+#include <glengine/material.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Exception lancée si le contenu d’un fichier '.mtl' est mal formé.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::MtlParser
+     */
+    class MtlParseError final : public RuntimeError {
+    public:
+        MtlParseError() noexcept = delete;
+
+        /**
+         * @brief Construit l’exception avec le numéro de la ligne fautive et la raison de l’erreur.
+         * @param line Le numéro de la ligne, commençant à 1.
+         * @param what_arg La raison de l’erreur.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        MtlParseError( const std::size_t line, const std::string& what_arg ) noexcept
+        : RuntimeError("Ligne " + std::to_string(line) + " : " + what_arg) {}
+
+        MtlParseError( const MtlParseError& ) noexcept = default;
+        MtlParseError( MtlParseError&& ) noexcept = default;
+        MtlParseError& operator=( const MtlParseError& ) noexcept = default;
+        MtlParseError& operator=( MtlParseError&& ) noexcept = default;
+        ~MtlParseError() noexcept override = default;
+    };
+
+    /**
+     * @brief Analyseur du format Wavefront '.mtl'.
+     *
+     * Mots-clés pris en charge : 'newmtl', 'Ka', 'Kd', 'Ks', 'Ke', 'Ns', 'd', 'Tr', 'illum',
+     * 'map_Ka', 'map_Kd', 'map_Ks', 'map_Bump', 'bump', 'norm' et 'map_d'.
+     * Les options des textures ('-s 1 1 1', '-clamp on', ...) sont ignorées, le reste de la ligne est le chemin.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::MaterialData
+     * @see [Format MTL](http://paulbourke.net/dataformats/mtl/)
+     */
+    class MtlParser final {
+    public:
+        // Note développeur : Classe purement statique, comme gl_engine::ObjectFactory.
+
+        MtlParser() noexcept = delete;
+        MtlParser( const MtlParser& ) noexcept = delete;
+        MtlParser( MtlParser&& ) noexcept = delete;
+        MtlParser& operator=( const MtlParser& ) noexcept = delete;
+        MtlParser& operator=( MtlParser&& ) noexcept = delete;
+        ~MtlParser() noexcept = delete;
+
+        /**
+         * @brief Analyse le contenu d’un fichier '.mtl'.
+         * @param source Le contenu du fichier.
+         * @return Les matériaux dans l’ordre du fichier.
+         *
+         * @throws gl_engine::MtlParseError Lancée si une propriété précède 'newmtl' ou si un nombre est mal formé.
+         *
+         * @exceptsafe FORT. Ne modifie aucune donnée.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note Les mots-clés inconnus et les couleurs 'spectral' ou 'xyz' sont ignorés.
+         * @note Les '\' des chemins écrits sous Windows sont remplacés par des '/'.
+         */
+        [[nodiscard]] static std::vector<MaterialData> parse( std::string_view source );
+    };
+}
+
+#endif // GLENGINE_MTL_PARSER_HPP
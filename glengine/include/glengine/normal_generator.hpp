@@ -0,0 +1,125 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef GLENGINE_NORMAL_GENERATOR_HPP
+#define GLENGINE_NORMAL_GENERATOR_HPP
+
+#include <cstdint>
+
+#include <glengine/obj_data.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Pondération des normales des faces autour d’un sommet.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::NormalGenerator
+     */
+    enum class NormalWeighting : std::uint8_t {
+        /// Chaque face compte proportionnellement à son aire : rapide, mais biaisé par la taille des triangles.
+        AREA,
+        /// Chaque face compte proportionnellement à son angle au sommet : indépendant de la triangulation.
+        ANGLE
+    };
+
+    /**
+     * @brief Options de gl_engine::NormalGenerator::generate.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct NormalOptions {
+        NormalWeighting weighting = NormalWeighting::ANGLE;
+
+        /// Respecte les instructions 's', sinon toutes les faces sont lissées ensemble.
+        bool useSmoothingGroups = true;
+
+        /// Nombre de threads, gl_engine::utility::AUTOMATIC_THREAD_COUNT pour tous les cœurs.
+        unsigned threadCount = 1;
+    };
+
+    /**
+     * @brief Calcule les normales manquantes d’un fichier '.obj'.
+     *
+     * Les normales des faces sont calculées quatre triangles à la fois (SIMD), puis accumulées par sommet
+     * avec la pondération choisie. Deux coins partageant une position ne partagent leur normale que s’ils
+     * appartiennent au même groupe de lissage : le sommet est dupliqué à la frontière entre deux groupes.
+     * Les faces du groupe 0 ('s off') sont plates.
+     *
+     * Les deux phases sont réparties sur plusieurs threads, le résultat ne dépend pas du nombre de threads.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::ObjData
+     * @see gl_engine::MeshBuilder
+     *
+     * @note Les groupes sont comparés par égalité, comme le décrit la spécification du format.
+     * @note Seuls les coins sans normale sont accumulés : un coin dont la normale est lue dans le fichier
+     * ne contribue pas aux normales calculées et n’en ajoute aucune.
+     * @note Les faces précédant la première instruction 's' sont lissées ensemble.
+     */
+    class NormalGenerator final {
+    public:
+        // Note développeur : Classe purement statique, comme gl_engine::ObjectFactory.
+
+        NormalGenerator() noexcept = delete;
+        NormalGenerator( const NormalGenerator& ) noexcept = delete;
+        NormalGenerator( NormalGenerator&& ) noexcept = delete;
+        NormalGenerator& operator=( const NormalGenerator& ) noexcept = delete;
+        NormalGenerator& operator=( NormalGenerator&& ) noexcept = delete;
+        ~NormalGenerator() noexcept = delete;
+
+        /**
+         * @brief Indique si au moins un coin n’a pas de normale.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] static bool needsNormals( const ObjData& data ) noexcept;
+
+        /**
+         * @brief Calcule une normale pour chaque coin qui n’en a pas.
+         * @param data Les données analysées, modifiées sur place.
+         * @param options La pondération, les groupes de lissage et le nombre de threads.
+         *
+         * @throws std::bad_alloc Si la mémoire de travail ne peut pas être allouée.
+         * @exceptsafe BASE. data reste valide mais peut être partiellement complété.
+         *
+         * @post Chaque coin de data a une normale, les normales déjà présentes ne sont pas modifiées.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note Les nouvelles normales sont ajoutées à la fin de data.normals.
+         */
+        static void generate( ObjData& data, const NormalOptions& options );
+
+        /**
+         * @overload
+         * @brief Calcule les normales manquantes avec les options par défaut.
+         */
+        static void generate( ObjData& data );
+    };
+}
+
+#endif // GLENGINE_NORMAL_GENERATOR_HPP
@@ -0,0 +1,130 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLENGINE_OBJ_DATA_HPP
+#define GLENGINE_OBJ_DATA_HPP
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Valeur d’un indice absent dans un coin de face (ex : 'f 1//3' n’a pas de coordonnée de texture).
+     */
+    inline constexpr std::uint32_t NO_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+    /**
+     * @brief Coin d’une face d’un fichier '.obj'. Les indices commencent à 0.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::ObjData
+     */
+    struct Corner {
+        std::uint32_t position = NO_INDEX;
+        std::uint32_t texture = NO_INDEX;
+        std::uint32_t normal = NO_INDEX;
+    };
+
+    constexpr bool operator==( const Corner& c1, const Corner& c2 ) noexcept {
+        return c1.position == c2.position && c1.texture == c2.texture && c1.normal == c2.normal;
+    }
+
+    constexpr bool operator!=( const Corner& c1, const Corner& c2 ) noexcept {
+        return !( c1 == c2 );
+    }
+
+    /**
+     * @brief Début d’une plage de triangles utilisant le même matériau ('usemtl').
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct MaterialRange {
+        /// Indice du matériau dans gl_engine::ObjData::materials.
+        std::uint32_t material = 0;
+        /// Premier triangle de la plage, la plage se termine au début de la suivante.
+        std::uint32_t firstTriangle = 0;
+    };
+
+    /**
+     * @brief Début d’une plage de triangles appartenant au même groupe de lissage ('s').
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct SmoothingRange {
+        /// Numéro du groupe, 0 si le lissage est désactivé ('s off' ou 's 0').
+        std::uint32_t group = 0;
+        /// Premier triangle de la plage, la plage se termine au début de la suivante.
+        std::uint32_t firstTriangle = 0;
+    };
+
+    /**
+     * @brief Contenu brut d’un fichier '.obj', tel qu’il est décrit dans le fichier.
+     *
+     * Les positions, coordonnées de texture et normales sont indexées séparément par les coins des faces.
+     * Toutes les faces sont des triangles, les coins sont donc rangés par groupe de trois.
+     *
+     * @version 1.1
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::ObjParser
+     * @see gl_engine::ObjectFactory
+     */
+    class ObjData final {
+    public:
+        std::vector<glm::vec3> positions{};
+        std::vector<glm::vec2> texCoords{};
+        std::vector<glm::vec3> normals{};
+
+        /// Trois coins par triangle.
+        std::vector<Corner> corners{};
+
+        /// Noms des fichiers '.mtl' déclarés par 'mtllib', relatifs au fichier '.obj'.
+        std::vector<std::string> materialLibraries{};
+
+        /// Noms des matériaux dans l’ordre de leur première utilisation.
+        std::vector<std::string> materials{};
+
+        /// Plages de matériaux, triées par premier triangle.
+        std::vector<MaterialRange> materialRanges{};
+
+        /// Plages de groupes de lissage, triées par premier triangle. Vide si le fichier n’a aucune instruction 's'.
+        std::vector<SmoothingRange> smoothingRanges{};
+
+        /**
+         * @brief Retourne le nombre de triangles.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] std::size_t triangleCount() const noexcept {
+            return corners.size() / 3;
+        }
+    };
+}
+
+#endif // GLENGINE_OBJ_DATA_HPP
@@ -0,0 +1,137 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLENGINE_OBJ_PARSER_HPP
+#define GLENGINE_OBJ_PARSER_HPP
+
+#include <string>
+#include <string_view>
+
+#include <glengine/exception.hpp>
+#include <glengine/obj_data.hpp>
+#include <glengine/parallel.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Exception lancée si le contenu d’un fichier '.obj' est mal formé.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::ObjParser
+     */
+    class ObjParseError final : public RuntimeError {
+    public:
+        ObjParseError() noexcept = delete;
+
+        /**
+         * @brief Construit l’exception avec le numéro de la ligne fautive et la raison de l’erreur.
+         * @param line Le numéro de la ligne, commençant à 1.
+         * @param what_arg La raison de l’erreur.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        ObjParseError( const std::size_t line, const std::string& what_arg ) noexcept
+        : RuntimeError("Ligne " + std::to_string(line) + " : " + what_arg) {}
+
+        /**
+         * @overload
+         * @brief Surcharge pour une erreur ne concernant pas une ligne en particulier.
+         * @param what_arg La raison de l’erreur.
+         */
+        explicit ObjParseError( const std::string& what_arg ) noexcept
+        : RuntimeError(what_arg) {}
+
+        ObjParseError( const ObjParseError& ) noexcept = default;
+        ObjParseError( ObjParseError&& ) noexcept = default;
+        ObjParseError& operator=( const ObjParseError& ) noexcept = default;
+        ObjParseError& operator=( ObjParseError&& ) noexcept = default;
+        ~ObjParseError() noexcept override = default;
+    };
+
+    /**
+     * @brief Analyseur du format Wavefront '.obj'.
+     *
+     * Le contenu est parcouru ligne par ligne directement dans le tampon fourni, sans copie ni flux.
+     * Les nombres sont convertis sans passer par la locale, aucune chaine de caractère n’est allouée pour les mots-clés.
+     *
+     * Les formes de coins prises en charge sont 'v', 'v/vt', 'v//vn' et 'v/vt/vn', les indices négatifs (relatifs) sont acceptés.
+     *
+     * @version 1.1
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::ObjData
+     * @see gl_engine::ObjectFactory
+     * @see [Format OBJ](http://www.hodge.net.au/sam/blog/wp-content/uploads/obj_format.txt)
+     */
+    class ObjParser final {
+    public:
+        // Note développeur : Classe purement statique, comme gl_engine::ObjectFactory.
+
+        ObjParser() noexcept = delete;
+        ObjParser( const ObjParser& ) noexcept = delete;
+        ObjParser( ObjParser&& ) noexcept = delete;
+        ObjParser& operator=( const ObjParser& ) noexcept = delete;
+        ObjParser& operator=( ObjParser&& ) noexcept = delete;
+        ~ObjParser() noexcept = delete;
+
+        /**
+         * @brief Analyse le contenu d’un fichier '.obj'.
+         * @param source Le contenu du fichier.
+         * @return Les données décrites dans le fichier.
+         *
+         * @throws gl_engine::ObjParseError Lancée si une ligne est mal formée ou si un indice est hors limites.
+         *
+         * @exceptsafe FORT. Ne modifie aucune donnée.
+         *
+         * @version 1.1
+         * @since 0.1
+         *
+         * @note Les mots-clés inconnus ou non pris en charge ('o', 'g', ...) sont ignorés.
+         * @note Les faces de plus de trois sommets sont triangulées : en éventail si elles sont convexes, par les oreilles sinon.
+         */
+        [[nodiscard]] static ObjData parse( std::string_view source );
+
+        /**
+         * @overload
+         * @brief Analyse le contenu d’un fichier '.obj' avec plusieurs threads.
+         * @param source Le contenu du fichier.
+         * @param threadCount Le nombre de threads, gl_engine::utility::AUTOMATIC_THREAD_COUNT pour tous les cœurs.
+         * @return Les données décrites dans le fichier, identiques octet pour octet à celles de l’analyse séquentielle.
+         *
+         * @throws gl_engine::ObjParseError Lancée si une ligne est mal formée ou si un indice est hors limites.
+         *
+         * @exceptsafe FORT. Ne modifie aucune donnée.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note Le contenu est découpé en morceaux aux fins de ligne, chaque morceau est analysé indépendamment
+         * puis les tableaux sont fusionnés avec les sommes préfixes de leurs tailles. Les indices négatifs
+         * référençant un morceau précédent sont corrigés lors de la fusion.
+         * @note Les petits contenus sont analysés sur le thread appelant.
+         */
+        [[nodiscard]] static ObjData parse( std::string_view source, unsigned threadCount );
+    };
+}
+
+#endif // GLENGINE_OBJ_PARSER_HPP
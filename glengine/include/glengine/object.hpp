@@ -22,9 +22,79 @@
 #ifndef OBJECT_HPP
 #define OBJECT_HPP
 
+#include <optional>
+
+#include <glengine/bounds.hpp>
+#include <glengine/occluder.hpp>
+
 namespace gl_engine {
+    class RenderQueue;
+    struct RenderView;
+
     class Object {
+    public:
+        Object() noexcept = default;
+        Object( const Object& ) = default;
+        Object( Object&& ) noexcept = default;
+        Object& operator=( const Object& ) = default;
+        Object& operator=( Object&& ) noexcept = default;
+
+        // Note développeur : Les objets sont détruits via un pointeur gl_engine::Object (voir gl_engine::ObjectFactory).
+        virtual ~Object() noexcept = default;
+
+        /**
+         * @brief Ajoute les éléments de dessin de l’objet à la file de l’image.
+         * @param queue La file de l’image.
+         * @param view Le point de vue, pour la profondeur des éléments.
+         *
+         * @exceptsafe FORT.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note Par défaut l’objet n’est pas dessiné : un objet sans données sur la carte graphique n’a rien à soumettre.
+         *
+         * @see gl_engine::Scene::render
+         */
+        virtual void submit( RenderQueue& queue, const RenderView& view ) const {
+            static_cast<void>(queue);
+            static_cast<void>(view);
+        }
+
+        /**
+         * @brief Retourne les volumes englobants de l’objet dans le monde, utilisés pour l’élimination hors champ.
+         * @return Les volumes, std::nullopt si l’objet doit toujours être soumis.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note Par défaut l’objet n’a pas de volume : il n’est jamais éliminé.
+         *
+         * @see gl_engine::Bvh
+         * @see gl_engine::FrustumCuller
+         */
+        [[nodiscard]] virtual std::optional<BoundingVolume> bounds() const noexcept {
+            return std::nullopt;
+        }
 
+        /**
+         * @brief Retourne l’occultant de l’objet, rastérisé pour cacher les objets situés derrière lui.
+         * @return Le maillage d’occultation et sa matrice dans le monde, std::nullopt si l’objet ne cache rien.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note Par défaut l’objet n’est pas un occultant.
+         *
+         * @see gl_engine::OcclusionBuffer
+         */
+        [[nodiscard]] virtual std::optional<Occluder> occluder() const noexcept {
+            return std::nullopt;
+        }
     };
 }
 
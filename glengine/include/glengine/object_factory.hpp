@@ -27,24 +27,68 @@
 #error GL_Engine a été développée pour C++17. Veuillez supprimer cette condition est testé le code à vos risques et périls.
 #endif
 
-#include <memory>
-#include <vector>
-#include <string>
-#include <sstream>
 #include <algorithm>
-#include <execution>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
 #include <glengine/complex_object.hpp>
+#include <glengine/normal_generator.hpp>
+#include <glengine/parallel.hpp>
 #include <glengine/utility.hpp>
 
 namespace gl_engine {
+    /**
+     * @brief Options de chargement d’un objet par gl_engine::ObjectFactory.
+     *
+     * @version 1.2
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::ObjectFactory
+     */
+    struct LoadOptions {
+        /// Nombre de threads analysant le fichier, gl_engine::utility::AUTOMATIC_THREAD_COUNT pour tous les cœurs.
+        unsigned threadCount = 1;
+
+        /// Réordonne triangles et sommets pour les caches de la carte graphique, voir gl_engine::MeshOptimizer.
+        bool optimize = false;
+
+        /// Pondération des normales calculées pour les faces qui n’en ont pas, voir gl_engine::NormalGenerator.
+        NormalWeighting normalWeighting = NormalWeighting::ANGLE;
+
+        /// Respecte les groupes de lissage ('s') lors du calcul des normales.
+        bool useSmoothingGroups = true;
+
+        /// Nombre de niveaux de détail simplifiés construits au chargement, voir gl_engine::MeshSimplifier.
+        std::size_t lodLevelCount = 0;
+
+        /**
+         * @brief Retourne l’identifiant des options modifiant le maillage produit, enregistré dans le cache '.glmesh'.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @note Le nombre de threads ne modifie pas le maillage, il n’en fait donc pas partie.
+         * @note Les niveaux de détail sont enregistrés dans le cache : leur nombre occupe les bits 8 et suivants.
+         */
+        [[nodiscard]] std::uint32_t cacheKey() const noexcept {
+            // Note développeur : La chaine s’arrête bien avant 255 niveaux, au-delà le nombre ne change plus le résultat.
+            const auto lodBits = static_cast<std::uint32_t>(std::min<std::size_t>( lodLevelCount, 0xff )) << 8;
+
+            return ( optimize ? 1u : 0u ) | ( normalWeighting == NormalWeighting::AREA ? 2u : 0u ) | ( useSmoothingGroups ? 0u : 4u )
+                   | lodBits;
+        }
+    };
+
     /**
      * @brief Factory permettant de charger un objet.
      *
-     * @version 1.0
+     * @version 1.1
      * @since 0.1
      * @author Axel DAVID
      *
      * @see gl_engine::Object
+     * @see gl_engine::ObjParser
      */
     class ObjectFactory final {
     public:
@@ -63,153 +107,91 @@ namespace gl_engine {
          * @return Un pointeur propriétaire gl_engine::Object.
          *
          * @pre Le contenu dans content doit être valide.
+         * @throws gl_engine::ObjParseError Lancée si le contenu est mal formé.
          *
          * @post L’objet gl_engine::Object représente l’objet décrit dans le contenu passé.
          *
-         * @exceptsafe TODO
+         * @exceptsafe FORT. Ne modifie aucune donnée.
          *
-         * @version 1.0
+         * @version 1.1
          * @since 0.1
          *
          * @see gl_engine::Object
          * @see gl_engine::Content
          *
-         * @note Peut seulement lire un objet.
-         * @note Ne prend pas en charge le lissage des normales.
+         * @note Peut seulement lire un objet, sans ses matériaux : les fichiers '.mtl' sont relatifs à un chemin.
+         * @note Les normales absentes du fichier sont calculées, voir gl_engine::NormalGenerator.
          */
-        static std::unique_ptr<Object> load(Content content) {
-            // Note développeur : Tous les attributs disponibles dans le format obj
-            // http://www.hodge.net.au/sam/blog/wp-content/uploads/obj_format.txt
-
-            // Vérifier le type du contenu, que c'est bien un obj
-
-            // Lire et extraire le contenu et le stocker dans des vecteurs
-            std::string word{};
-
-            std::stringstream stream(content.content());
-            try {
-                stream.exceptions( std::ios_base::failbit | std::ios_base::badbit );
-            }
-            catch (const std::ios_base::failure&) {
-                throw std::runtime_error("Erreur lors de la création du buffer de string");
-            }
-
-            struct Point {
-                float x = 0.0f;
-                float y = 0.0f;
-                float z = 0.0f;
-                float w = 1.0f;
-            };
-
-            struct TexturePosition {
-                float s = 0.0f;
-                float t = 0.0f;
-                float u = 0.0f;
-            };
-
-            struct Face {
-                unsigned int vertex1;
-                unsigned int vertex2;
-                unsigned int vertex3;
-            };
-
-            std::vector<Point> vertices;
-            std::vector<Point> normales;
-            std::vector<TexturePosition> texturePositions;
-
-            std::vector<Face> indices;
-
-            std::string textureName;
-
-            bool readVertices = false;
-            bool readNormales = false;
-            bool readTexturePositions = false;
-
-            try {
-                while ( !stream.eof() ) {
-                    stream >> word;
-
-                    if ( word.at( 0 ) == '#' && word.at( word.size() - 1 ) != '\n' ) {
-                        stream.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-                        break;
-                    }
-
-                    if ( word == "mtllib" ) {
-                        stream >> textureName;
-                        break;
-                    }
-
-                    if ( word == "v" || word == "vn" ) {
-                        auto x = 0.0f;
-                        auto y = 0.0f;
-                        auto z = 0.0f;
-                        auto w = 0.0f;
-                        
-                        // Extract line
-
-                        stream >> x >> y >> z;
-
-                        if ( word == "v" ) {
-                            vertices.push_back( { x, y, z } );
-                            readVertices = true;
-                        }
-                        else {
-                            normales.push_back( { x, y, z } );
-                            readNormales = true;
-                        }
-                    }
-
-                    if ( word == "vt" ) {
-                        auto x = 0.0f;
-                        auto y = 0.0f;
-
-                        stream >> x >> y;
-                        texturePositions.push_back({x,y});
-
-                        readTexturePositions = true;
-                    }
-
-                    if ( word == "s" ) {
-                        // Détection du lissage des normales
-                        // https://community.khronos.org/t/how-do-i-use-smoothing-groups-from-obj-files/73070/13
-
-                        std::string idGroupNormal{};
-
-                        stream >> idGroupNormal;
-
-                        // Note développeur : le format est en ascii pur, donc les lettres UTF-8 ne sont pas disponible pour les attributs
-                        // L'utilisation de std::tolower est suffisante
-                        // Sinon il faudrait utiliser la lib ICU
-                        // https://icu.unicode.org/
-                        // qui contient une fonction de conversion to lower pour l'UTF-8
-                        auto to_lower = [](auto& letter){
-                            letter = std::tolower(letter);
-                        };
-
-                        std::for_each( std::execution::par_unseq, idGroupNormal.begin(), idGroupNormal.end(), to_lower );
-                        if( idGroupNormal != "off" || idGroupNormal != "0" ) {
-                            throw std::invalid_argument("Le lissage des normales n'est pas pris en charge.");
-                        }
-                    }
-
-                    if ( word == "f" ) {
-                        // Récupération des faces en fonction du modèle
-                        // récupération des indices séparés par /
-                        // En fonction si v a été lu
-                        stream.sepa
-                    }
-                }
-            }
-            catch (...) {
-                // TODO Erreur de lecture
-            }
-
-            // Vérifier que tous les vecteurs fassent la même taille finale.
-
-
-
-            return std::make_unique<ComplexObject>();
-        }
+        static std::unique_ptr<Object> load( const Content& content );
+
+        /**
+         * @brief Construit un objet gl_engine::Object à partir du fichier '.obj' pointé par path.
+         * @param path Le chemin vers le fichier '.obj'.
+         * @return Un pointeur propriétaire gl_engine::Object.
+         *
+         * @throws gl_engine::utility::EmptySource Lancée si le fichier est vide.
+         * @throws gl_engine::utility::ErrorOpeningFile Lancée si le fichier ne peut pas être ouvert.
+         * @throws gl_engine::utility::ErrorReadingFile Lancée si le fichier ne peut pas être projeté en mémoire.
+         * @throws gl_engine::ObjParseError Lancée si le contenu est mal formé.
+         *
+         * @throws gl_engine::MtlParseError Lancée si un fichier '.mtl' est mal formé.
+         *
+         * @exceptsafe FORT. Ne modifie aucune donnée.
+         *
+         * @version 1.1
+         * @since 0.1
+         *
+         * @note Le fichier est projeté en mémoire puis analysé directement, sans copie intermédiaire.
+         * @note Le maillage est lu dans le cache '.glmesh' voisin s’il est à jour, sinon le cache est (ré)écrit.
+         * @note Les matériaux sont lus dans les fichiers '.mtl' déclarés par 'mtllib', leurs textures sont
+         * partagées par gl_engine::TextureCache. Un fichier '.mtl' ou une image introuvable est ignoré.
+         *
+         * @see gl_engine::MeshCache
+         * @see gl_engine::ComplexObject::materials
+         */
+        static std::unique_ptr<Object> load( const Path& path );
+
+        /**
+         * @overload
+         * @brief Charge un contenu '.obj' en répartissant l’analyse sur plusieurs threads.
+         * @param content Objet gl_engine::utility::Content représentant le contenu d’un fichier '.obj'.
+         * @param threadCount Le nombre de threads, gl_engine::utility::AUTOMATIC_THREAD_COUNT pour tous les cœurs.
+         *
+         * @see gl_engine::ObjParser::parse
+         */
+        static std::unique_ptr<Object> load( const Content& content, unsigned threadCount );
+
+        /**
+         * @overload
+         * @brief Charge un fichier '.obj' en répartissant l’analyse sur plusieurs threads.
+         * @param path Le chemin vers le fichier '.obj'.
+         * @param threadCount Le nombre de threads, gl_engine::utility::AUTOMATIC_THREAD_COUNT pour tous les cœurs.
+         *
+         * @see gl_engine::ObjParser::parse
+         */
+        static std::unique_ptr<Object> load( const Path& path, unsigned threadCount );
+
+        /**
+         * @overload
+         * @brief Charge un contenu '.obj' avec les options fournies.
+         * @param content Objet gl_engine::utility::Content représentant le contenu d’un fichier '.obj'.
+         * @param options Les options de chargement.
+         *
+         * @note Les niveaux de détail demandés sont construits à chaque chargement, voir gl_engine::ComplexObject::mesh.
+         */
+        static std::unique_ptr<Object> load( const Content& content, const LoadOptions& options );
+
+        /**
+         * @overload
+         * @brief Charge un fichier '.obj' avec les options fournies.
+         * @param path Le chemin vers le fichier '.obj'.
+         * @param options Les options de chargement.
+         *
+         * @note Le maillage optimisé est enregistré dans le cache, l’optimisation n’est donc payée qu’une fois.
+         * @note Les niveaux de détail sont enregistrés dans le cache avec le maillage : ils sont relus depuis un cache valide
+         * et ne sont construits que lorsque le cache est absent ou périmé.
+         */
+        static std::unique_ptr<Object> load( const Path& path, const LoadOptions& options );
     };
 }
 
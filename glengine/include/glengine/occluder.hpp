@@ -0,0 +1,73 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef GLENGINE_OCCLUDER_HPP
+#define GLENGINE_OCCLUDER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace gl_engine {
+    class Mesh;
+
+    /**
+     * @brief Maillage d’occultation : positions et triangles seulement, rastérisés par gl_engine::OcclusionBuffer.
+     *
+     * Un occultant doit être plus petit que l’objet qu’il représente, jamais plus grand : un mur réduit à ses deux
+     * grandes faces, un bâtiment à une boite intérieure. Sinon des objets visibles seraient éliminés.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct OccluderMesh {
+        std::vector<glm::vec3> positions{};
+        /// Trois indices par triangle, l’orientation n’importe pas.
+        std::vector<std::uint32_t> indices{};
+
+        /**
+         * @brief Copie les positions et les indices d’un maillage complet.
+         *
+         * @exceptsafe FORT.
+         *
+         * @note Pratique pour les objets peu détaillés (murs, sols) ; un maillage détaillé coûte autant de
+         * triangles à rastériser, un maillage simplifié lui est préférable (voir gl_engine::MeshSimplifier).
+         */
+        [[nodiscard]] static OccluderMesh fromMesh( const Mesh& mesh );
+    };
+
+    /**
+     * @brief Occultant d’une image : un maillage partagé et sa matrice dans le monde.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::Object::occluder
+     */
+    struct Occluder {
+        std::shared_ptr<const OccluderMesh> mesh{};
+        glm::mat4 model{1.0f};
+    };
+}
+
+#endif // GLENGINE_OCCLUDER_HPP
@@ -0,0 +1,181 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef GLENGINE_OCCLUSION_HPP
+#define GLENGINE_OCCLUSION_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <glengine/bounds.hpp>
+#include <glengine/occluder.hpp>
+#include <glengine/parallel.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Tampon de profondeur logiciel basse résolution et sa hiérarchie min/max, pour l’élimination des objets cachés.
+     *
+     * render() rastérise les triangles des occultants sur le processeur, sans lecture du GPU : les sommets sont
+     * transformés et découpés par le plan proche en parallèle par occultant, puis l’image est partagée en bandes de
+     * BAND_HEIGHT lignes rastérisées en parallèle. Chaque ligne d’un triangle est parcourue par groupes de 4 ou 8 pixels
+     * (SSE2 ou AVX) : fonctions d’arêtes et profondeur évaluées ensemble, profondeur gardée par min sans branchement.
+     * La hiérarchie est ensuite construite : chaque niveau garde la profondeur la plus proche et la plus lointaine
+     * de 2x2 texels du niveau précédent.
+     *
+     * visible() projette la boite d’un objet : elle est cachée si son point le plus proche est derrière la profondeur
+     * la plus lointaine de tous les texels couverts. Le test commence au niveau où la boite couvre au plus 4x4 texels ;
+     * s’il ne conclut pas (la boite n’est ni devant toutes les profondeurs les plus proches, ni derrière toutes les plus
+     * lointaines), il est repris sur les deux niveaux plus fins.
+     *
+     * Profondeur : celle d’OpenGL ramenée à [0, 1], 1 au plan lointain, valeur du tampon vide.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::Scene::render
+     */
+    class OcclusionBuffer final {
+    public:
+        static constexpr std::size_t DEFAULT_WIDTH = 256;
+        static constexpr std::size_t DEFAULT_HEIGHT = 128;
+
+        /// Lignes d’une bande rastérisée par un thread.
+        static constexpr std::size_t BAND_HEIGHT = 16;
+
+        /**
+         * @brief Construit un tampon de DEFAULT_WIDTH x DEFAULT_HEIGHT pixels.
+         *
+         * @exceptsafe FORT.
+         */
+        OcclusionBuffer();
+
+        /**
+         * @brief Construit un tampon de la taille fournie.
+         * @param width La largeur, arrondie au multiple de 8 supérieur.
+         * @param height La hauteur.
+         *
+         * @exceptsafe FORT.
+         */
+        OcclusionBuffer( std::size_t width, std::size_t height );
+
+        OcclusionBuffer( const OcclusionBuffer& ) = default;
+        OcclusionBuffer( OcclusionBuffer&& ) noexcept = default;
+        OcclusionBuffer& operator=( const OcclusionBuffer& ) = default;
+        OcclusionBuffer& operator=( OcclusionBuffer&& ) noexcept = default;
+        ~OcclusionBuffer() noexcept = default;
+
+        /**
+         * @brief Efface le tampon, rastérise les occultants vus par viewProjection et construit la hiérarchie.
+         * @param occluders Les occultants, un maillage nul est ignoré.
+         * @param viewProjection La matrice projection * vue, profondeur OpenGL [-1, 1].
+         * @param threadCount Le nombre de threads, gl_engine::utility::AUTOMATIC_THREAD_COUNT pour tous les cœurs.
+         *
+         * @exceptsafe BASE. Le tampon est vide en cas d’exception : aucun objet n’est caché.
+         *
+         * @note N’utilise pas OpenGL : peut être appelée sur n’importe quel thread, pendant que le thread principal
+         * prépare l’image. Les occultants ne doivent pas être modifiés pendant l’appel.
+         */
+        void render( const std::vector<Occluder>& occluders, const glm::mat4& viewProjection, unsigned threadCount );
+
+        /**
+         * @overload
+         * @brief Rastérisation sur le thread appelant seulement.
+         */
+        void render( const std::vector<Occluder>& occluders, const glm::mat4& viewProjection );
+
+        /**
+         * @brief Indique si une boite, dans le monde, peut être visible derrière les occultants du dernier render().
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @note Conservatif : une boite qui coupe le plan proche ou sort de l’image est toujours visible.
+         */
+        [[nodiscard]] bool visible( const Bounds& box ) const noexcept;
+
+        [[nodiscard]] std::size_t width() const noexcept {
+            return width_;
+        }
+
+        [[nodiscard]] std::size_t height() const noexcept {
+            return height_;
+        }
+
+        /// Profondeurs du tampon, ligne par ligne, la première en bas de l’image.
+        [[nodiscard]] const std::vector<float>& depth() const noexcept {
+            return depth_;
+        }
+
+        /// Nombre de triangles rastérisés lors du dernier render(), après découpage.
+        [[nodiscard]] std::size_t triangleCount() const noexcept {
+            return triangleCount_;
+        }
+
+    private:
+        /// Niveau de la hiérarchie, deux fois plus petit que le précédent ; le niveau 0 est depth_.
+        struct Level {
+            std::size_t width = 0;
+            std::size_t height = 0;
+            std::vector<float> nearest{};
+            std::vector<float> farthest{};
+        };
+
+        /// Triangle projeté : fonctions d’arêtes et plan de profondeur en pixels, rectangle couvert.
+        struct ScreenTriangle {
+            glm::vec3 edgeA{};
+            glm::vec3 edgeB{};
+            glm::vec3 edgeC{};
+            /// Profondeur = depth.x * x + depth.y * y + depth.z.
+            glm::vec3 depth{};
+            int minX = 0;
+            int maxX = 0;
+            int minY = 0;
+            int maxY = 0;
+        };
+
+        std::size_t width_ = 0;
+        std::size_t height_ = 0;
+        std::vector<float> depth_{};
+        std::vector<Level> levels_{};
+
+        glm::mat4 viewProjection_{1.0f};
+        std::size_t triangleCount_ = 0;
+
+        /// Triangles de chaque occultant, gardés d’une image à l’autre pour leur mémoire.
+        std::vector<std::vector<ScreenTriangle>> triangles_{};
+
+        void setup( const Occluder& occluder, std::vector<ScreenTriangle>& triangles ) const;
+        void addTriangle( const glm::vec4& a, const glm::vec4& b, const glm::vec4& c, std::vector<ScreenTriangle>& triangles ) const;
+        void rasterize( const ScreenTriangle& triangle, int firstRow, int lastRow ) noexcept;
+        void buildHierarchy() noexcept;
+
+        /// Résultat du test d’un rectangle de texels à un niveau : caché, visible, ou à reprendre plus finement.
+        enum class Coverage {
+            OCCLUDED,
+            VISIBLE,
+            UNKNOWN
+        };
+
+        [[nodiscard]] Coverage test( std::size_t level, int minX, int minY, int maxX, int maxY, float nearest ) const noexcept;
+    };
+}
+
+#endif // GLENGINE_OCCLUSION_HPP
@@ -0,0 +1,142 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLENGINE_PARALLEL_HPP
+#define GLENGINE_PARALLEL_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace gl_engine::utility {
+    /**
+     * @brief Valeur demandant d’utiliser autant de threads que de cœurs disponibles.
+     */
+    inline constexpr unsigned AUTOMATIC_THREAD_COUNT = 0;
+
+    /**
+     * @brief Retourne le nombre de threads matériels, au moins 1.
+     *
+     * @exceptsafe NO-THROW.
+     *
+     * @version 1.0
+     * @since 0.1
+     */
+    [[nodiscard]] unsigned hardwareThreadCount() noexcept;
+
+    /**
+     * @brief Convertit un nombre de threads demandé en nombre effectif.
+     * @param threadCount Le nombre demandé, gl_engine::utility::AUTOMATIC_THREAD_COUNT pour tous les cœurs.
+     * @return Un nombre de threads, au moins 1.
+     *
+     * @exceptsafe NO-THROW.
+     */
+    [[nodiscard]] unsigned resolveThreadCount( unsigned threadCount ) noexcept;
+
+    /**
+     * @brief Exécute task( i ) pour tout i dans [0, taskCount[, réparti sur threadCount threads.
+     * @param taskCount Le nombre de tâches.
+     * @param threadCount Le nombre de threads, le thread appelant en fait partie.
+     * @param task La tâche, appelée une seule fois par indice.
+     *
+     * @throws Relance la première exception lancée par une tâche, une fois tous les threads terminés.
+     * @exceptsafe BASE. Les tâches déjà exécutées ne sont pas annulées.
+     *
+     * @version 1.1
+     * @since 0.1
+     *
+     * @note Les tâches sont distribuées dynamiquement, l’ordre d’exécution n’est pas garanti.
+     * @note Avec un seul thread ou une seule tâche, tout est exécuté sur le thread appelant.
+     * @note Aucun thread n’est créé par appel : le thread appelant est aidé par un pool de hardwareThreadCount() - 1
+     * threads, créé au premier appel et partagé par tous les appels, même simultanés ou imbriqués.
+     * threadCount est donc plafonné au nombre de cœurs.
+     */
+    void parallelFor( std::size_t taskCount, unsigned threadCount, const std::function<void( std::size_t )>& task );
+
+    /**
+     * @brief Tâche lancée par gl_engine::utility::runAsync, exécutée par un thread du pool de parallelFor.
+     *
+     * Comme un std::future de std::async, la destruction attend la fin de la tâche.
+     *
+     * @version 1.0
+     * @since 0.1
+     */
+    class AsyncTask final {
+    public:
+        AsyncTask() noexcept = default;
+        AsyncTask( const AsyncTask& ) noexcept = delete;
+        AsyncTask( AsyncTask&& ) noexcept = default;
+        AsyncTask& operator=( const AsyncTask& ) noexcept = delete;
+
+        /**
+         * @brief Attend la tâche en cours, en ignorant son exception, puis prend celle de other.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        AsyncTask& operator=( AsyncTask&& other ) noexcept;
+
+        /**
+         * @brief Attend la fin de la tâche, son exception éventuelle est ignorée.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        ~AsyncTask() noexcept;
+
+        /**
+         * @brief Indique si une tâche est associée et pas encore attendue par wait().
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] bool valid() const noexcept;
+
+        /**
+         * @brief Attend la fin de la tâche. Si aucun thread du pool ne l’a commencée, elle est exécutée par le thread appelant.
+         *
+         * @throws Relance l’exception lancée par la tâche.
+         * @exceptsafe BASE. La tâche n’est plus associée, même si elle a lancé une exception.
+         *
+         * @note valid() doit être vrai.
+         */
+        void wait();
+
+    private:
+        friend AsyncTask runAsync( std::function<void()> task );
+
+        class State;
+
+        std::shared_ptr<State> state_ = nullptr;
+
+        explicit AsyncTask( std::shared_ptr<State> state ) noexcept;
+    };
+
+    /**
+     * @brief Lance task sur un thread du pool de gl_engine::utility::parallelFor, sans créer de thread.
+     * @param task La tâche. Elle peut elle-même appeler parallelFor, les threads du pool sont alors partagés entre les deux.
+     * @return La tâche lancée, à attendre par AsyncTask::wait().
+     *
+     * @throws std::bad_alloc Si la tâche ne peut pas être allouée.
+     * @exceptsafe STRONG.
+     *
+     * @version 1.0
+     * @since 0.1
+     *
+     * @note Sans thread libre dans le pool, la tâche est exécutée par AsyncTask::wait() sur le thread appelant.
+     */
+    [[nodiscard]] AsyncTask runAsync( std::function<void()> task );
+}
+
+#endif // GLENGINE_PARALLEL_HPP
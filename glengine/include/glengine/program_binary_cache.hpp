@@ -0,0 +1,164 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef GLENGINE_PROGRAM_BINARY_CACHE_HPP
+#define GLENGINE_PROGRAM_BINARY_CACHE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <initializer_list>
+#include <string_view>
+#include <vector>
+
+#include <glengine/utility.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Cache disque des programmes liés : le binaire rendu par glGetProgramBinary est relu par glProgramBinary
+     * aux démarrages suivants, sans compilation ni édition des liens.
+     *
+     * Un binaire n’est valable que pour les mêmes sources et le même pilote : la clé d’un programme est l’empreinte des
+     * sources de tous ses étages et des chaines GL_VENDOR, GL_RENDERER, GL_VERSION et GL_SHADING_LANGUAGE_VERSION.
+     * Chaque programme est un fichier '.glprog' du dossier du cache, nommé d’après sa clé, contenant un en-tête
+     * versionné et le binaire. Un fichier absent, corrompu, d’un autre format ou refusé par le pilote (mise à jour,
+     * changement de carte graphique) est simplement ignoré : le programme est compilé puis le fichier réécrit.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::ShaderProgram
+     * @see gl_engine::MeshCache
+     */
+    class ProgramBinaryCache final {
+    public:
+        /**
+         * @brief Version du format, à incrémenter à chaque modification de la disposition du fichier.
+         */
+        static constexpr std::uint32_t VERSION = 1;
+
+        /**
+         * @brief Extension des fichiers du cache.
+         */
+        static constexpr std::string_view EXTENSION = ".glprog";
+
+        /**
+         * @brief Construit un cache rangeant ses fichiers dans directory, créé à la première écriture.
+         * @param directory Le dossier du cache.
+         *
+         * @pre Un contexte OpenGL doit être courant sur le thread appelant : le pilote est identifié à la construction.
+         * @exceptsafe FORT.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        explicit ProgramBinaryCache( std::filesystem::path directory );
+
+        ProgramBinaryCache() noexcept = delete;
+        ProgramBinaryCache( const ProgramBinaryCache& ) = default;
+        ProgramBinaryCache( ProgramBinaryCache&& ) noexcept = default;
+        ProgramBinaryCache& operator=( const ProgramBinaryCache& ) = default;
+        ProgramBinaryCache& operator=( ProgramBinaryCache&& ) noexcept = default;
+        ~ProgramBinaryCache() noexcept = default;
+
+        /**
+         * @brief Indique si le contexte fournit des binaires de programme, sinon le cache ne lit ni n’écrit rien.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @note Il faut OpenGL 4.1 et au moins un format de binaire (GL_NUM_PROGRAM_BINARY_FORMATS).
+         */
+        [[nodiscard]] bool enabled() const noexcept {
+            return !formats_.empty();
+        }
+
+        [[nodiscard]] const std::filesystem::path& directory() const noexcept {
+            return directory_;
+        }
+
+        /**
+         * @brief Retourne la clé d’un programme.
+         * @param sources Les sources de chaque étage, dans l’ordre du pipeline.
+         * @return L’empreinte des sources et du pilote.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @note Les #define font partie des sources : deux variantes d’un même shader ont deux clés.
+         */
+        [[nodiscard]] std::uint64_t key( std::initializer_list<std::string_view> sources ) const noexcept;
+
+        /**
+         * @brief Retourne le chemin du fichier associé à la clé.
+         *
+         * @exceptsafe FORT. Ne modifie aucune donnée.
+         */
+        [[nodiscard]] std::filesystem::path cachePath( std::uint64_t key ) const;
+
+        /**
+         * @brief Charge le binaire associé à la clé dans le programme.
+         * @param program Le programme, sans liens édités.
+         * @param key La clé, voir key().
+         * @return true si le programme est lié et utilisable, false si le cache est absent ou refusé.
+         *
+         * @pre Un contexte OpenGL doit être courant sur le thread appelant.
+         * @exceptsafe FORT. En cas d’échec le programme reste sans liens édités, il peut être compilé normalement.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        [[nodiscard]] bool load( Id program, std::uint64_t key ) const;
+
+        /**
+         * @brief Écrit le binaire du programme associé à la clé.
+         * @param program Le programme, lié après prepare().
+         * @param key La clé, voir key().
+         *
+         * @pre Un contexte OpenGL doit être courant sur le thread appelant.
+         * @throws gl_engine::utility::ErrorWritingFile Lancée si le fichier ne peut pas être écrit.
+         *
+         * @exceptsafe FORT. Le fichier est écrit dans un fichier temporaire puis renommé,
+         * un fichier existant n’est jamais laissé à moitié écrit.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note Ne fait rien si le cache est désactivé ou si le pilote ne fournit pas de binaire.
+         */
+        void store( Id program, std::uint64_t key ) const;
+
+        /**
+         * @brief Demande au pilote de garder le binaire du programme, à appeler avant l’édition des liens.
+         * @param program Le programme.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        void prepare( Id program ) const noexcept;
+
+    private:
+        std::filesystem::path directory_;
+
+        /// Empreinte des chaines identifiant le pilote.
+        std::uint64_t driver_ = 0;
+
+        /// Formats de binaire acceptés par le pilote, vide si le cache est désactivé.
+        std::vector<std::uint32_t> formats_{};
+    };
+}
+
+#endif // GLENGINE_PROGRAM_BINARY_CACHE_HPP
@@ -0,0 +1,432 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLENGINE_RENDER_QUEUE_HPP
+#define GLENGINE_RENDER_QUEUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <glengine/material.hpp>
+#include <glengine/streaming_buffer.hpp>
+#include <glengine/uniform_block.hpp>
+#include <glengine/utility.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Passe de rendu d’un élément, les passes sont dessinées dans l’ordre de l’énumération.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::DrawKey
+     */
+    enum class RenderPass : std::uint8_t {
+        /// Surfaces opaques, triées par état puis de l’avant vers l’arrière.
+        SOLID,
+        /// Surfaces découpées par une texture d’opacité, triées comme SOLID.
+        CUTOUT,
+        /// Surfaces transparentes, mélangées et triées de l’arrière vers l’avant.
+        BLENDED,
+        /// Interface et repères dessinés par-dessus la scène, triés comme BLENDED.
+        OVERLAY
+    };
+
+    /**
+     * @brief Point de vue d’une image.
+     *
+     * @version 1.1
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct RenderView {
+        glm::mat4 view{1.0f};
+        glm::mat4 projection{1.0f};
+        /// Position de l’œil dans le monde, sert au tri en profondeur.
+        glm::vec3 eye{};
+        /// Temps écoulé en secondes, envoyé au bloc d’uniformes 'Frame'.
+        float time = 0.0f;
+    };
+
+    /**
+     * @brief Élément de dessin soumis à gl_engine::RenderQueue : une plage d’indices, son programme et son matériau.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::Object::submit
+     */
+    struct DrawItem {
+        RenderPass pass = RenderPass::SOLID;
+        Id program = 0;
+        Id vertexArray = 0;
+        /// Matériau de la plage, nullptr pour n’en lier aucun. Doit rester valide jusqu’à la fin de l’image.
+        const Material* material = nullptr;
+
+        /// GL_UNSIGNED_SHORT ou GL_UNSIGNED_INT.
+        GLenum indexType = GL_UNSIGNED_INT;
+        /// Décalage du premier indice dans le EBO, en octets.
+        std::size_t indexOffset = 0;
+        std::uint32_t indexCount = 0;
+        /// Ajouté à chaque indice, non nul pour un maillage rangé dans un gl_engine::MeshPool.
+        std::int32_t baseVertex = 0;
+
+        /// Matrice envoyée à l’uniforme 'model', ou à l’attribut 'instanceModel' d’un programme instancié.
+        glm::mat4 model{1.0f};
+        /// Couleur envoyée à l’uniforme 'color' s’il existe, ou à l’attribut 'instanceColor' d’un programme instancié.
+        glm::vec4 color{1.0f};
+        /// Distance à l’œil, positive.
+        float depth = 0.0f;
+
+        /// Envoyés aux uniformes de décodage des positions quantifiées, si le programme les déclare.
+        /// Propres au VAO : voir gl_engine::VertexFormat::positionOffset et gl_engine::VertexFormat::positionScale.
+        glm::vec3 positionOffset{0.0f};
+        glm::vec3 positionScale{1.0f};
+    };
+
+    /**
+     * @brief Commande de dessin lue par glMultiDrawElementsIndirect, disposition imposée par OpenGL.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct DrawElementsIndirectCommand {
+        std::uint32_t count = 0;
+        std::uint32_t instanceCount = 0;
+        std::uint32_t firstIndex = 0;
+        std::int32_t baseVertex = 0;
+        /// Première instance lue par les attributs de diviseur non nul.
+        std::uint32_t baseInstance = 0;
+    };
+
+    static_assert( sizeof( DrawElementsIndirectCommand ) == 20, "Disposition de DrawElementsIndirectCommand imposée par OpenGL." );
+
+    /**
+     * @brief Compteurs d’une image, voir gl_engine::RenderQueue::statistics.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct RenderStatistics {
+        /// Appels de dessin, un dessin instancié compte pour un.
+        std::size_t drawCount = 0;
+        /// Appels glDrawElementsInstanced.
+        std::size_t instancedDrawCount = 0;
+        /// Éléments dessinés par ces appels et par les commandes indirectes.
+        std::size_t instanceCount = 0;
+        /// Appels glMultiDrawElementsIndirect.
+        std::size_t multiDrawCount = 0;
+        /// Commandes exécutées par ces appels.
+        std::size_t commandCount = 0;
+        std::size_t passChanges = 0;
+        std::size_t programChanges = 0;
+        std::size_t vertexArrayChanges = 0;
+        std::size_t materialChanges = 0;
+        /// Textures réellement liées : une unité déjà liée à la même texture est ignorée.
+        std::size_t textureBinds = 0;
+        /// Blocs d’uniformes partagés envoyés au pilote : 'Frame' à chaque image, 'Camera' si le point de vue a changé.
+        std::size_t uniformBlockUpdates = 0;
+        /// Durée du tri des clés, en millisecondes.
+        double sortMilliseconds = 0.0;
+    };
+
+    /**
+     * @brief Construction des clés de tri 64 bits des éléments de dessin.
+     *
+     * De l’octet de poids fort au poids faible :
+     * - passes SOLID et CUTOUT : passe (2 bits), programme (12 bits), matériau (14 bits), VAO (12 bits),
+     * profondeur croissante (24 bits) : les changements d’état coûteux sont regroupés, puis l’avant est dessiné d’abord ;
+     * - passes BLENDED et OVERLAY : passe (2 bits), profondeur décroissante (24 bits), programme, matériau et VAO :
+     * l’ordre de l’arrière vers l’avant est imposé par le mélange.
+     *
+     * Programmes, matériaux et VAO sont désignés par de petits numéros attribués par gl_engine::RenderQueue.
+     * La profondeur est codée par les 24 bits de poids fort de son écriture flottante, croissante pour un flottant positif :
+     * aucun intervalle de profondeur n’est à fournir.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::RenderQueue
+     */
+    class DrawKey final {
+    public:
+        // Note développeur : Classe purement statique, comme gl_engine::ObjectFactory.
+
+        DrawKey() noexcept = delete;
+        DrawKey( const DrawKey& ) noexcept = delete;
+        DrawKey( DrawKey&& ) noexcept = delete;
+        DrawKey& operator=( const DrawKey& ) noexcept = delete;
+        DrawKey& operator=( DrawKey&& ) noexcept = delete;
+        ~DrawKey() noexcept = delete;
+
+        static constexpr unsigned PASS_BITS = 2;
+        static constexpr unsigned PROGRAM_BITS = 12;
+        static constexpr unsigned MATERIAL_BITS = 14;
+        static constexpr unsigned VERTEX_ARRAY_BITS = 12;
+        static constexpr unsigned DEPTH_BITS = 24;
+
+        static_assert( PASS_BITS + PROGRAM_BITS + MATERIAL_BITS + VERTEX_ARRAY_BITS + DEPTH_BITS == 64, "La clé occupe exactement 64 bits." );
+
+        /**
+         * @brief Construit la clé d’un élément.
+         * @param pass La passe de l’élément.
+         * @param program Le numéro du programme, tronqué à PROGRAM_BITS bits.
+         * @param material Le numéro du matériau, tronqué à MATERIAL_BITS bits.
+         * @param vertexArray Le numéro du VAO, tronqué à VERTEX_ARRAY_BITS bits.
+         * @param depth La distance à l’œil, une valeur négative compte pour 0.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @note Deux numéros tronqués identiques ne font que rapprocher deux éléments : le rendu reste correct.
+         */
+        [[nodiscard]] static std::uint64_t make( RenderPass pass, std::uint32_t program, std::uint32_t material,
+                                                 std::uint32_t vertexArray, float depth ) noexcept;
+
+        /**
+         * @brief Retourne la passe codée dans la clé.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] static RenderPass pass( std::uint64_t key ) noexcept {
+            return static_cast<RenderPass>(key >> ( 64 - PASS_BITS ));
+        }
+    };
+
+    /**
+     * @brief File des éléments de dessin d’une image, triée puis rejouée avec le moins de changements d’état possible.
+     *
+     * Chaque image : clear(), puis submit() pour chaque élément (voir gl_engine::Object::submit), sort() et execute().
+     * Le tri est un tri par base sur les clés 64 bits (8 passes de 8 bits au plus, les octets identiques pour toutes
+     * les clés sont sautés), en temps linéaire et sans allocation une fois la capacité atteinte.
+     *
+     * Lors du rejeu, un programme, un VAO, un matériau ou une texture n’est lié que s’il diffère du précédent.
+     * Les blocs d’uniformes gl_engine::FrameBlock et gl_engine::CameraBlock sont écrits une fois par image dans deux
+     * gl_engine::UniformBuffer liés à leurs points de liaison : un programme les déclarant les lit sans aucun appel,
+     * changer de caméra est une seule mise à jour quel que soit le nombre de programmes. Pour les autres programmes,
+     * les uniformes 'view' et 'projection' sont envoyés à leur première utilisation dans l’image.
+     * L’uniforme 'model' est envoyé à chaque élément. Les textures d’un matériau sont liées à l’unité de leur gl_engine::TextureSlot.
+     *
+     * Un programme déclarant l’attribut 'instanceModel' à l’emplacement INSTANCE_MODEL_LOCATION est instancié :
+     * les éléments consécutifs de la file partageant son VAO, son matériau et sa plage d’indices (les copies d’un même
+     * gl_engine::Model par exemple, que le tri rend voisines) sont dessinés par un seul glDrawElementsInstanced.
+     * Leurs matrices et couleurs sont copiées dans un VBO d’instances, lu avec un diviseur de 1 :
+     * @code
+     * layout (location = 3) in mat4 instanceModel;
+     * layout (location = 7) in vec4 instanceColor;
+     * @endcode
+     *
+     * Les éléments consécutifs d’un programme instancié partageant un VAO et un matériau mais pas leur plage d’indices
+     * (des maillages distincts d’un gl_engine::MeshPool) sont décrits par un tableau de gl_engine::DrawElementsIndirectCommand
+     * et dessinés par un seul glMultiDrawElementsIndirect sur un contexte OpenGL 4.3. Chaque commande lit ses données
+     * par élément à partir de son baseInstance, sans gl_DrawID. Sur un contexte plus ancien, les commandes sont dessinées
+     * une à une par glDrawElementsInstancedBaseVertex, toujours sans changer de VAO.
+     * Instances et commandes sont écrites dans un gl_engine::StreamingBuffer, sans copie ni attente du pilote.
+     *
+     * @version 1.3
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::DrawKey
+     * @see gl_engine::Scene::render
+     */
+    class RenderQueue final {
+    public:
+        /// Emplacement de la première colonne de la matrice d’instance, les trois suivantes occupent les emplacements voisins.
+        static constexpr GLuint INSTANCE_MODEL_LOCATION = 3;
+        static constexpr GLuint INSTANCE_COLOR_LOCATION = 7;
+
+        RenderQueue() noexcept = default;
+
+        // Note développeur : Les tables de numéros sont propres à une file, une copie n’aurait pas de sens.
+        RenderQueue( const RenderQueue& ) noexcept = delete;
+        RenderQueue( RenderQueue&& ) noexcept = default;
+        RenderQueue& operator=( const RenderQueue& ) noexcept = delete;
+        RenderQueue& operator=( RenderQueue&& ) noexcept = default;
+        ~RenderQueue() noexcept = default;
+
+        /**
+         * @brief Vide la file pour une nouvelle image, la mémoire est conservée.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        void clear() noexcept;
+
+        /**
+         * @brief Ajoute un élément à l’image et calcule sa clé.
+         * @param item L’élément.
+         *
+         * @exceptsafe FORT.
+         */
+        void submit( const DrawItem& item );
+
+        /**
+         * @brief Trie les éléments par clé croissante.
+         *
+         * @exceptsafe FORT.
+         *
+         * @note Le tri est stable : deux éléments de même clé restent dans l’ordre de soumission.
+         */
+        void sort();
+
+        /**
+         * @brief Dessine les éléments dans l’ordre de la file.
+         * @param view Le point de vue de l’image.
+         *
+         * @pre Un contexte OpenGL doit être courant sur le thread appelant, la file doit être triée.
+         * @post Le mélange est désactivé, l’écriture de profondeur activée et aucun VAO n’est lié.
+         *
+         * @throws gl_engine::UniformBlockMismatch Lancée si un programme déclare un bloc 'Frame' ou 'Camera'
+         * dont la disposition diffère de gl_engine::FrameBlock ou gl_engine::CameraBlock.
+         *
+         * @version 1.3
+         * @since 0.1
+         */
+        void execute( const RenderView& view );
+
+        /**
+         * @brief Retourne le nombre d’éléments de l’image.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] std::size_t size() const noexcept {
+            return items_.size();
+        }
+
+        /**
+         * @brief Retourne l’élément numéro i dans l’ordre de la file, trié après sort().
+         *
+         * @pre i doit être inférieur à size().
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] const DrawItem& item( const std::size_t i ) const noexcept {
+            return items_[entries_[i].item];
+        }
+
+        /**
+         * @brief Retourne la clé de l’élément numéro i dans l’ordre de la file.
+         *
+         * @pre i doit être inférieur à size().
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] std::uint64_t key( const std::size_t i ) const noexcept {
+            return entries_[i].key;
+        }
+
+        /**
+         * @brief Retourne les compteurs de l’image en cours : durée du tri et changements d’état du dernier rejeu.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] const RenderStatistics& statistics() const noexcept {
+            return statistics_;
+        }
+
+    private:
+        struct Entry {
+            std::uint64_t key = 0;
+            std::uint32_t item = 0;
+        };
+
+        /// Numéro d’un programme et emplacements de ses uniformes, lus à sa première utilisation.
+        struct ProgramSlot {
+            std::uint32_t number = 0;
+            bool resolved = false;
+            /// Le programme lit 'instanceModel' à INSTANCE_MODEL_LOCATION.
+            bool instanced = false;
+            /// Le programme déclare le bloc 'Camera' : 'view' et 'projection' ne lui sont pas envoyés.
+            bool cameraBlock = false;
+            GLint model = -1;
+            GLint view = -1;
+            GLint projection = -1;
+            GLint color = -1;
+            /// Uniformes de gl_engine::VertexFormat::glslDecoder, absents sans positions quantifiées.
+            GLint positionOffset = -1;
+            GLint positionScale = -1;
+            /// Dernière image où 'view' et 'projection' ont été envoyés.
+            std::uint64_t frame = 0;
+        };
+
+        /// Attributs d’une instance dans le VBO d’instances.
+        struct Instance {
+            glm::mat4 model{1.0f};
+            glm::vec4 color{1.0f};
+        };
+
+        static_assert( sizeof( Instance ) == 80, "Les attributs d’instance sont contigus." );
+
+        /// Éléments consécutifs de la file dessinés ensemble.
+        struct Batch {
+            std::uint32_t first = 0;
+            std::uint32_t count = 0;
+            /// Première instance dans le VBO d’instances, NO_INSTANCE pour un dessin non instancié.
+            std::uint32_t instance = 0;
+            /// Première commande dans commands_ et nombre de commandes, une par plage d’indices distincte.
+            std::uint32_t command = 0;
+            std::uint32_t commandCount = 0;
+        };
+
+        static constexpr auto NO_INSTANCE = static_cast<std::uint32_t>(-1);
+
+        std::vector<DrawItem> items_{};
+        std::vector<Entry> entries_{};
+        std::vector<Entry> scratch_{};
+
+        std::vector<Batch> batches_{};
+        std::vector<Instance> instances_{};
+        std::vector<DrawElementsIndirectCommand> commands_{};
+
+        /// Instances et commandes de l’image, recréé plus grand si une image ne tient plus dans une région.
+        std::optional<StreamingBuffer> stream_{};
+        std::size_t instanceOffset_ = 0;
+        std::size_t commandOffset_ = 0;
+
+        /// Blocs d’uniformes partagés, créés à la première image.
+        std::optional<UniformBuffer> frameBlock_{};
+        std::optional<UniformBuffer> cameraBlock_{};
+        float previousTime_ = 0.0f;
+
+        std::unordered_map<Id, ProgramSlot> programs_{};
+        /// Valeur de open_gl::programDeletions lors de la résolution des emplacements de programs_.
+        std::uint64_t programDeletions_ = 0;
+        std::unordered_map<const Material*, std::uint32_t> materials_{};
+        std::unordered_map<Id, std::uint32_t> vertexArrays_{};
+        /// Dernière image où les attributs d’instance ont été activés dans chaque VAO.
+        std::unordered_map<Id, std::uint64_t> instancedVertexArrays_{};
+
+        RenderStatistics statistics_{};
+        std::uint64_t frame_ = 1;
+
+        ProgramSlot& programSlot( Id program );
+        ProgramSlot& resolvedProgramSlot( Id program );
+        void batch();
+        void upload();
+        void bindInstances( Id vertexArray, std::uint32_t instance );
+        void updateBlocks( const RenderView& view );
+    };
+}
+
+#endif // GLENGINE_RENDER_QUEUE_HPP
@@ -18,7 +18,10 @@
 #ifndef GLENGINE_RENDERER_HPP
 #define GLENGINE_RENDERER_HPP
 
+#include <functional>
 #include <optional>
+#include <utility>
+
 #include <glengine/exception.hpp>
 #include <glengine/shaderProgram.hpp>
 
@@ -72,6 +75,14 @@ namespace gl_engine {
          */
         void addMethod( std::function<void()> renderer );
 
+        /**
+         * @brief Utilise le programme, s’il y en a un, puis appelle la méthode de rendu, s’il y en a une.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        void render() const;
+
     private:
         std::optional<ShaderProgram> program_{std::nullopt};
 
@@ -114,10 +125,10 @@ namespace gl_engine {
         };
     };
 
-    Renderer::Renderer( ShaderProgram program, std::function<void()> renderer )
+    inline Renderer::Renderer( ShaderProgram program, std::function<void()> renderer )
     : program_(std::move(program)), renderer_(std::move(renderer)) {}
 
-    Renderer::Renderer( ShaderProgram program )
+    inline Renderer::Renderer( ShaderProgram program )
     : Renderer(std::move(program), nullptr ) {}
 
     inline void Renderer::addProgram( ShaderProgram program ) {
@@ -126,14 +137,10 @@ namespace gl_engine {
                                         "Veuillez le supprimer et réessayer.");
         }
 
-        program_ = program;
+        program_ = std::move(program);
     }
     inline std::optional<ShaderProgram> Renderer::removeProgram() noexcept {
-        auto returnValue = program_;
-
-        program_.reset();
-
-        return returnValue;
+        return std::exchange(program_, std::nullopt);
     }
     inline void Renderer::swapProgram( ShaderProgram& program ) noexcept {
         std::swap(program, program_.value());
@@ -143,6 +150,15 @@ namespace gl_engine {
         renderer_ = std::move(renderer);
     }
 
+    inline void Renderer::render() const {
+        if ( program_.has_value() ) {
+            program_->use();
+        }
+        if ( renderer_ ) {
+            renderer_();
+        }
+    }
+
 }
 
 #endif // GLENGINE_RENDERER_HPP
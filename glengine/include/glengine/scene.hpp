@@ -18,17 +18,32 @@
 #ifndef SCENE_HPP
 #define SCENE_HPP
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
+#include <glengine/bvh.hpp>
+#include <glengine/culling.hpp>
 #include <glengine/exception.hpp>
+#include <glengine/model.hpp>
 #include <glengine/object.hpp>
+#include <glengine/occlusion.hpp>
+#include <glengine/parallel.hpp>
+#include <glengine/render_queue.hpp>
 #include <glengine/renderer.hpp>
+#include <glengine/transform_hierarchy.hpp>
 
 namespace gl_engine {
     /**
      * @brief Classe représentant une scène contenant des objects
      *
-     * @version 1.0
+     * @version 1.3
      * @since 0.1
      * @author Axel DAVID
      */
@@ -63,33 +78,68 @@ namespace gl_engine {
          *
          * @exceptsafe NO-THROW.
          *
-         * @version 1.0
+         * @version 1.1
          * @since 0.1
+         *
+         * @note Les objets sont partagés : un même objet peut appartenir à plusieurs scènes.
          */
-        explicit Scene( std::vector<Object> objects ) noexcept;
+        explicit Scene( std::vector<std::shared_ptr<const Object>> objects ) noexcept;
 
         /**
          * @brief Construit une scène avec le tableau d’objets fourni ainsi qu’avec la méthode de rendu.
          * @param objects Le tableau d’objets.
          * @param renderer La méthode de rendu.
          */
-        explicit Scene( std::vector<Object> objects, Renderer renderer ) noexcept;
+        explicit Scene( std::vector<std::shared_ptr<const Object>> objects, Renderer renderer ) noexcept;
 
         /**
          * @brief Demande le rendu de la scène.
          *
+         * Les matrices monde du graphe de scène (voir gl_engine::Scene::transforms) sont d’abord mises à jour, et
+         * recopiées dans les modèles attachés dont le nœud a changé.
+         * Les boites des objets (voir gl_engine::Object::bounds) sont rangées dans une gl_engine::Bvh : seuls les
+         * sous-arbres contenant un objet déplacé depuis l’image précédente sont mis à jour, l’arbre est reconstruit si des
+         * objets ont été ajoutés ou retirés, ou si les déplacements ont trop dégradé son coût SAH. Le volume de vue est
+         * ensuite testé contre la hiérarchie. Les objets sans volume sont toujours dessinés.
+         * Si des objets sont des occultants (voir gl_engine::Object::occluder), ils sont rastérisés dans un
+         * gl_engine::OcclusionBuffer par le pool de threads de gl_engine::utility::parallelFor pendant ces mises à jour,
+         * et les objets dans le champ sont ensuite testés contre sa hiérarchie de profondeurs : les objets cachés ne
+         * sont pas soumis.
+         * Chaque objet visible soumet ses éléments de dessin à la file de la scène, la file est triée puis rejouée
+         * avec le moins de changements d’état possible. La méthode de rendu, si elle existe, est appelée ensuite.
+         * Les objets partageant maillage, matériau et programme instancié sont regroupés en un seul dessin instancié.
+         *
+         * @pre Un contexte OpenGL doit être courant sur le thread appelant.
+         * @exceptsafe BASE. Une image interrompue laisse la scène utilisable pour la suivante.
+         *
+         * @version 1.6
+         * @since 0.1
+         *
+         * @see gl_engine::RenderQueue
+         * @see gl_engine::Scene::statistics
+         */
+        void render();
+
+        /**
+         * @brief Retourne l’objet dont la boite est touchée en premier par le rayon.
+         * @param ray Le rayon, dans le monde.
+         * @return L’objet, nullptr si aucune boite n’est touchée.
+         *
          * @exceptsafe NO-THROW.
          *
          * @version 1.0
          * @since 0.1
+         *
+         * @note Utilise les boites du dernier rendu. Le test porte sur les boites, pas sur les triangles :
+         * c’est une première sélection pour un test précis.
          */
-        void render() const noexcept;
+        [[nodiscard]] std::shared_ptr<const Object> raycast( const Ray& ray ) const noexcept;
 
         /**
          * @brief Ajoute un objet à la scène.
          * @param object L'objet a ajouter.
          */
-        void add( Object object );
+        void add( std::shared_ptr<const Object> object );
 
         /**
          * @brief Supprime l’objet fourni en paramètre.
@@ -99,7 +149,7 @@ namespace gl_engine {
          *
          * @note Ne fait rien si l’objet n’est pas présent.
          */
-        void remove( Object object ) noexcept;
+        void remove( const std::shared_ptr<const Object>& object ) noexcept;
 
         /**
          * @brief Supprime tous les objets de la scène.
@@ -111,6 +161,90 @@ namespace gl_engine {
          */
         void clear() noexcept;
 
+        /**
+         * @brief Retourne le graphe de scène : les nœuds y sont créés et animés, voir gl_engine::Scene::attach.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        [[nodiscard]] TransformHierarchy& transforms() noexcept;
+
+        /**
+         * @overload
+         */
+        [[nodiscard]] const TransformHierarchy& transforms() const noexcept;
+
+        /**
+         * @brief Place le modèle au nœud fourni : sa matrice suit la matrice monde du nœud à chaque rendu.
+         * @param model Le modèle, qui doit aussi être ajouté à la scène pour être dessiné.
+         * @param node Le nœud du graphe de scène.
+         *
+         * @throws gl_engine::TransformHierarchy::UnknownNode Lancée si node n’appartient pas au graphe de la scène.
+         * @exceptsafe FORT.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note Seuls les modèles dont le nœud a changé sont modifiés : une scène immobile ne coûte rien.
+         * @note Plusieurs modèles peuvent être attachés au même nœud.
+         */
+        void attach( std::shared_ptr<Model> model, TransformHierarchy::Node node );
+
+        /**
+         * @brief Détache le modèle de son nœud, sa matrice n’est plus modifiée par la scène.
+         * @param model Le modèle.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @note Ne fait rien si le modèle n’est pas attaché.
+         */
+        void detach( const std::shared_ptr<Model>& model ) noexcept;
+
+        /**
+         * @brief Change le point de vue des prochains rendus.
+         * @param view Les matrices de vue et de projection, la position de l’œil et le temps écoulé.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @version 1.1
+         * @since 0.1
+         */
+        void setView( const RenderView& view ) noexcept;
+
+        /**
+         * @brief Retourne la durée du tri et les changements d’état du dernier rendu.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @version 1.1
+         * @since 0.1
+         */
+        [[nodiscard]] const RenderStatistics& statistics() const noexcept;
+
+        /**
+         * @brief Retourne le nombre d’objets testés et visibles lors du dernier rendu, et la durée du test.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @note La durée comprend la mise à jour ou la reconstruction de la hiérarchie, et l’attente des occultants.
+         *
+         * @version 1.2
+         * @since 0.1
+         */
+        [[nodiscard]] const CullStatistics& cullStatistics() const noexcept;
+
+        /**
+         * @brief Retourne le tampon de profondeur des occultants du dernier rendu, pour le déboguer.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        [[nodiscard]] const OcclusionBuffer& occlusionBuffer() const noexcept;
+
         /**
          * @brief Ajoute l’objet de rendu gl_engine::Renderer à la scène, pour pouvoir la rendre.
          * @param renderer La function de rendu.
@@ -138,10 +272,34 @@ namespace gl_engine {
         std::optional<Renderer> removeRenderer() noexcept;
 
     private:
-        std::vector<Object> objects_{};
+        std::vector<std::shared_ptr<const Object>> objects_{};
 
         std::optional<Renderer> renderer_{std::nullopt};
 
+        TransformHierarchy transforms_{};
+        std::vector<std::pair<std::shared_ptr<Model>, TransformHierarchy::Node>> attachments_{};
+
+        RenderQueue queue_{};
+        RenderView view_{};
+
+        /// Au-delà de ce rapport entre le coût SAH de l’arbre mis à jour et celui de sa construction, il est reconstruit.
+        static constexpr float REBUILD_COST_RATIO = 1.5f;
+
+        Bvh hierarchy_{};
+        float builtCost_ = 0.0f;
+
+        /// Boites des objets ayant un volume, éléments de hierarchy_, et l’indice de l’objet de chacune.
+        std::vector<Bounds> boxes_{};
+        std::vector<std::uint32_t> boundedObjects_{};
+        std::vector<std::uint32_t> unboundedObjects_{};
+        std::vector<std::uint32_t> moved_{};
+
+        std::vector<std::uint32_t> visible_{};
+        CullStatistics cullStatistics_{};
+
+        std::vector<Occluder> occluders_{};
+        OcclusionBuffer occlusion_{};
+
         /**
          * @brief Exception lancée si la fonction de rendu existe déjà dans la scène actuelle.
          *
@@ -183,26 +341,182 @@ namespace gl_engine {
         };
     };
 
-    Scene::Scene( Renderer renderer ) noexcept
-    : renderer_(renderer) {}
+    inline Scene::Scene( Renderer renderer ) noexcept
+    : renderer_(std::move(renderer)) {}
 
-    Scene::Scene( std::vector<Object> objects ) noexcept
+    inline Scene::Scene( std::vector<std::shared_ptr<const Object>> objects ) noexcept
     : objects_(std::move(objects)) {}
 
-    Scene::Scene( std::vector<Object> objects, Renderer renderer ) noexcept
-    : objects_(std::move(objects)), renderer_(renderer) {}
+    inline Scene::Scene( std::vector<std::shared_ptr<const Object>> objects, Renderer renderer ) noexcept
+    : objects_(std::move(objects)), renderer_(std::move(renderer)) {}
 
 
-    inline void Scene::add( Object object ) {
-        objects_.push_back(std::move(object));
+    inline void Scene::render() {
+        queue_.clear();
+
+        if ( transforms_.update( utility::AUTOMATIC_THREAD_COUNT ) > 0 ) {
+            for ( const auto& [model, node] : attachments_ ) {
+                if ( transforms_.changed( node ) ) {
+                    model->setTransform( transforms_.world( node ) );
+                }
+            }
+        }
+
+        // Les objets peuvent avoir bougé depuis l’image précédente : leurs boites sont relues à chaque image,
+        // comparées à celles de l’arbre pour ne mettre à jour que ce qui a changé.
+        auto rebuild = false;
+        std::size_t bounded = 0;
+
+        moved_.clear();
+        unboundedObjects_.clear();
+        occluders_.clear();
+        for ( std::size_t i = 0; i < objects_.size(); ++i ) {
+            if ( auto occluder = objects_[i]->occluder() ) {
+                occluders_.push_back( std::move( *occluder ) );
+            }
+
+            const auto volume = objects_[i]->bounds();
+            const auto object = static_cast<std::uint32_t>(i);
+
+            if ( !volume.has_value() ) {
+                unboundedObjects_.push_back( object );
+                continue;
+            }
+
+            if ( bounded == boxes_.size() ) {
+                boxes_.push_back( volume->box );
+                boundedObjects_.push_back( object );
+                rebuild = true;
+            }
+            else {
+                if ( boundedObjects_[bounded] != object ) {
+                    boundedObjects_[bounded] = object;
+                    rebuild = true;
+                }
+                if ( boxes_[bounded].min != volume->box.min || boxes_[bounded].max != volume->box.max ) {
+                    boxes_[bounded] = volume->box;
+                    moved_.push_back( static_cast<std::uint32_t>(bounded) );
+                }
+            }
+
+            ++bounded;
+        }
+
+        if ( bounded != boxes_.size() ) {
+            boxes_.resize( bounded );
+            boundedObjects_.resize( bounded );
+            rebuild = true;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto viewProjection = view_.projection * view_.view;
+
+        // Les occultants sont rastérisés par le pool de threads pendant que le thread appelant met à jour la hiérarchie et la parcourt.
+        // Les deux passes se partagent les mêmes threads, aucun n’est créé par image.
+        // Note développeur : la tâche est attendue à sa destruction, même si une exception est lancée ici.
+        utility::AsyncTask occlusion{};
+        if ( !occluders_.empty() ) {
+            occlusion = utility::runAsync( [this, viewProjection]() {
+                occlusion_.render( occluders_, viewProjection, utility::AUTOMATIC_THREAD_COUNT );
+            } );
+        }
+
+        if ( !rebuild ) {
+            hierarchy_.refit( boxes_, moved_, utility::AUTOMATIC_THREAD_COUNT );
+            rebuild = hierarchy_.cost() > builtCost_ * REBUILD_COST_RATIO;
+        }
+        if ( rebuild ) {
+            hierarchy_.build( boxes_, utility::AUTOMATIC_THREAD_COUNT );
+            builtCost_ = hierarchy_.cost();
+        }
+
+        visible_.clear();
+        hierarchy_.cull( Frustum::fromMatrix( viewProjection ), visible_ );
+
+        std::size_t occluded = 0;
+        if ( occlusion.valid() ) {
+            occlusion.wait();
+
+            const auto hidden = std::remove_if( visible_.begin(), visible_.end(), [this]( const std::uint32_t item ) noexcept {
+                return !occlusion_.visible( boxes_[item] );
+            } );
+            occluded = static_cast<std::size_t>(visible_.end() - hidden);
+            visible_.erase( hidden, visible_.end() );
+        }
+
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        cullStatistics_ = {objects_.size(), visible_.size() + unboundedObjects_.size(), elapsed, occluded};
+
+        for ( const auto item : visible_ ) {
+            objects_[boundedObjects_[item]]->submit( queue_, view_ );
+        }
+        for ( const auto object : unboundedObjects_ ) {
+            objects_[object]->submit( queue_, view_ );
+        }
+
+        queue_.sort();
+        queue_.execute( view_ );
+
+        if ( renderer_.has_value() ) {
+            renderer_->render();
+        }
+    }
+
+    inline std::shared_ptr<const Object> Scene::raycast( const Ray& ray ) const noexcept {
+        const auto hit = hierarchy_.raycast( ray );
+
+        if ( !hit.has_value() || boundedObjects_[hit->item] >= objects_.size() ) {
+            return nullptr;
+        }
+
+        return objects_[boundedObjects_[hit->item]];
     }
-    inline void Scene::remove( Object object ) noexcept {
 
+    inline void Scene::add( std::shared_ptr<const Object> object ) {
+        objects_.push_back(std::move(object));
+    }
+    inline void Scene::remove( const std::shared_ptr<const Object>& object ) noexcept {
+        objects_.erase( std::remove( objects_.begin(), objects_.end(), object ), objects_.end() );
     }
     inline void Scene::clear() noexcept {
         objects_.clear();
     }
 
+    inline TransformHierarchy& Scene::transforms() noexcept {
+        return transforms_;
+    }
+    inline const TransformHierarchy& Scene::transforms() const noexcept {
+        return transforms_;
+    }
+
+    inline void Scene::attach( std::shared_ptr<Model> model, const TransformHierarchy::Node node ) {
+        if ( node >= transforms_.size() ) {
+            throw TransformHierarchy::UnknownNode( "Le nœud n’appartient pas au graphe de la scène." );
+        }
+
+        // Le nœud peut ne plus changer : le modèle reçoit tout de suite la matrice du dernier rendu.
+        attachments_.emplace_back( std::move( model ), node );
+        attachments_.back().first->setTransform( transforms_.world( node ) );
+    }
+    inline void Scene::detach( const std::shared_ptr<Model>& model ) noexcept {
+        attachments_.erase( std::remove_if( attachments_.begin(), attachments_.end(), [&model]( const auto& attachment ) noexcept {
+            return attachment.first == model;
+        } ), attachments_.end() );
+    }
+
+    inline void Scene::setView( const RenderView& view ) noexcept {
+        view_ = view;
+    }
+    inline const RenderStatistics& Scene::statistics() const noexcept {
+        return queue_.statistics();
+    }
+    inline const CullStatistics& Scene::cullStatistics() const noexcept {
+        return cullStatistics_;
+    }
+    inline const OcclusionBuffer& Scene::occlusionBuffer() const noexcept {
+        return occlusion_;
+    }
+
     inline void Scene::addRenderer( Renderer renderer ) {
         if ( renderer_.has_value() ) {
             throw RendererAlreadyPresent("La méthode de rendu est déjà existante dans la scène.\n"
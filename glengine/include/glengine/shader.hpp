@@ -49,9 +49,9 @@ namespace gl_engine {
         explicit VertexShader( Content content )
         : AbstractShader(Shader_t::VERTEX, std::move(content)) {}
 
-        VertexShader( const VertexShader& other ) = default;
+        VertexShader( const VertexShader& other ) noexcept = default;
         VertexShader( VertexShader&& ) noexcept = default;
-        VertexShader& operator=( const VertexShader& ) = default;
+        VertexShader& operator=( const VertexShader& ) noexcept = default;
         VertexShader& operator=( VertexShader&& ) noexcept = default;
         ~VertexShader() noexcept = default;
     };
@@ -83,9 +83,9 @@ namespace gl_engine {
         explicit FragmentShader( Content content )
         : AbstractShader(Shader_t::FRAGMENT, std::move(content)) {}
 
-        FragmentShader( const FragmentShader& ) = default;
+        FragmentShader( const FragmentShader& ) noexcept = default;
         FragmentShader( FragmentShader&& ) noexcept = default;
-        FragmentShader& operator=( const FragmentShader& ) = default;
+        FragmentShader& operator=( const FragmentShader& ) noexcept = default;
         FragmentShader& operator=( FragmentShader&& ) noexcept = default;
         ~FragmentShader() noexcept = default;
     };
@@ -117,9 +117,9 @@ namespace gl_engine {
         explicit GeometryShader( Content content )
         : AbstractShader(Shader_t::GEOMETRY, std::move(content)) {}
 
-        GeometryShader( const GeometryShader& ) = default;
+        GeometryShader( const GeometryShader& ) noexcept = default;
         GeometryShader( GeometryShader&& ) noexcept = default;
-        GeometryShader& operator=( const GeometryShader& ) = default;
+        GeometryShader& operator=( const GeometryShader& ) noexcept = default;
         GeometryShader& operator=( GeometryShader&& ) noexcept = default;
         ~GeometryShader() noexcept = default;
     };
@@ -21,14 +21,140 @@
 #include <GLFW/glfw3.h>
 
 #include <glengine/utility.hpp>
+#include <glengine/hash.hpp>
+#include <glengine/program_binary_cache.hpp>
 #include <glengine/shader.hpp>
+#include <glengine/uniform_block.hpp>
 
+#include <cstdint>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include <glm/glm.hpp>
 
 namespace gl_engine {
+    /**
+     * @brief Uniforme d’un gl_engine::ShaderProgram dont la localisation est résolue une fois, par gl_engine::ShaderProgram::uniform.
+     *
+     * Modifier un uniforme par sa poignée ne fait ni allocation ni hachage, contrairement à la surcharge prenant son nom.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::ShaderProgram::setUniform
+     *
+     * @note Une poignée reste valide tant que le programme n’est pas lié à nouveau (attachShader, detachShader).
+     */
+    class UniformHandle final {
+    public:
+        /**
+         * @brief Construit une poignée invalide, ignorée par OpenGL.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        constexpr UniformHandle() noexcept = default;
+
+        /**
+         * @brief Indique si la poignée désigne un uniforme.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] constexpr bool valid() const noexcept {
+            return location_ >= 0;
+        }
+
+        /**
+         * @brief Retourne la localisation de l’uniforme, -1 pour une poignée invalide.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] constexpr GLint location() const noexcept {
+            return location_;
+        }
+
+    private:
+        friend class ShaderProgram;
+
+        constexpr explicit UniformHandle( const GLint location ) noexcept
+        : location_(location) {}
+
+        GLint location_ = -1;
+    };
+
+    /**
+     * @brief Identifiant d’un uniforme : l’empreinte FNV-1a de son nom, calculable à la compilation.
+     *
+     * Le code appelant garde des noms lisibles sans aucun travail sur les chaines à l’exécution :
+     * @code
+     * constexpr UniformId PROJECTION{"projection"};
+     * program.setUniform( PROJECTION, projection, ShaderProgram::TRANSPOSE::NO );
+     * @endcode
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::ShaderProgram::uniform
+     *
+     * @note Un identifiant déclaré constexpr est toujours calculé à la compilation, un temporaire ne l’est
+     * que si le compilateur le choisit.
+     */
+    class UniformId final {
+    public:
+        UniformId() noexcept = delete;
+
+        /**
+         * @brief Construit l’identifiant de l’uniforme name.
+         * @param name Le nom de l’uniforme dans le GLSL, 'lights' ou 'lights[0]' pour un tableau.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        constexpr explicit UniformId( const std::string_view name ) noexcept
+        : hash_(utility::fnv1a( name )) {}
+
+        /**
+         * @brief Retourne l’empreinte du nom.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] constexpr std::uint64_t hash() const noexcept {
+            return hash_;
+        }
+
+    private:
+        std::uint64_t hash_;
+    };
+
+    /**
+     * @brief Uniforme actif d’un programme, lu par glGetActiveUniform à l’édition des liens.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::ShaderProgram::uniforms
+     */
+    struct ActiveUniform {
+        /// Nom de l’uniforme, sans le suffixe '[0]' pour un tableau.
+        std::string name;
+
+        /// Localisation de l’uniforme, celle du premier élément pour un tableau.
+        GLint location;
+
+        /// Type GLSL, GL_FLOAT_VEC3 par exemple.
+        GLenum type;
+
+        /// Nombre d’éléments, 1 si l’uniforme n’est pas un tableau.
+        GLint size;
+
+        /// Indique si l’uniforme est un tableau, listé par OpenGL sous le nom de son premier élément.
+        bool array;
+    };
+
     class ShaderProgram {
     public:
         /**
@@ -36,11 +162,16 @@ namespace gl_engine {
          */
         ShaderProgram();
 
-        ShaderProgram( const ShaderProgram& other ) noexcept = default;
-        ShaderProgram( ShaderProgram&& ) noexcept = default;
-        ShaderProgram& operator=( const ShaderProgram& other ) noexcept = default;
-        ShaderProgram& operator=( ShaderProgram&& ) noexcept = default;
+        ShaderProgram( const ShaderProgram& ) noexcept = delete;
+        ShaderProgram( ShaderProgram&& other ) noexcept;
+        ShaderProgram& operator=( const ShaderProgram& ) noexcept = delete;
+        ShaderProgram& operator=( ShaderProgram&& other ) noexcept;
 
+        /**
+         * @brief Détruit le programme OpenGL, sauf s’il a été déplacé.
+         *
+         * @exceptsafe NO-THROW.
+         */
         ~ShaderProgram() noexcept;
 
         explicit ShaderProgram( VertexShader shader );
@@ -49,6 +180,49 @@ namespace gl_engine {
         explicit ShaderProgram( VertexShader vertex, FragmentShader fragment );
         explicit ShaderProgram( VertexShader vertex, FragmentShader fragment, GeometryShader geometry );
 
+        /**
+         * @brief Construit le programme depuis ses sources, en le relisant dans le cache de binaires s’il y est.
+         * @param vertex La source du vertex shader.
+         * @param fragment La source du fragment shader.
+         * @param cache Le cache de binaires.
+         *
+         * @pre Un contexte OpenGL doit être courant sur le thread appelant.
+         * @throws std::runtime_error Lancée si un shader ne compile pas (cache absent ou refusé).
+         * @throws gl_engine::ShaderProgram::LinkError Lancée si l’édition des liens échoue.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note Un binaire relu ne demande ni compilation ni édition des liens : aucun shader n’est alors attaché.
+         * Sinon les shaders sont compilés et liés, puis le binaire est écrit dans le cache pour le prochain démarrage.
+         * @note Un cache impossible à écrire est ignoré, le programme reste utilisable.
+         *
+         * @see gl_engine::ShaderProgram::fromCache
+         */
+        ShaderProgram( const Content& vertex, const Content& fragment, const ProgramBinaryCache& cache );
+
+        /**
+         * @overload
+         * @brief Programme avec geometry shader.
+         * @param vertex La source du vertex shader.
+         * @param fragment La source du fragment shader.
+         * @param geometry La source du geometry shader.
+         * @param cache Le cache de binaires.
+         */
+        ShaderProgram( const Content& vertex, const Content& fragment, const Content& geometry, const ProgramBinaryCache& cache );
+
+        /**
+         * @brief Indique si le programme a été relu dans un gl_engine::ProgramBinaryCache plutôt que compilé.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        [[nodiscard]] bool fromCache() const noexcept {
+            return fromCache_;
+        }
+
 
 
         /**
@@ -59,6 +233,8 @@ namespace gl_engine {
         /**
          * @brief Attache un shader au programme et le recompile
          * @param shader
+         *
+         * @throws gl_engine::ShaderProgram::LinkError Lancée si l’édition des liens échoue, avec le journal du pilote.
          */
         void attachShader( VertexShader shader );
         void attachShader( FragmentShader shader );
@@ -145,11 +321,187 @@ namespace gl_engine {
         void setUniform( std::string name, glm::dmat4x2 value, TRANSPOSE transpose );
         void setUniform( std::string name, glm::dmat4x3 value, TRANSPOSE transpose );
 
+        /**
+         * @brief Retourne la poignée de l’uniforme name, pour le modifier sans rechercher son nom à chaque fois.
+         * @param name Le nom de l’uniforme dans le GLSL.
+         * @return La poignée de l’uniforme.
+         *
+         * @throws gl_engine::ShaderProgram::ProgramNotCompiled Lancée si le programme n’est pas compilé.
+         * @throws gl_engine::ShaderProgram::UniformNotFound Lancée si aucun uniforme n’est trouvé pour le nom fourni.
+         *
+         * @exceptsafe FORT. Ne modifie aucune donnée.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note Recherche dichotomique dans la table des uniformes actifs, un élément de tableau ('lights[2]')
+         * est demandé à OpenGL.
+         */
+        [[nodiscard]] UniformHandle uniform( std::string_view name ) const;
+
+        /**
+         * @overload
+         * @brief Retourne la poignée de l’uniforme dont l’identifiant est fourni.
+         * @param id L’identifiant de l’uniforme.
+         *
+         * @throws gl_engine::ShaderProgram::ProgramNotCompiled Lancée si le programme n’est pas compilé.
+         * @throws gl_engine::ShaderProgram::UniformNotFound Lancée si aucun uniforme actif n’a cet identifiant,
+         * ou si deux uniformes du programme le partagent.
+         *
+         * @note Recherche dichotomique parmi les identifiants des uniformes actifs, calculés à l’édition des liens.
+         * Les éléments de tableau autres que le premier n’y figurent pas.
+         */
+        [[nodiscard]] UniformHandle uniform( UniformId id ) const;
+
+        /**
+         * @brief Retourne les uniformes actifs du programme, triés par nom.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note Les membres des blocs d’uniformes n’y figurent pas, voir uniformBlockLayout.
+         */
+        [[nodiscard]] const std::vector<ActiveUniform>& uniforms() const noexcept {
+            return uniforms_;
+        }
+
+        /**
+         * @brief Modifie l’uniforme dont l’identifiant est fourni, avec les mêmes valeurs que les surcharges
+         * prenant une gl_engine::UniformHandle.
+         * @param id L’identifiant de l’uniforme.
+         * @param args La valeur, suivie de gl_engine::ShaderProgram::TRANSPOSE pour une matrice.
+         *
+         * @throws gl_engine::ShaderProgram::ProgramNotCompiled Lancée si le programme n’est pas compilé.
+         * @throws gl_engine::ShaderProgram::UniformNotFound Lancée si aucun uniforme actif n’a cet identifiant.
+         */
+        template<typename... Args>
+        void setUniform( const UniformId id, Args... args ) {
+            setUniform( uniform( id ), args... );
+        }
+
+        // Note développeur : Mêmes surcharges que celles prenant le nom, sans allocation ni hachage.
+        // Une poignée invalide est ignorée par OpenGL, comme une localisation de -1.
+        void setUniform( UniformHandle uniform, int value );
+        void setUniform( UniformHandle uniform, float value );
+        void setUniform( UniformHandle uniform, bool value );
+        void setUniform( UniformHandle uniform, double value );
+        void setUniform( UniformHandle uniform, unsigned int value );
+
+        void setUniform( UniformHandle uniform, glm::vec2 value );
+        void setUniform( UniformHandle uniform, glm::vec3 value );
+        void setUniform( UniformHandle uniform, glm::vec4 value );
+
+        void setUniform( UniformHandle uniform, glm::ivec2 value );
+        void setUniform( UniformHandle uniform, glm::ivec3 value );
+        void setUniform( UniformHandle uniform, glm::ivec4 value );
+
+        void setUniform( UniformHandle uniform, glm::uvec2 value );
+        void setUniform( UniformHandle uniform, glm::uvec3 value );
+        void setUniform( UniformHandle uniform, glm::uvec4 value );
+
+        void setUniform( UniformHandle uniform, glm::bvec2 value );
+        void setUniform( UniformHandle uniform, glm::bvec3 value );
+        void setUniform( UniformHandle uniform, glm::bvec4 value );
+
+        void setUniform( UniformHandle uniform, glm::dvec2 value );
+        void setUniform( UniformHandle uniform, glm::dvec3 value );
+        void setUniform( UniformHandle uniform, glm::dvec4 value );
+
+        void setUniform( UniformHandle uniform, glm::mat2 value, TRANSPOSE transpose );
+        void setUniform( UniformHandle uniform, glm::mat2x3 value, TRANSPOSE transpose );
+        void setUniform( UniformHandle uniform, glm::mat2x4 value, TRANSPOSE transpose );
+
+        void setUniform( UniformHandle uniform, glm::mat3 value, TRANSPOSE transpose );
+        void setUniform( UniformHandle uniform, glm::mat3x2 value, TRANSPOSE transpose );
+        void setUniform( UniformHandle uniform, glm::mat3x4 value, TRANSPOSE transpose );
+
+        void setUniform( UniformHandle uniform, glm::mat4 value, TRANSPOSE transpose );
+        void setUniform( UniformHandle uniform, glm::mat4x2 value, TRANSPOSE transpose );
+        void setUniform( UniformHandle uniform, glm::mat4x3 value, TRANSPOSE transpose );
+
+        void setUniform( UniformHandle uniform, glm::dmat2 value, TRANSPOSE transpose );
+        void setUniform( UniformHandle uniform, glm::dmat2x3 value, TRANSPOSE transpose );
+        void setUniform( UniformHandle uniform, glm::dmat2x4 value, TRANSPOSE transpose );
+
+        void setUniform( UniformHandle uniform, glm::dmat3 value, TRANSPOSE transpose );
+        void setUniform( UniformHandle uniform, glm::dmat3x2 value, TRANSPOSE transpose );
+        void setUniform( UniformHandle uniform, glm::dmat3x4 value, TRANSPOSE transpose );
+
+        void setUniform( UniformHandle uniform, glm::dmat4 value, TRANSPOSE transpose );
+        void setUniform( UniformHandle uniform, glm::dmat4x2 value, TRANSPOSE transpose );
+        void setUniform( UniformHandle uniform, glm::dmat4x3 value, TRANSPOSE transpose );
+
+        /**
+         * @brief Lit la disposition d’un bloc d’uniformes du programme.
+         * @param name Le nom du bloc dans le GLSL.
+         * @return La disposition : taille et décalage de chaque membre.
+         *
+         * @throws gl_engine::ShaderProgram::ProgramNotCompiled Lancée si le programme n’est pas compilé.
+         * @throws gl_engine::ShaderProgram::UniformBlockNotFound Lancée si le programme ne déclare pas le bloc.
+         *
+         * @exceptsafe FORT. Ne modifie aucune donnée.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @see gl_engine::Std140Layout
+         */
+        [[nodiscard]] UniformBlockLayout uniformBlockLayout( const std::string& name ) const;
+
+        /**
+         * @brief Associe un bloc d’uniformes du programme à un point de liaison.
+         * @param name Le nom du bloc dans le GLSL.
+         * @param binding Le point de liaison, où un gl_engine::UniformBuffer est lié.
+         *
+         * @throws gl_engine::ShaderProgram::ProgramNotCompiled Lancée si le programme n’est pas compilé.
+         * @throws gl_engine::ShaderProgram::UniformBlockNotFound Lancée si le programme ne déclare pas le bloc.
+         *
+         * @exceptsafe FORT.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note L’association fait partie du programme : elle est perdue à chaque nouvelle édition des liens.
+         */
+        void bindUniformBlock( const std::string& name, GLuint binding );
+
+        /**
+         * @overload
+         * @brief Vérifie la disposition du bloc Block::NAME puis l’associe au point de liaison Block::BINDING.
+         * @return true si le programme déclare le bloc, false sinon.
+         *
+         * @throws gl_engine::ShaderProgram::ProgramNotCompiled Lancée si le programme n’est pas compilé.
+         * @throws gl_engine::UniformBlockMismatch Lancée si la disposition du bloc diffère de Block::Layout.
+         *
+         * @see gl_engine::FrameBlock
+         * @see gl_engine::CameraBlock
+         */
+        template<typename Block>
+        bool bindUniformBlock() {
+            if ( !compiled_ ) {
+                throw ProgramNotCompiled("Le programme doit être compilé pour pouvoir lier un bloc d’uniformes.");
+            }
+
+            return open_gl::bindUniformBlock<Block>( id_ );
+        }
+
 
     private:
+        friend class ProgramFuture;
+
+        /**
+         * @brief Prend possession d’un programme déjà lié, sans shader attaché.
+         * @param linked Le programme.
+         * @param fromCache Indique s’il a été relu dans un gl_engine::ProgramBinaryCache.
+         */
+        ShaderProgram( Id linked, bool fromCache );
+
         Id id_ = open_gl::createProgram();
 
         bool compiled_ = false;
+        bool fromCache_ = false;
 
         std::optional<VertexShader> vertex_ = std::nullopt;
         std::optional<FragmentShader> fragment_ = std::nullopt;
@@ -158,6 +510,12 @@ namespace gl_engine {
 
         void compile();
 
+        /**
+         * @brief Relit le programme dans le cache, ou attache les shaders et le lie puis l’écrit dans le cache.
+         * @param geometry La source du geometry shader, nullptr s’il n’y en a pas.
+         */
+        void compile( const Content& vertex, const Content& fragment, const Content* geometry, const ProgramBinaryCache& cache );
+
         /**
          * @brief Cache des positions des uniforms pour le programme.
          *
@@ -166,6 +524,44 @@ namespace gl_engine {
          */
         std::unordered_map<std::string, GLint> uniformLocation_;
 
+        /**
+         * @brief Uniformes actifs triés par nom, lus à chaque édition des liens.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        std::vector<ActiveUniform> uniforms_;
+
+        /**
+         * @brief Identifiant et localisation d’un uniforme.
+         */
+        struct UniformSlot {
+            std::uint64_t id;
+            GLint location;
+        };
+
+        /**
+         * @brief Localisations triées par identifiant, construites avec uniforms_.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note Les identifiants partagés par deux noms en sont retirés : ils ne désignent jamais le mauvais uniforme.
+         */
+        std::vector<UniformSlot> uniformIds_;
+
+        /**
+         * @brief Remplit uniforms_ et uniformIds_ depuis les uniformes actifs du programme lié.
+         *
+         * @note Hors NDEBUG, les noms dont les identifiants entrent en collision sont affichés sur la sortie d’erreur.
+         */
+        void reflectUniforms();
+
+        /**
+         * @brief Construit uniformIds_ depuis uniforms_.
+         */
+        void reflectUniformIds();
+
         /**
          * @brief Récupère la localisation de l’uniforme dont le nom est passé en paramètre.
          * @param name Le nom de l’uniforme.
@@ -183,6 +579,12 @@ namespace gl_engine {
 
         void setUniformFloatMatrix( std::string name, const float* value, size_t sizeX, size_t sizeY, bool transpose );
 
+        void setUniformFloat( GLint location, const float* value, size_t size );
+        void setUniformInt( GLint location, const int* value, size_t size );
+        void setUniformUnsigned( GLint location, const unsigned int* value, size_t size );
+
+        void setUniformFloatMatrix( GLint location, const float* value, size_t sizeX, size_t sizeY, bool transpose );
+
         /**
          * @brief Exception lancée si l’utilisateur souhaite utiliser un gl_engine::ShaderProgram alors qu’il n’est pas compilé.
          *
@@ -375,6 +777,66 @@ namespace gl_engine {
             ~UniformNotFound() noexcept = default;
         };
 
+        /**
+         * @brief Exception lancée si le programme ne déclare pas le bloc d’uniformes demandé.
+         *
+         * @version 1.0
+         * @since 0.1
+         * @author Axel DAVID
+         */
+        class UniformBlockNotFound final : public RuntimeError {
+        public:
+            UniformBlockNotFound() noexcept = delete;
+
+            /**
+             * @brief Construit une exception avec un message préfixé ainsi que le nom du bloc non trouvé.
+             * @param name Le nom du bloc.
+             *
+             * @exceptsafe NO-THROW.
+             *
+             * @version 1.0
+             * @since 0.1
+             */
+            explicit UniformBlockNotFound( const std::string& name ) noexcept
+            : RuntimeError("Le bloc d’uniformes : " + name + " n'a pas été trouvé.") {}
+
+            UniformBlockNotFound( const UniformBlockNotFound& ) noexcept = default;
+            UniformBlockNotFound( UniformBlockNotFound&& ) noexcept = default;
+            UniformBlockNotFound& operator=( const UniformBlockNotFound& ) noexcept = default;
+            UniformBlockNotFound& operator=( UniformBlockNotFound&& ) noexcept = default;
+            ~UniformBlockNotFound() noexcept = default;
+        };
+
+        /**
+         * @brief Exception lancée si l’édition des liens du programme échoue.
+         *
+         * @version 1.0
+         * @since 0.1
+         * @author Axel DAVID
+         */
+        class LinkError final : public RuntimeError {
+        public:
+            LinkError() noexcept = delete;
+
+            /**
+             * @brief Construit l’exception avec le journal du pilote.
+             * @param log Le journal de l’édition des liens.
+             *
+             * @exceptsafe NO-THROW.
+             *
+             * @version 1.0
+             * @since 0.1
+             */
+            explicit LinkError( const std::string& log ) noexcept
+            : RuntimeError("Erreur durant l’édition des liens du programme :\n" + log) {}
+
+            LinkError( const LinkError& ) noexcept = default;
+            LinkError( LinkError&& ) noexcept = default;
+            LinkError& operator=( const LinkError& ) noexcept = default;
+            LinkError& operator=( LinkError&& ) noexcept = default;
+            ~LinkError() noexcept override = default;
+        };
+
         /**
          * @brief Exception lancée si on essaie de compiler un gl_engine::ShaderProgram sans gl_engine::VertexShader
          *
@@ -0,0 +1,240 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef GLENGINE_SHADER_COMPILER_HPP
+#define GLENGINE_SHADER_COMPILER_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include <glengine/exception.hpp>
+#include <glengine/program_binary_cache.hpp>
+#include <glengine/shaderProgram.hpp>
+#include <glengine/utility.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Programme en cours de compilation, rendu par gl_engine::ShaderCompiler::submit.
+     *
+     * Comme un std::future : ready() indique sans attendre si le programme est prêt, get() attend la fin de la
+     * compilation, vérifie les erreurs et rend le programme une seule fois.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::ShaderCompiler
+     */
+    class ProgramFuture final {
+    public:
+        ProgramFuture() noexcept = default;
+
+        ProgramFuture( const ProgramFuture& ) noexcept = delete;
+        ProgramFuture( ProgramFuture&& other ) noexcept;
+        ProgramFuture& operator=( const ProgramFuture& ) noexcept = delete;
+        ProgramFuture& operator=( ProgramFuture&& other ) noexcept;
+
+        /**
+         * @brief Supprime le programme et ses shaders s’il n’a pas été récupéré.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        ~ProgramFuture() noexcept;
+
+        /**
+         * @brief Indique si le programme peut encore être récupéré par get().
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] bool valid() const noexcept {
+            return program_ != 0;
+        }
+
+        /**
+         * @brief Indique, sans attendre, si la compilation et l’édition des liens sont terminées.
+         *
+         * @pre valid() doit retourner true, un contexte OpenGL doit être courant sur le thread appelant.
+         * @exceptsafe NO-THROW.
+         *
+         * @note Sans GL_KHR_parallel_shader_compile l’état ne peut pas être lu sans attendre : retourne toujours true.
+         */
+        [[nodiscard]] bool ready() const noexcept;
+
+        /**
+         * @brief Attend la fin de la compilation et rend le programme lié.
+         * @return Le programme, prêt à être utilisé.
+         *
+         * @pre valid() doit retourner true, un contexte OpenGL doit être courant sur le thread appelant.
+         * @throws gl_engine::ShaderCompiler::CompileError Lancée si un shader ne compile pas ou si l’édition des liens
+         * échoue, avec le journal du pilote.
+         *
+         * @exceptsafe BASE. Le futur n’est plus valide après l’appel, même en cas d’exception.
+         *
+         * @post valid() retourne false.
+         *
+         * @note C’est le premier appel à lire l’état de compilation : les soumissions précédentes ne l’attendent pas.
+         * @note Un programme compilé est écrit dans le cache de binaires de sa soumission, s’il en a un.
+         */
+        [[nodiscard]] ShaderProgram get();
+
+    private:
+        friend class ShaderCompiler;
+
+        /// Étages dans l’ordre vertex, geometry, fragment, 0 pour un étage absent.
+        std::array<Id, 3> shaders_{};
+        Id program_ = 0;
+
+        /// Cache où écrire le binaire après compilation, nullptr si le programme vient du cache ou n’en a pas.
+        const ProgramBinaryCache* cache_ = nullptr;
+        std::uint64_t key_ = 0;
+
+        bool parallel_ = false;
+        bool fromCache_ = false;
+
+        void release() noexcept;
+    };
+
+    /**
+     * @brief Compilation de programmes par lots : tous les programmes sont soumis, puis récupérés à leur première
+     * utilisation.
+     *
+     * submit() lance la compilation des shaders et l’édition des liens sans jamais lire leur état : le pilote n’a pas
+     * à les terminer avant de rendre la main. Avec GL_KHR_parallel_shader_compile, il les compile sur ses propres
+     * threads, et le temps de démarrage est celui de la plus longue compilation plutôt que la somme de toutes.
+     * Sans l’extension, le pilote peut encore différer le travail jusqu’à la première lecture d’état.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::ProgramFuture
+     * @see gl_engine::ProgramBinaryCache
+     */
+    class ShaderCompiler final {
+    public:
+        /**
+         * @brief Prépare le compilateur du contexte courant, en demandant au pilote tous ses threads de compilation.
+         *
+         * @pre Un contexte OpenGL doit être courant sur le thread appelant.
+         * @exceptsafe NO-THROW.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        ShaderCompiler() noexcept;
+
+        ShaderCompiler( const ShaderCompiler& ) noexcept = default;
+        ShaderCompiler( ShaderCompiler&& ) noexcept = default;
+        ShaderCompiler& operator=( const ShaderCompiler& ) noexcept = default;
+        ShaderCompiler& operator=( ShaderCompiler&& ) noexcept = default;
+        ~ShaderCompiler() noexcept = default;
+
+        /**
+         * @brief Indique si le pilote compile en arrière-plan (GL_KHR_parallel_shader_compile).
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] bool parallel() const noexcept {
+            return parallel_;
+        }
+
+        /**
+         * @brief Lance la compilation d’un programme sans l’attendre.
+         * @param vertex La source du vertex shader.
+         * @param fragment La source du fragment shader.
+         * @return Le programme à venir.
+         *
+         * @pre Un contexte OpenGL doit être courant sur le thread appelant.
+         * @exceptsafe FORT. Aucun objet OpenGL n’est gardé en cas d’exception.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note Les erreurs de compilation ne sont signalées que par gl_engine::ProgramFuture::get.
+         */
+        [[nodiscard]] ProgramFuture submit( const Content& vertex, const Content& fragment ) const;
+
+        /**
+         * @overload
+         * @brief Programme avec geometry shader.
+         */
+        [[nodiscard]] ProgramFuture submit( const Content& vertex, const Content& fragment, const Content& geometry ) const;
+
+        /**
+         * @overload
+         * @brief Relit le programme dans le cache de binaires s’il y est, il est alors prêt immédiatement.
+         * @param vertex La source du vertex shader.
+         * @param fragment La source du fragment shader.
+         * @param cache Le cache de binaires, il doit survivre au futur.
+         *
+         * @note Sinon le programme est compilé, et son binaire écrit dans le cache par gl_engine::ProgramFuture::get.
+         */
+        [[nodiscard]] ProgramFuture submit( const Content& vertex, const Content& fragment, const ProgramBinaryCache& cache ) const;
+
+        /**
+         * @overload
+         * @brief Programme avec geometry shader, relu dans le cache de binaires s’il y est.
+         */
+        [[nodiscard]] ProgramFuture submit( const Content& vertex, const Content& fragment, const Content& geometry,
+                                            const ProgramBinaryCache& cache ) const;
+
+        /**
+         * @brief Exception lancée si un shader ne compile pas ou si l’édition des liens échoue.
+         *
+         * @version 1.0
+         * @since 0.1
+         * @author Axel DAVID
+         */
+        class CompileError final : public RuntimeError {
+        public:
+            /**
+             * @brief Construit l’exception avec le journal du pilote.
+             * @param what_arg L’étage en erreur et le journal.
+             *
+             * @exceptsafe NO-THROW.
+             */
+            explicit CompileError( const std::string& what_arg ) noexcept
+            : RuntimeError(what_arg) {}
+
+            /**
+             * @overload
+             * @brief Surcharge du constructeur en passant la raison sous forme de pointeur vers une chaine de caractère.
+             * @param what_arg Le pointeur.
+             */
+            explicit CompileError( const char* what_arg ) noexcept
+            : CompileError( std::string{what_arg} ) {}
+
+            CompileError() noexcept = delete;
+            CompileError( const CompileError& ) noexcept = default;
+            CompileError( CompileError&& ) noexcept = default;
+            CompileError& operator=( const CompileError& ) noexcept = default;
+            CompileError& operator=( CompileError&& ) noexcept = default;
+            ~CompileError() noexcept override = default;
+        };
+
+    private:
+        bool parallel_ = false;
+
+        ProgramFuture launch( const Content& vertex, const Content& fragment, const Content* geometry,
+                              const ProgramBinaryCache* cache ) const;
+    };
+}
+
+#endif // GLENGINE_SHADER_COMPILER_HPP
@@ -0,0 +1,322 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef GLENGINE_SIMD_HPP
+#define GLENGINE_SIMD_HPP
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define GLENGINE_SIMD_SSE2 1
+#include <emmintrin.h>
+#else
+#include <algorithm>
+#include <cmath>
+#endif
+
+// Note développeur : AVX n’est pas activé par défaut, compiler avec -mavx2 (ou -march=native, /arch:AVX2) pour en profiter.
+#if defined( __AVX__ )
+#define GLENGINE_SIMD_AVX 1
+#include <immintrin.h>
+#endif
+
+namespace gl_engine::simd {
+    /**
+     * @brief Quatre flottants traités par la même instruction, SSE2 si disponible, scalaire sinon.
+     *
+     * Les calculs sur plusieurs éléments s’écrivent en SoA : un Float4 par composante, un élément par voie.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @note Sans SSE2, le même code est compilé en scalaire, les résultats sont identiques.
+     */
+    struct Float4 {
+        // Note développeur : Membre public pour que le type reste trivial et passe par registre.
+#ifdef GLENGINE_SIMD_SSE2
+        __m128 value;
+#else
+        float value[4];
+#endif
+
+        /**
+         * @brief Lit quatre flottants consécutifs, sans contrainte d’alignement.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        static Float4 load( const float* const data ) noexcept {
+#ifdef GLENGINE_SIMD_SSE2
+            return {_mm_loadu_ps( data )};
+#else
+            return {{data[0], data[1], data[2], data[3]}};
+#endif
+        }
+
+        /**
+         * @brief Construit un Float4 dont les quatre voies valent value.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        static Float4 broadcast( const float value ) noexcept {
+#ifdef GLENGINE_SIMD_SSE2
+            return {_mm_set1_ps( value )};
+#else
+            return {{value, value, value, value}};
+#endif
+        }
+
+        /**
+         * @brief Construit un Float4 voie par voie, v0 dans la première voie.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        static Float4 set( const float v0, const float v1, const float v2, const float v3 ) noexcept {
+#ifdef GLENGINE_SIMD_SSE2
+            return {_mm_setr_ps( v0, v1, v2, v3 )};
+#else
+            return {{v0, v1, v2, v3}};
+#endif
+        }
+
+        /**
+         * @brief Écrit les quatre voies dans data, sans contrainte d’alignement.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        void store( float* const data ) const noexcept {
+#ifdef GLENGINE_SIMD_SSE2
+            _mm_storeu_ps( data, value );
+#else
+            for ( int i = 0; i < 4; ++i ) {
+                data[i] = value[i];
+            }
+#endif
+        }
+    };
+
+#ifdef GLENGINE_SIMD_SSE2
+    inline Float4 operator+( const Float4 a, const Float4 b ) noexcept {
+        return {_mm_add_ps( a.value, b.value )};
+    }
+
+    inline Float4 operator-( const Float4 a, const Float4 b ) noexcept {
+        return {_mm_sub_ps( a.value, b.value )};
+    }
+
+    inline Float4 operator*( const Float4 a, const Float4 b ) noexcept {
+        return {_mm_mul_ps( a.value, b.value )};
+    }
+
+    inline Float4 operator/( const Float4 a, const Float4 b ) noexcept {
+        return {_mm_div_ps( a.value, b.value )};
+    }
+
+    inline Float4 min( const Float4 a, const Float4 b ) noexcept {
+        return {_mm_min_ps( a.value, b.value )};
+    }
+
+    inline Float4 max( const Float4 a, const Float4 b ) noexcept {
+        return {_mm_max_ps( a.value, b.value )};
+    }
+
+    inline Float4 sqrt( const Float4 a ) noexcept {
+        return {_mm_sqrt_ps( a.value )};
+    }
+
+    inline Float4 abs( const Float4 a ) noexcept {
+        return {_mm_andnot_ps( _mm_set1_ps( -0.0f ), a.value )};
+    }
+
+    /**
+     * @brief Retourne un masque de 4 bits, le bit i valant 1 si la voie i de a est inférieure à celle de b.
+     *
+     * @exceptsafe NO-THROW.
+     */
+    inline unsigned lessMask( const Float4 a, const Float4 b ) noexcept {
+        return static_cast<unsigned>(_mm_movemask_ps( _mm_cmplt_ps( a.value, b.value ) ));
+    }
+
+    /**
+     * @brief Retourne un masque par voie, vrai si la voie de a est inférieure à celle de b, pour select().
+     *
+     * @exceptsafe NO-THROW.
+     */
+    inline Float4 less( const Float4 a, const Float4 b ) noexcept {
+        return {_mm_cmplt_ps( a.value, b.value )};
+    }
+
+    /**
+     * @brief Choisit voie par voie : a là où mask est vrai, b ailleurs.
+     * @param mask Un masque retourné par less().
+     *
+     * @exceptsafe NO-THROW.
+     */
+    inline Float4 select( const Float4 mask, const Float4 a, const Float4 b ) noexcept {
+        return {_mm_or_ps( _mm_and_ps( mask.value, a.value ), _mm_andnot_ps( mask.value, b.value ) )};
+    }
+#else
+    namespace detail {
+        template <typename Operation>
+        Float4 apply( const Float4 a, const Float4 b, Operation operation ) noexcept {
+            return {{operation( a.value[0], b.value[0] ), operation( a.value[1], b.value[1] ),
+                     operation( a.value[2], b.value[2] ), operation( a.value[3], b.value[3] )}};
+        }
+    }
+
+    inline Float4 operator+( const Float4 a, const Float4 b ) noexcept {
+        return detail::apply( a, b, []( float x, float y ) { return x + y; } );
+    }
+
+    inline Float4 operator-( const Float4 a, const Float4 b ) noexcept {
+        return detail::apply( a, b, []( float x, float y ) { return x - y; } );
+    }
+
+    inline Float4 operator*( const Float4 a, const Float4 b ) noexcept {
+        return detail::apply( a, b, []( float x, float y ) { return x * y; } );
+    }
+
+    inline Float4 operator/( const Float4 a, const Float4 b ) noexcept {
+        return detail::apply( a, b, []( float x, float y ) { return x / y; } );
+    }
+
+    inline Float4 min( const Float4 a, const Float4 b ) noexcept {
+        // Note développeur : Même convention que _mm_min_ps, b est retourné si l’un des deux est NaN.
+        return detail::apply( a, b, []( float x, float y ) { return x < y ? x : y; } );
+    }
+
+    inline Float4 max( const Float4 a, const Float4 b ) noexcept {
+        return detail::apply( a, b, []( float x, float y ) { return x > y ? x : y; } );
+    }
+
+    inline Float4 sqrt( const Float4 a ) noexcept {
+        return {{std::sqrt( a.value[0] ), std::sqrt( a.value[1] ), std::sqrt( a.value[2] ), std::sqrt( a.value[3] )}};
+    }
+
+    inline Float4 abs( const Float4 a ) noexcept {
+        return {{std::fabs( a.value[0] ), std::fabs( a.value[1] ), std::fabs( a.value[2] ), std::fabs( a.value[3] )}};
+    }
+
+    inline unsigned lessMask( const Float4 a, const Float4 b ) noexcept {
+        unsigned mask = 0;
+        for ( unsigned i = 0; i < 4; ++i ) {
+            mask |= ( a.value[i] < b.value[i] ? 1u : 0u ) << i;
+        }
+
+        return mask;
+    }
+
+    inline Float4 less( const Float4 a, const Float4 b ) noexcept {
+        // Note développeur : Masque scalaire 1 ou 0, seul select() l’interprète.
+        return detail::apply( a, b, []( float x, float y ) { return x < y ? 1.0f : 0.0f; } );
+    }
+
+    inline Float4 select( const Float4 mask, const Float4 a, const Float4 b ) noexcept {
+        return {{mask.value[0] != 0.0f ? a.value[0] : b.value[0], mask.value[1] != 0.0f ? a.value[1] : b.value[1],
+                 mask.value[2] != 0.0f ? a.value[2] : b.value[2], mask.value[3] != 0.0f ? a.value[3] : b.value[3]}};
+    }
+#endif
+
+#ifdef GLENGINE_SIMD_AVX
+    /**
+     * @brief Huit flottants traités par la même instruction AVX, même interface que gl_engine::simd::Float4.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @note Défini seulement si GLENGINE_SIMD_AVX l’est : le code l’utilisant doit garder un chemin Float4.
+     */
+    struct Float8 {
+        __m256 value;
+
+        static Float8 load( const float* const data ) noexcept {
+            return {_mm256_loadu_ps( data )};
+        }
+
+        static Float8 broadcast( const float value ) noexcept {
+            return {_mm256_set1_ps( value )};
+        }
+
+        void store( float* const data ) const noexcept {
+            _mm256_storeu_ps( data, value );
+        }
+    };
+
+    inline Float8 operator+( const Float8 a, const Float8 b ) noexcept {
+        return {_mm256_add_ps( a.value, b.value )};
+    }
+
+    inline Float8 operator-( const Float8 a, const Float8 b ) noexcept {
+        return {_mm256_sub_ps( a.value, b.value )};
+    }
+
+    inline Float8 operator*( const Float8 a, const Float8 b ) noexcept {
+        return {_mm256_mul_ps( a.value, b.value )};
+    }
+
+    inline Float8 min( const Float8 a, const Float8 b ) noexcept {
+        return {_mm256_min_ps( a.value, b.value )};
+    }
+
+    inline Float8 max( const Float8 a, const Float8 b ) noexcept {
+        return {_mm256_max_ps( a.value, b.value )};
+    }
+
+    inline Float8 abs( const Float8 a ) noexcept {
+        return {_mm256_andnot_ps( _mm256_set1_ps( -0.0f ), a.value )};
+    }
+
+    inline unsigned lessMask( const Float8 a, const Float8 b ) noexcept {
+        return static_cast<unsigned>(_mm256_movemask_ps( _mm256_cmp_ps( a.value, b.value, _CMP_LT_OQ ) ));
+    }
+
+    inline Float8 less( const Float8 a, const Float8 b ) noexcept {
+        return {_mm256_cmp_ps( a.value, b.value, _CMP_LT_OQ )};
+    }
+
+    inline Float8 select( const Float8 mask, const Float8 a, const Float8 b ) noexcept {
+        return {_mm256_blendv_ps( b.value, a.value, mask.value )};
+    }
+#endif
+
+    /**
+     * @brief Quatre vecteurs 3D en SoA : la voie i de x, y et z forme le vecteur i.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct Vec3x4 {
+        Float4 x;
+        Float4 y;
+        Float4 z;
+    };
+
+    inline Vec3x4 operator-( const Vec3x4& a, const Vec3x4& b ) noexcept {
+        return {a.x - b.x, a.y - b.y, a.z - b.z};
+    }
+
+    inline Float4 dot( const Vec3x4& a, const Vec3x4& b ) noexcept {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    inline Vec3x4 cross( const Vec3x4& a, const Vec3x4& b ) noexcept {
+        return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+    }
+}
+
+#endif // GLENGINE_SIMD_HPP
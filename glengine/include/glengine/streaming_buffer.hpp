@@ -0,0 +1,207 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef GLENGINE_STREAMING_BUFFER_HPP
+#define GLENGINE_STREAMING_BUFFER_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <glengine/utility.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Place réservée dans un gl_engine::StreamingBuffer pour l’image en cours.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct StreamAllocation {
+        /// Adresse où écrire les données, valide jusqu’à StreamingBuffer::flush.
+        void* data = nullptr;
+        /// Décalage depuis le début du buffer, à passer à glBindBufferRange ou glVertexAttribPointer.
+        std::size_t offset = 0;
+        std::size_t size = 0;
+    };
+
+    /**
+     * @brief Buffer d’envoi des données changeant à chaque image : matrices, instances, commandes, lignes de débogage...
+     *
+     * Sur un contexte OpenGL 4.4, le buffer est alloué par glBufferStorage et projeté une fois pour toutes
+     * (GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT). Il est découpé en régions utilisées tour à tour, une par image :
+     * une région n’est réécrite qu’après que la carte graphique a fini de la lire, ce que vérifie un glFenceSync posé
+     * à la fin de l’image. Le pilote n’a ainsi ni copie ni synchronisation à faire.
+     *
+     * Sur un contexte OpenGL 3.3, le buffer est réalloué (orphelin) puis projeté par glMapBufferRange à chaque image :
+     * le pilote fournit un nouveau stockage plutôt que d’attendre la carte.
+     *
+     * Chaque image :
+     * @code
+     * stream.beginFrame();
+     * const auto matrices = stream.allocate( sizeof( Matrices ), StreamingBuffer::uniformOffsetAlignment() );
+     * std::memcpy( matrices.data, &frameMatrices, sizeof( Matrices ) );
+     * stream.flush();
+     * glBindBufferRange( GL_UNIFORM_BUFFER, 0, stream.buffer(), matrices.offset, matrices.size );
+     * // Dessins lisant le buffer.
+     * stream.endFrame();
+     * @endcode
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::RenderQueue
+     */
+    class StreamingBuffer final {
+    public:
+        /// Régions par défaut : une pour l’image écrite, deux pour celles que la carte graphique peut encore lire.
+        static constexpr std::size_t DEFAULT_REGION_COUNT = 3;
+
+        StreamingBuffer() noexcept = delete;
+
+        /**
+         * @brief Crée le buffer et le projette en mémoire si le contexte le permet.
+         * @param regionSize La place disponible pour une image, en octets.
+         * @param regionCount Le nombre d’images pouvant être en cours à la fois, au moins 1.
+         *
+         * @pre Un contexte OpenGL doit être courant sur le thread appelant.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note La taille d’une région est arrondie au multiple de l’alignement maximal, 256 octets.
+         */
+        StreamingBuffer( std::size_t regionSize, std::size_t regionCount );
+
+        /**
+         * @overload
+         * @brief Crée un buffer de DEFAULT_REGION_COUNT régions.
+         * @param regionSize La place disponible pour une image, en octets.
+         */
+        explicit StreamingBuffer( std::size_t regionSize );
+
+        StreamingBuffer( const StreamingBuffer& ) noexcept = delete;
+        StreamingBuffer( StreamingBuffer&& other ) noexcept;
+        StreamingBuffer& operator=( const StreamingBuffer& ) noexcept = delete;
+        StreamingBuffer& operator=( StreamingBuffer&& other ) noexcept;
+
+        /**
+         * @brief Supprime le buffer et les barrières restantes.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        ~StreamingBuffer() noexcept;
+
+        /**
+         * @brief Passe à la région suivante, après avoir attendu que la carte graphique ait fini de la lire.
+         *
+         * @pre L’image précédente doit être terminée par endFrame().
+         * @exceptsafe NO-THROW.
+         *
+         * @note L’attente n’a lieu que si le processeur a DEFAULT_REGION_COUNT images d’avance.
+         */
+        void beginFrame() noexcept;
+
+        /**
+         * @brief Réserve size octets dans la région de l’image, à un décalage multiple de alignment.
+         * @param size Le nombre d’octets.
+         * @param alignment L’alignement du décalage, une puissance de deux.
+         * @return La place réservée.
+         *
+         * @pre beginFrame() doit avoir été appelée, flush() pas encore.
+         * @throws std::length_error Lancée si la région de l’image est pleine.
+         *
+         * @exceptsafe FORT.
+         */
+        StreamAllocation allocate( std::size_t size, std::size_t alignment );
+
+        /**
+         * @overload
+         * @brief Réserve size octets à un décalage utilisable par glBindBufferRange( GL_UNIFORM_BUFFER, ... ).
+         * @param size Le nombre d’octets.
+         */
+        StreamAllocation allocate( std::size_t size );
+
+        /**
+         * @brief Termine les écritures de l’image : le buffer peut ensuite être lu par les dessins.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @note Ne fait rien sur un buffer persistant et cohérent, retire la projection sinon.
+         */
+        void flush() noexcept;
+
+        /**
+         * @brief Termine l’image : pose la barrière protégeant la région jusqu’à la fin de ses lectures.
+         *
+         * @pre Tous les dessins lisant la région de l’image doivent avoir été soumis.
+         * @exceptsafe NO-THROW.
+         */
+        void endFrame() noexcept;
+
+        [[nodiscard]] Id buffer() const noexcept {
+            return buffer_;
+        }
+
+        [[nodiscard]] std::size_t regionSize() const noexcept {
+            return regionSize_;
+        }
+
+        [[nodiscard]] std::size_t regionCount() const noexcept {
+            return regionCount_;
+        }
+
+        /**
+         * @brief Indique si le buffer est projeté de façon persistante (OpenGL 4.4).
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] bool persistent() const noexcept {
+            return persistent_;
+        }
+
+        /**
+         * @brief Retourne GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, lu une fois.
+         *
+         * @pre Un contexte OpenGL doit être courant sur le thread appelant.
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] static std::size_t uniformOffsetAlignment() noexcept;
+
+    private:
+        Id buffer_ = 0;
+
+        std::size_t regionSize_ = 0;
+        std::size_t regionCount_ = 0;
+        std::size_t region_ = 0;
+        /// Octets réservés dans la région de l’image.
+        std::size_t cursor_ = 0;
+
+        bool persistent_ = false;
+        /// Début de la projection : tout le buffer s’il est persistant, sinon la région projetée pour l’image.
+        unsigned char* mapping_ = nullptr;
+
+        // Note développeur : GLsync n’est pas défini par GL/gl.h, les barrières sont conservées comme pointeurs opaques.
+        std::vector<void*> fences_{};
+
+        void release() noexcept;
+    };
+}
+
+#endif // GLENGINE_STREAMING_BUFFER_HPP
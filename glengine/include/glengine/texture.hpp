@@ -15,14 +15,156 @@
  * If not, see <https://www.gnu.org/licenses/>.
  */
 
+
 #ifndef GLENGINE_TEXTURE_HPP
 #define GLENGINE_TEXTURE_HPP
 
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+#include <glengine/utility.hpp>
+
 namespace gl_engine {
-    class Texture {
+    /**
+     * @brief Texture 2D lue depuis une image, décodée à la construction et envoyée à la carte graphique au premier bind().
+     *
+     * Le décodage ne demande pas de contexte OpenGL, un objet peut donc être chargé sur n’importe quel thread.
+     * Les pixels décodés sont libérés dès l’envoi.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::TextureCache
+     */
+    class Texture final {
     public:
+        Texture() noexcept = delete;
+
+        /**
+         * @brief Décode l’image pointée par path.
+         * @param path Le chemin vers l’image.
+         *
+         * @throws gl_engine::utility::EmptySource Lancée si le fichier est vide.
+         * @throws gl_engine::utility::STBException Lancée si l’image ne peut pas être décodée.
+         *
+         * @exceptsafe FORT.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        explicit Texture( const Path& path );
+
+        // Note développeur : Partagée par gl_engine::TextureCache, une texture n’est jamais copiée ni déplacée.
+        Texture( const Texture& ) noexcept = delete;
+        Texture( Texture&& ) noexcept = delete;
+        Texture& operator=( const Texture& ) noexcept = delete;
+        Texture& operator=( Texture&& ) noexcept = delete;
+
+        /**
+         * @brief Supprime la texture de la carte graphique si elle y a été envoyée.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        ~Texture() noexcept;
+
+        /**
+         * @brief Lie la texture à l’unité fournie, l’envoie à la carte graphique au premier appel.
+         * @param unit L’unité de texture, à partir de 0.
+         *
+         * @pre Un contexte OpenGL doit être courant sur le thread appelant.
+         * @exceptsafe NO-THROW.
+         */
+        void bind( unsigned unit ) noexcept;
+
+        [[nodiscard]] int width() const noexcept {
+            return width_;
+        }
+
+        [[nodiscard]] int height() const noexcept {
+            return height_;
+        }
+
+        /**
+         * @brief Indique si la texture a déjà été envoyée à la carte graphique.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] bool isUploaded() const noexcept {
+            return texture_ != 0;
+        }
 
     private:
+        std::optional<Image> image_ = std::nullopt;
+
+        int width_ = 0;
+        int height_ = 0;
+
+        Id texture_ = 0;
+
+        /// Envoie l’image à la carte graphique en liant la nouvelle texture à l’unité fournie.
+        void upload( unsigned unit ) noexcept;
+    };
+
+    /**
+     * @brief Cache des textures partagé par tout le processus, indexé par le chemin canonique de l’image.
+     *
+     * Une image référencée par plusieurs matériaux, ou plusieurs objets, n’est décodée et envoyée qu’une seule fois.
+     * Le cache ne conserve que des références faibles : une texture est libérée lorsque plus aucun matériau ne l’utilise.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::Texture
+     * @see gl_engine::Material
+     *
+     * @note Toutes les méthodes peuvent être appelées depuis plusieurs threads.
+     * @note Les textures sont envoyées dans le contexte courant au premier bind(), tous les contextes
+     * utilisant le cache doivent donc partager leurs objets.
+     */
+    class TextureCache final {
+    public:
+        // Note développeur : Classe purement statique, comme gl_engine::ObjectFactory.
+
+        TextureCache() noexcept = delete;
+        TextureCache( const TextureCache& ) noexcept = delete;
+        TextureCache( TextureCache&& ) noexcept = delete;
+        TextureCache& operator=( const TextureCache& ) noexcept = delete;
+        TextureCache& operator=( TextureCache&& ) noexcept = delete;
+        ~TextureCache() noexcept = delete;
+
+        /**
+         * @brief Retourne la texture de l’image pointée par path, la décode si elle n’est pas déjà chargée.
+         * @param path Le chemin vers l’image.
+         * @return La texture partagée.
+         *
+         * @throws gl_engine::utility::EmptySource Lancée si le fichier est vide.
+         * @throws gl_engine::utility::STBException Lancée si l’image ne peut pas être décodée.
+         *
+         * @exceptsafe FORT.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note Deux chemins désignant le même fichier ('a/../b.png' et 'b.png') partagent la même texture.
+         */
+        static std::shared_ptr<Texture> load( const Path& path );
+
+        /**
+         * @brief Retourne le nombre de textures encore utilisées.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] static std::size_t size() noexcept;
+
+        /**
+         * @brief Oublie les textures qui ne sont plus utilisées.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        static void purge() noexcept;
     };
 }
 
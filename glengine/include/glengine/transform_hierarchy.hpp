@@ -0,0 +1,275 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef GLENGINE_TRANSFORM_HIERARCHY_HPP
+#define GLENGINE_TRANSFORM_HIERARCHY_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <glengine/exception.hpp>
+#include <glengine/parallel.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Graphe de scène : transformations locales (translation, rotation, échelle) de nœuds et leurs matrices monde.
+     *
+     * Les transformations locales sont rangées en SoA, un tableau par composante, et les nœuds triés par profondeur :
+     * un parent est toujours rangé avant ses enfants, et chaque niveau de l’arbre occupe une plage contiguë.
+     * Modifier un nœud le marque ; update() propage les marques aux descendants, puis recalcule niveau par niveau
+     * les matrices monde des seuls nœuds marqués. Les matrices locales sont calculées quatre nœuds à la fois (huit avec
+     * AVX), les nœuds d’un même niveau sont indépendants et répartis en tranches sur plusieurs threads.
+     *
+     * Les nœuds sont désignés par un identifiant stable, leur rang de création : le tri par profondeur ne les change pas.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::Scene::transforms
+     */
+    class TransformHierarchy final {
+    public:
+        using Node = std::uint32_t;
+
+        /// Parent des racines.
+        static constexpr Node NO_PARENT = std::numeric_limits<Node>::max();
+
+        /// En dessous de ce nombre de nœuds, un niveau est mis à jour sur le thread appelant.
+        static constexpr std::size_t PARALLEL_THRESHOLD = std::size_t{1} << 13;
+
+        /// Nœuds d’une tranche de mise à jour, multiple de huit.
+        static constexpr std::size_t CHUNK_SIZE = std::size_t{1} << 11;
+
+        TransformHierarchy() noexcept = default;
+
+        TransformHierarchy( const TransformHierarchy& ) = default;
+        TransformHierarchy( TransformHierarchy&& ) noexcept = default;
+        TransformHierarchy& operator=( const TransformHierarchy& ) = default;
+        TransformHierarchy& operator=( TransformHierarchy&& ) noexcept = default;
+        ~TransformHierarchy() noexcept = default;
+
+        /**
+         * @brief Ajoute un nœud de transformation identité.
+         * @param parent Le parent du nœud, NO_PARENT pour une racine.
+         * @return L’identifiant du nœud.
+         *
+         * @throws gl_engine::TransformHierarchy::UnknownNode Lancée si parent n’est pas un nœud de la hiérarchie.
+         * @exceptsafe FORT.
+         *
+         * @note Le parent d’un nœud est fixé à sa création : il existe donc toujours avant ses enfants.
+         */
+        Node add( Node parent );
+
+        /**
+         * @overload
+         * @brief Ajoute un nœud de transformation locale fournie.
+         * @param parent Le parent du nœud, NO_PARENT pour une racine.
+         * @param translation La translation.
+         * @param rotation La rotation, normalisée par la hiérarchie.
+         * @param scale L’échelle sur chaque axe.
+         */
+        Node add( Node parent, const glm::vec3& translation, const glm::quat& rotation, const glm::vec3& scale );
+
+        /**
+         * @brief Supprime tous les nœuds.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        void clear() noexcept;
+
+        /**
+         * @brief Réserve la place de count nœuds.
+         *
+         * @exceptsafe FORT.
+         */
+        void reserve( std::size_t count );
+
+        /**
+         * @brief Recalcule les matrices monde des nœuds modifiés depuis le dernier appel, et de leurs descendants.
+         * @param threadCount Le nombre de threads, gl_engine::utility::AUTOMATIC_THREAD_COUNT pour tous les cœurs.
+         * @return Le nombre de nœuds recalculés.
+         *
+         * @exceptsafe BASE.
+         *
+         * @note Sans modification, ne coûte qu’un parcours des marques.
+         */
+        std::size_t update( unsigned threadCount );
+
+        /**
+         * @overload
+         * @brief Mise à jour sur le thread appelant seulement.
+         */
+        std::size_t update();
+
+        /**
+         * @brief Retourne la matrice monde du nœud, calculée par le dernier update().
+         *
+         * @pre node doit être un nœud de la hiérarchie.
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] const glm::mat4& world( const Node node ) const noexcept {
+            return worlds_[slots_[node]];
+        }
+
+        /**
+         * @brief Indique si la matrice monde du nœud a été recalculée par le dernier update().
+         *
+         * @pre node doit être un nœud de la hiérarchie.
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] bool changed( const Node node ) const noexcept {
+            return changed_[slots_[node]] != 0;
+        }
+
+        /**
+         * @brief Retourne le parent du nœud, NO_PARENT pour une racine.
+         *
+         * @pre node doit être un nœud de la hiérarchie.
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] Node parent( Node node ) const noexcept;
+
+        [[nodiscard]] glm::vec3 translation( Node node ) const noexcept;
+        [[nodiscard]] glm::quat rotation( Node node ) const noexcept;
+        [[nodiscard]] glm::vec3 scale( Node node ) const noexcept;
+
+        /**
+         * @brief Modifie la translation du nœud, sa matrice monde et celles de ses descendants suivront au prochain update().
+         *
+         * @pre node doit être un nœud de la hiérarchie.
+         * @exceptsafe NO-THROW.
+         */
+        void setTranslation( Node node, const glm::vec3& translation ) noexcept;
+
+        /**
+         * @brief Modifie la rotation du nœud, normalisée par la hiérarchie.
+         *
+         * @pre node doit être un nœud de la hiérarchie.
+         * @exceptsafe NO-THROW.
+         */
+        void setRotation( Node node, const glm::quat& rotation ) noexcept;
+
+        /**
+         * @brief Modifie l’échelle du nœud sur chaque axe.
+         *
+         * @pre node doit être un nœud de la hiérarchie.
+         * @exceptsafe NO-THROW.
+         */
+        void setScale( Node node, const glm::vec3& scale ) noexcept;
+
+        /**
+         * @brief Retourne le nombre de nœuds.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] std::size_t size() const noexcept {
+            return slots_.size();
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return slots_.empty();
+        }
+
+        /**
+         * @brief Exception lancée si un nœud n’appartient pas à la hiérarchie.
+         *
+         * @version 1.0
+         * @since 0.1
+         * @author Axel DAVID
+         */
+        class UnknownNode final : public LogicError {
+        public:
+            /**
+             * @brief Construit l’exception avec la raison fournie.
+             * @param what_arg La raison de l’exception.
+             *
+             * @exceptsafe NO-THROW.
+             */
+            explicit UnknownNode( const std::string& what_arg ) noexcept
+            : LogicError(what_arg) {}
+
+            /**
+             * @overload
+             * @brief Surcharge du constructeur en passant la raison sous forme de pointeur vers une chaine de caractère.
+             * @param what_arg Le pointeur.
+             */
+            explicit UnknownNode( const char* what_arg ) noexcept
+            : UnknownNode( std::string{what_arg} ) {}
+
+            UnknownNode() noexcept = delete;
+            UnknownNode( const UnknownNode& ) noexcept = default;
+            UnknownNode( UnknownNode&& ) noexcept = default;
+            UnknownNode& operator=( const UnknownNode& ) noexcept = default;
+            UnknownNode& operator=( UnknownNode&& ) noexcept = default;
+            ~UnknownNode() noexcept override = default;
+        };
+
+    private:
+        /// Composantes de la transformation locale, un tableau chacune.
+        enum Component : std::size_t {
+            TRANSLATION_X, TRANSLATION_Y, TRANSLATION_Z,
+            ROTATION_X, ROTATION_Y, ROTATION_Z, ROTATION_W,
+            SCALE_X, SCALE_Y, SCALE_Z,
+            COMPONENT_COUNT
+        };
+
+        /// Les tableaux par nœud ont PADDING éléments de plus : les derniers nœuds se lisent d’un bloc, même avec AVX.
+        static constexpr std::size_t PADDING = 7;
+
+        // Note développeur : tous les tableaux ci-dessous sont rangés par profondeur (emplacements), sauf slots_.
+
+        std::array<std::vector<float>, COMPONENT_COUNT> components_{};
+        /// Emplacement du parent, NO_PARENT pour une racine : toujours inférieur à celui de l’enfant.
+        std::vector<std::uint32_t> parents_{};
+        std::vector<std::uint32_t> depths_{};
+        std::vector<glm::mat4> worlds_{};
+        std::vector<std::uint8_t> dirty_{};
+        std::vector<std::uint8_t> changed_{};
+
+        /// Emplacement de chaque nœud, et nœud de chaque emplacement.
+        std::vector<std::uint32_t> slots_{};
+        std::vector<Node> nodes_{};
+
+        /// Premier emplacement de chaque niveau, suivi du nombre de nœuds.
+        std::vector<std::uint32_t> levels_{};
+        bool sorted_ = true;
+
+        void sortByDepth();
+
+        void updateRange( std::size_t first, std::size_t last ) noexcept;
+    };
+
+    inline TransformHierarchy::Node TransformHierarchy::add( const Node parent ) {
+        return add( parent, glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f) );
+    }
+
+    inline std::size_t TransformHierarchy::update() {
+        return update( 1 );
+    }
+}
+
+#endif // GLENGINE_TRANSFORM_HIERARCHY_HPP
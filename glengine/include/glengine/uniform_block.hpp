@@ -0,0 +1,524 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLENGINE_UNIFORM_BLOCK_HPP
+#define GLENGINE_UNIFORM_BLOCK_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <glengine/exception.hpp>
+#include <glengine/utility.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Alignement, taille et écriture d’un type selon la disposition std140 d’un bloc d’uniformes.
+     *
+     * Types pris en charge : float, std::int32_t, std::uint32_t, bool (écrit sur 4 octets), les vecteurs et matrices
+     * glm de flottants, d’entiers et d’entiers non signés, et std::array de ces types.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::Std140Layout
+     */
+    template<typename T>
+    struct Std140;
+
+    namespace std140 {
+        // Note développeur : Règles de la section 7.6.2.2 de la spécification OpenGL 4.5.
+
+        /// Alignement d’un vec4, celui des matrices et des éléments de tableau.
+        constexpr std::size_t VEC4_ALIGNMENT = 16;
+
+        constexpr std::size_t alignUp( const std::size_t value, const std::size_t alignment ) noexcept {
+            return ( value + alignment - 1 ) / alignment * alignment;
+        }
+
+        /// Scalaire de 4 octets, copié tel quel.
+        template<typename T>
+        struct Scalar {
+            static constexpr std::size_t ALIGNMENT = 4;
+            static constexpr std::size_t SIZE = 4;
+
+            static void write( std::byte* const destination, const T& value ) noexcept {
+                std::memcpy( destination, &value, SIZE );
+            }
+        };
+    }
+
+    template<>
+    struct Std140<float> : std140::Scalar<float> {};
+
+    template<>
+    struct Std140<std::int32_t> : std140::Scalar<std::int32_t> {};
+
+    template<>
+    struct Std140<std::uint32_t> : std140::Scalar<std::uint32_t> {};
+
+    template<>
+    struct Std140<bool> {
+        static constexpr std::size_t ALIGNMENT = 4;
+        static constexpr std::size_t SIZE = 4;
+
+        static void write( std::byte* const destination, const bool& value ) noexcept {
+            Std140<std::uint32_t>::write( destination, value ? 1u : 0u );
+        }
+    };
+
+    /// Un vec3 occupe 12 octets mais est aligné comme un vec4 : le membre suivant peut se loger dans le reste.
+    template<glm::length_t L, typename T, glm::qualifier Q>
+    struct Std140<glm::vec<L, T, Q>> {
+        static_assert( L >= 2 && L <= 4 && sizeof( T ) == 4, "Vecteur de 2 à 4 composantes de 4 octets." );
+
+        static constexpr std::size_t ALIGNMENT = L == 2 ? 8 : std140::VEC4_ALIGNMENT;
+        static constexpr std::size_t SIZE = L * sizeof( T );
+
+        static void write( std::byte* const destination, const glm::vec<L, T, Q>& value ) noexcept {
+            std::memcpy( destination, &value[0], SIZE );
+        }
+    };
+
+    /// Une matrice est un tableau de colonnes : chaque colonne est alignée sur 16 octets.
+    template<glm::length_t C, glm::length_t R, typename T, glm::qualifier Q>
+    struct Std140<glm::mat<C, R, T, Q>> {
+        static_assert( R >= 2 && R <= 4 && sizeof( T ) == 4, "Colonnes de 2 à 4 composantes de 4 octets." );
+
+        static constexpr std::size_t ALIGNMENT = std140::VEC4_ALIGNMENT;
+        static constexpr std::size_t SIZE = C * std140::VEC4_ALIGNMENT;
+
+        static void write( std::byte* const destination, const glm::mat<C, R, T, Q>& value ) noexcept {
+            for ( glm::length_t column = 0; column < C; ++column ) {
+                Std140<glm::vec<R, T, Q>>::write( destination + column * std140::VEC4_ALIGNMENT, value[column] );
+            }
+        }
+    };
+
+    /// Chaque élément d’un tableau est aligné sur 16 octets, quelle que soit sa taille.
+    template<typename T, std::size_t N>
+    struct Std140<std::array<T, N>> {
+        static constexpr std::size_t STRIDE = std140::alignUp( Std140<T>::SIZE, std140::VEC4_ALIGNMENT );
+        static constexpr std::size_t ALIGNMENT = std140::VEC4_ALIGNMENT;
+        static constexpr std::size_t SIZE = N * STRIDE;
+
+        static void write( std::byte* const destination, const std::array<T, N>& value ) noexcept {
+            for ( std::size_t i = 0; i < N; ++i ) {
+                Std140<T>::write( destination + i * STRIDE, value[i] );
+            }
+        }
+    };
+
+    /**
+     * @brief Disposition std140 d’un bloc d’uniformes dont les membres ont, dans l’ordre, les types Members.
+     *
+     * Les décalages sont calculés à la compilation : ils peuvent être vérifiés contre la déclaration GLSL
+     * par static_assert, et contre la disposition lue dans le programme par gl_engine::open_gl::checkUniformBlock.
+     * @code
+     * // layout (std140) uniform Light { vec3 position; float radius; mat3 basis; };
+     * using LightLayout = Std140Layout<glm::vec3, float, glm::mat3>;
+     * static_assert( LightLayout::offset<1>() == 12 && LightLayout::offset<2>() == 16 && LightLayout::SIZE == 64 );
+     *
+     * std::array<std::byte, LightLayout::SIZE> bytes{};
+     * LightLayout::pack( bytes.data(), position, radius, basis );
+     * @endcode
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::Std140
+     */
+    template<typename... Members>
+    class Std140Layout final {
+    public:
+        Std140Layout() noexcept = delete;
+        Std140Layout( const Std140Layout& ) noexcept = delete;
+        Std140Layout( Std140Layout&& ) noexcept = delete;
+        Std140Layout& operator=( const Std140Layout& ) noexcept = delete;
+        Std140Layout& operator=( Std140Layout&& ) noexcept = delete;
+        ~Std140Layout() noexcept = delete;
+
+        static constexpr std::size_t MEMBER_COUNT = sizeof...( Members );
+
+    private:
+        static constexpr std::array<std::size_t, MEMBER_COUNT> computeOffsets() noexcept {
+            constexpr std::array<std::size_t, MEMBER_COUNT> alignments{Std140<Members>::ALIGNMENT...};
+            constexpr std::array<std::size_t, MEMBER_COUNT> sizes{Std140<Members>::SIZE...};
+
+            std::array<std::size_t, MEMBER_COUNT> offsets{};
+            std::size_t cursor = 0;
+            for ( std::size_t i = 0; i < MEMBER_COUNT; ++i ) {
+                offsets[i] = std140::alignUp( cursor, alignments[i] );
+                cursor = offsets[i] + sizes[i];
+            }
+
+            return offsets;
+        }
+
+        static constexpr std::size_t computeSize() noexcept {
+            constexpr std::array<std::size_t, MEMBER_COUNT> sizes{Std140<Members>::SIZE...};
+
+            return MEMBER_COUNT == 0 ? 0 : std140::alignUp( OFFSETS[MEMBER_COUNT - 1] + sizes[MEMBER_COUNT - 1], std140::VEC4_ALIGNMENT );
+        }
+
+    public:
+        /// Décalage de chaque membre depuis le début du bloc, en octets.
+        static constexpr std::array<std::size_t, MEMBER_COUNT> OFFSETS = computeOffsets();
+
+        /// Taille du bloc, GL_UNIFORM_BLOCK_DATA_SIZE : arrondie à un multiple de 16 octets.
+        static constexpr std::size_t SIZE = computeSize();
+
+        /**
+         * @brief Retourne le décalage du membre numéro I.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        template<std::size_t I>
+        [[nodiscard]] static constexpr std::size_t offset() noexcept {
+            static_assert( I < MEMBER_COUNT, "Le bloc n’a pas autant de membres." );
+            return OFFSETS[I];
+        }
+
+        /**
+         * @brief Écrit les membres à leurs décalages std140.
+         * @param destination Le début du bloc, au moins SIZE octets.
+         * @param members Les valeurs des membres, dans l’ordre de la déclaration GLSL.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @note Les octets de remplissage ne sont pas écrits.
+         */
+        static void pack( void* const destination, const Members&... members ) noexcept {
+            pack( static_cast<std::byte*>(destination), std::index_sequence_for<Members...>{}, members... );
+        }
+
+    private:
+        template<std::size_t... I>
+        static void pack( std::byte* const destination, std::index_sequence<I...>, const Members&... members ) noexcept {
+            ( Std140<Members>::write( destination + OFFSETS[I], members ), ... );
+        }
+    };
+
+    /**
+     * @brief Bloc d’uniformes 'Frame', partagé par tous les programmes et mis à jour une fois par image.
+     *
+     * @code
+     * layout (std140) uniform Frame {
+     *     float time;
+     *     float deltaTime;
+     *     uint frame;
+     * };
+     * @endcode
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::RenderQueue::execute
+     */
+    struct FrameBlock {
+        static constexpr const char* NAME = "Frame";
+        static constexpr GLuint BINDING = 0;
+
+        using Layout = Std140Layout<float, float, std::uint32_t>;
+
+        /// Temps écoulé en secondes.
+        float time = 0.0f;
+        /// Durée de l’image précédente en secondes.
+        float deltaTime = 0.0f;
+        std::uint32_t frame = 0;
+
+        void pack( void* const destination ) const noexcept {
+            Layout::pack( destination, time, deltaTime, frame );
+        }
+    };
+
+    static_assert( FrameBlock::Layout::offset<1>() == 4 && FrameBlock::Layout::offset<2>() == 8, "Disposition std140 du bloc 'Frame'." );
+    static_assert( FrameBlock::Layout::SIZE == 16, "Disposition std140 du bloc 'Frame'." );
+
+    /**
+     * @brief Bloc d’uniformes 'Camera', partagé par tous les programmes : changer de caméra est une seule mise à jour.
+     *
+     * @code
+     * layout (std140) uniform Camera {
+     *     mat4 view;
+     *     mat4 projection;
+     *     mat4 viewProjection;
+     *     vec3 eye;
+     * };
+     * @endcode
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::RenderView
+     */
+    struct CameraBlock {
+        static constexpr const char* NAME = "Camera";
+        static constexpr GLuint BINDING = 1;
+
+        using Layout = Std140Layout<glm::mat4, glm::mat4, glm::mat4, glm::vec3>;
+
+        glm::mat4 view{1.0f};
+        glm::mat4 projection{1.0f};
+        glm::mat4 viewProjection{1.0f};
+        glm::vec3 eye{};
+
+        void pack( void* const destination ) const noexcept {
+            Layout::pack( destination, view, projection, viewProjection, eye );
+        }
+    };
+
+    static_assert( CameraBlock::Layout::offset<1>() == 64 && CameraBlock::Layout::offset<2>() == 128
+                   && CameraBlock::Layout::offset<3>() == 192, "Disposition std140 du bloc 'Camera'." );
+    static_assert( CameraBlock::Layout::SIZE == 208, "Disposition std140 du bloc 'Camera'." );
+
+    /**
+     * @brief Membre actif d’un bloc d’uniformes, lu dans un programme lié.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     */
+    struct UniformBlockMember {
+        std::string name{};
+        /// GL_UNIFORM_OFFSET.
+        std::size_t offset = 0;
+    };
+
+    /**
+     * @brief Disposition d’un bloc d’uniformes lue par glGetActiveUniformBlockiv et glGetActiveUniformsiv.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::open_gl::uniformBlockLayout
+     */
+    struct UniformBlockLayout {
+        /// Indice du bloc dans le programme, GL_INVALID_INDEX si le programme ne le déclare pas.
+        GLuint index = ~GLuint{0};
+        /// GL_UNIFORM_BLOCK_DATA_SIZE.
+        std::size_t size = 0;
+        /// Membres actifs par décalage croissant.
+        std::vector<UniformBlockMember> members{};
+
+        [[nodiscard]] bool found() const noexcept {
+            return index != ~GLuint{0};
+        }
+    };
+
+    /**
+     * @brief Exception lancée si la disposition d’un bloc d’uniformes dans un programme diffère de celle attendue.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::open_gl::checkUniformBlock
+     */
+    class UniformBlockMismatch final : public LogicError {
+    public:
+        UniformBlockMismatch() noexcept = delete;
+
+        /**
+         * @brief Construit l’exception avec la raison de l’erreur.
+         * @param what_arg La raison de l’erreur sous forme de chaine de caractère.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        explicit UniformBlockMismatch( const std::string& what_arg ) noexcept
+        : LogicError(what_arg) {}
+
+        UniformBlockMismatch( const UniformBlockMismatch& ) noexcept = default;
+        UniformBlockMismatch( UniformBlockMismatch&& ) noexcept = default;
+        UniformBlockMismatch& operator=( const UniformBlockMismatch& ) noexcept = default;
+        UniformBlockMismatch& operator=( UniformBlockMismatch&& ) noexcept = default;
+        ~UniformBlockMismatch() noexcept override = default;
+    };
+
+    /**
+     * @brief Buffer d’un bloc d’uniformes partagé par plusieurs programmes, lié à un point de liaison fixe.
+     *
+     * Les programmes associent leur bloc au point de liaison par glUniformBlockBinding, une fois après l’édition
+     * des liens : la mise à jour du buffer est ensuite vue par tous, sans aucun appel par programme.
+     * Une mise à jour identique au contenu actuel n’est pas transmise au pilote.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::ShaderProgram::bindUniformBlock
+     */
+    class UniformBuffer final {
+    public:
+        UniformBuffer() noexcept = delete;
+
+        /**
+         * @brief Crée le buffer, non initialisé.
+         * @param size La taille du bloc en octets.
+         *
+         * @pre Un contexte OpenGL doit être courant sur le thread appelant.
+         */
+        explicit UniformBuffer( std::size_t size );
+
+        UniformBuffer( const UniformBuffer& ) noexcept = delete;
+        UniformBuffer( UniformBuffer&& other ) noexcept;
+        UniformBuffer& operator=( const UniformBuffer& ) noexcept = delete;
+        UniformBuffer& operator=( UniformBuffer&& other ) noexcept;
+
+        /**
+         * @brief Supprime le buffer.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        ~UniformBuffer() noexcept;
+
+        /**
+         * @brief Remplace le contenu du buffer par glBufferSubData s’il a changé.
+         * @param data Le nouveau contenu, size() octets.
+         * @return true si le buffer a été mis à jour.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        bool update( const void* data ) noexcept;
+
+        /**
+         * @overload
+         * @brief Écrit le bloc dans sa disposition std140 puis met à jour le buffer.
+         * @param block Le bloc, de taille Block::Layout::SIZE.
+         *
+         * @pre size() doit valoir Block::Layout::SIZE.
+         */
+        template<typename Block, typename = std::enable_if_t<std::is_class_v<Block>>>
+        bool update( const Block& block ) noexcept {
+            std::array<std::byte, Block::Layout::SIZE> bytes{};
+            block.pack( bytes.data() );
+
+            return update( bytes.data() );
+        }
+
+        /**
+         * @brief Lie le buffer au point de liaison fourni par glBindBufferBase, sauf s’il l’est déjà.
+         * @param binding Le point de liaison.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        void bind( GLuint binding ) const noexcept;
+
+        [[nodiscard]] Id buffer() const noexcept {
+            return buffer_;
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept {
+            return contents_.size();
+        }
+
+    private:
+        Id buffer_ = 0;
+        /// Copie du contenu du buffer, comparée à chaque mise à jour.
+        std::vector<std::byte> contents_{};
+        bool initialized_ = false;
+
+        void release() noexcept;
+    };
+
+    namespace open_gl {
+        /**
+         * @brief Lit la disposition d’un bloc d’uniformes dans un programme lié.
+         * @param program Le programme.
+         * @param name Le nom du bloc dans le GLSL.
+         * @return La disposition, dont found() retourne false si le programme ne déclare pas le bloc.
+         *
+         * @pre Un contexte OpenGL doit être courant sur le thread appelant, le programme doit être lié.
+         * @exceptsafe FORT.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        UniformBlockLayout uniformBlockLayout( Id program, const std::string& name );
+
+        /**
+         * @brief Compare la disposition lue dans un programme aux décalages std140 calculés à la compilation.
+         * @param layout La disposition lue par uniformBlockLayout.
+         * @param name Le nom du bloc, pour le message d’erreur.
+         * @param offsets Les décalages attendus des membres, dans l’ordre.
+         * @param size La taille attendue du bloc.
+         *
+         * @throws gl_engine::UniformBlockMismatch Lancée si la taille, le nombre de membres ou un décalage diffère.
+         *
+         * @exceptsafe FORT. Ne modifie aucune donnée.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note Un bloc std140 n’a pas de membre inactif : tous les membres déclarés sont comparés.
+         */
+        void checkUniformBlock( const UniformBlockLayout& layout, const std::string& name,
+                                const std::size_t* offsets, std::size_t memberCount, std::size_t size );
+
+        /**
+         * @brief Associe un bloc d’uniformes d’un programme à un point de liaison, remplace glUniformBlockBinding.
+         * @param program Le programme.
+         * @param index L’indice du bloc, voir gl_engine::UniformBlockLayout::index.
+         * @param binding Le point de liaison.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        void uniformBlockBinding( Id program, GLuint index, GLuint binding ) noexcept;
+
+        /**
+         * @brief Vérifie le bloc Block::NAME d’un programme et l’associe au point de liaison Block::BINDING.
+         * @param program Le programme.
+         * @return true si le programme déclare le bloc.
+         *
+         * @throws gl_engine::UniformBlockMismatch Lancée si la disposition du bloc diffère de Block::Layout.
+         *
+         * @exceptsafe FORT.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        template<typename Block>
+        bool bindUniformBlock( const Id program ) {
+            const auto layout = uniformBlockLayout( program, Block::NAME );
+            if ( !layout.found() ) {
+                return false;
+            }
+
+            checkUniformBlock( layout, Block::NAME, Block::Layout::OFFSETS.data(), Block::Layout::MEMBER_COUNT, Block::Layout::SIZE );
+            uniformBlockBinding( program, layout.index, Block::BINDING );
+
+            return true;
+        }
+    }
+}
+
+#endif // GLENGINE_UNIFORM_BLOCK_HPP
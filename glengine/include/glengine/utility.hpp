@@ -20,12 +20,14 @@
 
 #include <GLFW/glfw3.h>
 
+#include <cstddef>
 #include <stdexcept>
 #include <type_traits>
 #include <string>
 #include <string_view>
 #include <istream>
 #include <filesystem>
+#include <vector>
 
 #include <glengine/exception.hpp>
 
@@ -42,6 +44,10 @@ namespace gl_engine {
     using Size = GLsizei;
 
     using Length = GLint;
+
+    class MeshCache;
+    class TextureCache;
+    class ObjectFactory;
 }
 
 /**
@@ -216,6 +222,45 @@ namespace gl_engine::utility {
         ~ErrorClosingFile() noexcept override = default;
     };
 
+    /**
+     * @brief Exception lancée si une erreur survient durant l’écriture d’un fichier.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::MeshCache
+     */
+    class ErrorWritingFile final : public IOException {
+    public:
+        /**
+         * @brief Crée une exception indiquant une erreur d’écriture du fichier avec l’adresse du fichier passée en paramètre.
+         * @param fileUrl L’adresse du fichier ne pouvant pas être écrit.
+         *
+         * @exceptsafe NO-THROWS.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        explicit ErrorWritingFile( const std::string& fileUrl ) noexcept
+        : IOException("Erreur durant l’écriture du fichier : " + fileUrl) {}
+
+        /**
+         * @overload
+         * @brief Surcharge prenant l’adresse du fichier sous forme de pointeur vers chaine de caractère.
+         * @param fileUrl Le pointeur vers la chaine de caractère.
+         */
+        explicit ErrorWritingFile( const char* fileUrl ) noexcept
+        : ErrorWritingFile(std::string{fileUrl}) {}
+
+        ErrorWritingFile() noexcept = delete;
+        ErrorWritingFile( const ErrorWritingFile& ) noexcept = default;
+        ErrorWritingFile( ErrorWritingFile&& ) noexcept = default;
+        ErrorWritingFile& operator=( const ErrorWritingFile& ) noexcept = default;
+        ErrorWritingFile& operator=( ErrorWritingFile&& ) noexcept = default;
+        ~ErrorWritingFile() noexcept override = default;
+    };
+
     /**
      * @brief Exception lancée lorsqu’une erreur survient durant l’ouverture d’un flux.
      *
@@ -514,6 +559,19 @@ namespace gl_engine::utility {
          */
         [[nodiscard]] std::string content() const noexcept;
 
+        /**
+         * @brief Retourne une vue sur le contenu, sans copie.
+         * @return Une vue valide tant que l’objet Content existe.
+         *
+         * @exceptsafe NO-THROWS.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        [[nodiscard]] std::string_view view() const noexcept {
+            return content_;
+        }
+
         /**
          * @brief Retourne le type de la source. Dans le cas d’un path, cela retourne aussi le chemin du fichier contenant le code source.
          * @return Une chaine de caractère
@@ -748,6 +806,14 @@ namespace gl_engine::utility {
 
         friend class Image;
 
+        friend class MappedFile;
+
+        friend class gl_engine::MeshCache;
+
+        friend class gl_engine::TextureCache;
+
+        friend class gl_engine::ObjectFactory;
+
     private:
         // Dans le cas que seul la classe Content utilise Path, stocké un pointeur vers un const char*
         // peut être une optimisation de taille, si cela est nécessaire.
@@ -836,6 +902,32 @@ namespace gl_engine::utility {
         Image& operator=( Image&& ) noexcept = default;
         ~Image() noexcept = default;
 
+        [[nodiscard]] int width() const noexcept {
+            return width_;
+        }
+
+        [[nodiscard]] int height() const noexcept {
+            return height_;
+        }
+
+        /**
+         * @brief Retourne le nombre de composantes par pixel, entre 1 et 4.
+         *
+         * @exceptsafe NO-THROWS.
+         */
+        [[nodiscard]] int channels() const noexcept {
+            return channels_;
+        }
+
+        /**
+         * @brief Retourne les pixels, ligne par ligne, channels() octets par pixel.
+         *
+         * @exceptsafe NO-THROWS.
+         */
+        [[nodiscard]] const unsigned char* data() const noexcept {
+            return data_.get();
+        }
+
     private:
         int width_ = 0;
         int height_ = 0;
@@ -855,6 +947,95 @@ namespace gl_engine::utility {
     };
 
 
+    /**
+     * @brief Projection en lecture seule d’un fichier régulier dans la mémoire du processus.
+     *
+     * Le contenu du fichier n’est jamais copié : le système charge les pages à la demande lors de leur lecture.
+     * Le contenu est exposé sous la forme d’une std::string_view valide durant toute la durée de vie de l’objet.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::utility::Path
+     * @see gl_engine::utility::Content
+     */
+    class MappedFile final {
+    public:
+        MappedFile() noexcept = delete;
+
+        /**
+         * @brief Projette en mémoire le fichier pointé par path.
+         * @param path Le chemin vers le fichier à projeter.
+         *
+         * @pre Le fichier ne doit pas être vide.
+         * @throws gl_engine::utility::EmptySource Lancée si le fichier est vide.
+         * @throws gl_engine::utility::ErrorOpeningFile Lancée si le fichier ne peut pas être ouvert.
+         * @throws gl_engine::utility::ErrorReadingFile Lancée si le fichier ne peut pas être projeté en mémoire.
+         * @post view() retourne le contenu complet du fichier.
+         *
+         * @exceptsafe FORT. Aucune ressource n’est conservée en cas d’exception.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        explicit MappedFile( const Path& path );
+
+        MappedFile( const MappedFile& ) noexcept = delete;
+        MappedFile( MappedFile&& other ) noexcept;
+        MappedFile& operator=( const MappedFile& ) noexcept = delete;
+        MappedFile& operator=( MappedFile&& other ) noexcept;
+
+        /**
+         * @brief Libère la projection du fichier.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        ~MappedFile() noexcept;
+
+        /**
+         * @brief Retourne une vue sur le contenu du fichier.
+         * @return Une vue non propriétaire, valide tant que l’objet existe.
+         *
+         * @exceptsafe NO-THROW.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        [[nodiscard]] std::string_view view() const noexcept {
+            return {data_, size_};
+        }
+
+        /**
+         * @brief Retourne un pointeur vers le premier octet du fichier.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] const char* data() const noexcept {
+            return data_;
+        }
+
+        /**
+         * @brief Retourne la taille du fichier en octets.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] std::size_t size() const noexcept {
+            return size_;
+        }
+
+    private:
+        const char* data_ = nullptr;
+
+        std::size_t size_ = 0;
+
+        // Note développeur : Poignée du mapping, nécessaire seulement sous Windows.
+        void* handle_ = nullptr;
+
+        void release() noexcept;
+    };
+
+
     class Dimension final {
     public:
         GLsizei width;
@@ -876,6 +1057,7 @@ namespace gl_engine {
     using Path = gl_engine::utility::Path;
     using Image = gl_engine::utility::Image;
     using Dimension = gl_engine::utility::Dimension;
+    using MappedFile = gl_engine::utility::MappedFile;
 }
 
 namespace gl_engine::open_gl {
@@ -933,12 +1115,16 @@ namespace gl_engine::open_gl {
     /**
      * @brief Surcharge de la macro glUseProgram
      * @param id
+     *
+     * @note L’appel n’est transmis que si le programme n’est pas déjà utilisé, voir gl_engine/gl_state.hpp.
      */
     void useProgram( Id id );
 
     /**
      * @brief Surcharge de la macro glDeleteProgram
      * @param id_
+     *
+     * @note Le programme est oublié par le cache d’états, voir gl_engine/gl_state.hpp.
      */
     void deleteProgram( Id id );
 
@@ -964,9 +1150,118 @@ namespace gl_engine::open_gl {
 
     GLint getUniformLocation( Id idProgram, std::string name );
 
+    /**
+     * @brief Indique si les binaires de programme sont utilisables : contexte OpenGL 4.1 ou plus récent.
+     *
+     * @exceptsafe NO-THROW.
+     *
+     * @note Chargées comme glMultiDrawElementsIndirect, voir hasMultiDrawIndirect. Le pilote peut n’accepter
+     * aucun format (GL_NUM_PROGRAM_BINARY_FORMATS nul), voir gl_engine::ProgramBinaryCache.
+     */
+    bool hasProgramBinary() noexcept;
+
+    /**
+     * @brief Surcharge de la fonction glProgramParameteri.
+     * @param id Le programme.
+     * @param name Le paramètre, GL_PROGRAM_BINARY_RETRIEVABLE_HINT par exemple.
+     * @param value La valeur.
+     *
+     * @pre hasProgramBinary() doit retourner true.
+     */
+    void programParameter( Id id, GLenum name, GLint value ) noexcept;
+
+    /**
+     * @brief Surcharge de la fonction glGetProgramBinary.
+     * @param id Le programme, dont les liens ont été édités.
+     * @param format Reçoit le format du binaire, propre au pilote.
+     * @return Le binaire, vide si le pilote n’en fournit pas.
+     *
+     * @pre hasProgramBinary() doit retourner true.
+     * @exceptsafe FORT.
+     */
+    std::vector<char> getProgramBinary( Id id, GLenum& format );
+
+    /**
+     * @brief Surcharge de la fonction glProgramBinary : remplace l’édition des liens du programme.
+     * @param id Le programme.
+     * @param format Le format, lu avec le binaire.
+     * @param binary Le binaire.
+     * @param size La taille du binaire en octets.
+     *
+     * @pre hasProgramBinary() doit retourner true.
+     * @post GL_LINK_STATUS indique si le pilote a accepté le binaire.
+     */
+    void programBinary( Id id, GLenum format, const void* binary, Size size ) noexcept;
+
+    /**
+     * @brief Indique si le pilote compile les shaders en arrière-plan : extension GL_KHR_parallel_shader_compile
+     * (ou GL_ARB_parallel_shader_compile).
+     *
+     * @exceptsafe NO-THROW.
+     *
+     * @note Avec l’extension, glCompileShader et glLinkProgram rendent la main tout de suite, et
+     * GL_COMPLETION_STATUS_KHR indique sans attendre si le travail est terminé. Chargée au premier appel,
+     * comme glMultiDrawElementsIndirect.
+     */
+    bool hasParallelShaderCompile() noexcept;
+
+    /**
+     * @brief Surcharge de la fonction glMaxShaderCompilerThreadsKHR.
+     * @param count Le nombre de threads de compilation du pilote, 0xFFFFFFFF pour le maximum du pilote.
+     *
+     * @pre hasParallelShaderCompile() doit retourner true.
+     */
+    void maxShaderCompilerThreads( GLuint count ) noexcept;
+
     template <typename T>
     void setUniform( Id id, T value );
     //endregion
+
+    // region Draw
+    /**
+     * @brief Indique si glMultiDrawElementsIndirect est utilisable : contexte OpenGL 4.3 ou plus récent.
+     *
+     * @exceptsafe NO-THROW.
+     *
+     * @note La fonction ne fait pas partie du chargeur glad du moteur (OpenGL 3.3), elle est chargée par
+     * glfwGetProcAddress au premier appel, un contexte doit donc être courant.
+     */
+    bool hasMultiDrawIndirect() noexcept;
+
+    /**
+     * @brief Surcharge de la fonction glMultiDrawElementsIndirect.
+     * @param mode Les primitives, GL_TRIANGLES par exemple.
+     * @param type Le type des indices.
+     * @param indirect Décalage de la première commande dans le buffer lié à GL_DRAW_INDIRECT_BUFFER.
+     * @param drawCount Le nombre de commandes.
+     * @param stride L’écart entre deux commandes, 0 si elles sont contiguës.
+     *
+     * @pre hasMultiDrawIndirect() doit retourner true.
+     */
+    void multiDrawElementsIndirect( GLenum mode, GLenum type, const void* indirect, Size drawCount, Size stride ) noexcept;
+    // endregion
+
+    // region Buffer
+    /**
+     * @brief Indique si glBufferStorage est utilisable : contexte OpenGL 4.4 ou plus récent.
+     *
+     * @exceptsafe NO-THROW.
+     *
+     * @note Chargée comme glMultiDrawElementsIndirect, voir hasMultiDrawIndirect.
+     */
+    bool hasBufferStorage() noexcept;
+
+    /**
+     * @brief Surcharge de la fonction glBufferStorage : alloue un stockage immuable au buffer lié à target.
+     * @param target La cible où le buffer est lié.
+     * @param size La taille du stockage en octets.
+     * @param data Le contenu initial, nullptr pour un contenu indéfini.
+     * @param flags Combinaison de GL_MAP_WRITE_BIT, GL_MAP_PERSISTENT_BIT, GL_MAP_COHERENT_BIT...
+     *
+     * @pre hasBufferStorage() doit retourner true.
+     */
+    void bufferStorage( GLenum target, std::ptrdiff_t size, const void* data, GLbitfield flags ) noexcept;
+    // endregion
 }
 
 #endif // GLENGINE_UTILITY_HPP
@@ -0,0 +1,162 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLENGINE_VERTEX_FORMAT_HPP
+#define GLENGINE_VERTEX_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <glengine/mesh.hpp>
+
+namespace gl_engine {
+    /**
+     * @brief Format des sommets envoyés à la carte graphique, éventuellement compressé.
+     *
+     * | Attribut  | Non compressé        | Compressé                                                  |
+     * |-----------|----------------------|------------------------------------------------------------|
+     * | Position  | 3 × GL_FLOAT (12 o)  | 3 × GL_UNSIGNED_SHORT normalisés dans la boite englobante (8 o) |
+     * | Normale   | 3 × GL_FLOAT (12 o)  | GL_INT_2_10_10_10_REV normalisé (4 o)                      |
+     * | Texture   | 2 × GL_FLOAT (8 o)   | 2 × GL_HALF_FLOAT (4 o)                                    |
+     *
+     * Normales et coordonnées de texture sont décodées par le matériel lors de la lecture des attributs.
+     * Seules les positions quantifiées demandent un changement d’échelle, fait par le code GLSL généré
+     * par glslDecoder() à partir des uniformes POSITION_OFFSET_UNIFORM et POSITION_SCALE_UNIFORM.
+     *
+     * @version 1.0
+     * @since 0.1
+     * @author Axel DAVID
+     *
+     * @see gl_engine::MeshBuffer
+     */
+    struct VertexFormat {
+        /// Nom de l’uniforme vec3 contenant le coin minimal de la boite englobante.
+        static constexpr std::string_view POSITION_OFFSET_UNIFORM = "glengine_positionOffset";
+        /// Nom de l’uniforme vec3 contenant la taille de la boite englobante.
+        static constexpr std::string_view POSITION_SCALE_UNIFORM = "glengine_positionScale";
+
+        /// Positions quantifiées sur 16 bits relativement à la boite englobante du maillage.
+        bool quantizePositions = false;
+        /// Normales compressées en GL_INT_2_10_10_10_REV.
+        bool packNormals = false;
+        /// Coordonnées de texture en demi-flottants.
+        bool halfTexCoords = false;
+
+        /**
+         * @brief Retourne le format où tous les attributs sont compressés.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] static constexpr VertexFormat compressed() noexcept {
+            return {true, true, true};
+        }
+
+        /**
+         * @brief Indique si le format est celui de gl_engine::Vertex, les sommets sont alors envoyés sans conversion.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] constexpr bool isUncompressed() const noexcept {
+            return !quantizePositions && !packNormals && !halfTexCoords;
+        }
+
+        [[nodiscard]] constexpr std::size_t positionOffset() const noexcept {
+            return 0;
+        }
+
+        [[nodiscard]] constexpr std::size_t normalOffset() const noexcept {
+            // Trois composantes de 16 bits et une de remplissage pour garder l’alignement sur 4 octets.
+            return quantizePositions ? 4 * sizeof( std::uint16_t ) : 3 * sizeof( float );
+        }
+
+        [[nodiscard]] constexpr std::size_t texCoordOffset() const noexcept {
+            return normalOffset() + ( packNormals ? sizeof( std::uint32_t ) : 3 * sizeof( float ) );
+        }
+
+        /**
+         * @brief Retourne la taille d’un sommet en octets.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] constexpr std::size_t stride() const noexcept {
+            return texCoordOffset() + ( halfTexCoords ? 2 * sizeof( std::uint16_t ) : 2 * sizeof( float ) );
+        }
+
+        /**
+         * @brief Convertit les sommets du maillage dans ce format.
+         * @param mesh Le maillage.
+         * @return vertexCount() × stride() octets.
+         *
+         * @exceptsafe FORT. Ne modifie aucune donnée.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        [[nodiscard]] std::vector<std::uint8_t> encode( const Mesh& mesh ) const;
+
+        /**
+         * @brief Retourne la valeur de l’uniforme POSITION_OFFSET_UNIFORM pour le maillage.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] static glm::vec3 positionOffset( const Bounds& bounds ) noexcept {
+            return bounds.min;
+        }
+
+        /**
+         * @brief Retourne la valeur de l’uniforme POSITION_SCALE_UNIFORM pour le maillage.
+         *
+         * @exceptsafe NO-THROW.
+         */
+        [[nodiscard]] static glm::vec3 positionScale( const Bounds& bounds ) noexcept {
+            return bounds.max - bounds.min;
+        }
+
+        /**
+         * @brief Génère les déclarations GLSL des attributs et les fonctions de décodage.
+         * @return Du code GLSL 330 déclarant les attributs aux emplacements de gl_engine::MeshBuffer
+         * et les fonctions meshPosition(), meshNormal() et meshTexCoord().
+         *
+         * @exceptsafe FORT.
+         *
+         * @version 1.0
+         * @since 0.1
+         */
+        [[nodiscard]] std::string glslDecoder() const;
+
+        /**
+         * @brief Insère le code de glslDecoder() après la directive '#version' d’un vertex shader.
+         * @param vertexSource Le code source du vertex shader, qui doit utiliser meshPosition(), meshNormal() et meshTexCoord().
+         * @return Le code source complété.
+         *
+         * @exceptsafe FORT.
+         *
+         * @version 1.0
+         * @since 0.1
+         *
+         * @note Le code est inséré au début si la source ne contient pas de directive '#version'.
+         */
+        [[nodiscard]] std::string injectDecoder( std::string_view vertexSource ) const;
+    };
+}
+
+#endif // GLENGINE_VERTEX_FORMAT_HPP
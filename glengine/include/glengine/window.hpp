@@ -36,6 +36,7 @@
 
 #include <glengine/glfw/glfw.hpp>
 #include <glengine/utility.hpp>
+#include <glengine/gl_state.hpp>
 #include <glengine/scene.hpp>
 
 namespace gl_engine::glfw {
@@ -94,6 +95,7 @@ namespace gl_engine {
          * @note L’exception gl_engine::glfw::Platform_Error est expliqué dans le lien fourni.
          */
         void operator()( GLFWwindow* const window ) const {
+            open_gl::releaseState(window);
             interface::SmartDestroyWindow_GLFW::destroyWindow(window);
         }
     };
@@ -181,7 +183,7 @@ namespace gl_engine {
         Window& operator=( const Window& other ) noexcept = delete;
         Window& operator=( Window&& other ) noexcept {
             title_ = std::move(other.title_);
-            scene_ = other.scene_;
+            scene_ = std::move(other.scene_);
             handle_ = std::move(other.handle_);
             resizeFunction_ = std::move(other.resizeFunction_);
 
@@ -198,11 +200,13 @@ namespace gl_engine {
         /**
          * @brief Demande le rendu de la fenêtre.
          *
-         * @see void gl_engine::Scene::render() const
+         * @see void gl_engine::Scene::render()
          *
          * @note Cette fonction donnera un rendu noir si aucune scène n’a été liée à la fenêtre.
+         * @note La scène n’est pas copiable (sa file de rendu conserve l’état GL de l’image précédente),
+         * la fenêtre ne peut donc être que déplacée.
          */
-        void render() const;
+        void render();
 
         void addScene( Scene scene );
 
@@ -18,11 +18,20 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
-#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <glengine/abstract_shader.hpp>
+#include <glengine/gl_state.hpp>
+#include <glengine/hash.hpp>
 #include "glengine/utility.hpp"
 
 namespace gl_engine::open_gl {
@@ -31,352 +40,234 @@ namespace gl_engine::open_gl {
     }
 }
 
-// Constructors
-gl_engine::AbstractShader::AbstractShader( const Shader_t type, Content source )
-        : Shader() {
-    // TODO Vérifier les erreurs opengl avant
-
-    privateId_ = open_gl::createShader(type);
-    // Vérifier que la création du shader est valide(aka le type)
-    if ( 0 == privateId_ ) {
-        GLint sizeLog = 0;
-        glGetShaderiv( privateId_, GL_INFO_LOG_LENGTH, &sizeLog );
-
-        // TODO Vider glGetError
-
-        //const auto logMessage = std::make_unique<char[]>( static_cast<size_t>(sizeLog) );
-        std::string logMessage;
-        logMessage.resize(static_cast<size_t>(sizeLog), '\0' );
-        glGetShaderInfoLog( privateId_, sizeLog, nullptr, logMessage.data() );
+namespace gl_engine {
+    /**
+     * @brief Shader OpenGL compilé, supprimé avec sa dernière référence.
+     *
+     * La source est conservée : elle départage deux sources de même empreinte dans gl_engine::ShaderCache et
+     * évite de la relire avec glGetShaderSource.
+     */
+    class AbstractShader::Object final {
+    public:
+        Object( const Id id, const Shader_t type, std::string source, const std::uint64_t context ) noexcept
+        : id(id), type(type), source(std::move(source)), context(context) {}
+
+        Object( const Object& ) = delete;
+        Object( Object&& ) = delete;
+        Object& operator=( const Object& ) = delete;
+        Object& operator=( Object&& ) = delete;
+
+        ~Object() noexcept {
+            ShaderCache::release( context, id );
+        }
 
-        std::string errorMessage( "ERROR::CREATE_SHADER::TYPE : " );
-        errorMessage.append( "TYPE"/*type*/ ).append( " , source : " )
-                    .append( source.type() ).append( " : " ).append( logMessage );
+        const Id id;
+        const Shader_t type;
+        const std::string source;
+
+        /// Contexte dans lequel le shader a été compilé, voir gl_engine::open_gl::currentContext.
+        const std::uint64_t context;
+    };
+
+    struct ShaderCache::State {
+        /**
+         * @brief Contexte, type et empreinte de la source d’un shader.
+         */
+        struct Key {
+            std::uint64_t context;
+            GLenum type;
+            std::uint64_t hash;
+
+            bool operator==( const Key& other ) const noexcept {
+                return context == other.context && type == other.type && hash == other.hash;
+            }
+        };
 
-        throw std::runtime_error( errorMessage );
-    }
+        struct KeyHash {
+            std::size_t operator()( const Key& key ) const noexcept {
+                // Note développeur : L’empreinte de la source est déjà mélangée, seuls contexte et type sont combinés.
+                return static_cast<std::size_t>(utility::combine( utility::combine( key.hash, key.type ), key.context ));
+            }
+        };
+
+        std::mutex mutex{};
+        std::unordered_map<Key, std::weak_ptr<const AbstractShader::Object>, KeyHash> shaders{};
+
+        // Note développeur : Les suppressions différées ont leur propre verrou : un shader peut être détruit
+        // pendant que mutex est pris, par la dernière référence rendue par un weak_ptr.
+        std::mutex deletionMutex{};
+        /// Shaders à supprimer dans leur contexte, détruits pendant qu’un autre contexte était courant.
+        std::vector<std::pair<std::uint64_t, Id>> deletions{};
+
+        /**
+         * @brief Supprime les shaders différés du contexte courant et oublie ceux des contextes détruits.
+         */
+        void flushDeletions( const std::uint64_t current ) noexcept {
+            const std::lock_guard<std::mutex> lock(deletionMutex);
+
+            const auto end = std::remove_if( deletions.begin(), deletions.end(), [current]( const auto& deletion ) noexcept {
+                if ( deletion.first == current ) {
+                    open_gl::deleteShader( deletion.second );
+                    return true;
+                }
+
+                // Un contexte détruit a emporté ses shaders.
+                return !open_gl::isContextAlive( deletion.first );
+            } );
+            deletions.erase( end, deletions.end() );
+        }
+    };
 
-    // Le shader a été alloué
-    // Toutes exceptions lancées doivent supprimer le shader
-    try {
-        compile(std::move(source) );
-    }
-    catch ( ... ) {
-        open_gl::deleteShader(privateId_);
-        throw;
+    ShaderCache::State& ShaderCache::state() {
+        static State state{};
+        return state;
     }
 
-    // TODO Vérifier les erreurs finales
-}
+    std::shared_ptr<const AbstractShader::Object> ShaderCache::acquire( const Shader_t type, const Content& source ) {
+        const auto text = source.view();
+        // Note développeur : L’identifiant du contexte n’est jamais réutilisé, contrairement à son adresse :
+        // un contexte recréé au même endroit ne retrouve pas les shaders de l’ancien.
+        const State::Key key{open_gl::currentContext(), type.get(), utility::hashBytes( text.data(), text.size() )};
 
-gl_engine::AbstractShader::AbstractShader( const AbstractShader& other ) {
-    // TODO Vérifier les erreurs opengl avant
-
-    const auto type = other.getType();
-    const auto source = other.getSource();
-
-    privateId_ = open_gl::createShader(type);
-    // Vérifier que la création du shader est valide(aka le type)
-    if ( 0 == privateId_ ) {
-        GLint sizeLog = 0;
-        glGetShaderiv( privateId_, GL_INFO_LOG_LENGTH, &sizeLog );
+        auto& state = ShaderCache::state();
+        state.flushDeletions( key.context );
 
-        // TODO Vider glGetError
+        // Note développeur : Le verrou est conservé pendant la compilation, comme dans gl_engine::TextureCache :
+        // une source demandée deux fois à la fois n’est compilée qu’une fois.
+        const std::lock_guard<std::mutex> lock(state.mutex);
 
-        //const auto logMessage = std::make_unique<char[]>( static_cast<size_t>(sizeLog) );
-        std::string logMessage;
-        logMessage.resize(static_cast<size_t>(sizeLog), '\0' );
-        glGetShaderInfoLog( privateId_, sizeLog, nullptr, logMessage.data() );
+        const auto found = state.shaders.find( key );
+        if ( found != state.shaders.end() ) {
+            if ( auto shader = found->second.lock(); shader != nullptr && shader->source == text ) {
+                return shader;
+            }
+        }
 
-        std::string errorMessage( "ERROR::CREATE_SHADER::TYPE : " );
-        errorMessage.append( "TYPE"/*type*/ ).append( " , source : " )
-                    .append( source.type() ).append( " : " ).append( logMessage );
+        // Note développeur : Deux sources de même empreinte ne partagent pas de shader, la dernière remplace l’entrée.
+        // L’entrée n’est écrite qu’après la compilation, une erreur ne laisse donc rien dans le cache.
+        auto shader = AbstractShader::compile( type, source );
+        state.shaders[key] = shader;
 
-        throw std::runtime_error( errorMessage );
+        return shader;
     }
 
-    // Le shader a été alloué
-    // Toutes exceptions lancées doivent supprimer le shader
-    try {
-        open_gl::shaderSource( privateId_, source );
-
-        GLint sizeLog = 0;
-        glGetShaderiv( privateId_, GL_INFO_LOG_LENGTH, &sizeLog );
-
-        if ( sizeLog > 0 ) {
-            //const auto logMessage = std::make_unique<char[]>( static_cast<size_t>(sizeLog) );
-            std::string logMessage;
-            logMessage.resize(static_cast<size_t>(sizeLog), '\0' );
-            glGetShaderInfoLog( privateId_, sizeLog, nullptr, logMessage.data() );
-
-            std::string errorMessage( "ERROR::SOURCE_SHADER::TYPE : " );
-            errorMessage.append( "TYPE"/*type*/ ).append( " , source : " ).append( source.type() ).append(
-                    " : " ).append( logMessage );
-
-            throw std::runtime_error( errorMessage );
+    void ShaderCache::release( const std::uint64_t context, const Id id ) noexcept {
+        if ( open_gl::currentContext() == context ) {
+            open_gl::deleteShader( id );
+            return;
         }
 
-        // Compiler
-        open_gl::compileShader(privateId_);
-
-        // Vérifier les erreurs
-        GLint success = GL_FALSE;
-        glGetShaderiv( privateId_, GL_COMPILE_STATUS, &success );
-
-        if ( GL_FALSE == static_cast<GLboolean>(success) ) {
-            glGetShaderiv( privateId_, GL_INFO_LOG_LENGTH, &sizeLog );
-            //const auto logMessage = std::make_unique<char[]>( static_cast<size_t>(sizeLog) );
-            std::string logMessage;
-            logMessage.resize(static_cast<size_t>(sizeLog), '\0' );
-            glGetShaderInfoLog( privateId_, sizeLog, nullptr, logMessage.data() );
-
-            std::string errorMessage( "ERROR::COMPILATION_SHADER::TYPE : " );
-            errorMessage.append( "TYPE"/*type*/ ).append( " , source : " ).append( source.type() ).append(
-                    " : " ).append( logMessage );
-
-            throw std::runtime_error( errorMessage );
+        // Note développeur : glDeleteShader dans un autre contexte supprimerait un shader sans rapport de même identifiant.
+        if ( !open_gl::isContextAlive( context ) ) {
+            return;
         }
-    }
-    catch ( ... ) {
-        open_gl::deleteShader(privateId_);
-        throw;
-    }
-
-    // TODO Vérifier les erreurs finales
-}
-
-gl_engine::AbstractShader::AbstractShader( AbstractShader&& other ) noexcept {
-    // TODO Vérifier les erreurs opengl avant
-
-    privateId_ = std::exchange(other.privateId_, 0);
-
-    // TODO Vérifier les erreurs finales
-}
-
-gl_engine::AbstractShader& gl_engine::AbstractShader::operator=( const gl_engine::AbstractShader& other ) {
-    // TODO Vérifier les erreurs opengl avant
-
-    if ( &other != this ) {
-
-        const auto source = other.getSource();
-
-        if ( const auto type = other.getType();
-                getType() != type ) {
-            // TODO Erreur opengl
-            open_gl::deleteShader( privateId_ );
-            // TODO erreur delete
 
-            privateId_ = open_gl::createShader( type );
-            // Vérifier que la création du shader est valide(aka le type)
-            if ( 0 == privateId_ ) {
-                GLint sizeLog = 0;
-                glGetShaderiv( privateId_, GL_INFO_LOG_LENGTH, &sizeLog );
-
-                // TODO Vider glGetError
-
-                //const auto logMessage = std::make_unique<char[]>( static_cast<size_t>(sizeLog) );
-                std::string logMessage;
-                logMessage.resize( static_cast<size_t>(sizeLog), '\0' );
-                glGetShaderInfoLog( privateId_, sizeLog, nullptr, logMessage.data() );
+        auto& state = ShaderCache::state();
+        const std::lock_guard<std::mutex> lock(state.deletionMutex);
+        state.deletions.emplace_back( context, id );
+    }
 
-                std::string errorMessage( "ERROR::CREATE_SHADER::TYPE : " );
-                errorMessage.append( "TYPE"/*type*/ ).append( " , source : " ).append( source.type() ).append(
-                        " : " ).append( logMessage );
+    std::size_t ShaderCache::size() noexcept {
+        auto& state = ShaderCache::state();
+        const std::lock_guard<std::mutex> lock(state.mutex);
 
-                throw std::runtime_error( errorMessage );
-            }
+        std::size_t count = 0;
+        for ( const auto& [key, shader] : state.shaders ) {
+            count += shader.expired() ? 0 : 1;
         }
 
-        try {
-            open_gl::shaderSource( privateId_, source );
-
-            GLint sizeLog = 0;
-            glGetShaderiv( privateId_, GL_INFO_LOG_LENGTH, &sizeLog );
-
-            if ( sizeLog > 0 ) {
-                //const auto logMessage = std::make_unique<char[]>( static_cast<size_t>(sizeLog) );
-                std::string logMessage;
-                logMessage.resize( static_cast<size_t>(sizeLog), '\0' );
-                glGetShaderInfoLog( privateId_, sizeLog, nullptr, logMessage.data() );
-
-                std::string errorMessage( "ERROR::SOURCE_SHADER::TYPE : " );
-                errorMessage.append( "TYPE"/*type*/ ).append( " , source : " ).append( source.type() ).append(
-                        " : " ).append( logMessage );
-
-                throw std::runtime_error( errorMessage );
-            }
-
-            // Compiler
-            open_gl::compileShader( privateId_ );
-
-            // Vérifier les erreurs
-            GLint success = GL_FALSE;
-            glGetShaderiv( privateId_, GL_COMPILE_STATUS, &success );
+        return count;
+    }
 
-            if ( GL_FALSE == static_cast<GLboolean>(success) ) {
-                glGetShaderiv( privateId_, GL_INFO_LOG_LENGTH, &sizeLog );
-                //const auto logMessage = std::make_unique<char[]>( static_cast<size_t>(sizeLog) );
-                std::string logMessage;
-                logMessage.resize( static_cast<size_t>(sizeLog), '\0' );
-                glGetShaderInfoLog( privateId_, sizeLog, nullptr, logMessage.data() );
+    void ShaderCache::purge() noexcept {
+        auto& state = ShaderCache::state();
+        state.flushDeletions( open_gl::currentContext() );
 
-                std::string errorMessage( "ERROR::COMPILATION_SHADER::TYPE : " );
-                errorMessage.append( "TYPE"/*type*/ ).append( " , source : " ).append( source.type() ).append(
-                        " : " ).append( logMessage );
+        const std::lock_guard<std::mutex> lock(state.mutex);
 
-                throw std::runtime_error( errorMessage );
-            }
-        }
-        catch ( ... ) {
-            open_gl::deleteShader( privateId_ );
-            throw;
+        for ( auto it = state.shaders.begin(); it != state.shaders.end(); ) {
+            const auto unused = it->second.expired() || !open_gl::isContextAlive( it->first.context );
+            it = unused ? state.shaders.erase( it ) : std::next( it );
         }
-        // TODO Vérifier les erreurs finales
     }
-
-    return *this;
 }
 
-gl_engine::AbstractShader& gl_engine::AbstractShader::operator=( gl_engine::AbstractShader&& other ) noexcept {
-    if ( &other != this ) {
-        // TODO Vérifier erreur
-        open_gl::deleteShader( privateId_ );
-        // TODO Vérifier erreur après
-
-        privateId_ = std::exchange( other.privateId_, 0 );
-    }
-
-    return *this;
-}
+// Constructors
+gl_engine::AbstractShader::AbstractShader( const Shader_t type, Content content )
+        : Shader(), object_(ShaderCache::acquire( type, content )) {}
 
-// Destructor
-gl_engine::AbstractShader::~AbstractShader() noexcept {
-    // TODO les erreurs avant doivent juste être lancées
-    open_gl::deleteShader(privateId_);
-    // TODO Vérification des erreurs
-    // TODO les erreurs doivent faire planter l'executions
+// region Getters
+gl_engine::Id gl_engine::AbstractShader::id_() const noexcept {
+    // Note développeur : Un shader déplacé n’a plus d’objet, 0 est ignoré par OpenGL comme avant.
+    return object_ != nullptr ? object_->id : 0;
 }
 
-// region Getters
 gl_engine::Shader_t gl_engine::AbstractShader::type_() const {
-    GLint type = GL_NONE;
-    glGetShaderiv( privateId_, GL_SHADER_TYPE, &type );
-
-    if ( GL_NONE == type ) {
-        GLint sizeLog = 0;
-        glGetShaderiv( privateId_, GL_INFO_LOG_LENGTH, &sizeLog );
-
-        //const auto logMessage = std::make_unique<char[]>( static_cast<size_t>(sizeLog) );
-        std::string logMessage;
-        logMessage.resize(static_cast<size_t>(sizeLog), '\0' );
-        glGetShaderInfoLog( privateId_, sizeLog, nullptr, logMessage.data() );
-
-        std::string errorMessage( "ERROR::GET_TYPE_SHADER::ID : " );
-        errorMessage.append( std::to_string(privateId_) ).append( " : ").append( logMessage );
-
-        throw std::runtime_error( errorMessage );
+    if ( object_ == nullptr ) {
+        throw std::runtime_error( "ERROR::GET_TYPE_SHADER : Le shader a été déplacé." );
     }
 
-    return gl_engine::Shader_t(static_cast<GLenum>(type));
+    return object_->type;
 }
 
 gl_engine::Content gl_engine::AbstractShader::source_() const {
-    // Vérification avant exécution
-    GLenum errorCode = GL_NO_ERROR;
-    std::string errorMessage("ERREUR_INTERNE::AVANT_EXECUTION::getSource()::SHADER_ID : " + std::to_string(privateId_) + '\n' );
-    while ( (errorCode = glGetError()) != GL_NO_ERROR ) {
-        errorMessage.append("ERREUR " ).append( std::to_string(errorCode) ).append( " : " )
-                    .append( gl_engine::utility::to_string(errorCode) + '\n');
-    }
-
-    // Récupération de la taille de la source
-    GLint sourceLength = 0;
-    glGetShaderiv( privateId_, GL_SHADER_SOURCE_LENGTH, &sourceLength );
-
-    // Vérification des erreurs
-    if ( const auto errorCode2 = glGetError(); errorCode2 != GL_NO_ERROR ) {
-        throw std::runtime_error("Erreur glGetShaderiv : " + gl_engine::utility::to_string(errorCode2) );
+    if ( object_ == nullptr ) {
+        throw std::runtime_error( "INTERNAL_ERROR::SOURCE_SHADER : Le shader a été déplacé." );
     }
 
-    if ( sourceLength <= 0 ) {
-        GLint logSize = 0;
-        glGetShaderiv( privateId_, GL_INFO_LOG_LENGTH, &logSize );
+    return Content(std::string_view(object_->source));
+}
 
-        if ( logSize > 0 ) {
-            const auto logMessage = std::make_unique<GLchar>(logSize);
-            glGetShaderInfoLog( privateId_, logSize, nullptr, logMessage.get() );
+// Private function
+std::shared_ptr<const gl_engine::AbstractShader::Object> gl_engine::AbstractShader::compile( const Shader_t type,
+                                                                                             const Content& source ) {
+    // TODO Vérifier les erreurs opengl avant
 
-            std::string errorMessage("INTERNAL_ERROR::SOURCE_SHADER::ID : " );
-            errorMessage.append( std::to_string( privateId_ ) ).append(" : ").append(logMessage.get());
+    const auto id = open_gl::createShader(type);
+    // Vérifier que la création du shader est valide(aka le type)
+    if ( 0 == id ) {
+        std::string errorMessage( "ERROR::CREATE_SHADER::TYPE : " );
+        errorMessage.append( type.to_string() ).append( " , source : " ).append( source.type() );
 
-            throw std::runtime_error(errorMessage);
-        }
+        throw std::runtime_error( errorMessage );
     }
 
-    // Récupération de la source
-    std::string source;
-    source.resize(sourceLength);
-    glGetShaderSource( privateId_, sourceLength, nullptr, source.data() );
-
-    GLint logSize = 0;
-    glGetShaderiv( privateId_, GL_INFO_LOG_LENGTH, &logSize );
-
-    if ( logSize > 0 ) {
-        const auto logMessage = std::make_unique<GLchar>(logSize);
-        glGetShaderInfoLog( privateId_, logSize, nullptr, logMessage.get() );
+    // Le shader a été alloué
+    // Toutes exceptions lancées doivent supprimer le shader
+    try {
+        const auto text = source.view();
+        const auto* string = text.data();
+        const auto length = static_cast<Length>(text.size());
 
-        std::string errorMessage("INTERNAL_ERROR::SOURCE_SHADER::ID : " );
-        errorMessage.append( std::to_string( privateId_ ) ).append(" : ").append(logMessage.get());
+        open_gl::shaderSource( id, 1, &string, &length );
 
-        throw std::runtime_error(errorMessage);
-    }
+        // Compiler
+        open_gl::compileShader(id);
 
-    return Content(source);
-}
+        // Vérifier les erreurs
+        GLint success = GL_FALSE;
+        glGetShaderiv( id, GL_COMPILE_STATUS, &success );
 
-// Private function
-void gl_engine::AbstractShader::compile( const Content source ) const {
-    open_gl::shaderSource( privateId_, source );
+        if ( GL_FALSE == static_cast<GLboolean>(success) ) {
+            GLint sizeLog = 0;
+            glGetShaderiv( id, GL_INFO_LOG_LENGTH, &sizeLog );
 
-    GLint sizeLog = 0;
-    glGetShaderiv( privateId_, GL_INFO_LOG_LENGTH, &sizeLog );
+            std::string logMessage;
+            logMessage.resize( static_cast<size_t>(sizeLog), '\0' );
+            glGetShaderInfoLog( id, sizeLog, nullptr, logMessage.data() );
 
-    if ( sizeLog > 0 ) {
-        //const auto logMessage = std::make_unique<char[]>( static_cast<size_t>(sizeLog) );
-        std::string logMessage;
-        logMessage.resize(static_cast<size_t>(sizeLog), '\0' );
-        glGetShaderInfoLog( privateId_, sizeLog, nullptr, logMessage.data() );
+            std::string errorMessage( "ERROR::COMPILATION_SHADER::TYPE : " );
+            errorMessage.append( type.to_string() ).append( " , source : " ).append( source.type() ).append(
+                    " : " ).append( logMessage );
 
-        std::string errorMessage( "ERROR::SOURCE_SHADER::TYPE : " );
-        errorMessage.append( "TYPE"/*type*/ ).append( " , source : " ).append( source.type() ).append(
-                " : " ).append( logMessage );
+            throw std::runtime_error( errorMessage );
+        }
 
-        throw std::runtime_error( errorMessage );
+        return std::make_shared<const Object>( id, type, std::string(text), open_gl::currentContext() );
     }
-
-    // Compiler
-    open_gl::compileShader(privateId_);
-
-    // Vérifier les erreurs
-    GLint success = GL_FALSE;
-    glGetShaderiv( privateId_, GL_COMPILE_STATUS, &success );
-
-    if ( GL_FALSE == static_cast<GLboolean>(success) ) {
-        glGetShaderiv( privateId_, GL_INFO_LOG_LENGTH, &sizeLog );
-        //const auto logMessage = std::make_unique<char[]>( static_cast<size_t>(sizeLog) );
-        std::string logMessage;
-        logMessage.resize(static_cast<size_t>(sizeLog), '\0' );
-        glGetShaderInfoLog( privateId_, sizeLog, nullptr, logMessage.data() );
-
-        std::string errorMessage( "ERROR::COMPILATION_SHADER::TYPE : " );
-        errorMessage.append( "TYPE"/*type*/ ).append( " , source : " ).append( source.type() ).append(
-                " : " ).append( logMessage );
-
-        throw std::runtime_error( errorMessage );
+    catch ( ... ) {
+        open_gl::deleteShader(id);
+        throw;
     }
 }
-
-void gl_engine::AbstractShader::checkCompileError() const {
-
-}
 // endregion
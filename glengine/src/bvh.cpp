@@ -0,0 +1,787 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <glengine/bvh.hpp>
+
+namespace gl_engine {
+    namespace {
+        constexpr float INFINITE = std::numeric_limits<float>::infinity();
+
+        /// Coût de la traversée d’un nœud, relatif au test d’un élément : les boites d’une feuille sont lues à la suite
+        /// dans boxes_, un nœud demande une entrée de pile et un saut. Mesuré : feuilles de 4 éléments en moyenne,
+        /// arbre quatre fois plus petit et parcours plus rapides qu’avec 1.
+        constexpr float TRAVERSAL_COST = 4.0f;
+
+        /// Profondeur à partir de laquelle les coupes se font à la médiane : elle divise au moins par deux le nombre
+        /// d’éléments, la profondeur totale reste donc sous Bvh::MAXIMUM_DEPTH.
+        constexpr std::size_t MEDIAN_DEPTH = Bvh::MAXIMUM_DEPTH - 32;
+
+        /// Nombre de sous-arbres visé par refit() : assez pour équilibrer les threads et ne mettre à jour qu’une petite
+        /// partie de l’arbre quand peu d’éléments bougent.
+        constexpr std::size_t REFIT_SUBTREE_COUNT = 256;
+
+        /// Nombre de sous-arbres construits en parallèle visé par thread.
+        constexpr std::size_t BUILD_TASKS_PER_THREAD = 4;
+
+        Bounds emptyBounds() noexcept {
+            return {glm::vec3(INFINITE), glm::vec3(-INFINITE)};
+        }
+
+        void grow( Bounds& bounds, const Bounds& other ) noexcept {
+            bounds.min = glm::min( bounds.min, other.min );
+            bounds.max = glm::max( bounds.max, other.max );
+        }
+
+        void grow( Bounds& bounds, const glm::vec3& point ) noexcept {
+            bounds.min = glm::min( bounds.min, point );
+            bounds.max = glm::max( bounds.max, point );
+        }
+
+        /// Demi-surface de la boite, 0 si elle est vide : seuls les rapports de surfaces comptent pour la SAH.
+        float halfArea( const glm::vec3& min, const glm::vec3& max ) noexcept {
+            const auto size = glm::max( max - min, glm::vec3(0.0f) );
+
+            return size.x * size.y + size.y * size.z + size.z * size.x;
+        }
+
+        float halfArea( const Bounds& bounds ) noexcept {
+            return halfArea( bounds.min, bounds.max );
+        }
+
+        /// Distance du centre et rayon projeté d’une boite pour un plan : entièrement derrière si d + r < 0,
+        /// entièrement devant si d - r >= 0.
+        struct PlaneTest {
+            std::array<glm::vec4, 6> planes;
+            std::array<glm::vec3, 6> absNormals;
+
+            explicit PlaneTest( const Frustum& frustum ) noexcept
+            : planes(frustum.planes), absNormals() {
+                for ( std::size_t p = 0; p < planes.size(); ++p ) {
+                    absNormals[p] = glm::abs( glm::vec3(planes[p]) );
+                }
+            }
+
+            /// Retourne le masque des plans encore à tester pour les enfants, ou std::nullopt si la boite est éliminée.
+            [[nodiscard]] std::optional<std::uint32_t> test( const glm::vec3& min, const glm::vec3& max, std::uint32_t mask ) const noexcept {
+                const auto center = ( min + max ) * 0.5f;
+                const auto extent = ( max - min ) * 0.5f;
+
+                for ( std::uint32_t p = 0; p < planes.size(); ++p ) {
+                    const auto bit = 1u << p;
+                    if ( ( mask & bit ) == 0 ) {
+                        continue;
+                    }
+
+                    const auto distance = glm::dot( glm::vec3(planes[p]), center ) + planes[p].w;
+                    const auto radius = glm::dot( absNormals[p], extent );
+
+                    if ( distance + radius < 0.0f ) {
+                        return std::nullopt;
+                    }
+                    if ( distance - radius >= 0.0f ) {
+                        mask &= ~bit;
+                    }
+                }
+
+                return mask;
+            }
+        };
+
+        /// Rayon préparé pour le test des plans de la boite (slabs).
+        struct RayTest {
+            glm::vec3 origin;
+            glm::vec3 inverseDirection;
+
+            explicit RayTest( const Ray& ray ) noexcept
+            : origin(ray.origin), inverseDirection(1.0f / ray.direction) {}
+
+            /// Retourne la distance d’entrée dans la boite, INFINITE si elle n’est pas touchée avant maxDistance.
+            [[nodiscard]] float enter( const glm::vec3& min, const glm::vec3& max, const float maxDistance ) const noexcept {
+                const auto t1 = ( min - origin ) * inverseDirection;
+                const auto t2 = ( max - origin ) * inverseDirection;
+                const auto near = glm::min( t1, t2 );
+                const auto far = glm::max( t1, t2 );
+
+                const auto entry = std::max( {near.x, near.y, near.z, 0.0f} );
+                const auto exit = std::min( {far.x, far.y, far.z, maxDistance} );
+
+                return entry <= exit ? entry : INFINITE;
+            }
+        };
+
+        bool overlaps( const glm::vec3& min, const glm::vec3& max, const Bounds& box ) noexcept {
+            return min.x <= box.max.x && max.x >= box.min.x &&
+                   min.y <= box.max.y && max.y >= box.min.y &&
+                   min.z <= box.max.z && max.z >= box.min.z;
+        }
+
+        /// Élément en cours de construction : boite, centre et indice sont déplacés ensemble par les partitions,
+        /// les passes sur une plage lisent donc une mémoire contiguë.
+        struct Primitive {
+            Bounds box{};
+            glm::vec3 centroid{};
+            std::uint32_t item = 0;
+        };
+
+        /**
+         * @brief Construit les nœuds par coupes SAH récursives, en permutant une plage des éléments.
+         *
+         * Deux plages disjointes peuvent être construites en même temps par deux threads.
+         */
+        class Builder final {
+        public:
+            explicit Builder( const std::vector<Bounds>& bounds )
+            : primitives_(bounds.size()) {
+                for ( std::size_t i = 0; i < bounds.size(); ++i ) {
+                    primitives_[i] = {bounds[i], ( bounds[i].min + bounds[i].max ) * 0.5f, static_cast<std::uint32_t>(i)};
+                }
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept {
+                return primitives_.size();
+            }
+
+            [[nodiscard]] std::uint32_t item( const std::size_t i ) const noexcept {
+                return primitives_[i].item;
+            }
+
+            /// Boite des éléments et boite de leurs centres.
+            [[nodiscard]] std::pair<Bounds, Bounds> measure( const std::size_t begin, const std::size_t end ) const noexcept {
+                auto box = emptyBounds();
+                auto centroidBox = emptyBounds();
+
+                for ( auto i = begin; i < end; ++i ) {
+                    grow( box, primitives_[i].box );
+                    grow( centroidBox, primitives_[i].centroid );
+                }
+
+                return {box, centroidBox};
+            }
+
+            /**
+             * @brief Choisit la coupe de [begin, end[ et y partitionne les éléments.
+             * @return La position de la coupe, begin si la plage doit rester une feuille.
+             */
+            std::size_t split( const std::size_t begin, const std::size_t end, const std::size_t depth,
+                               const Bounds& box, const Bounds& centroidBox ) {
+                const auto count = end - begin;
+                if ( count <= 1 ) {
+                    return begin;
+                }
+
+                const auto first = primitives_.begin() + static_cast<std::ptrdiff_t>(begin);
+                const auto last = primitives_.begin() + static_cast<std::ptrdiff_t>(end);
+                const auto middle = begin + count / 2;
+
+                const auto extent = centroidBox.max - centroidBox.min;
+
+                if ( depth >= MEDIAN_DEPTH ) {
+                    if ( count <= Bvh::MAXIMUM_LEAF_SIZE ) {
+                        return begin;
+                    }
+
+                    const auto axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : extent.y >= extent.z ? 1 : 2;
+                    std::nth_element( first, primitives_.begin() + static_cast<std::ptrdiff_t>(middle), last,
+                                      [axis]( const Primitive& a, const Primitive& b ) noexcept {
+                                          return a.centroid[axis] < b.centroid[axis];
+                                      } );
+
+                    return middle;
+                }
+
+                // Une seule passe remplit les intervalles des trois axes ; un axe sans étendue n’est pas évalué.
+                std::array<std::array<Bounds, Bvh::BIN_COUNT>, 3> bins{};
+                std::array<std::array<std::size_t, Bvh::BIN_COUNT>, 3> counts{};
+                for ( auto& axisBins : bins ) {
+                    axisBins.fill( emptyBounds() );
+                }
+
+                const auto origin = centroidBox.min;
+                const auto scale = glm::vec3(static_cast<float>(Bvh::BIN_COUNT)) / glm::max( extent, glm::vec3(std::numeric_limits<float>::min()) );
+
+                for ( auto i = first; i != last; ++i ) {
+                    for ( auto axis = 0; axis < 3; ++axis ) {
+                        const auto bin = binOf( i->centroid[axis], origin[axis], scale[axis] );
+
+                        grow( bins[axis][bin], i->box );
+                        ++counts[axis][bin];
+                    }
+                }
+
+                auto bestCost = INFINITE;
+                auto bestAxis = -1;
+                std::size_t bestBin = 0;
+
+                for ( auto axis = 0; axis < 3; ++axis ) {
+                    if ( !( extent[axis] > 0.0f ) ) {
+                        continue;
+                    }
+
+                    // Coupe s : intervalles [0, s[ à gauche, [s, BIN_COUNT[ à droite.
+                    std::array<float, Bvh::BIN_COUNT> leftCosts{};
+                    std::array<std::size_t, Bvh::BIN_COUNT> leftCounts{};
+
+                    auto left = emptyBounds();
+                    std::size_t leftCount = 0;
+                    for ( std::size_t s = 1; s < Bvh::BIN_COUNT; ++s ) {
+                        grow( left, bins[axis][s - 1] );
+                        leftCount += counts[axis][s - 1];
+
+                        leftCosts[s] = halfArea( left ) * static_cast<float>(leftCount);
+                        leftCounts[s] = leftCount;
+                    }
+
+                    auto right = emptyBounds();
+                    std::size_t rightCount = 0;
+                    for ( auto s = Bvh::BIN_COUNT - 1; s > 0; --s ) {
+                        grow( right, bins[axis][s] );
+                        rightCount += counts[axis][s];
+
+                        if ( leftCounts[s] == 0 || rightCount == 0 ) {
+                            continue;
+                        }
+
+                        const auto cost = leftCosts[s] + halfArea( right ) * static_cast<float>(rightCount);
+                        if ( cost < bestCost ) {
+                            bestCost = cost;
+                            bestAxis = axis;
+                            bestBin = s;
+                        }
+                    }
+                }
+
+                // Tous les centres sont confondus : aucune coupe ne les sépare.
+                if ( bestAxis < 0 ) {
+                    return count <= Bvh::MAXIMUM_LEAF_SIZE ? begin : middle;
+                }
+
+                const auto area = halfArea( box );
+                const auto splitCost = TRAVERSAL_COST + ( area > 0.0f ? bestCost / area : 0.0f );
+                if ( count <= Bvh::MAXIMUM_LEAF_SIZE && splitCost >= static_cast<float>(count) ) {
+                    return begin;
+                }
+
+                const auto position = std::partition( first, last, [&]( const Primitive& primitive ) noexcept {
+                    return binOf( primitive.centroid[bestAxis], origin[bestAxis], scale[bestAxis] ) < bestBin;
+                } );
+
+                return static_cast<std::size_t>(position - primitives_.begin());
+            }
+
+            /// Construit le sous-arbre de [begin, end[ à la suite de nodes, indices relatifs au début de nodes.
+            void build( const std::size_t begin, const std::size_t end, const std::size_t depth, std::vector<BvhNode>& nodes ) {
+                const auto [box, centroidBox] = measure( begin, end );
+
+                const auto index = nodes.size();
+                auto& node = nodes.emplace_back();
+                node.min = box.min;
+                node.max = box.max;
+
+                const auto position = split( begin, end, depth, box, centroidBox );
+                if ( position == begin ) {
+                    nodes[index].index = static_cast<std::uint32_t>(begin);
+                    nodes[index].count = static_cast<std::uint32_t>(end - begin);
+                    return;
+                }
+
+                build( begin, position, depth + 1, nodes );
+                nodes[index].index = static_cast<std::uint32_t>(nodes.size());
+                build( position, end, depth + 1, nodes );
+            }
+
+        private:
+            std::vector<Primitive> primitives_;
+
+            static std::size_t binOf( const float value, const float origin, const float scale ) noexcept {
+                const auto bin = static_cast<std::size_t>(std::max( ( value - origin ) * scale, 0.0f ));
+
+                return std::min( bin, Bvh::BIN_COUNT - 1 );
+            }
+        };
+
+        /// Nœud des niveaux coupés sur le thread appelant, avant la construction parallèle des sous-arbres.
+        struct TopNode {
+            Bounds box{};
+            std::size_t left = 0;
+            std::size_t right = 0;
+            /// Sous-arbre construit en parallèle, NO_TASK pour un nœud interne.
+            std::size_t task = 0;
+        };
+
+        constexpr auto NO_TASK = static_cast<std::size_t>(-1);
+
+        struct BuildTask {
+            std::size_t begin = 0;
+            std::size_t end = 0;
+            std::size_t depth = 0;
+            std::vector<BvhNode> nodes{};
+        };
+    }
+
+    void Bvh::build( const std::vector<Bounds>& bounds ) {
+        build( bounds, 1 );
+    }
+
+    void Bvh::build( const std::vector<Bounds>& bounds, const unsigned threadCount ) {
+        nodes_.clear();
+        items_.clear();
+        boxes_.clear();
+        slots_.clear();
+        subtrees_.clear();
+        subtreeAreas_.clear();
+        topNodes_.clear();
+        cost_ = 0.0f;
+
+        if ( bounds.empty() ) {
+            return;
+        }
+
+        try {
+            Builder builder(bounds);
+            const auto threads = utility::resolveThreadCount( threadCount );
+
+            // Les niveaux du haut sont coupés ici jusqu’à des plages assez petites pour équilibrer les threads.
+            const auto taskSize = threads > 1 && bounds.size() >= PARALLEL_THRESHOLD
+                                  ? std::max( bounds.size() / ( threads * BUILD_TASKS_PER_THREAD ), PARALLEL_THRESHOLD / 4 )
+                                  : bounds.size();
+
+            std::vector<TopNode> top{};
+            std::vector<BuildTask> tasks{};
+
+            const auto splitTop = [&]( const auto& self, const std::size_t begin, const std::size_t end, const std::size_t depth ) -> std::size_t {
+                const auto [box, centroidBox] = builder.measure( begin, end );
+                const auto index = top.size();
+                top.push_back( {box, 0, 0, NO_TASK} );
+
+                const auto position = end - begin > taskSize ? builder.split( begin, end, depth, box, centroidBox ) : begin;
+                if ( position == begin ) {
+                    top[index].task = tasks.size();
+                    tasks.push_back( {begin, end, depth, {}} );
+                    return index;
+                }
+
+                const auto left = self( self, begin, position, depth + 1 );
+                const auto right = self( self, position, end, depth + 1 );
+                top[index].left = left;
+                top[index].right = right;
+
+                return index;
+            };
+            splitTop( splitTop, 0, builder.size(), 0 );
+
+            utility::parallelFor( tasks.size(), threadCount, [&]( const std::size_t t ) {
+                auto& task = tasks[t];
+                builder.build( task.begin, task.end, task.depth, task.nodes );
+            } );
+
+            std::size_t nodeCount = 0;
+            for ( const auto& task : tasks ) {
+                nodeCount += task.nodes.size();
+            }
+            nodes_.reserve( nodeCount + top.size() );
+
+            // Recopie en profondeur d’abord : chaque sous-arbre est décalé à sa place.
+            const auto emit = [&]( const auto& self, const std::size_t index ) -> void {
+                const auto& topNode = top[index];
+
+                if ( topNode.task != NO_TASK ) {
+                    const auto offset = static_cast<std::uint32_t>(nodes_.size());
+                    for ( auto node : tasks[topNode.task].nodes ) {
+                        if ( !node.leaf() ) {
+                            node.index += offset;
+                        }
+                        nodes_.push_back( node );
+                    }
+                    return;
+                }
+
+                const auto node = nodes_.size();
+                nodes_.push_back( {topNode.box.min, 0, topNode.box.max, 0} );
+
+                self( self, topNode.left );
+                nodes_[node].index = static_cast<std::uint32_t>(nodes_.size());
+                self( self, topNode.right );
+            };
+            emit( emit, 0 );
+
+            items_.resize( builder.size() );
+            slots_.resize( builder.size() );
+            for ( std::size_t k = 0; k < items_.size(); ++k ) {
+                items_[k] = builder.item( k );
+                slots_[items_[k]] = static_cast<std::uint32_t>(k);
+            }
+
+            partitionSubtrees();
+            boxes_.resize( items_.size() );
+            refit( bounds, threadCount );
+        }
+        catch ( ... ) {
+            nodes_.clear();
+            items_.clear();
+            boxes_.clear();
+            slots_.clear();
+            subtrees_.clear();
+            subtreeAreas_.clear();
+            topNodes_.clear();
+            throw;
+        }
+    }
+
+    void Bvh::partitionSubtrees() {
+        const auto target = nodes_.size() >= PARALLEL_THRESHOLD ? nodes_.size() / REFIT_SUBTREE_COUNT : nodes_.size();
+
+        // Le sous-arbre de node occupe [node, fin[, la fin est celle du sous-arbre de son dernier enfant.
+        const auto subtreeEnd = [&]( std::uint32_t node ) noexcept {
+            while ( !nodes_[node].leaf() ) {
+                node = nodes_[node].index;
+            }
+            return node + 1;
+        };
+
+        const auto visit = [&]( const auto& self, const std::uint32_t node ) -> void {
+            const auto end = subtreeEnd( node );
+
+            if ( nodes_[node].leaf() || end - node <= target ) {
+                const auto [firstItem, lastItem] = itemRange( node );
+                subtrees_.push_back( {node, end, firstItem, lastItem} );
+                return;
+            }
+
+            topNodes_.push_back( node );
+            self( self, node + 1 );
+            self( self, nodes_[node].index );
+        };
+        visit( visit, 0 );
+
+        subtreeAreas_.assign( subtrees_.size(), 0.0f );
+    }
+
+    void Bvh::refit( const std::vector<Bounds>& bounds ) {
+        refit( bounds, 1 );
+    }
+
+    void Bvh::refit( const std::vector<Bounds>& bounds, const unsigned threadCount ) {
+        if ( bounds.size() != items_.size() || items_.empty() ) {
+            if ( !( bounds.empty() && items_.empty() ) ) {
+                build( bounds, threadCount );
+            }
+            return;
+        }
+
+        std::vector<std::uint32_t> subtrees(subtrees_.size());
+        for ( std::size_t s = 0; s < subtrees.size(); ++s ) {
+            subtrees[s] = static_cast<std::uint32_t>(s);
+        }
+
+        refitSubtrees( bounds.data(), subtrees, threadCount );
+    }
+
+    void Bvh::refit( const std::vector<Bounds>& bounds, const std::vector<std::uint32_t>& moved, const unsigned threadCount ) {
+        if ( bounds.size() != items_.size() || items_.empty() ) {
+            refit( bounds, threadCount );
+            return;
+        }
+        if ( moved.empty() ) {
+            return;
+        }
+
+        // Les plages d’éléments des sous-arbres se suivent : le sous-arbre d’un élément est trouvé par dichotomie.
+        std::vector<bool> dirty(subtrees_.size(), false);
+        for ( const auto item : moved ) {
+            const auto slot = slots_[item];
+            const auto next = std::upper_bound( subtrees_.begin(), subtrees_.end(), slot,
+                                                []( const std::uint32_t value, const Subtree& subtree ) noexcept {
+                                                    return value < subtree.firstItem;
+                                                } );
+
+            dirty[static_cast<std::size_t>(next - subtrees_.begin()) - 1] = true;
+        }
+
+        std::vector<std::uint32_t> subtrees{};
+        for ( std::size_t s = 0; s < dirty.size(); ++s ) {
+            if ( dirty[s] ) {
+                subtrees.push_back( static_cast<std::uint32_t>(s) );
+            }
+        }
+
+        refitSubtrees( bounds.data(), subtrees, threadCount );
+    }
+
+    void Bvh::refitSubtrees( const Bounds* bounds, const std::vector<std::uint32_t>& subtrees, const unsigned threadCount ) {
+        utility::parallelFor( subtrees.size(), threadCount, [&]( const std::size_t s ) {
+            const auto subtree = subtrees[s];
+            subtreeAreas_[subtree] = refitSubtree( bounds, subtrees_[subtree] );
+        } );
+
+        auto weightedArea = 0.0f;
+        for ( const auto area : subtreeAreas_ ) {
+            weightedArea += area;
+        }
+
+        // Nœuds du haut en ordre inverse : les enfants, plus loin dans l’ordre en profondeur, sont déjà à jour.
+        for ( auto i = topNodes_.rbegin(); i != topNodes_.rend(); ++i ) {
+            weightedArea += refitNode( *i );
+        }
+
+        const auto rootArea = halfArea( nodes_.front().min, nodes_.front().max );
+        cost_ = rootArea > 0.0f ? weightedArea / rootArea : static_cast<float>(items_.size());
+    }
+
+    float Bvh::refitSubtree( const Bounds* bounds, const Subtree& subtree ) noexcept {
+        // Les boites sont d’abord copiées dans l’ordre des feuilles, dans une boucle sans dépendance :
+        // les lectures dispersées dans bounds se recouvrent au lieu d’attendre chacune la mémoire.
+        for ( auto k = subtree.firstItem; k < subtree.lastItem; ++k ) {
+            boxes_[k] = bounds[items_[k]];
+        }
+
+        auto weightedArea = 0.0f;
+        for ( auto node = subtree.last; node > subtree.first; --node ) {
+            weightedArea += refitNode( node - 1 );
+        }
+
+        return weightedArea;
+    }
+
+    float Bvh::refitNode( const std::uint32_t index ) noexcept {
+        auto& node = nodes_[index];
+
+        if ( node.leaf() ) {
+            auto box = emptyBounds();
+
+            const auto end = node.index + node.count;
+            for ( auto k = node.index; k < end; ++k ) {
+                grow( box, boxes_[k] );
+            }
+
+            node.min = box.min;
+            node.max = box.max;
+
+            return halfArea( box ) * static_cast<float>(node.count);
+        }
+
+        const auto& left = nodes_[index + 1];
+        const auto& right = nodes_[node.index];
+        node.min = glm::min( left.min, right.min );
+        node.max = glm::max( left.max, right.max );
+
+        return halfArea( node.min, node.max ) * TRAVERSAL_COST;
+    }
+
+    std::pair<std::uint32_t, std::uint32_t> Bvh::itemRange( const std::uint32_t node ) const noexcept {
+        // Les éléments d’un sous-arbre sont contigus : de la première feuille à gauche à la dernière à droite.
+        auto first = node;
+        while ( !nodes_[first].leaf() ) {
+            ++first;
+        }
+
+        auto last = node;
+        while ( !nodes_[last].leaf() ) {
+            last = nodes_[last].index;
+        }
+
+        return {nodes_[first].index, nodes_[last].index + nodes_[last].count};
+    }
+
+    void Bvh::appendSubtree( const std::uint32_t node, std::vector<std::uint32_t>& result ) const {
+        const auto [first, last] = itemRange( node );
+
+        result.insert( result.end(), items_.begin() + first, items_.begin() + last );
+    }
+
+    void Bvh::cull( const Frustum& frustum, std::vector<std::uint32_t>& visible ) const {
+        if ( nodes_.empty() ) {
+            return;
+        }
+
+        const PlaneTest planes(frustum);
+        constexpr std::uint32_t ALL_PLANES = 0x3f;
+
+        struct Entry {
+            std::uint32_t node;
+            std::uint32_t mask;
+        };
+        std::array<Entry, MAXIMUM_DEPTH + 1> stack{};
+        std::size_t size = 0;
+
+        stack[size++] = {0, ALL_PLANES};
+        while ( size > 0 ) {
+            const auto [index, parentMask] = stack[--size];
+            const auto& node = nodes_[index];
+
+            const auto mask = planes.test( node.min, node.max, parentMask );
+            if ( !mask.has_value() ) {
+                continue;
+            }
+
+            if ( *mask == 0 ) {
+                appendSubtree( index, visible );
+            }
+            else if ( node.leaf() ) {
+                for ( auto k = node.index; k < node.index + node.count; ++k ) {
+                    if ( planes.test( boxes_[k].min, boxes_[k].max, *mask ).has_value() ) {
+                        visible.push_back( items_[k] );
+                    }
+                }
+            }
+            else {
+                stack[size++] = {node.index, *mask};
+                stack[size++] = {index + 1, *mask};
+            }
+        }
+    }
+
+    std::optional<RayHit> Bvh::raycast( const Ray& ray ) const noexcept {
+        if ( nodes_.empty() ) {
+            return std::nullopt;
+        }
+
+        const RayTest test(ray);
+        auto best = ray.maxDistance;
+        std::optional<RayHit> hit{};
+
+        struct Entry {
+            std::uint32_t node;
+            float distance;
+        };
+        std::array<Entry, MAXIMUM_DEPTH + 1> stack{};
+        std::size_t size = 0;
+
+        const auto rootDistance = test.enter( nodes_.front().min, nodes_.front().max, best );
+        if ( rootDistance < INFINITE ) {
+            stack[size++] = {0, rootDistance};
+        }
+
+        while ( size > 0 ) {
+            const auto [index, distance] = stack[--size];
+            if ( distance > best ) {
+                continue;
+            }
+
+            const auto& node = nodes_[index];
+            if ( node.leaf() ) {
+                for ( auto k = node.index; k < node.index + node.count; ++k ) {
+                    const auto entry = test.enter( boxes_[k].min, boxes_[k].max, best );
+                    if ( entry < INFINITE && ( !hit.has_value() || entry < best ) ) {
+                        best = entry;
+                        hit = RayHit{items_[k], entry};
+                    }
+                }
+                continue;
+            }
+
+            const auto left = index + 1;
+            const auto right = node.index;
+            const auto leftDistance = test.enter( nodes_[left].min, nodes_[left].max, best );
+            const auto rightDistance = test.enter( nodes_[right].min, nodes_[right].max, best );
+
+            // Le plus proche est empilé en dernier pour être visité en premier.
+            if ( leftDistance <= rightDistance ) {
+                if ( rightDistance < INFINITE ) {
+                    stack[size++] = {right, rightDistance};
+                }
+                if ( leftDistance < INFINITE ) {
+                    stack[size++] = {left, leftDistance};
+                }
+            }
+            else {
+                stack[size++] = {right, rightDistance};
+                if ( leftDistance < INFINITE ) {
+                    stack[size++] = {left, leftDistance};
+                }
+            }
+        }
+
+        return hit;
+    }
+
+    void Bvh::query( const Ray& ray, std::vector<RayHit>& hits ) const {
+        if ( nodes_.empty() ) {
+            return;
+        }
+
+        const RayTest test(ray);
+
+        std::array<std::uint32_t, MAXIMUM_DEPTH + 1> stack{};
+        std::size_t size = 0;
+
+        stack[size++] = 0;
+        while ( size > 0 ) {
+            const auto index = stack[--size];
+            const auto& node = nodes_[index];
+
+            if ( test.enter( node.min, node.max, ray.maxDistance ) == INFINITE ) {
+                continue;
+            }
+
+            if ( node.leaf() ) {
+                for ( auto k = node.index; k < node.index + node.count; ++k ) {
+                    const auto entry = test.enter( boxes_[k].min, boxes_[k].max, ray.maxDistance );
+                    if ( entry < INFINITE ) {
+                        hits.push_back( {items_[k], entry} );
+                    }
+                }
+            }
+            else {
+                stack[size++] = node.index;
+                stack[size++] = index + 1;
+            }
+        }
+    }
+
+    void Bvh::query( const Bounds& box, std::vector<std::uint32_t>& result ) const {
+        if ( nodes_.empty() ) {
+            return;
+        }
+
+        std::array<std::uint32_t, MAXIMUM_DEPTH + 1> stack{};
+        std::size_t size = 0;
+
+        stack[size++] = 0;
+        while ( size > 0 ) {
+            const auto index = stack[--size];
+            const auto& node = nodes_[index];
+
+            if ( !overlaps( node.min, node.max, box ) ) {
+                continue;
+            }
+
+            if ( node.leaf() ) {
+                for ( auto k = node.index; k < node.index + node.count; ++k ) {
+                    if ( overlaps( boxes_[k].min, boxes_[k].max, box ) ) {
+                        result.push_back( items_[k] );
+                    }
+                }
+            }
+            else {
+                stack[size++] = node.index;
+                stack[size++] = index + 1;
+            }
+        }
+    }
+}
@@ -0,0 +1,257 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <glengine/culling.hpp>
+#include <glengine/simd.hpp>
+
+namespace gl_engine {
+    namespace {
+        /// Rayon et demi-côtés d’un objet sans volume : aucun plan ne l’élimine.
+        constexpr float UNBOUNDED = std::numeric_limits<float>::max();
+
+        /// Rayon des volumes de remplissage : tous les plans les éliminent.
+        constexpr float EMPTY = -std::numeric_limits<float>::infinity();
+
+#ifdef GLENGINE_SIMD_AVX
+        using Lane = simd::Float8;
+        constexpr std::size_t LANE_WIDTH = 8;
+#else
+        using Lane = simd::Float4;
+        constexpr std::size_t LANE_WIDTH = 4;
+#endif
+
+        static_assert( CullingSet::LANE_COUNT % LANE_WIDTH == 0, "Les tableaux sont complétés pour la largeur la plus grande." );
+        static_assert( FrustumCuller::CHUNK_SIZE % CullingSet::LANE_COUNT == 0, "Une tranche commence sur un groupe complet." );
+
+        /// Composantes des plans répétées dans chaque voie, calculées une fois par test.
+        struct LanePlanes {
+            std::array<Lane, 6> x;
+            std::array<Lane, 6> y;
+            std::array<Lane, 6> z;
+            std::array<Lane, 6> w;
+            std::array<Lane, 6> absX;
+            std::array<Lane, 6> absY;
+            std::array<Lane, 6> absZ;
+        };
+
+        LanePlanes broadcast( const Frustum& frustum ) noexcept {
+            LanePlanes planes{};
+            for ( std::size_t p = 0; p < 6; ++p ) {
+                const auto& plane = frustum.planes[p];
+
+                planes.x[p] = Lane::broadcast( plane.x );
+                planes.y[p] = Lane::broadcast( plane.y );
+                planes.z[p] = Lane::broadcast( plane.z );
+                planes.w[p] = Lane::broadcast( plane.w );
+                planes.absX[p] = Lane::broadcast( std::abs( plane.x ) );
+                planes.absY[p] = Lane::broadcast( std::abs( plane.y ) );
+                planes.absZ[p] = Lane::broadcast( std::abs( plane.z ) );
+            }
+
+            return planes;
+        }
+
+        /**
+         * @brief Teste les objets [first, last[ et écrit les indices visibles à partir de visible.
+         * @return Le nombre d’indices écrits.
+         *
+         * first et last sont des multiples de LANE_WIDTH. visible doit avoir la place de last - first indices :
+         * chaque voie écrit son indice avant de savoir s’il est conservé.
+         */
+        std::size_t cullRange( const CullingSet& set, const LanePlanes& planes, const std::size_t first, const std::size_t last,
+                               std::uint32_t* const visible ) noexcept {
+            const auto zero = Lane::broadcast( 0.0f );
+            std::size_t count = 0;
+
+            for ( auto i = first; i < last; i += LANE_WIDTH ) {
+                const auto centerX = Lane::load( set.centerX() + i );
+                const auto centerY = Lane::load( set.centerY() + i );
+                const auto centerZ = Lane::load( set.centerZ() + i );
+                const auto extentX = Lane::load( set.extentX() + i );
+                const auto extentY = Lane::load( set.extentY() + i );
+                const auto extentZ = Lane::load( set.extentZ() + i );
+                const auto radius = Lane::load( set.radius() + i );
+
+                unsigned outside = 0;
+                for ( std::size_t p = 0; p < 6; ++p ) {
+                    const auto distance = planes.x[p] * centerX + planes.y[p] * centerY + planes.z[p] * centerZ + planes.w[p];
+                    const auto boxRadius = planes.absX[p] * extentX + planes.absY[p] * extentY + planes.absZ[p] * extentZ;
+
+                    outside |= simd::lessMask( distance + simd::min( boxRadius, radius ), zero );
+                }
+
+                for ( std::size_t lane = 0; lane < LANE_WIDTH; ++lane ) {
+                    visible[count] = static_cast<std::uint32_t>(i + lane);
+                    count += ( ~outside >> lane ) & 1u;
+                }
+            }
+
+            return count;
+        }
+    }
+
+    Frustum Frustum::fromMatrix( const glm::mat4& viewProjection ) noexcept {
+        const auto row = [&]( const int i ) noexcept {
+            return glm::vec4( viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i] );
+        };
+
+        Frustum frustum{};
+        frustum.planes = {row( 3 ) + row( 0 ), row( 3 ) - row( 0 ),
+                          row( 3 ) + row( 1 ), row( 3 ) - row( 1 ),
+                          row( 3 ) + row( 2 ), row( 3 ) - row( 2 )};
+
+        for ( auto& plane : frustum.planes ) {
+            const auto length = glm::length( glm::vec3(plane) );
+            if ( length > 0.0f ) {
+                plane /= length;
+            }
+        }
+
+        return frustum;
+    }
+
+    bool Frustum::intersects( const BoundingVolume& volume ) const noexcept {
+        const auto center = ( volume.box.min + volume.box.max ) * 0.5f;
+        const auto extent = ( volume.box.max - volume.box.min ) * 0.5f;
+
+        for ( const auto& plane : planes ) {
+            const auto normal = glm::vec3(plane);
+            const auto distance = glm::dot( normal, center ) + plane.w;
+            const auto boxRadius = glm::dot( glm::abs( normal ), extent );
+
+            // Même test que FrustumCuller::cull, objet par objet.
+            if ( distance + std::min( boxRadius, volume.sphere.radius ) < 0.0f ) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void CullingSet::clear() noexcept {
+        centerX_.clear();
+        centerY_.clear();
+        centerZ_.clear();
+        extentX_.clear();
+        extentY_.clear();
+        extentZ_.clear();
+        radius_.clear();
+        size_ = 0;
+    }
+
+    void CullingSet::resize( const std::size_t size ) {
+        const auto padded = ( size + LANE_COUNT - 1 ) / LANE_COUNT * LANE_COUNT;
+        const auto previous = size_;
+
+        // Note développeur : Le test retient le plus petit des deux rayons : un objet sans volume a donc une boite
+        // et une sphère immenses, un volume de remplissage une sphère de rayon -infini.
+        for ( auto* const component : {&centerX_, &centerY_, &centerZ_, &extentX_, &extentY_, &extentZ_} ) {
+            component->resize( padded, 0.0f );
+        }
+        radius_.resize( padded, EMPTY );
+
+        for ( auto i = previous; i < size; ++i ) {
+            store( i, glm::vec3(0.0f), glm::vec3(UNBOUNDED), UNBOUNDED );
+        }
+        for ( auto i = size; i < padded; ++i ) {
+            store( i, glm::vec3(0.0f), glm::vec3(0.0f), EMPTY );
+        }
+
+        size_ = size;
+    }
+
+    std::uint32_t CullingSet::add( const BoundingVolume& volume ) {
+        const auto index = add();
+        set( index, volume );
+
+        return index;
+    }
+
+    std::uint32_t CullingSet::add() {
+        const auto index = size_;
+        resize( size_ + 1 );
+
+        return static_cast<std::uint32_t>(index);
+    }
+
+    void CullingSet::set( const std::size_t index, const BoundingVolume& volume ) noexcept {
+        store( index, ( volume.box.min + volume.box.max ) * 0.5f, ( volume.box.max - volume.box.min ) * 0.5f, volume.sphere.radius );
+    }
+
+    void CullingSet::set( const std::size_t index ) noexcept {
+        store( index, glm::vec3(0.0f), glm::vec3(UNBOUNDED), UNBOUNDED );
+    }
+
+    void CullingSet::store( const std::size_t index, const glm::vec3& center, const glm::vec3& extent, const float radius ) noexcept {
+        centerX_[index] = center.x;
+        centerY_[index] = center.y;
+        centerZ_[index] = center.z;
+        extentX_[index] = extent.x;
+        extentY_[index] = extent.y;
+        extentZ_[index] = extent.z;
+        radius_[index] = radius;
+    }
+
+    CullStatistics FrustumCuller::cull( const CullingSet& set, const Frustum& frustum, std::vector<std::uint32_t>& visible,
+                                        const unsigned threadCount ) {
+        const auto start = std::chrono::steady_clock::now();
+
+        const auto planes = broadcast( frustum );
+        const auto padded = ( set.size() + CullingSet::LANE_COUNT - 1 ) / CullingSet::LANE_COUNT * CullingSet::LANE_COUNT;
+
+        visible.resize( padded );
+
+        std::size_t count = 0;
+        if ( set.size() < PARALLEL_THRESHOLD || utility::resolveThreadCount( threadCount ) <= 1 ) {
+            count = cullRange( set, planes, 0, padded, visible.data() );
+        }
+        else {
+            const auto chunkCount = ( padded + CHUNK_SIZE - 1 ) / CHUNK_SIZE;
+            std::vector<std::size_t> counts(chunkCount, 0);
+
+            utility::parallelFor( chunkCount, threadCount, [&]( const std::size_t chunk ) {
+                const auto first = chunk * CHUNK_SIZE;
+                counts[chunk] = cullRange( set, planes, first, std::min( first + CHUNK_SIZE, padded ), visible.data() + first );
+            } );
+
+            // Chaque tranche a écrit à sa place : les résultats sont ramenés les uns à la suite des autres.
+            for ( std::size_t chunk = 0; chunk < chunkCount; ++chunk ) {
+                const auto* const first = visible.data() + chunk * CHUNK_SIZE;
+                std::copy( first, first + counts[chunk], visible.data() + count );
+                count += counts[chunk];
+            }
+        }
+
+        visible.resize( count );
+
+        return {set.size(), count, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()};
+    }
+
+    CullStatistics FrustumCuller::cull( const CullingSet& set, const Frustum& frustum, std::vector<std::uint32_t>& visible ) {
+        return cull( set, frustum, visible, 1 );
+    }
+}
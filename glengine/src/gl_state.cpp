@@ -0,0 +1,470 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <glengine/gl_state.hpp>
+
+namespace gl_engine::open_gl {
+    namespace {
+        /// Valeur d’un identifiant ou d’une énumération jamais fixée par le cache.
+        constexpr GLuint UNKNOWN = ~GLuint{0};
+
+        /// Unités de texture suivies, les suivantes sont toujours transmises au pilote.
+        constexpr unsigned TRACKED_TEXTURE_UNITS = 32;
+
+        enum class TriState : std::uint8_t {
+            UNKNOWN,
+            DISABLED,
+            ENABLED
+        };
+
+        /**
+         * @brief Copie des états d’un contexte OpenGL.
+         *
+         * Les cibles de tampons, de textures et les fonctionnalités sont peu nombreuses : de petits tableaux
+         * parcourus linéairement sont plus rapides qu’une table de hachage.
+         */
+        struct ContextState {
+            GLuint program = UNKNOWN;
+            GLuint vertexArray = UNKNOWN;
+            std::vector<std::pair<GLenum, GLuint>> buffers{};
+            /// Points de liaison indexés, la clé réunit la cible et le numéro du point.
+            std::vector<std::pair<std::uint64_t, GLuint>> indexedBuffers{};
+
+            GLuint activeUnit = UNKNOWN;
+            std::array<std::vector<std::pair<GLenum, GLuint>>, TRACKED_TEXTURE_UNITS> textures{};
+            std::array<GLuint, TRACKED_TEXTURE_UNITS> samplers{};
+
+            std::vector<std::pair<GLenum, TriState>> capabilities{};
+
+            std::array<GLenum, 4> blendFunc{};
+            GLenum blendEquation = UNKNOWN;
+            GLenum depthFunc = UNKNOWN;
+            TriState depthMask = TriState::UNKNOWN;
+            GLenum cullFace = UNKNOWN;
+            GLenum frontFace = UNKNOWN;
+
+            StateStatistics statistics{};
+
+            /// Identifiant du contexte, voir gl_engine::open_gl::currentContext.
+            std::uint64_t id = 0;
+
+            ContextState() noexcept {
+                invalidate();
+            }
+
+            void invalidate() noexcept {
+                program = UNKNOWN;
+                vertexArray = UNKNOWN;
+                buffers.clear();
+                indexedBuffers.clear();
+
+                activeUnit = UNKNOWN;
+                for ( auto& unit : textures ) {
+                    unit.clear();
+                }
+                samplers.fill( UNKNOWN );
+
+                capabilities.clear();
+
+                blendFunc.fill( UNKNOWN );
+                blendEquation = UNKNOWN;
+                depthFunc = UNKNOWN;
+                depthMask = TriState::UNKNOWN;
+                cullFace = UNKNOWN;
+                frontFace = UNKNOWN;
+            }
+
+            /**
+             * @brief Enregistre la nouvelle valeur d’un état.
+             * @return true si l’appel doit être transmis au pilote.
+             */
+            template <typename T>
+            bool change( T& current, const T value, const StateCategory category ) noexcept {
+                auto& counter = statistics[category];
+
+                if ( current == value ) {
+                    ++counter.skipped;
+                    return false;
+                }
+
+                current = value;
+                ++counter.issued;
+
+                return true;
+            }
+
+            /// Retourne la valeur enregistrée pour key, insérée à initial si elle est absente.
+            template <typename Key, typename T>
+            static T& slot( std::vector<std::pair<Key, T>>& slots, const Key key, const T initial ) {
+                for ( auto& [slotKey, value] : slots ) {
+                    if ( slotKey == key ) {
+                        return value;
+                    }
+                }
+
+                return slots.emplace_back( key, initial ).second;
+            }
+        };
+
+        struct Registry {
+            std::mutex mutex{};
+            std::unordered_map<GLFWwindow*, std::unique_ptr<ContextState>> states{};
+
+            /// Incrémenté à chaque libération : les copies mémorisées par les threads sont alors relues.
+            std::atomic<std::uint64_t> generation{0};
+
+            /// Dernier identifiant de contexte attribué, protégé par mutex.
+            std::uint64_t lastContext = 0;
+
+            /// Incrémenté à chaque glDeleteProgram, voir gl_engine::open_gl::programDeletions.
+            std::atomic<std::uint64_t> programDeletions{0};
+        };
+
+        Registry& registry() {
+            static Registry registry{};
+            return registry;
+        }
+
+        /**
+         * @brief Retourne la copie des états du contexte courant.
+         *
+         * Le dernier contexte de chaque thread est mémorisé : le verrou n’est pris qu’au changement de contexte.
+         */
+        ContextState& state() noexcept {
+            thread_local GLFWwindow* cachedContext = nullptr;
+            thread_local ContextState* cachedState = nullptr;
+            thread_local std::uint64_t cachedGeneration = 0;
+
+            auto& registry = open_gl::registry();
+
+            auto* const context = glfwGetCurrentContext();
+            const auto generation = registry.generation.load( std::memory_order_acquire );
+
+            if ( cachedState == nullptr || context != cachedContext || generation != cachedGeneration ) {
+                const std::lock_guard<std::mutex> lock(registry.mutex);
+
+                auto& entry = registry.states[context];
+                if ( entry == nullptr ) {
+                    entry = std::make_unique<ContextState>();
+                    entry->id = ++registry.lastContext;
+                }
+
+                cachedContext = context;
+                cachedState = entry.get();
+                cachedGeneration = generation;
+            }
+
+            return *cachedState;
+        }
+
+        // Note développeur : glActiveTexture n’est pas compté à part, il fait partie du coût d’une liaison de texture.
+        void selectUnit( ContextState& state, const unsigned unit ) noexcept {
+            if ( state.activeUnit != unit ) {
+                glActiveTexture( GL_TEXTURE0 + unit );
+                state.activeUnit = unit;
+            }
+        }
+
+        void setCapability( const GLenum capability, const bool enabled ) noexcept {
+            auto& state = open_gl::state();
+            auto& current = ContextState::slot( state.capabilities, capability, TriState::UNKNOWN );
+
+            if ( state.change( current, enabled ? TriState::ENABLED : TriState::DISABLED, StateCategory::CAPABILITY ) ) {
+                if ( enabled ) {
+                    glEnable( capability );
+                }
+                else {
+                    glDisable( capability );
+                }
+            }
+        }
+    }
+
+    // region ShaderProgram
+    // Note développeur : Déclarées avec les autres surcharges dans utility.hpp, elles passent par le cache d’états.
+    void useProgram( const Id id ) {
+        auto& state = open_gl::state();
+
+        if ( state.change( state.program, id, StateCategory::PROGRAM ) ) {
+            glUseProgram( id );
+        }
+    }
+
+    void deleteProgram( const Id id ) {
+        auto& state = open_gl::state();
+
+        // Un programme utilisé n’est détruit qu’une fois remplacé : la liaison reste valide pour OpenGL.
+        // Son identifiant peut cependant être réutilisé ensuite, l’état est donc oublié.
+        if ( state.program == id ) {
+            state.program = UNKNOWN;
+        }
+
+        glDeleteProgram( id );
+        registry().programDeletions.fetch_add( 1, std::memory_order_release );
+    }
+    // endregion
+
+    // region State
+    void bindVertexArray( const Id id ) noexcept {
+        auto& state = open_gl::state();
+
+        if ( state.change( state.vertexArray, id, StateCategory::VERTEX_ARRAY ) ) {
+            glBindVertexArray( id );
+
+            // Le tampon d’indices fait partie du tableau de sommets.
+            for ( auto& [target, buffer] : state.buffers ) {
+                if ( target == GL_ELEMENT_ARRAY_BUFFER ) {
+                    buffer = UNKNOWN;
+                }
+            }
+        }
+    }
+
+    void bindBuffer( const GLenum target, const Id id ) noexcept {
+        auto& state = open_gl::state();
+
+        if ( state.change( ContextState::slot( state.buffers, target, UNKNOWN ), id, StateCategory::BUFFER ) ) {
+            glBindBuffer( target, id );
+        }
+    }
+
+    void bindBufferBase( const GLenum target, const GLuint index, const Id id ) noexcept {
+        auto& state = open_gl::state();
+
+        const auto key = std::uint64_t{target} << 32 | index;
+        if ( state.change( ContextState::slot( state.indexedBuffers, key, UNKNOWN ), id, StateCategory::BUFFER ) ) {
+            glBindBufferBase( target, index, id );
+            ContextState::slot( state.buffers, target, UNKNOWN ) = id;
+        }
+    }
+
+    void activeTexture( const unsigned unit ) noexcept {
+        selectUnit( state(), unit );
+    }
+
+    void bindTexture( const unsigned unit, const GLenum target, const Id id ) noexcept {
+        auto& state = open_gl::state();
+
+        if ( unit >= TRACKED_TEXTURE_UNITS ) {
+            ++state.statistics[StateCategory::TEXTURE].issued;
+            selectUnit( state, unit );
+            glBindTexture( target, id );
+            return;
+        }
+
+        if ( state.change( ContextState::slot( state.textures[unit], target, UNKNOWN ), id, StateCategory::TEXTURE ) ) {
+            selectUnit( state, unit );
+            glBindTexture( target, id );
+        }
+    }
+
+    void bindSampler( const unsigned unit, const Id id ) noexcept {
+        auto& state = open_gl::state();
+
+        if ( unit >= TRACKED_TEXTURE_UNITS ) {
+            ++state.statistics[StateCategory::SAMPLER].issued;
+            glBindSampler( unit, id );
+            return;
+        }
+
+        if ( state.change( state.samplers[unit], id, StateCategory::SAMPLER ) ) {
+            glBindSampler( unit, id );
+        }
+    }
+
+    void enable( const GLenum capability ) noexcept {
+        setCapability( capability, true );
+    }
+
+    void disable( const GLenum capability ) noexcept {
+        setCapability( capability, false );
+    }
+
+    void enable( const GLenum capability, const bool enabled ) noexcept {
+        setCapability( capability, enabled );
+    }
+
+    void blendFunc( const GLenum source, const GLenum destination ) noexcept {
+        auto& state = open_gl::state();
+
+        if ( state.change( state.blendFunc, {source, destination, source, destination}, StateCategory::BLEND ) ) {
+            glBlendFunc( source, destination );
+        }
+    }
+
+    void blendFuncSeparate( const GLenum sourceColor, const GLenum destinationColor,
+                            const GLenum sourceAlpha, const GLenum destinationAlpha ) noexcept {
+        auto& state = open_gl::state();
+
+        if ( state.change( state.blendFunc, {sourceColor, destinationColor, sourceAlpha, destinationAlpha}, StateCategory::BLEND ) ) {
+            glBlendFuncSeparate( sourceColor, destinationColor, sourceAlpha, destinationAlpha );
+        }
+    }
+
+    void blendEquation( const GLenum mode ) noexcept {
+        auto& state = open_gl::state();
+
+        if ( state.change( state.blendEquation, mode, StateCategory::BLEND ) ) {
+            glBlendEquation( mode );
+        }
+    }
+
+    void depthFunc( const GLenum function ) noexcept {
+        auto& state = open_gl::state();
+
+        if ( state.change( state.depthFunc, function, StateCategory::DEPTH ) ) {
+            glDepthFunc( function );
+        }
+    }
+
+    void depthMask( const bool write ) noexcept {
+        auto& state = open_gl::state();
+
+        if ( state.change( state.depthMask, write ? TriState::ENABLED : TriState::DISABLED, StateCategory::DEPTH ) ) {
+            glDepthMask( write ? GL_TRUE : GL_FALSE );
+        }
+    }
+
+    void cullFace( const GLenum mode ) noexcept {
+        auto& state = open_gl::state();
+
+        if ( state.change( state.cullFace, mode, StateCategory::CULL ) ) {
+            glCullFace( mode );
+        }
+    }
+
+    void frontFace( const GLenum mode ) noexcept {
+        auto& state = open_gl::state();
+
+        if ( state.change( state.frontFace, mode, StateCategory::CULL ) ) {
+            glFrontFace( mode );
+        }
+    }
+
+    void deleteVertexArray( const Id id ) noexcept {
+        auto& state = open_gl::state();
+
+        if ( state.vertexArray == id ) {
+            state.vertexArray = 0;
+
+            for ( auto& [target, buffer] : state.buffers ) {
+                if ( target == GL_ELEMENT_ARRAY_BUFFER ) {
+                    buffer = UNKNOWN;
+                }
+            }
+        }
+
+        glDeleteVertexArrays( 1, &id );
+    }
+
+    void deleteBuffer( const Id id ) noexcept {
+        auto& state = open_gl::state();
+
+        for ( auto& [target, buffer] : state.buffers ) {
+            if ( buffer == id ) {
+                buffer = 0;
+            }
+        }
+        for ( auto& [key, buffer] : state.indexedBuffers ) {
+            if ( buffer == id ) {
+                buffer = 0;
+            }
+        }
+
+        glDeleteBuffers( 1, &id );
+    }
+
+    void deleteTexture( const Id id ) noexcept {
+        auto& state = open_gl::state();
+
+        for ( auto& unit : state.textures ) {
+            for ( auto& [target, texture] : unit ) {
+                if ( texture == id ) {
+                    texture = 0;
+                }
+            }
+        }
+
+        glDeleteTextures( 1, &id );
+    }
+
+    void deleteSampler( const Id id ) noexcept {
+        auto& state = open_gl::state();
+
+        for ( auto& sampler : state.samplers ) {
+            if ( sampler == id ) {
+                sampler = 0;
+            }
+        }
+
+        glDeleteSamplers( 1, &id );
+    }
+
+    void invalidateState() noexcept {
+        state().invalidate();
+    }
+
+    void releaseState( GLFWwindow* const context ) noexcept {
+        auto& registry = open_gl::registry();
+
+        const std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.states.erase( context );
+        registry.generation.fetch_add( 1, std::memory_order_release );
+    }
+
+    std::uint64_t currentContext() noexcept {
+        if ( glfwGetCurrentContext() == nullptr ) {
+            return 0;
+        }
+
+        return state().id;
+    }
+
+    bool isContextAlive( const std::uint64_t context ) noexcept {
+        auto& registry = open_gl::registry();
+
+        const std::lock_guard<std::mutex> lock(registry.mutex);
+        return std::any_of( registry.states.cbegin(), registry.states.cend(), [context]( const auto& entry ) noexcept {
+            return entry.second->id == context;
+        } );
+    }
+
+    std::uint64_t programDeletions() noexcept {
+        return registry().programDeletions.load( std::memory_order_acquire );
+    }
+
+    StateStatistics stateStatistics() noexcept {
+        return state().statistics;
+    }
+
+    void resetStateStatistics() noexcept {
+        state().statistics = StateStatistics{};
+    }
+    // endregion
+}
@@ -0,0 +1,74 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <glengine/lod_selector.hpp>
+
+namespace gl_engine {
+    LodSelector::LodSelector( const float pixelError, const float hysteresis ) noexcept
+    : pixelError_(pixelError), hysteresis_(std::clamp( hysteresis, 0.0f, 1.0f )) {}
+
+    float LodSelector::projectionScale( const float viewportHeight, const float verticalFieldOfView ) noexcept {
+        return viewportHeight / ( 2.0f * std::tan( verticalFieldOfView * 0.5f ) );
+    }
+
+    float LodSelector::distance( const Bounds& bounds, const glm::mat4& model, const glm::vec3& eye ) noexcept {
+        const auto center = glm::vec3(model * glm::vec4( ( bounds.min + bounds.max ) * 0.5f, 1.0f ));
+
+        // Le rayon suit la plus grande échelle de la matrice.
+        const auto scale = std::max( {glm::length( glm::vec3(model[0]) ), glm::length( glm::vec3(model[1]) ),
+                                      glm::length( glm::vec3(model[2]) )} );
+        const auto radius = glm::length( bounds.max - bounds.min ) * 0.5f * scale;
+
+        return std::max( glm::length( eye - center ) - radius, 0.0f );
+    }
+
+    std::size_t LodSelector::select( const ComplexObject& object, const float distance, const float projectionScale ) noexcept {
+        const auto levelCount = object.levelCount();
+        level_ = std::min( level_, levelCount - 1 );
+
+        // Dans l’objet, l’œil ne tolère aucun écart : le niveau le plus fin est choisi.
+        if ( distance <= 0.0f ) {
+            level_ = 0;
+            return level_;
+        }
+
+        const auto pixels = [&]( const std::size_t level ) noexcept {
+            return object.lodError( level ) * projectionScale / distance;
+        };
+
+        if ( pixels( level_ ) > pixelError_ * ( 1.0f + hysteresis_ ) ) {
+            // Trop grossier : le niveau le plus grossier sous le seuil, le niveau 0 n’ayant aucun écart.
+            while ( level_ > 0 && pixels( level_ ) > pixelError_ ) {
+                --level_;
+            }
+        }
+        else {
+            auto coarser = level_;
+            for ( auto level = level_ + 1; level < levelCount; ++level ) {
+                if ( pixels( level ) <= pixelError_ * ( 1.0f - hysteresis_ ) ) {
+                    coarser = level;
+                }
+            }
+            level_ = coarser;
+        }
+
+        return level_;
+    }
+}
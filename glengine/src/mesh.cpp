@@ -0,0 +1,74 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <utility>
+
+#include <glengine/mesh.hpp>
+
+namespace gl_engine {
+    namespace {
+        Bounds computeBounds( const std::vector<Vertex>& vertices ) noexcept {
+            if ( vertices.empty() ) {
+                return {};
+            }
+
+            Bounds bounds{vertices.front().position, vertices.front().position};
+            for ( const auto& vertex : vertices ) {
+                bounds.min = glm::min( bounds.min, vertex.position );
+                bounds.max = glm::max( bounds.max, vertex.position );
+            }
+
+            return bounds;
+        }
+    }
+
+    Mesh::Mesh( std::vector<Vertex> vertices, std::vector<std::uint32_t> indices, std::vector<SubMesh> subMeshes )
+    : ownedVertices_(std::move(vertices)), subMeshes_(std::move(subMeshes)) {
+        vertices_ = ownedVertices_.data();
+        vertexCount_ = ownedVertices_.size();
+
+        // La moitié de la mémoire et de la bande passante des indices lorsque 16 bits suffisent.
+        if ( vertexCount_ <= MAXIMUM_SHORT_VERTEX_COUNT ) {
+            ownedShortIndices_.assign( indices.cbegin(), indices.cend() );
+
+            indices_ = ownedShortIndices_.data();
+            indexCount_ = ownedShortIndices_.size();
+            indexSize_ = sizeof( std::uint16_t );
+        }
+        else {
+            ownedIndices_ = std::move( indices );
+
+            indices_ = ownedIndices_.data();
+            indexCount_ = ownedIndices_.size();
+            indexSize_ = sizeof( std::uint32_t );
+        }
+
+        bounds_ = computeBounds( ownedVertices_ );
+    }
+
+    Mesh::Mesh( std::vector<Vertex> vertices, std::vector<std::uint16_t> indices, std::vector<SubMesh> subMeshes ) noexcept
+    : ownedVertices_(std::move(vertices)), ownedShortIndices_(std::move(indices)), subMeshes_(std::move(subMeshes)) {
+        vertices_ = ownedVertices_.data();
+        vertexCount_ = ownedVertices_.size();
+
+        indices_ = ownedShortIndices_.data();
+        indexCount_ = ownedShortIndices_.size();
+        indexSize_ = sizeof( std::uint16_t );
+
+        bounds_ = computeBounds( ownedVertices_ );
+    }
+}
@@ -0,0 +1,163 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <glengine/gl_state.hpp>
+#include <glengine/mesh_buffer.hpp>
+
+namespace gl_engine {
+    namespace {
+        const void* offsetOf( const std::size_t offset ) noexcept {
+            return reinterpret_cast<const void*>(offset);
+        }
+    }
+
+    MeshBuffer::MeshBuffer( const Mesh& mesh )
+    : MeshBuffer( mesh, VertexFormat{} ) {}
+
+    MeshBuffer::MeshBuffer( const Mesh& mesh, const VertexFormat& format )
+    : indexCount_(static_cast<GLsizei>(mesh.indexCount())),
+      indexType_(mesh.indexSize() == sizeof( std::uint16_t ) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT),
+      indexSize_(static_cast<GLsizei>(mesh.indexSize())), format_(format), bounds_(mesh.bounds()) {
+        const auto stride = static_cast<GLsizei>(format.stride());
+
+        glGenVertexArrays( 1, &vertexArray_ );
+        glGenBuffers( 1, &vertexBuffer_ );
+        glGenBuffers( 1, &indexBuffer_ );
+
+        open_gl::bindVertexArray( vertexArray_ );
+
+        open_gl::bindBuffer( GL_ARRAY_BUFFER, vertexBuffer_ );
+        if ( format.isUncompressed() ) {
+            glBufferData( GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(mesh.vertexCount() * sizeof( Vertex )), mesh.vertices(), GL_STATIC_DRAW );
+        }
+        else {
+            const auto bytes = format.encode( mesh );
+            glBufferData( GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(bytes.size()), bytes.data(), GL_STATIC_DRAW );
+        }
+
+        // Note développeur : Le EBO est retenu par le VAO, il doit être lié pendant que le VAO est lié.
+        open_gl::bindBuffer( GL_ELEMENT_ARRAY_BUFFER, indexBuffer_ );
+        glBufferData( GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(mesh.indexCount() * mesh.indexSize()), mesh.indices(), GL_STATIC_DRAW );
+
+        glEnableVertexAttribArray( POSITION_LOCATION );
+        if ( format.quantizePositions ) {
+            glVertexAttribPointer( POSITION_LOCATION, 3, GL_UNSIGNED_SHORT, GL_TRUE, stride, offsetOf( format.positionOffset() ) );
+        }
+        else {
+            glVertexAttribPointer( POSITION_LOCATION, 3, GL_FLOAT, GL_FALSE, stride, offsetOf( format.positionOffset() ) );
+        }
+
+        glEnableVertexAttribArray( NORMAL_LOCATION );
+        if ( format.packNormals ) {
+            // Le format compressé impose 4 composantes, la quatrième est ignorée par le shader.
+            glVertexAttribPointer( NORMAL_LOCATION, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, offsetOf( format.normalOffset() ) );
+        }
+        else {
+            glVertexAttribPointer( NORMAL_LOCATION, 3, GL_FLOAT, GL_FALSE, stride, offsetOf( format.normalOffset() ) );
+        }
+
+        glEnableVertexAttribArray( TEXCOORD_LOCATION );
+        if ( format.halfTexCoords ) {
+            glVertexAttribPointer( TEXCOORD_LOCATION, 2, GL_HALF_FLOAT, GL_FALSE, stride, offsetOf( format.texCoordOffset() ) );
+        }
+        else {
+            glVertexAttribPointer( TEXCOORD_LOCATION, 2, GL_FLOAT, GL_FALSE, stride, offsetOf( format.texCoordOffset() ) );
+        }
+
+        open_gl::bindVertexArray( 0 );
+    }
+
+    MeshBuffer::MeshBuffer( MeshBuffer&& other ) noexcept
+    : vertexArray_(std::exchange(other.vertexArray_, 0)), vertexBuffer_(std::exchange(other.vertexBuffer_, 0)),
+      indexBuffer_(std::exchange(other.indexBuffer_, 0)), indexCount_(std::exchange(other.indexCount_, 0)),
+      indexType_(other.indexType_), indexSize_(other.indexSize_), format_(other.format_), bounds_(other.bounds_) {}
+
+    MeshBuffer& MeshBuffer::operator=( MeshBuffer&& other ) noexcept {
+        if ( &other != this ) {
+            release();
+
+            vertexArray_ = std::exchange( other.vertexArray_, 0 );
+            vertexBuffer_ = std::exchange( other.vertexBuffer_, 0 );
+            indexBuffer_ = std::exchange( other.indexBuffer_, 0 );
+            indexCount_ = std::exchange( other.indexCount_, 0 );
+            indexType_ = other.indexType_;
+            indexSize_ = other.indexSize_;
+            format_ = other.format_;
+            bounds_ = other.bounds_;
+        }
+
+        return *this;
+    }
+
+    MeshBuffer::~MeshBuffer() noexcept {
+        release();
+    }
+
+    void MeshBuffer::bind() const {
+        open_gl::bindVertexArray( vertexArray_ );
+    }
+
+    void MeshBuffer::draw() const {
+        bind();
+        glDrawElements( GL_TRIANGLES, indexCount_, indexType_, nullptr );
+    }
+
+    void MeshBuffer::draw( const SubMesh& subMesh ) const {
+        bind();
+        glDrawElements( GL_TRIANGLES, static_cast<GLsizei>(subMesh.indexCount), indexType_,
+                        offsetOf( static_cast<std::size_t>(subMesh.firstIndex) * static_cast<std::size_t>(indexSize_) ) );
+    }
+
+    void MeshBuffer::setDecoderUniforms( const Id program ) const {
+        if ( !format_.quantizePositions ) {
+            return;
+        }
+
+        const auto offset = glGetUniformLocation( program, std::string{VertexFormat::POSITION_OFFSET_UNIFORM}.c_str() );
+        const auto scale = glGetUniformLocation( program, std::string{VertexFormat::POSITION_SCALE_UNIFORM}.c_str() );
+
+        if ( offset != -1 ) {
+            glUniform3fv( offset, 1, glm::value_ptr( VertexFormat::positionOffset( bounds_ ) ) );
+        }
+        if ( scale != -1 ) {
+            glUniform3fv( scale, 1, glm::value_ptr( VertexFormat::positionScale( bounds_ ) ) );
+        }
+    }
+
+    void MeshBuffer::release() noexcept {
+        if ( vertexArray_ == 0 ) {
+            return;
+        }
+
+        open_gl::deleteBuffer( indexBuffer_ );
+        open_gl::deleteBuffer( vertexBuffer_ );
+        open_gl::deleteVertexArray( vertexArray_ );
+
+        vertexArray_ = 0;
+        vertexBuffer_ = 0;
+        indexBuffer_ = 0;
+    }
+}
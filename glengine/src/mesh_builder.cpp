@@ -0,0 +1,208 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glengine/mesh_builder.hpp>
+
+namespace gl_engine {
+    namespace {
+        /**
+         * @brief Table de hachage à adressage ouvert associant un coin de face à l’indice de son sommet.
+         *
+         * La capacité est une puissance de deux au moins deux fois supérieure au nombre de coins :
+         * le facteur de charge reste sous 50 %, les sondages sont donc courts et la table n’est jamais agrandie.
+         */
+        class CornerTable final {
+        public:
+            explicit CornerTable( const std::size_t cornerCount ) {
+                std::size_t capacity = 16;
+                while ( capacity < cornerCount * 2 ) {
+                    capacity *= 2;
+                }
+
+                slots_.resize( capacity );
+                mask_ = capacity - 1;
+            }
+
+            /**
+             * @brief Retourne l’indice associé au coin, ou l’insère avec l’indice candidate.
+             * @return L’indice du sommet et true si le coin vient d’être inséré.
+             */
+            std::pair<std::uint32_t, bool> insert( const Corner& corner, const std::uint32_t candidate ) noexcept {
+                for ( auto slot = hash( corner ) & mask_; ; slot = ( slot + 1 ) & mask_ ) {
+                    auto& entry = slots_[slot];
+
+                    if ( entry.index == NO_INDEX ) {
+                        entry.corner = corner;
+                        entry.index = candidate;
+
+                        return {candidate, true};
+                    }
+
+                    if ( entry.corner == corner ) {
+                        return {entry.index, false};
+                    }
+                }
+            }
+
+        private:
+            struct Slot {
+                Corner corner{};
+                std::uint32_t index = NO_INDEX;
+            };
+
+            static_assert( sizeof( Slot ) == 16, "Quatre entrées par ligne de cache." );
+
+            std::vector<Slot> slots_{};
+            std::size_t mask_ = 0;
+
+            static std::size_t hash( const Corner& corner ) noexcept {
+                // Multiplications par des constantes impaires distinctes puis mélange final de murmur3.
+                auto hash = corner.position * 0x9e3779b1u ^ corner.texture * 0x85ebca77u ^ corner.normal * 0xc2b2ae3du;
+                hash ^= hash >> 16;
+                hash *= 0x7feb352du;
+                hash ^= hash >> 15;
+
+                return hash;
+            }
+        };
+
+        /**
+         * @brief Regroupe les triangles par matériau : une seule plage d’indices, donc un seul appel de dessin, par matériau.
+         * @param order Reçoit l’ordre des triangles, vide si le fichier les regroupe déjà.
+         * @return Les plages, dans l’ordre de première utilisation des matériaux.
+         *
+         * Tri par dénombrement stable : l’ordre du fichier est conservé à l’intérieur d’un matériau.
+         */
+        std::vector<SubMesh> groupByMaterial( const ObjData& data, std::vector<std::uint32_t>& order ) {
+            constexpr auto NO_GROUP = static_cast<std::size_t>(-1);
+
+            const auto triangleCount = static_cast<std::uint32_t>(data.triangleCount());
+            const auto& ranges = data.materialRanges;
+
+            // Groupe 0 : triangles précédant le premier 'usemtl', groupe m + 1 : matériau m.
+            const auto rangeEnd = [&]( const std::size_t i ) noexcept {
+                return i + 1 < ranges.size() ? ranges[i + 1].firstTriangle : triangleCount;
+            };
+
+            std::vector<std::uint32_t> counts(data.materials.size() + 1, 0);
+            counts[0] = ranges.empty() ? triangleCount : ranges.front().firstTriangle;
+            for ( std::size_t i = 0; i < ranges.size(); ++i ) {
+                counts[ranges[i].material + 1] += rangeEnd( i ) - ranges[i].firstTriangle;
+            }
+
+            std::vector<SubMesh> subMeshes{};
+            std::vector<std::uint32_t> starts(counts.size(), 0);
+
+            std::uint32_t first = 0;
+            for ( std::size_t group = 0; group < counts.size(); ++group ) {
+                starts[group] = first;
+
+                if ( counts[group] > 0 ) {
+                    subMeshes.push_back( {group == 0 ? std::string{} : data.materials[group - 1], first * 3, counts[group] * 3} );
+                }
+
+                first += counts[group];
+            }
+
+            // Les matériaux apparaissent déjà un par un, dans l’ordre des plages : l’ordre du fichier convient.
+            auto sorted = true;
+            auto previousGroup = counts[0] > 0 ? std::size_t{0} : NO_GROUP;
+            for ( std::size_t i = 0; i < ranges.size() && sorted; ++i ) {
+                if ( rangeEnd( i ) > ranges[i].firstTriangle ) {
+                    const std::size_t group = ranges[i].material + 1;
+
+                    sorted = previousGroup == NO_GROUP || group > previousGroup;
+                    previousGroup = group;
+                }
+            }
+
+            if ( sorted ) {
+                order.clear();
+                return subMeshes;
+            }
+
+            order.resize( triangleCount );
+
+            for ( std::uint32_t triangle = 0; triangle < counts[0]; ++triangle ) {
+                order[starts[0]++] = triangle;
+            }
+            for ( std::size_t i = 0; i < ranges.size(); ++i ) {
+                auto& cursor = starts[ranges[i].material + 1];
+
+                for ( auto triangle = ranges[i].firstTriangle; triangle < rangeEnd( i ); ++triangle ) {
+                    order[cursor++] = triangle;
+                }
+            }
+
+            return subMeshes;
+        }
+    }
+
+    Mesh MeshBuilder::build( const ObjData& data ) {
+        WeldStatistics statistics{};
+
+        return build( data, statistics );
+    }
+
+    Mesh MeshBuilder::build( const ObjData& data, WeldStatistics& statistics ) {
+        const auto& corners = data.corners;
+
+        std::vector<std::uint32_t> order{};
+        auto subMeshes = groupByMaterial( data, order );
+
+        CornerTable table(corners.size());
+
+        std::vector<Vertex> vertices{};
+        std::vector<std::uint32_t> indices( corners.size() );
+
+        for ( std::size_t i = 0; i < corners.size(); ++i ) {
+            const auto source = order.empty() ? i : std::size_t{order[i / 3]} * 3 + i % 3;
+            const auto& corner = corners[source];
+
+            const auto [index, inserted] = table.insert( corner, static_cast<std::uint32_t>(vertices.size()) );
+            if ( inserted ) {
+                auto& vertex = vertices.emplace_back();
+
+                vertex.position = data.positions[corner.position];
+                if ( corner.normal != NO_INDEX ) {
+                    vertex.normal = data.normals[corner.normal];
+                }
+                if ( corner.texture != NO_INDEX ) {
+                    vertex.texCoord = data.texCoords[corner.texture];
+                }
+            }
+
+            indices[i] = index;
+        }
+
+        vertices.shrink_to_fit();
+
+        statistics.cornerCount = corners.size();
+        statistics.vertexCount = vertices.size();
+
+        Mesh mesh(std::move(vertices), std::move(indices), std::move(subMeshes));
+        mesh.setMaterialLibraries( data.materialLibraries );
+        statistics.indexSize = mesh.indexSize();
+
+        return mesh;
+    }
+}
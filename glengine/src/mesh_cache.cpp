@@ -0,0 +1,551 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <glengine/hash.hpp>
+#include <glengine/mesh_cache.hpp>
+
+namespace gl_engine {
+    namespace {
+        constexpr char MAGIC[8] = {'G', 'L', 'M', 'E', 'S', 'H', '\0', '\0'};
+
+        // Note développeur : Relu avec l’ordre des octets de la machine, un cache écrit sur une machine
+        // de boutisme différent est simplement ignoré.
+        constexpr std::uint32_t ENDIANNESS_MARK = 0x01020304;
+
+        constexpr std::uint64_t ALIGNMENT = 16;
+
+        /**
+         * @brief En-tête du fichier, écrit tel quel au début du cache.
+         */
+        struct Header {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t byteOrder;
+
+            std::uint64_t sourceSize;
+            std::int64_t sourceTime;
+            std::uint64_t sourceHash;
+
+            std::uint32_t vertexStride;
+            std::uint32_t indexSize;
+            std::uint64_t vertexCount;
+            std::uint64_t indexCount;
+
+            float boundsMin[3];
+            float boundsMax[3];
+
+            std::uint32_t subMeshCount;
+            std::uint32_t stringsSize;
+
+            std::uint32_t options;
+            std::uint32_t libraryCount;
+
+            std::uint64_t vertexOffset;
+            std::uint64_t indexOffset;
+            std::uint64_t subMeshOffset;
+            std::uint64_t libraryOffset;
+            std::uint64_t stringsOffset;
+
+            std::uint32_t lodCount;
+            std::uint32_t reserved;
+            std::uint64_t lodOffset;
+        };
+
+        static_assert( sizeof( Header ) == 160, "L’en-tête du cache ne doit pas contenir de remplissage." );
+
+        /**
+         * @brief Plage de matériau écrite dans le cache, le nom est stocké dans la table des chaines.
+         */
+        struct SubMeshRecord {
+            std::uint32_t nameOffset;
+            std::uint32_t nameSize;
+            std::uint32_t firstIndex;
+            std::uint32_t indexCount;
+        };
+
+        /**
+         * @brief Nom d’une bibliothèque de matériaux, stocké dans la table des chaines.
+         */
+        struct LibraryRecord {
+            std::uint32_t nameOffset;
+            std::uint32_t nameSize;
+        };
+
+        /**
+         * @brief Niveau de détail simplifié : ses sommets, indices et plages ont leurs propres sections.
+         */
+        struct LodRecord {
+            float error;
+            std::uint32_t indexSize;
+            std::uint32_t subMeshCount;
+            std::uint32_t reserved;
+
+            float boundsMin[3];
+            float boundsMax[3];
+
+            std::uint64_t vertexCount;
+            std::uint64_t indexCount;
+
+            std::uint64_t vertexOffset;
+            std::uint64_t indexOffset;
+            std::uint64_t subMeshOffset;
+        };
+
+        static_assert( sizeof( LodRecord ) == 80, "Un niveau du cache ne doit pas contenir de remplissage." );
+
+        constexpr std::uint64_t align( const std::uint64_t offset ) noexcept {
+            return ( offset + ALIGNMENT - 1 ) & ~( ALIGNMENT - 1 );
+        }
+
+        /**
+         * @brief Vérifie qu’une section de count éléments de size octets tient dans le fichier.
+         */
+        bool fits( const std::uint64_t offset, const std::uint64_t count, const std::uint64_t size, const std::uint64_t fileSize ) noexcept {
+            return offset % ALIGNMENT == 0
+                   && offset <= fileSize
+                   && count <= ( fileSize - offset ) / size;
+        }
+
+        /**
+         * @brief Date de modification du fichier, dans l’unité de l’horloge du système de fichier.
+         */
+        std::int64_t modificationTime( const std::filesystem::path& path, std::error_code& error ) noexcept {
+            return static_cast<std::int64_t>(std::filesystem::last_write_time( path, error ).time_since_epoch().count());
+        }
+
+        bool isValid( const Header& header, const std::uint64_t fileSize ) noexcept {
+            return std::memcmp( header.magic, MAGIC, sizeof( MAGIC ) ) == 0
+                   && header.version == MeshCache::VERSION
+                   && header.byteOrder == ENDIANNESS_MARK
+                   && header.vertexStride == sizeof( Vertex )
+                   && ( header.indexSize == 2 || header.indexSize == 4 )
+                   && fits( header.vertexOffset, header.vertexCount, header.vertexStride, fileSize )
+                   && fits( header.indexOffset, header.indexCount, header.indexSize, fileSize )
+                   && fits( header.subMeshOffset, header.subMeshCount, sizeof( SubMeshRecord ), fileSize )
+                   && fits( header.libraryOffset, header.libraryCount, sizeof( LibraryRecord ), fileSize )
+                   && fits( header.lodOffset, header.lodCount, sizeof( LodRecord ), fileSize )
+                   && fits( header.stringsOffset, header.stringsSize, 1, fileSize );
+        }
+
+        bool isValid( const LodRecord& record, const std::uint64_t fileSize ) noexcept {
+            return ( record.indexSize == 2 || record.indexSize == 4 )
+                   && fits( record.vertexOffset, record.vertexCount, sizeof( Vertex ), fileSize )
+                   && fits( record.indexOffset, record.indexCount, record.indexSize, fileSize )
+                   && fits( record.subMeshOffset, record.subMeshCount, sizeof( SubMeshRecord ), fileSize );
+        }
+
+        /**
+         * @brief Vérifie que chaque indice désigne un des vertexCount sommets.
+         */
+        template<typename Index>
+        bool indicesBelow( const char* const data, const std::uint64_t count, const std::uint64_t vertexCount ) noexcept {
+            const auto* const indices = reinterpret_cast<const Index*>(data);
+
+            // Un maximum plutôt qu’un arrêt au premier indice invalide : la boucle est vectorisée par le compilateur.
+            Index maximum = 0;
+            for ( std::uint64_t i = 0; i < count; ++i ) {
+                maximum = std::max( maximum, indices[i] );
+            }
+
+            return count == 0 || maximum < vertexCount;
+        }
+
+        bool indicesBelow( const char* const data, const std::uint64_t count, const std::uint32_t indexSize,
+                           const std::uint64_t vertexCount ) noexcept {
+            return indexSize == sizeof( std::uint16_t ) ? indicesBelow<std::uint16_t>( data, count, vertexCount )
+                                                        : indicesBelow<std::uint32_t>( data, count, vertexCount );
+        }
+
+        /**
+         * @brief Réécrit en place la date de la source dans l’en-tête d’un cache dont l’empreinte vient d’être vérifiée.
+         *
+         * @note Les deux dates désignent une source identique : un lecteur concurrent qui lit l’une ou l’autre
+         * utilise le même cache. Un échec est ignoré, l’empreinte sera simplement recalculée au prochain chargement.
+         */
+        void restamp( const std::filesystem::path& path, const std::int64_t sourceTime ) noexcept {
+            try {
+                std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+                if ( stream.is_open() ) {
+                    stream.seekp( static_cast<std::streamoff>(offsetof( Header, sourceTime )) );
+                    stream.write( reinterpret_cast<const char*>(&sourceTime), sizeof( sourceTime ) );
+                }
+            }
+            catch ( ... ) {
+                // La date n’est qu’une accélération : le cache reste valide.
+            }
+        }
+
+        /**
+         * @brief Lit une table de plages, std::nullopt si une plage sort de la table des chaines ou des indices.
+         */
+        std::optional<std::vector<SubMesh>> readSubMeshes( const MappedFile& file, const Header& header, const std::uint64_t offset,
+                                                           const std::uint32_t count, const std::uint64_t indexCount ) {
+            const auto* const strings = file.data() + header.stringsOffset;
+
+            std::vector<SubMesh> subMeshes{};
+            subMeshes.reserve( count );
+
+            for ( std::uint32_t i = 0; i < count; ++i ) {
+                SubMeshRecord record{};
+                std::memcpy( &record, file.data() + offset + i * sizeof( SubMeshRecord ), sizeof( SubMeshRecord ) );
+
+                const auto nameEnd = static_cast<std::uint64_t>(record.nameOffset) + record.nameSize;
+                const auto indexEnd = static_cast<std::uint64_t>(record.firstIndex) + record.indexCount;
+                if ( nameEnd > header.stringsSize || indexEnd > indexCount ) {
+                    return std::nullopt;
+                }
+
+                subMeshes.push_back( {std::string(strings + record.nameOffset, record.nameSize), record.firstIndex, record.indexCount} );
+            }
+
+            return subMeshes;
+        }
+
+        /**
+         * @brief Retourne les plages du maillage à écrire, leurs noms sont ajoutés à la table des chaines.
+         */
+        std::vector<SubMeshRecord> makeSubMeshRecords( const Mesh& mesh, std::string& strings ) {
+            std::vector<SubMeshRecord> records{};
+            records.reserve( mesh.subMeshes().size() );
+
+            for ( const auto& subMesh : mesh.subMeshes() ) {
+                records.push_back( {static_cast<std::uint32_t>(strings.size()), static_cast<std::uint32_t>(subMesh.material.size()),
+                                    subMesh.firstIndex, subMesh.indexCount} );
+                strings += subMesh.material;
+            }
+
+            return records;
+        }
+
+        void writePadding( std::ofstream& stream, const std::uint64_t offset ) {
+            static constexpr char ZEROS[ALIGNMENT] = {};
+
+            const auto padding = align( offset ) - offset;
+            stream.write( ZEROS, static_cast<std::streamsize>(padding) );
+        }
+    }
+
+    std::filesystem::path MeshCache::cachePath( const Path& source ) {
+        auto path = source.path_;
+        path += EXTENSION;
+
+        return path;
+    }
+
+    std::optional<MeshCache::Entry> MeshCache::load( const Path& source, const std::uint32_t options ) {
+        const auto path = cachePath( source );
+
+        std::error_code cacheError{};
+        const auto sourceStamp = stamp( source );
+        const auto cacheExists = std::filesystem::is_regular_file( path, cacheError );
+
+        if ( !sourceStamp || cacheError || !cacheExists ) {
+            return std::nullopt;
+        }
+
+        std::shared_ptr<const MappedFile> mapping{};
+
+        try {
+            mapping = std::make_shared<MappedFile>( Path(path) );
+        }
+        catch ( const Exception& ) {
+            // Cache vide ou illisible : il sera simplement reconstruit.
+            return std::nullopt;
+        }
+
+        const auto& file = *mapping;
+
+        Header header{};
+        if ( file.size() < sizeof( Header ) ) {
+            return std::nullopt;
+        }
+        std::memcpy( &header, file.data(), sizeof( Header ) );
+
+        if ( !isValid( header, file.size() ) || header.sourceSize != sourceStamp->size || header.options != options ) {
+            return std::nullopt;
+        }
+
+        if ( header.sourceTime != sourceStamp->time ) {
+            try {
+                const MappedFile sourceFile(source);
+                if ( utility::hashBytes( sourceFile.data(), sourceFile.size() ) != header.sourceHash ) {
+                    return std::nullopt;
+                }
+            }
+            catch ( const Exception& ) {
+                return std::nullopt;
+            }
+
+            // Source recopiée ou dépôt cloné : la nouvelle date évite de recalculer l’empreinte à chaque chargement.
+            restamp( path, sourceStamp->time );
+        }
+
+        // Un indice hors des sommets ferait lire la carte graphique hors du tampon : le cache est alors refusé.
+        if ( !indicesBelow( file.data() + header.indexOffset, header.indexCount, header.indexSize, header.vertexCount ) ) {
+            return std::nullopt;
+        }
+
+        // Les plages de matériaux sont les seules données copiées, elles sont peu nombreuses.
+        auto subMeshes = readSubMeshes( file, header, header.subMeshOffset, header.subMeshCount, header.indexCount );
+        if ( !subMeshes ) {
+            return std::nullopt;
+        }
+
+        Entry entry{};
+        auto& mesh = entry.mesh;
+
+        mesh.file_ = mapping;
+        mesh.subMeshes_ = std::move( *subMeshes );
+
+        const auto* const strings = file.data() + header.stringsOffset;
+        mesh.materialLibraries_.reserve( header.libraryCount );
+
+        for ( std::uint32_t i = 0; i < header.libraryCount; ++i ) {
+            LibraryRecord record{};
+            std::memcpy( &record, file.data() + header.libraryOffset + i * sizeof( LibraryRecord ), sizeof( LibraryRecord ) );
+
+            if ( static_cast<std::uint64_t>(record.nameOffset) + record.nameSize > header.stringsSize ) {
+                return std::nullopt;
+            }
+
+            mesh.materialLibraries_.emplace_back( strings + record.nameOffset, record.nameSize );
+        }
+
+        // Note développeur : La projection est alignée sur une page et les sections sur 16 octets,
+        // les pointeurs peuvent donc être lus directement comme des tableaux de sommets et d’indices.
+        mesh.vertices_ = reinterpret_cast<const Vertex*>(file.data() + header.vertexOffset);
+        mesh.vertexCount_ = static_cast<std::size_t>(header.vertexCount);
+
+        mesh.indices_ = file.data() + header.indexOffset;
+        mesh.indexCount_ = static_cast<std::size_t>(header.indexCount);
+        mesh.indexSize_ = header.indexSize;
+
+        mesh.bounds_.min = {header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]};
+        mesh.bounds_.max = {header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]};
+
+        // Les niveaux de détail partagent la projection du maillage : ni simplification, ni copie au chargement.
+        entry.lods.reserve( header.lodCount );
+
+        for ( std::uint32_t i = 0; i < header.lodCount; ++i ) {
+            LodRecord record{};
+            std::memcpy( &record, file.data() + header.lodOffset + i * sizeof( LodRecord ), sizeof( LodRecord ) );
+
+            if ( !isValid( record, file.size() )
+                 || !indicesBelow( file.data() + record.indexOffset, record.indexCount, record.indexSize, record.vertexCount ) ) {
+                return std::nullopt;
+            }
+
+            auto lodSubMeshes = readSubMeshes( file, header, record.subMeshOffset, record.subMeshCount, record.indexCount );
+            if ( !lodSubMeshes ) {
+                return std::nullopt;
+            }
+
+            auto& level = entry.lods.emplace_back();
+            level.error = record.error;
+
+            auto& lod = level.mesh;
+            lod.file_ = mapping;
+            lod.subMeshes_ = std::move( *lodSubMeshes );
+
+            lod.vertices_ = reinterpret_cast<const Vertex*>(file.data() + record.vertexOffset);
+            lod.vertexCount_ = static_cast<std::size_t>(record.vertexCount);
+
+            lod.indices_ = file.data() + record.indexOffset;
+            lod.indexCount_ = static_cast<std::size_t>(record.indexCount);
+            lod.indexSize_ = record.indexSize;
+
+            lod.bounds_.min = {record.boundsMin[0], record.boundsMin[1], record.boundsMin[2]};
+            lod.bounds_.max = {record.boundsMax[0], record.boundsMax[1], record.boundsMax[2]};
+        }
+
+        return entry;
+    }
+
+    std::optional<MeshCache::SourceStamp> MeshCache::stamp( const Path& source ) noexcept {
+        std::error_code sizeError{};
+        std::error_code timeError{};
+        const auto size = std::filesystem::file_size( source.path_, sizeError );
+        const auto time = modificationTime( source.path_, timeError );
+
+        if ( sizeError || timeError ) {
+            return std::nullopt;
+        }
+
+        return SourceStamp{size, time};
+    }
+
+    void MeshCache::store( const Path& source, const SourceStamp& stamp, const std::string_view content, const Mesh& mesh,
+                           const std::vector<LodLevel>& lods, const std::uint32_t options ) {
+        const auto path = cachePath( source );
+
+        auto temporaryPath = path;
+        temporaryPath += ".tmp";
+
+        std::error_code error{};
+
+        std::string strings{};
+        const auto records = makeSubMeshRecords( mesh, strings );
+
+        std::vector<LibraryRecord> libraries{};
+        libraries.reserve( mesh.materialLibraries().size() );
+
+        for ( const auto& library : mesh.materialLibraries() ) {
+            libraries.push_back( {static_cast<std::uint32_t>(strings.size()), static_cast<std::uint32_t>(library.size())} );
+            strings += library;
+        }
+
+        std::vector<std::vector<SubMeshRecord>> lodSubMeshes{};
+        lodSubMeshes.reserve( lods.size() );
+
+        for ( const auto& level : lods ) {
+            lodSubMeshes.push_back( makeSubMeshRecords( level.mesh, strings ) );
+        }
+
+        Header header{};
+        std::memcpy( header.magic, MAGIC, sizeof( MAGIC ) );
+        header.version = VERSION;
+        header.byteOrder = ENDIANNESS_MARK;
+
+        // Note développeur : La date relevée avant la lecture ne peut pas être plus récente que le contenu.
+        // Si la source a changé depuis, la date du fichier diffère de celle du cache et l’empreinte est recalculée.
+        header.sourceSize = content.size();
+        header.sourceTime = stamp.time;
+        header.sourceHash = utility::hashBytes( content.data(), content.size() );
+
+        header.vertexStride = sizeof( Vertex );
+        header.indexSize = static_cast<std::uint32_t>(mesh.indexSize());
+        header.vertexCount = mesh.vertexCount();
+        header.indexCount = mesh.indexCount();
+
+        const auto& bounds = mesh.bounds();
+        std::copy( &bounds.min.x, &bounds.min.x + 3, header.boundsMin );
+        std::copy( &bounds.max.x, &bounds.max.x + 3, header.boundsMax );
+
+        header.subMeshCount = static_cast<std::uint32_t>(records.size());
+        header.stringsSize = static_cast<std::uint32_t>(strings.size());
+
+        header.options = options;
+        header.libraryCount = static_cast<std::uint32_t>(libraries.size());
+        header.lodCount = static_cast<std::uint32_t>(lods.size());
+
+        const auto vertexBytes = header.vertexCount * header.vertexStride;
+        const auto indexBytes = header.indexCount * header.indexSize;
+        const auto subMeshBytes = records.size() * sizeof( SubMeshRecord );
+        const auto libraryBytes = libraries.size() * sizeof( LibraryRecord );
+        const auto lodBytes = lods.size() * sizeof( LodRecord );
+
+        header.vertexOffset = align( sizeof( Header ) );
+        header.indexOffset = align( header.vertexOffset + vertexBytes );
+        header.subMeshOffset = align( header.indexOffset + indexBytes );
+        header.libraryOffset = align( header.subMeshOffset + subMeshBytes );
+        header.lodOffset = align( header.libraryOffset + libraryBytes );
+
+        // Les sections de chaque niveau suivent la table des niveaux, dans le même ordre que celles du maillage.
+        std::vector<LodRecord> lodRecords( lods.size() );
+        auto end = header.lodOffset + lodBytes;
+
+        for ( std::size_t i = 0; i < lods.size(); ++i ) {
+            const auto& lod = lods[i].mesh;
+            auto& record = lodRecords[i];
+
+            record.error = lods[i].error;
+            record.indexSize = static_cast<std::uint32_t>(lod.indexSize());
+            record.subMeshCount = static_cast<std::uint32_t>(lodSubMeshes[i].size());
+
+            std::copy( &lod.bounds().min.x, &lod.bounds().min.x + 3, record.boundsMin );
+            std::copy( &lod.bounds().max.x, &lod.bounds().max.x + 3, record.boundsMax );
+
+            record.vertexCount = lod.vertexCount();
+            record.indexCount = lod.indexCount();
+
+            record.vertexOffset = align( end );
+            record.indexOffset = align( record.vertexOffset + record.vertexCount * sizeof( Vertex ) );
+            record.subMeshOffset = align( record.indexOffset + record.indexCount * record.indexSize );
+            end = record.subMeshOffset + record.subMeshCount * sizeof( SubMeshRecord );
+        }
+
+        header.stringsOffset = align( end );
+
+        {
+            std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+            if ( !stream.is_open() ) {
+                throw utility::ErrorWritingFile(temporaryPath.string());
+            }
+
+            stream.write( reinterpret_cast<const char*>(&header), sizeof( Header ) );
+            writePadding( stream, sizeof( Header ) );
+
+            stream.write( reinterpret_cast<const char*>(mesh.vertices()), static_cast<std::streamsize>(vertexBytes) );
+            writePadding( stream, header.vertexOffset + vertexBytes );
+
+            stream.write( static_cast<const char*>(mesh.indices()), static_cast<std::streamsize>(indexBytes) );
+            writePadding( stream, header.indexOffset + indexBytes );
+
+            stream.write( reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(subMeshBytes) );
+            writePadding( stream, header.subMeshOffset + subMeshBytes );
+
+            stream.write( reinterpret_cast<const char*>(libraries.data()), static_cast<std::streamsize>(libraryBytes) );
+            writePadding( stream, header.libraryOffset + libraryBytes );
+
+            stream.write( reinterpret_cast<const char*>(lodRecords.data()), static_cast<std::streamsize>(lodBytes) );
+            writePadding( stream, header.lodOffset + lodBytes );
+
+            for ( std::size_t i = 0; i < lods.size(); ++i ) {
+                const auto& lod = lods[i].mesh;
+                const auto& record = lodRecords[i];
+
+                const auto lodVertexBytes = record.vertexCount * sizeof( Vertex );
+                const auto lodIndexBytes = record.indexCount * record.indexSize;
+                const auto lodSubMeshBytes = record.subMeshCount * sizeof( SubMeshRecord );
+
+                stream.write( reinterpret_cast<const char*>(lod.vertices()), static_cast<std::streamsize>(lodVertexBytes) );
+                writePadding( stream, record.vertexOffset + lodVertexBytes );
+
+                stream.write( static_cast<const char*>(lod.indices()), static_cast<std::streamsize>(lodIndexBytes) );
+                writePadding( stream, record.indexOffset + lodIndexBytes );
+
+                stream.write( reinterpret_cast<const char*>(lodSubMeshes[i].data()), static_cast<std::streamsize>(lodSubMeshBytes) );
+                writePadding( stream, record.subMeshOffset + lodSubMeshBytes );
+            }
+
+            stream.write( strings.data(), static_cast<std::streamsize>(strings.size()) );
+
+            stream.close();
+            if ( !stream ) {
+                std::filesystem::remove( temporaryPath, error );
+                throw utility::ErrorWritingFile(temporaryPath.string());
+            }
+        }
+
+        // Le renommage remplace atomiquement un ancien cache, un lecteur ne voit jamais un fichier partiel.
+        std::filesystem::rename( temporaryPath, path, error );
+        if ( error ) {
+            std::filesystem::remove( temporaryPath, error );
+            throw utility::ErrorWritingFile(path.string());
+        }
+    }
+}
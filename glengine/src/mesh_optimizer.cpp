@@ -0,0 +1,430 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <glengine/mesh_optimizer.hpp>
+
+namespace gl_engine {
+    namespace {
+        using Indices = std::vector<std::uint32_t>;
+
+        // region Forsyth
+        // Note développeur : Constantes de l’article original de Tom Forsyth.
+        constexpr float CACHE_DECAY_POWER = 1.5f;
+        constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+        constexpr float VALENCE_BOOST_SCALE = 2.0f;
+        constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+        constexpr std::size_t MAXIMUM_VALENCE = 32;
+
+        /**
+         * @brief Tables des scores selon la position dans le cache et le nombre de triangles restants.
+         */
+        class ScoreTables final {
+        public:
+            ScoreTables() noexcept {
+                constexpr auto size = MeshOptimizer::CACHE_SIZE;
+
+                for ( std::size_t position = 0; position < size; ++position ) {
+                    if ( position < 3 ) {
+                        // Les sommets du dernier triangle ont un score fixe, pour ne pas favoriser un triangle
+                        // réutilisant l’arête qui vient d’être dessinée plutôt qu’un autre.
+                        cache[position] = LAST_TRIANGLE_SCORE;
+                    }
+                    else {
+                        const auto scale = 1.0f / static_cast<float>(size - 3);
+                        cache[position] = std::pow( 1.0f - static_cast<float>(position - 3) * scale, CACHE_DECAY_POWER );
+                    }
+                }
+
+                valence[0] = 0.0f;
+                for ( std::size_t count = 1; count <= MAXIMUM_VALENCE; ++count ) {
+                    valence[count] = VALENCE_BOOST_SCALE * std::pow( static_cast<float>(count), -VALENCE_BOOST_POWER );
+                }
+            }
+
+            float score( const int cachePosition, const std::uint32_t activeTriangles ) const noexcept {
+                if ( activeTriangles == 0 ) {
+                    return -1.0f;
+                }
+
+                auto result = valence[std::min<std::size_t>( activeTriangles, MAXIMUM_VALENCE )];
+                if ( cachePosition >= 0 && static_cast<std::size_t>(cachePosition) < MeshOptimizer::CACHE_SIZE ) {
+                    result += cache[static_cast<std::size_t>(cachePosition)];
+                }
+
+                return result;
+            }
+
+        private:
+            std::array<float, MeshOptimizer::CACHE_SIZE> cache{};
+            std::array<float, MAXIMUM_VALENCE + 1> valence{};
+        };
+
+        /**
+         * @brief Réordonne les triangles de [first, first + count[ pour la localité du cache de sommets.
+         */
+        void optimizeVertexCache( Indices& indices, const std::size_t first, const std::size_t count, const std::size_t vertexCount ) {
+            static const ScoreTables tables{};
+
+            const auto triangleCount = count / 3;
+            if ( triangleCount < 2 ) {
+                return;
+            }
+
+            const auto* const source = indices.data() + first;
+
+            // Triangles adjacents à chaque sommet, rangés de façon contiguë (CSR).
+            // Les triangles restant à dessiner sont en tête de la plage de chaque sommet.
+            std::vector<std::uint32_t> activeTriangles( vertexCount, 0 );
+            for ( std::size_t i = 0; i < count; ++i ) {
+                ++activeTriangles[source[i]];
+            }
+
+            std::vector<std::uint32_t> adjacencyOffsets( vertexCount + 1, 0 );
+            for ( std::size_t vertex = 0; vertex < vertexCount; ++vertex ) {
+                adjacencyOffsets[vertex + 1] = adjacencyOffsets[vertex] + activeTriangles[vertex];
+            }
+
+            std::vector<std::uint32_t> adjacency( count );
+            {
+                auto cursors = adjacencyOffsets;
+                for ( std::size_t triangle = 0; triangle < triangleCount; ++triangle ) {
+                    for ( std::size_t corner = 0; corner < 3; ++corner ) {
+                        adjacency[cursors[source[triangle * 3 + corner]]++] = static_cast<std::uint32_t>(triangle);
+                    }
+                }
+            }
+
+            std::vector<int> cachePositions( vertexCount, -1 );
+            std::vector<float> vertexScores( vertexCount, 0.0f );
+            for ( std::size_t vertex = 0; vertex < vertexCount; ++vertex ) {
+                vertexScores[vertex] = tables.score( -1, activeTriangles[vertex] );
+            }
+
+            std::vector<float> triangleScores( triangleCount );
+            for ( std::size_t triangle = 0; triangle < triangleCount; ++triangle ) {
+                triangleScores[triangle] = vertexScores[source[triangle * 3]]
+                                           + vertexScores[source[triangle * 3 + 1]]
+                                           + vertexScores[source[triangle * 3 + 2]];
+            }
+
+            std::vector<bool> emitted( triangleCount, false );
+
+            Indices result{};
+            result.reserve( count );
+
+            std::array<std::uint32_t, MeshOptimizer::CACHE_SIZE + 3> cache{};
+            std::array<std::uint32_t, MeshOptimizer::CACHE_SIZE + 3> nextCache{};
+            std::size_t cacheCount = 0;
+
+            auto best = static_cast<std::size_t>(std::max_element( triangleScores.cbegin(), triangleScores.cend() ) - triangleScores.cbegin());
+            std::size_t cursor = 0;
+
+            while ( result.size() < count ) {
+                if ( best == triangleCount ) {
+                    // Impasse : aucun triangle adjacent au cache, on reprend au premier triangle restant.
+                    while ( emitted[cursor] ) {
+                        ++cursor;
+                    }
+                    best = cursor;
+                }
+
+                emitted[best] = true;
+
+                const std::array<std::uint32_t, 3> triangle = {source[best * 3], source[best * 3 + 1], source[best * 3 + 2]};
+
+                for ( const auto vertex : triangle ) {
+                    result.push_back( vertex );
+
+                    // Retire le triangle des triangles actifs du sommet.
+                    const auto begin = adjacency.begin() + adjacencyOffsets[vertex];
+                    const auto end = begin + activeTriangles[vertex];
+                    std::iter_swap( std::find( begin, end, static_cast<std::uint32_t>(best) ), end - 1 );
+                    --activeTriangles[vertex];
+                }
+
+                // Les sommets du triangle passent en tête du cache LRU, suivis des anciens sommets.
+                std::size_t nextCount = 0;
+                for ( const auto vertex : triangle ) {
+                    if ( std::find( nextCache.cbegin(), nextCache.cbegin() + nextCount, vertex ) == nextCache.cbegin() + nextCount ) {
+                        nextCache[nextCount++] = vertex;
+                    }
+                }
+                for ( std::size_t i = 0; i < cacheCount; ++i ) {
+                    const auto vertex = cache[i];
+                    if ( vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2] ) {
+                        nextCache[nextCount++] = vertex;
+                    }
+                }
+
+                for ( std::size_t i = 0; i < nextCount; ++i ) {
+                    const auto vertex = nextCache[i];
+                    cachePositions[vertex] = i < MeshOptimizer::CACHE_SIZE ? static_cast<int>(i) : -1;
+                    vertexScores[vertex] = tables.score( cachePositions[vertex], activeTriangles[vertex] );
+                }
+
+                // Seuls les triangles adjacents aux sommets du cache (ou qui viennent d’en sortir) changent de score.
+                best = triangleCount;
+                auto bestScore = -1.0f;
+                for ( std::size_t i = 0; i < nextCount; ++i ) {
+                    const auto vertex = nextCache[i];
+                    const auto begin = adjacencyOffsets[vertex];
+
+                    for ( auto j = begin; j < begin + activeTriangles[vertex]; ++j ) {
+                        const auto candidate = adjacency[j];
+                        const auto score = vertexScores[source[candidate * 3]]
+                                           + vertexScores[source[candidate * 3 + 1]]
+                                           + vertexScores[source[candidate * 3 + 2]];
+                        triangleScores[candidate] = score;
+
+                        if ( score > bestScore ) {
+                            bestScore = score;
+                            best = candidate;
+                        }
+                    }
+                }
+
+                cacheCount = std::min( nextCount, MeshOptimizer::CACHE_SIZE );
+                std::copy( nextCache.cbegin(), nextCache.cbegin() + cacheCount, cache.begin() );
+            }
+
+            std::copy( result.cbegin(), result.cend(), indices.begin() + first );
+        }
+        // endregion
+
+        // region Surcharge de pixels
+        /**
+         * @brief Cache FIFO de sommets transformés simulé par horodatage.
+         */
+        class FifoCache final {
+        public:
+            FifoCache( const std::size_t vertexCount, const std::size_t size )
+            : timestamps_(vertexCount, 0), size_(size), time_(size + 1) {}
+
+            /**
+             * @brief Retourne true si le sommet a dû être transformé.
+             */
+            bool access( const std::uint32_t vertex ) noexcept {
+                if ( time_ - timestamps_[vertex] <= size_ ) {
+                    return false;
+                }
+
+                timestamps_[vertex] = time_++;
+
+                return true;
+            }
+
+        private:
+            std::vector<std::size_t> timestamps_;
+            std::size_t size_;
+            std::size_t time_;
+        };
+
+        /**
+         * @brief Trie les groupes de triangles de [first, first + count[ pour réduire la surcharge de pixels.
+         *
+         * Un groupe commence à chaque triangle dont les trois sommets manquent le cache : déplacer un groupe
+         * entier ne dégrade donc quasiment pas la localité obtenue par l’algorithme de Forsyth. Les groupes
+         * dont la normale moyenne pointe vers l’extérieur du maillage sont dessinés en premier, ils occultent
+         * le plus souvent les autres.
+         */
+        void optimizeOverdraw( Indices& indices, const std::size_t first, const std::size_t count, const Mesh& mesh ) {
+            const auto triangleCount = count / 3;
+            if ( triangleCount < 2 ) {
+                return;
+            }
+
+            const auto* const source = indices.data() + first;
+            const auto* const vertices = mesh.vertices();
+
+            std::vector<std::size_t> clusterStarts{};
+            {
+                FifoCache cache(mesh.vertexCount(), MeshOptimizer::CLUSTER_CACHE_SIZE);
+                for ( std::size_t triangle = 0; triangle < triangleCount; ++triangle ) {
+                    auto misses = 0;
+                    for ( std::size_t corner = 0; corner < 3; ++corner ) {
+                        misses += cache.access( source[triangle * 3 + corner] ) ? 1 : 0;
+                    }
+
+                    if ( triangle == 0 || misses == 3 ) {
+                        clusterStarts.push_back( triangle );
+                    }
+                }
+            }
+
+            if ( clusterStarts.size() < 2 ) {
+                return;
+            }
+
+            clusterStarts.push_back( triangleCount );
+            const auto clusterCount = clusterStarts.size() - 1;
+
+            struct Cluster {
+                glm::vec3 centroid{};
+                glm::vec3 normal{};
+                float area = 0.0f;
+            };
+
+            std::vector<Cluster> clusters( clusterCount );
+            glm::vec3 meshCentroid{};
+            auto meshArea = 0.0f;
+
+            for ( std::size_t i = 0; i < clusterCount; ++i ) {
+                auto& cluster = clusters[i];
+
+                for ( auto triangle = clusterStarts[i]; triangle < clusterStarts[i + 1]; ++triangle ) {
+                    const auto& a = vertices[source[triangle * 3]].position;
+                    const auto& b = vertices[source[triangle * 3 + 1]].position;
+                    const auto& c = vertices[source[triangle * 3 + 2]].position;
+
+                    // La norme du produit vectoriel vaut deux fois l’aire du triangle.
+                    const auto normal = glm::cross( b - a, c - a );
+                    const auto area = glm::length( normal );
+
+                    cluster.centroid += ( a + b + c ) * ( area / 3.0f );
+                    cluster.normal += normal;
+                    cluster.area += area;
+                }
+
+                meshCentroid += cluster.centroid;
+                meshArea += cluster.area;
+
+                if ( cluster.area > 0.0f ) {
+                    cluster.centroid /= cluster.area;
+                }
+            }
+
+            if ( meshArea > 0.0f ) {
+                meshCentroid /= meshArea;
+            }
+
+            std::vector<float> keys( clusterCount );
+            for ( std::size_t i = 0; i < clusterCount; ++i ) {
+                const auto& cluster = clusters[i];
+                const auto length = glm::length( cluster.normal );
+
+                keys[i] = length > 0.0f ? glm::dot( cluster.centroid - meshCentroid, cluster.normal / length ) : 0.0f;
+            }
+
+            std::vector<std::size_t> order( clusterCount );
+            std::iota( order.begin(), order.end(), 0 );
+            std::stable_sort( order.begin(), order.end(), [&keys]( const std::size_t c1, const std::size_t c2 ) {
+                return keys[c1] > keys[c2];
+            } );
+
+            Indices result{};
+            result.reserve( count );
+            for ( const auto cluster : order ) {
+                result.insert( result.end(), source + clusterStarts[cluster] * 3, source + clusterStarts[cluster + 1] * 3 );
+            }
+
+            std::copy( result.cbegin(), result.cend(), indices.begin() + first );
+        }
+        // endregion
+
+        /**
+         * @brief Renumérote les sommets dans l’ordre de leur première utilisation.
+         *
+         * Les sommets inutilisés sont conservés à la fin.
+         */
+        std::vector<Vertex> optimizeVertexFetch( Indices& indices, const Mesh& mesh ) {
+            constexpr auto UNUSED = std::numeric_limits<std::uint32_t>::max();
+
+            const auto vertexCount = mesh.vertexCount();
+
+            std::vector<std::uint32_t> remap( vertexCount, UNUSED );
+            std::vector<Vertex> vertices{};
+            vertices.reserve( vertexCount );
+
+            for ( auto& index : indices ) {
+                if ( remap[index] == UNUSED ) {
+                    remap[index] = static_cast<std::uint32_t>(vertices.size());
+                    vertices.push_back( mesh.vertices()[index] );
+                }
+
+                index = remap[index];
+            }
+
+            for ( std::size_t vertex = 0; vertex < vertexCount; ++vertex ) {
+                if ( remap[vertex] == UNUSED ) {
+                    vertices.push_back( mesh.vertices()[vertex] );
+                }
+            }
+
+            return vertices;
+        }
+    }
+
+    Mesh MeshOptimizer::optimize( const Mesh& mesh ) {
+        Indices indices( mesh.indexCount() );
+        for ( std::size_t i = 0; i < indices.size(); ++i ) {
+            indices[i] = mesh.index( i );
+        }
+
+        // Les plages de matériaux sont optimisées séparément pour rester contiguës.
+        for ( const auto& subMesh : mesh.subMeshes() ) {
+            optimizeVertexCache( indices, subMesh.firstIndex, subMesh.indexCount, mesh.vertexCount() );
+            optimizeOverdraw( indices, subMesh.firstIndex, subMesh.indexCount, mesh );
+        }
+
+        auto vertices = optimizeVertexFetch( indices, mesh );
+
+        Mesh optimized(std::move(vertices), std::move(indices), mesh.subMeshes());
+        optimized.setMaterialLibraries( mesh.materialLibraries() );
+
+        return optimized;
+    }
+
+    VertexCacheStatistics MeshOptimizer::analyzeVertexCache( const Mesh& mesh, const std::size_t cacheSize ) {
+        VertexCacheStatistics statistics{};
+
+        if ( mesh.indexCount() == 0 ) {
+            return statistics;
+        }
+
+        FifoCache cache(mesh.vertexCount(), cacheSize);
+        std::vector<bool> used( mesh.vertexCount(), false );
+        std::size_t usedCount = 0;
+
+        for ( std::size_t i = 0; i < mesh.indexCount(); ++i ) {
+            const auto vertex = mesh.index( i );
+
+            if ( cache.access( vertex ) ) {
+                ++statistics.transformedVertices;
+            }
+
+            if ( !used[vertex] ) {
+                used[vertex] = true;
+                ++usedCount;
+            }
+        }
+
+        statistics.acmr = static_cast<double>(statistics.transformedVertices) / static_cast<double>(mesh.indexCount() / 3);
+        statistics.atvr = static_cast<double>(statistics.transformedVertices) / static_cast<double>(usedCount);
+
+        return statistics;
+    }
+}
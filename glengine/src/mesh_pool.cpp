@@ -0,0 +1,208 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <glengine/gl_state.hpp>
+#include <glengine/mesh_buffer.hpp>
+#include <glengine/mesh_pool.hpp>
+
+namespace gl_engine {
+    namespace {
+        /// Capacité minimale d’un agrandissement, en éléments : évite une série de petites copies au début.
+        constexpr std::size_t MINIMUM_CAPACITY = 4096;
+
+        const void* offsetOf( const std::size_t offset ) noexcept {
+            return reinterpret_cast<const void*>(offset);
+        }
+
+        /**
+         * @brief Remplace un buffer par un buffer plus grand contenant ses usedBytes premiers octets.
+         *
+         * Les cibles de copie ne font pas partie du VAO : le EBO lié au VAO n’est pas modifié.
+         */
+        Id grow( const Id buffer, const std::size_t usedBytes, const std::size_t capacityBytes ) {
+            Id grown = 0;
+            glGenBuffers( 1, &grown );
+
+            open_gl::bindBuffer( GL_COPY_WRITE_BUFFER, grown );
+            glBufferData( GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(capacityBytes), nullptr, GL_STATIC_DRAW );
+
+            if ( usedBytes > 0 ) {
+                open_gl::bindBuffer( GL_COPY_READ_BUFFER, buffer );
+                glCopyBufferSubData( GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, static_cast<GLsizeiptr>(usedBytes) );
+            }
+            if ( buffer != 0 ) {
+                open_gl::deleteBuffer( buffer );
+            }
+
+            return grown;
+        }
+    }
+
+    MeshPool::MeshPool() {
+        glGenVertexArrays( 1, &vertexArray_ );
+    }
+
+    MeshPool::MeshPool( const std::size_t vertexCapacity, const std::size_t indexCapacity )
+    : MeshPool() {
+        reserve( vertexCapacity, indexCapacity );
+    }
+
+    MeshPool::MeshPool( MeshPool&& other ) noexcept
+    : vertexArray_(std::exchange(other.vertexArray_, 0)), vertexBuffer_(std::exchange(other.vertexBuffer_, 0)),
+      indexBuffer_(std::exchange(other.indexBuffer_, 0)), vertexCount_(std::exchange(other.vertexCount_, 0)),
+      indexCount_(std::exchange(other.indexCount_, 0)), vertexCapacity_(std::exchange(other.vertexCapacity_, 0)),
+      indexCapacity_(std::exchange(other.indexCapacity_, 0)) {}
+
+    MeshPool& MeshPool::operator=( MeshPool&& other ) noexcept {
+        if ( &other != this ) {
+            release();
+
+            vertexArray_ = std::exchange( other.vertexArray_, 0 );
+            vertexBuffer_ = std::exchange( other.vertexBuffer_, 0 );
+            indexBuffer_ = std::exchange( other.indexBuffer_, 0 );
+            vertexCount_ = std::exchange( other.vertexCount_, 0 );
+            indexCount_ = std::exchange( other.indexCount_, 0 );
+            vertexCapacity_ = std::exchange( other.vertexCapacity_, 0 );
+            indexCapacity_ = std::exchange( other.indexCapacity_, 0 );
+        }
+
+        return *this;
+    }
+
+    MeshPool::~MeshPool() noexcept {
+        release();
+    }
+
+    PoolRange MeshPool::add( const Mesh& mesh ) {
+        constexpr auto MAXIMUM_VERTEX_COUNT = static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max());
+        constexpr auto MAXIMUM_INDEX_COUNT = static_cast<std::size_t>(std::numeric_limits<std::uint32_t>::max());
+
+        if ( mesh.vertexCount() > MAXIMUM_VERTEX_COUNT - vertexCount_ || mesh.indexCount() > MAXIMUM_INDEX_COUNT - indexCount_ ) {
+            throw std::length_error( "gl_engine::MeshPool : le pool ne peut pas contenir ce maillage." );
+        }
+
+        const PoolRange range{static_cast<std::int32_t>(vertexCount_), static_cast<std::uint32_t>(indexCount_),
+                              static_cast<std::uint32_t>(mesh.indexCount())};
+        if ( mesh.indexCount() == 0 ) {
+            return range;
+        }
+
+        // Les indices 16 bits sont élargis : un seul type d’indice pour tout le pool.
+        std::vector<std::uint32_t> widened{};
+        const void* indices = mesh.indices();
+        if ( mesh.indexSize() != sizeof( std::uint32_t ) ) {
+            widened.resize( mesh.indexCount() );
+            for ( std::size_t i = 0; i < widened.size(); ++i ) {
+                widened[i] = mesh.index( i );
+            }
+            indices = widened.data();
+        }
+
+        reserve( vertexCount_ + mesh.vertexCount(), indexCount_ + mesh.indexCount() );
+
+        open_gl::bindBuffer( GL_ARRAY_BUFFER, vertexBuffer_ );
+        glBufferSubData( GL_ARRAY_BUFFER, static_cast<GLintptr>(vertexCount_ * sizeof( Vertex )),
+                         static_cast<GLsizeiptr>(mesh.vertexCount() * sizeof( Vertex )), mesh.vertices() );
+
+        open_gl::bindBuffer( GL_COPY_WRITE_BUFFER, indexBuffer_ );
+        glBufferSubData( GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(indexCount_ * sizeof( std::uint32_t )),
+                         static_cast<GLsizeiptr>(mesh.indexCount() * sizeof( std::uint32_t )), indices );
+
+        vertexCount_ += mesh.vertexCount();
+        indexCount_ += mesh.indexCount();
+
+        return range;
+    }
+
+    void MeshPool::reserve( const std::size_t vertexCount, const std::size_t indexCount ) {
+        auto changed = false;
+
+        if ( vertexCount > vertexCapacity_ ) {
+            const auto capacity = std::max( {vertexCount, vertexCapacity_ * 2, MINIMUM_CAPACITY} );
+            vertexBuffer_ = grow( vertexBuffer_, vertexCount_ * sizeof( Vertex ), capacity * sizeof( Vertex ) );
+            vertexCapacity_ = capacity;
+            changed = true;
+        }
+
+        if ( indexCount > indexCapacity_ ) {
+            const auto capacity = std::max( {indexCount, indexCapacity_ * 2, MINIMUM_CAPACITY} );
+            indexBuffer_ = grow( indexBuffer_, indexCount_ * sizeof( std::uint32_t ), capacity * sizeof( std::uint32_t ) );
+            indexCapacity_ = capacity;
+            changed = true;
+        }
+
+        if ( changed ) {
+            attach();
+        }
+    }
+
+    void MeshPool::attach() noexcept {
+        // Note développeur : Le VAO retient le buffer de chaque attribut et le EBO : tout est relié après un agrandissement.
+        open_gl::bindVertexArray( vertexArray_ );
+
+        if ( vertexBuffer_ != 0 ) {
+            open_gl::bindBuffer( GL_ARRAY_BUFFER, vertexBuffer_ );
+
+            constexpr auto stride = static_cast<GLsizei>(sizeof( Vertex ));
+
+            glEnableVertexAttribArray( MeshBuffer::POSITION_LOCATION );
+            glVertexAttribPointer( MeshBuffer::POSITION_LOCATION, 3, GL_FLOAT, GL_FALSE, stride, offsetOf( offsetof( Vertex, position ) ) );
+            glEnableVertexAttribArray( MeshBuffer::NORMAL_LOCATION );
+            glVertexAttribPointer( MeshBuffer::NORMAL_LOCATION, 3, GL_FLOAT, GL_FALSE, stride, offsetOf( offsetof( Vertex, normal ) ) );
+            glEnableVertexAttribArray( MeshBuffer::TEXCOORD_LOCATION );
+            glVertexAttribPointer( MeshBuffer::TEXCOORD_LOCATION, 2, GL_FLOAT, GL_FALSE, stride, offsetOf( offsetof( Vertex, texCoord ) ) );
+        }
+
+        if ( indexBuffer_ != 0 ) {
+            open_gl::bindBuffer( GL_ELEMENT_ARRAY_BUFFER, indexBuffer_ );
+        }
+
+        open_gl::bindVertexArray( 0 );
+    }
+
+    void MeshPool::release() noexcept {
+        if ( vertexArray_ == 0 ) {
+            return;
+        }
+
+        if ( indexBuffer_ != 0 ) {
+            open_gl::deleteBuffer( indexBuffer_ );
+        }
+        if ( vertexBuffer_ != 0 ) {
+            open_gl::deleteBuffer( vertexBuffer_ );
+        }
+        open_gl::deleteVertexArray( vertexArray_ );
+
+        vertexArray_ = 0;
+        vertexBuffer_ = 0;
+        indexBuffer_ = 0;
+        vertexCount_ = 0;
+        indexCount_ = 0;
+        vertexCapacity_ = 0;
+        indexCapacity_ = 0;
+    }
+}
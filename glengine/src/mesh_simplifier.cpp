@@ -0,0 +1,836 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <glengine/mesh_optimizer.hpp>
+#include <glengine/mesh_simplifier.hpp>
+#include <glengine/parallel.hpp>
+
+namespace gl_engine {
+    namespace {
+        /// Normale (3) et coordonnées de texture (2).
+        constexpr std::size_t ATTRIBUTE_COUNT = 5;
+
+        /// Arêtes évaluées par tâche.
+        constexpr std::size_t EDGES_PER_TASK = 4096;
+
+        /// Cosinus minimal entre la normale d’un triangle avant et après une contraction.
+        constexpr double MINIMUM_FLIP_COSINE = 0.2;
+
+        /// Poids des plans retenant les bords ouverts, relatif au carré de la longueur de l’arête.
+        constexpr double BORDER_WEIGHT = 4.0;
+
+        /// Une passe n’examine que la moitié la moins coûteuse des arêtes : les autres sont réévaluées à la passe suivante,
+        /// dans un maillage déjà simplifié autour d’elles, plutôt que contractées sur une évaluation périmée.
+        constexpr std::size_t PASS_FRACTION_PERCENT = 50;
+
+        /// Un niveau de détail réduisant moins que cette fraction du niveau précédent termine la chaine.
+        constexpr double MINIMUM_LOD_REDUCTION = 0.95;
+
+        constexpr double NO_COLLAPSE = std::numeric_limits<double>::infinity();
+
+        constexpr std::uint32_t NO_VERTEX = std::numeric_limits<std::uint32_t>::max();
+
+        using Attributes = std::array<double, ATTRIBUTE_COUNT>;
+
+        /**
+         * @brief Quadrique de distance aux plans : p^T A p + 2 b.p + c, A symétrique.
+         */
+        struct Quadric {
+            double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+            double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+            double c = 0.0;
+            /// Somme des aires, normalise l’erreur en distance.
+            double weight = 0.0;
+
+            void addPlane( const glm::dvec3& normal, const double distance, const double planeWeight ) noexcept {
+                a00 += planeWeight * normal.x * normal.x;
+                a01 += planeWeight * normal.x * normal.y;
+                a02 += planeWeight * normal.x * normal.z;
+                a11 += planeWeight * normal.y * normal.y;
+                a12 += planeWeight * normal.y * normal.z;
+                a22 += planeWeight * normal.z * normal.z;
+                b0 += planeWeight * normal.x * distance;
+                b1 += planeWeight * normal.y * distance;
+                b2 += planeWeight * normal.z * distance;
+                c += planeWeight * distance * distance;
+                weight += planeWeight;
+            }
+
+            Quadric& operator+=( const Quadric& other ) noexcept {
+                a00 += other.a00, a01 += other.a01, a02 += other.a02, a11 += other.a11, a12 += other.a12, a22 += other.a22;
+                b0 += other.b0, b1 += other.b1, b2 += other.b2;
+                c += other.c;
+                weight += other.weight;
+
+                return *this;
+            }
+
+            [[nodiscard]] double evaluate( const glm::dvec3& p ) const noexcept {
+                return a00 * p.x * p.x + a11 * p.y * p.y + a22 * p.z * p.z
+                       + 2.0 * ( a01 * p.x * p.y + a02 * p.x * p.z + a12 * p.y * p.z )
+                       + 2.0 * ( b0 * p.x + b1 * p.y + b2 * p.z ) + c;
+            }
+        };
+
+        /**
+         * @brief Quadrique d’attributs de Hoppe : somme des aires × (g.p + d - s)² pour chaque attribut s,
+         * où g.p + d interpole linéairement l’attribut sur un triangle d’origine.
+         */
+        struct AttributeQuadric {
+            struct Term {
+                /// Somme de aire × g g^T, symétrique.
+                double gg[6]{};
+                /// Somme de aire × g × d.
+                double gd[3]{};
+                /// Somme de aire × g.
+                double g[3]{};
+                /// Somme de aire × d².
+                double dd = 0.0;
+                /// Somme de aire × d.
+                double d = 0.0;
+            };
+
+            std::array<Term, ATTRIBUTE_COUNT> terms{};
+            double weight = 0.0;
+
+            void addGradient( const std::size_t attribute, const glm::dvec3& gradient, const double offset, const double area ) noexcept {
+                auto& term = terms[attribute];
+
+                term.gg[0] += area * gradient.x * gradient.x;
+                term.gg[1] += area * gradient.x * gradient.y;
+                term.gg[2] += area * gradient.x * gradient.z;
+                term.gg[3] += area * gradient.y * gradient.y;
+                term.gg[4] += area * gradient.y * gradient.z;
+                term.gg[5] += area * gradient.z * gradient.z;
+                for ( std::size_t axis = 0; axis < 3; ++axis ) {
+                    term.gd[axis] += area * gradient[static_cast<glm::length_t>(axis)] * offset;
+                    term.g[axis] += area * gradient[static_cast<glm::length_t>(axis)];
+                }
+                term.dd += area * offset * offset;
+                term.d += area * offset;
+            }
+
+            AttributeQuadric& operator+=( const AttributeQuadric& other ) noexcept {
+                for ( std::size_t attribute = 0; attribute < ATTRIBUTE_COUNT; ++attribute ) {
+                    auto& term = terms[attribute];
+                    const auto& source = other.terms[attribute];
+
+                    for ( std::size_t i = 0; i < 6; ++i ) {
+                        term.gg[i] += source.gg[i];
+                    }
+                    for ( std::size_t i = 0; i < 3; ++i ) {
+                        term.gd[i] += source.gd[i];
+                        term.g[i] += source.g[i];
+                    }
+                    term.dd += source.dd;
+                    term.d += source.d;
+                }
+                weight += other.weight;
+
+                return *this;
+            }
+
+            [[nodiscard]] double evaluate( const glm::dvec3& p, const Attributes& values ) const noexcept {
+                double error = 0.0;
+
+                for ( std::size_t attribute = 0; attribute < ATTRIBUTE_COUNT; ++attribute ) {
+                    const auto& term = terms[attribute];
+                    const auto s = values[attribute];
+
+                    error += term.gg[0] * p.x * p.x + term.gg[3] * p.y * p.y + term.gg[5] * p.z * p.z
+                             + 2.0 * ( term.gg[1] * p.x * p.y + term.gg[2] * p.x * p.z + term.gg[4] * p.y * p.z )
+                             + 2.0 * ( term.gd[0] * p.x + term.gd[1] * p.y + term.gd[2] * p.z )
+                             - 2.0 * s * ( term.g[0] * p.x + term.g[1] * p.y + term.g[2] * p.z )
+                             + term.dd - 2.0 * s * term.d + s * s * weight;
+                }
+
+                return error;
+            }
+        };
+
+        enum class VertexKind : std::uint8_t {
+            INTERIOR,
+            BORDER,
+            /// Touche une arête partagée par plus de deux triangles : jamais déplacée.
+            LOCKED
+        };
+
+        /**
+         * @brief Contraction de la position from sur la position to.
+         */
+        struct Collapse {
+            std::uint32_t from = 0;
+            std::uint32_t to = 0;
+            double cost = NO_COLLAPSE;
+        };
+
+        /**
+         * @brief Mémoire de travail d’une évaluation, réutilisée d’une arête à l’autre.
+         */
+        struct Scratch {
+            std::vector<std::uint32_t> neighbors{};
+            std::vector<std::uint32_t> otherNeighbors{};
+            /// Sommets de from et de to des triangles de l’arête.
+            std::vector<std::pair<std::uint32_t, std::uint32_t>> edgeWedges{};
+            /// Sommets de from et sommet qui les remplace, eux-mêmes s’ils sont seulement déplacés.
+            std::vector<std::pair<std::uint32_t, std::uint32_t>> targets{};
+        };
+
+        class Simplifier final {
+        public:
+            Simplifier( const Mesh& mesh, const SimplifyOptions& options )
+            : options_(options) {
+                const auto vertexCount = mesh.vertexCount();
+                const auto* const vertices = mesh.vertices();
+
+                const auto& bounds = mesh.bounds();
+                const auto extent = std::max( {bounds.max.x - bounds.min.x, bounds.max.y - bounds.min.y, bounds.max.z - bounds.min.z} );
+                scale_ = extent > 0.0f ? 1.0 / extent : 1.0;
+
+                mergePositions( mesh );
+
+                attributes_.resize( vertexCount );
+                for ( std::size_t i = 0; i < vertexCount; ++i ) {
+                    const auto& vertex = vertices[i];
+                    attributes_[i] = {vertex.normal.x * options.normalWeight, vertex.normal.y * options.normalWeight,
+                                      vertex.normal.z * options.normalWeight, vertex.texCoord.x * options.texCoordWeight,
+                                      vertex.texCoord.y * options.texCoordWeight};
+                }
+
+                const auto triangleCount = mesh.indexCount() / 3;
+                corners_.resize( triangleCount * 3 );
+                for ( std::size_t i = 0; i < corners_.size(); ++i ) {
+                    corners_[i] = mesh.index( i );
+                }
+
+                triangleSubMeshes_.assign( triangleCount, 0 );
+                const auto& subMeshes = mesh.subMeshes();
+                for ( std::size_t s = 0; s < subMeshes.size(); ++s ) {
+                    const auto first = std::min<std::size_t>( subMeshes[s].firstIndex / 3, triangleCount );
+                    const auto last = std::min<std::size_t>( first + subMeshes[s].indexCount / 3, triangleCount );
+                    std::fill( triangleSubMeshes_.begin() + first, triangleSubMeshes_.begin() + last, static_cast<std::uint32_t>(s) );
+                }
+
+                compact();
+                buildAdjacency();
+                computeQuadrics();
+            }
+
+            void run( const std::size_t targetTriangleCount ) {
+                std::vector<Collapse> collapses{};
+                std::vector<std::uint8_t> touched{};
+
+                while ( triangleCount() > targetTriangleCount ) {
+                    const auto edges = collectEdges();
+
+                    collapses.assign( edges.size(), Collapse{} );
+                    const auto taskCount = ( edges.size() + EDGES_PER_TASK - 1 ) / EDGES_PER_TASK;
+                    utility::parallelFor( taskCount, options_.threadCount, [&]( const std::size_t task ) {
+                        Scratch scratch{};
+
+                        const auto last = std::min( edges.size(), ( task + 1 ) * EDGES_PER_TASK );
+                        for ( auto i = task * EDGES_PER_TASK; i < last; ++i ) {
+                            collapses[i] = cheapestCollapse( edges[i].first, edges[i].second, scratch );
+                        }
+                    } );
+
+                    collapses.erase( std::remove_if( collapses.begin(), collapses.end(), []( const Collapse& collapse ) {
+                        return collapse.cost == NO_COLLAPSE;
+                    } ), collapses.end() );
+                    if ( collapses.empty() ) {
+                        break;
+                    }
+
+                    const auto cheaper = []( const Collapse& left, const Collapse& right ) noexcept {
+                        return std::tie( left.cost, left.from, left.to ) < std::tie( right.cost, right.from, right.to );
+                    };
+                    const auto examined = std::max<std::size_t>( 1, collapses.size() * PASS_FRACTION_PERCENT / 100 );
+                    std::nth_element( collapses.begin(), collapses.begin() + static_cast<std::ptrdiff_t>(examined - 1), collapses.end(), cheaper );
+                    collapses.resize( examined );
+                    std::sort( collapses.begin(), collapses.end(), cheaper );
+
+                    // Une contraction modifie les triangles de from : ses voisins ne bougent plus durant la passe,
+                    // les évaluations restantes restent donc exactes.
+                    touched.assign( points_.size(), 0 );
+                    auto remaining = triangleCount();
+                    std::size_t applied = 0;
+
+                    Scratch scratch{};
+                    for ( const auto& collapse : collapses ) {
+                        if ( remaining <= targetTriangleCount ) {
+                            break;
+                        }
+                        if ( touched[collapse.from] || touched[collapse.to] ) {
+                            continue;
+                        }
+
+                        neighbors( collapse.from, scratch.neighbors );
+                        for ( const auto neighbor : scratch.neighbors ) {
+                            touched[neighbor] = 1;
+                        }
+                        touched[collapse.from] = 1;
+
+                        remaining -= apply( collapse, scratch );
+                        ++applied;
+                    }
+
+                    compact();
+                    if ( applied == 0 ) {
+                        break;
+                    }
+                    buildAdjacency();
+                }
+            }
+
+            [[nodiscard]] Mesh result( const Mesh& source ) const {
+                const auto* const vertices = source.vertices();
+                const auto subMeshCount = source.subMeshes().size();
+
+                std::vector<std::uint32_t> remap(attributes_.size(), NO_VERTEX);
+                std::vector<Vertex> output{};
+                std::vector<std::uint32_t> indices{};
+                indices.reserve( corners_.size() );
+
+                std::vector<SubMesh> subMeshes = source.subMeshes();
+                for ( std::size_t s = 0; s < std::max<std::size_t>( subMeshCount, 1 ); ++s ) {
+                    const auto firstIndex = static_cast<std::uint32_t>(indices.size());
+
+                    for ( std::size_t triangle = 0; triangle < triangleCount(); ++triangle ) {
+                        if ( subMeshCount > 0 && triangleSubMeshes_[triangle] != s ) {
+                            continue;
+                        }
+
+                        for ( std::size_t k = 0; k < 3; ++k ) {
+                            const auto wedge = corners_[triangle * 3 + k];
+
+                            if ( remap[wedge] == NO_VERTEX ) {
+                                remap[wedge] = static_cast<std::uint32_t>(output.size());
+
+                                auto vertex = vertices[wedge];
+                                vertex.position = positions_[wedgePositions_[wedge]];
+                                output.push_back( vertex );
+                            }
+
+                            indices.push_back( remap[wedge] );
+                        }
+                    }
+
+                    if ( subMeshCount > 0 ) {
+                        subMeshes[s].firstIndex = firstIndex;
+                        subMeshes[s].indexCount = static_cast<std::uint32_t>(indices.size()) - firstIndex;
+                    }
+                }
+
+                Mesh mesh(std::move(output), std::move(indices), std::move(subMeshes));
+                mesh.setMaterialLibraries( source.materialLibraries() );
+
+                return mesh;
+            }
+
+            /**
+             * @brief Retourne le plus grand écart géométrique des contractions appliquées, dans l’unité des positions.
+             */
+            [[nodiscard]] float error() const noexcept {
+                return static_cast<float>(std::sqrt( maximumError_ ) / scale_);
+            }
+
+            [[nodiscard]] std::size_t triangleCount() const noexcept {
+                return corners_.size() / 3;
+            }
+
+        private:
+            SimplifyOptions options_;
+            double scale_ = 1.0;
+
+            /// Positions d’origine et positions ramenées dans une boite de côté 1.
+            std::vector<glm::vec3> positions_{};
+            std::vector<glm::dvec3> points_{};
+
+            /// Position de chaque sommet du maillage et ses attributs pondérés.
+            std::vector<std::uint32_t> wedgePositions_{};
+            std::vector<Attributes> attributes_{};
+
+            /// Sommet de chaque coin, trois par triangle, et plage de matériau de chaque triangle.
+            std::vector<std::uint32_t> corners_{};
+            std::vector<std::uint32_t> triangleSubMeshes_{};
+
+            /// Triangles autour de chaque position, rangés par position (CSR).
+            std::vector<std::uint32_t> firstTriangles_{};
+            std::vector<std::uint32_t> triangles_{};
+            std::vector<VertexKind> kinds_{};
+
+            std::vector<Quadric> quadrics_{};
+            std::vector<AttributeQuadric> attributeQuadrics_{};
+
+            double maximumError_ = 0.0;
+
+            [[nodiscard]] std::uint32_t position( const std::size_t triangle, const std::size_t k ) const noexcept {
+                return wedgePositions_[corners_[triangle * 3 + k]];
+            }
+
+            /**
+             * @brief Regroupe les sommets de même position : ils sont déplacés ensemble, une couture ne s’ouvre jamais.
+             */
+            void mergePositions( const Mesh& mesh ) {
+                const auto* const vertices = mesh.vertices();
+
+                const auto key = [vertices]( const std::uint32_t vertex ) noexcept {
+                    std::array<std::uint32_t, 3> bits{};
+                    std::memcpy( bits.data(), &vertices[vertex].position, sizeof( bits ) );
+
+                    return bits;
+                };
+
+                std::vector<std::uint32_t> order(mesh.vertexCount());
+                for ( std::size_t i = 0; i < order.size(); ++i ) {
+                    order[i] = static_cast<std::uint32_t>(i);
+                }
+                std::sort( order.begin(), order.end(), [&key]( const std::uint32_t left, const std::uint32_t right ) {
+                    return std::make_pair( key( left ), left ) < std::make_pair( key( right ), right );
+                } );
+
+                wedgePositions_.resize( order.size() );
+                for ( std::size_t i = 0; i < order.size(); ++i ) {
+                    if ( i == 0 || key( order[i] ) != key( order[i - 1] ) ) {
+                        const auto& position = vertices[order[i]].position;
+
+                        positions_.push_back( position );
+                        points_.push_back( glm::dvec3( position - mesh.bounds().min ) * scale_ );
+                    }
+
+                    wedgePositions_[order[i]] = static_cast<std::uint32_t>(positions_.size() - 1);
+                }
+            }
+
+            /**
+             * @brief Supprime les triangles dégénérés, ceux dont deux coins sont à la même position.
+             */
+            void compact() noexcept {
+                std::size_t kept = 0;
+
+                for ( std::size_t triangle = 0; triangle < triangleCount(); ++triangle ) {
+                    const auto a = position( triangle, 0 );
+                    const auto b = position( triangle, 1 );
+                    const auto c = position( triangle, 2 );
+
+                    if ( a == b || b == c || c == a ) {
+                        continue;
+                    }
+
+                    std::copy_n( corners_.begin() + static_cast<std::ptrdiff_t>(triangle * 3), 3,
+                                 corners_.begin() + static_cast<std::ptrdiff_t>(kept * 3) );
+                    triangleSubMeshes_[kept] = triangleSubMeshes_[triangle];
+                    ++kept;
+                }
+
+                corners_.resize( kept * 3 );
+                triangleSubMeshes_.resize( kept );
+            }
+
+            void buildAdjacency() {
+                firstTriangles_.assign( points_.size() + 1, 0 );
+                for ( std::size_t corner = 0; corner < corners_.size(); ++corner ) {
+                    ++firstTriangles_[wedgePositions_[corners_[corner]] + 1];
+                }
+                for ( std::size_t i = 1; i < firstTriangles_.size(); ++i ) {
+                    firstTriangles_[i] += firstTriangles_[i - 1];
+                }
+
+                triangles_.resize( corners_.size() );
+                auto cursors = firstTriangles_;
+                for ( std::size_t corner = 0; corner < corners_.size(); ++corner ) {
+                    triangles_[cursors[wedgePositions_[corners_[corner]]]++] = static_cast<std::uint32_t>(corner / 3);
+                }
+
+                // Nature de chaque position d’après le nombre de triangles partageant chacune de ses arêtes.
+                kinds_.assign( points_.size(), VertexKind::INTERIOR );
+                std::vector<std::uint32_t> around{};
+                for ( std::uint32_t p = 0; p < points_.size(); ++p ) {
+                    around.clear();
+                    for ( auto t = firstTriangles_[p]; t < firstTriangles_[p + 1]; ++t ) {
+                        for ( std::size_t k = 0; k < 3; ++k ) {
+                            const auto other = position( triangles_[t], k );
+                            if ( other != p ) {
+                                around.push_back( other );
+                            }
+                        }
+                    }
+                    std::sort( around.begin(), around.end() );
+
+                    for ( std::size_t i = 0; i < around.size(); ) {
+                        auto j = i;
+                        while ( j < around.size() && around[j] == around[i] ) {
+                            ++j;
+                        }
+
+                        if ( j - i > 2 ) {
+                            kinds_[p] = VertexKind::LOCKED;
+                            break;
+                        }
+                        if ( j - i == 1 ) {
+                            kinds_[p] = VertexKind::BORDER;
+                        }
+
+                        i = j;
+                    }
+                }
+            }
+
+            [[nodiscard]] bool isBorderEdge( const std::uint32_t from, const std::uint32_t to ) const noexcept {
+                std::size_t count = 0;
+
+                for ( auto t = firstTriangles_[from]; t < firstTriangles_[from + 1]; ++t ) {
+                    for ( std::size_t k = 0; k < 3; ++k ) {
+                        count += position( triangles_[t], k ) == to ? 1 : 0;
+                    }
+                }
+
+                return count == 1;
+            }
+
+            void computeQuadrics() {
+                quadrics_.assign( points_.size(), Quadric{} );
+                attributeQuadrics_.assign( attributes_.size(), AttributeQuadric{} );
+
+                for ( std::size_t triangle = 0; triangle < triangleCount(); ++triangle ) {
+                    const std::uint32_t wedges[3] = {corners_[triangle * 3], corners_[triangle * 3 + 1], corners_[triangle * 3 + 2]};
+                    const std::uint32_t p[3] = {wedgePositions_[wedges[0]], wedgePositions_[wedges[1]], wedgePositions_[wedges[2]]};
+
+                    const auto e1 = points_[p[1]] - points_[p[0]];
+                    const auto e2 = points_[p[2]] - points_[p[0]];
+                    const auto normal = glm::cross( e1, e2 );
+                    const auto length2 = glm::dot( normal, normal );
+                    if ( length2 <= 0.0 ) {
+                        continue;
+                    }
+
+                    const auto length = std::sqrt( length2 );
+                    const auto area = length * 0.5;
+                    const auto unit = normal / length;
+                    const auto distance = -glm::dot( unit, points_[p[0]] );
+
+                    for ( const auto corner : p ) {
+                        quadrics_[corner].addPlane( unit, distance, area );
+                    }
+
+                    for ( std::size_t k = 0; k < 3; ++k ) {
+                        const auto from = p[k];
+                        const auto to = p[( k + 1 ) % 3];
+                        if ( !isBorderEdge( from, to ) ) {
+                            continue;
+                        }
+
+                        const auto edge = points_[to] - points_[from];
+                        const auto side = glm::cross( edge, unit );
+                        const auto sideLength = glm::length( side );
+                        if ( sideLength <= 0.0 ) {
+                            continue;
+                        }
+
+                        const auto sideUnit = side / sideLength;
+                        const auto edgeWeight = BORDER_WEIGHT * glm::dot( edge, edge );
+                        quadrics_[from].addPlane( sideUnit, -glm::dot( sideUnit, points_[from] ), edgeWeight );
+                        quadrics_[to].addPlane( sideUnit, -glm::dot( sideUnit, points_[from] ), edgeWeight );
+                    }
+
+                    // Gradient g et décalage d tels que g.p + d interpole l’attribut sur le triangle, g orthogonal à la normale.
+                    const auto across1 = glm::cross( e2, normal ) / length2;
+                    const auto across2 = glm::cross( normal, e1 ) / length2;
+
+                    AttributeQuadric quadric{};
+                    for ( std::size_t attribute = 0; attribute < ATTRIBUTE_COUNT; ++attribute ) {
+                        const auto s0 = attributes_[wedges[0]][attribute];
+                        const auto gradient = across1 * ( attributes_[wedges[1]][attribute] - s0 )
+                                              + across2 * ( attributes_[wedges[2]][attribute] - s0 );
+
+                        quadric.addGradient( attribute, gradient, s0 - glm::dot( gradient, points_[p[0]] ), area );
+                    }
+                    quadric.weight = area;
+
+                    for ( const auto wedge : wedges ) {
+                        attributeQuadrics_[wedge] += quadric;
+                    }
+                }
+            }
+
+            /**
+             * @brief Retourne les arêtes du maillage, chacune une seule fois.
+             */
+            [[nodiscard]] std::vector<std::pair<std::uint32_t, std::uint32_t>> collectEdges() const {
+                std::vector<std::pair<std::uint32_t, std::uint32_t>> edges{};
+                edges.reserve( corners_.size() );
+
+                for ( std::size_t triangle = 0; triangle < triangleCount(); ++triangle ) {
+                    for ( std::size_t k = 0; k < 3; ++k ) {
+                        const auto a = position( triangle, k );
+                        const auto b = position( triangle, ( k + 1 ) % 3 );
+
+                        edges.emplace_back( std::min( a, b ), std::max( a, b ) );
+                    }
+                }
+
+                std::sort( edges.begin(), edges.end() );
+                edges.erase( std::unique( edges.begin(), edges.end() ), edges.end() );
+
+                return edges;
+            }
+
+            void neighbors( const std::uint32_t p, std::vector<std::uint32_t>& output ) const {
+                output.clear();
+
+                for ( auto t = firstTriangles_[p]; t < firstTriangles_[p + 1]; ++t ) {
+                    for ( std::size_t k = 0; k < 3; ++k ) {
+                        const auto other = position( triangles_[t], k );
+                        if ( other != p ) {
+                            output.push_back( other );
+                        }
+                    }
+                }
+
+                std::sort( output.begin(), output.end() );
+                output.erase( std::unique( output.begin(), output.end() ), output.end() );
+            }
+
+            [[nodiscard]] Collapse cheapestCollapse( const std::uint32_t a, const std::uint32_t b, Scratch& scratch ) const {
+                const Collapse forward{a, b, evaluate( a, b, scratch )};
+                const Collapse backward{b, a, evaluate( b, a, scratch )};
+
+                return backward.cost < forward.cost ? backward : forward;
+            }
+
+            /**
+             * @brief Calcule le coût de la contraction de from sur to, NO_COLLAPSE si elle est interdite.
+             *
+             * Remplit scratch.targets avec le devenir de chaque sommet de from.
+             */
+            [[nodiscard]] double evaluate( const std::uint32_t from, const std::uint32_t to, Scratch& scratch ) const {
+                if ( kinds_[from] == VertexKind::LOCKED ) {
+                    return NO_COLLAPSE;
+                }
+                if ( options_.lockBorders && ( kinds_[from] == VertexKind::BORDER || kinds_[to] == VertexKind::BORDER ) ) {
+                    return NO_COLLAPSE;
+                }
+
+                scratch.edgeWedges.clear();
+                scratch.targets.clear();
+
+                std::size_t sharedCount = 0;
+                for ( auto t = firstTriangles_[from]; t < firstTriangles_[from + 1]; ++t ) {
+                    const auto triangle = triangles_[t];
+
+                    std::size_t fromCorner = 3;
+                    std::size_t toCorner = 3;
+                    for ( std::size_t k = 0; k < 3; ++k ) {
+                        const auto p = position( triangle, k );
+                        fromCorner = p == from ? k : fromCorner;
+                        toCorner = p == to ? k : toCorner;
+                    }
+
+                    const auto fromWedge = corners_[triangle * 3 + fromCorner];
+                    scratch.targets.emplace_back( fromWedge, fromWedge );
+
+                    if ( toCorner != 3 ) {
+                        ++sharedCount;
+                        scratch.edgeWedges.emplace_back( fromWedge, corners_[triangle * 3 + toCorner] );
+                        continue;
+                    }
+
+                    // Le triangle subsiste : il ne doit pas se retourner.
+                    const auto& p0 = points_[position( triangle, 0 )];
+                    const auto& p1 = points_[position( triangle, 1 )];
+                    const auto& p2 = points_[position( triangle, 2 )];
+                    const auto before = glm::cross( p1 - p0, p2 - p0 );
+
+                    glm::dvec3 moved[3] = {p0, p1, p2};
+                    moved[fromCorner] = points_[to];
+                    const auto after = glm::cross( moved[1] - moved[0], moved[2] - moved[0] );
+
+                    const auto beforeLength2 = glm::dot( before, before );
+                    const auto afterLength2 = glm::dot( after, after );
+                    if ( afterLength2 <= 0.0 ) {
+                        return NO_COLLAPSE;
+                    }
+                    if ( beforeLength2 > 0.0 && glm::dot( before, after ) <= MINIMUM_FLIP_COSINE * std::sqrt( beforeLength2 * afterLength2 ) ) {
+                        return NO_COLLAPSE;
+                    }
+                }
+
+                if ( sharedCount == 0 || sharedCount > 2 ) {
+                    return NO_COLLAPSE;
+                }
+
+                // Un bord ne glisse que le long de lui-même, sinon le maillage se pincerait.
+                if ( kinds_[from] == VertexKind::BORDER && sharedCount != 1 ) {
+                    return NO_COLLAPSE;
+                }
+
+                // Condition de lien : les seuls voisins communs sont les sommets opposés à l’arête.
+                neighbors( from, scratch.neighbors );
+                neighbors( to, scratch.otherNeighbors );
+                std::size_t commonCount = 0;
+                for ( std::size_t i = 0, j = 0; i < scratch.neighbors.size() && j < scratch.otherNeighbors.size(); ) {
+                    if ( scratch.neighbors[i] < scratch.otherNeighbors[j] ) {
+                        ++i;
+                    }
+                    else if ( scratch.otherNeighbors[j] < scratch.neighbors[i] ) {
+                        ++j;
+                    }
+                    else {
+                        ++commonCount, ++i, ++j;
+                    }
+                }
+                if ( commonCount != sharedCount ) {
+                    return NO_COLLAPSE;
+                }
+
+                // Un sommet de from rejoint le sommet de to qu’il côtoie sur l’arête, s’il est unique :
+                // les attributs restent continus et une couture reste fermée. Sinon il est seulement déplacé.
+                std::sort( scratch.targets.begin(), scratch.targets.end() );
+                scratch.targets.erase( std::unique( scratch.targets.begin(), scratch.targets.end() ), scratch.targets.end() );
+
+                for ( auto& [wedge, target] : scratch.targets ) {
+                    auto candidate = NO_VERTEX;
+
+                    for ( const auto& [fromWedge, toWedge] : scratch.edgeWedges ) {
+                        if ( fromWedge != wedge ) {
+                            continue;
+                        }
+
+                        if ( candidate == NO_VERTEX || candidate == toWedge ) {
+                            candidate = toWedge;
+                        }
+                        else {
+                            candidate = wedge;
+                        }
+                    }
+
+                    target = candidate == NO_VERTEX ? wedge : candidate;
+                }
+
+                const auto& point = points_[to];
+                auto cost = quadrics_[from].evaluate( point ) + quadrics_[to].evaluate( point );
+                for ( const auto& [wedge, target] : scratch.targets ) {
+                    cost += attributeQuadrics_[wedge].evaluate( point, attributes_[target] );
+                }
+
+                return std::max( cost, 0.0 );
+            }
+
+            /**
+             * @brief Applique la contraction et retourne le nombre de triangles supprimés.
+             */
+            std::size_t apply( const Collapse& collapse, Scratch& scratch ) {
+                // Réévaluée pour remplir scratch.targets, le voisinage n’a pas changé depuis l’évaluation.
+                static_cast<void>(evaluate( collapse.from, collapse.to, scratch ));
+
+                // L’erreur retenue est l’écart géométrique seul : c’est lui qui se voit à l’écran.
+                const auto& point = points_[collapse.to];
+                const auto distance = quadrics_[collapse.from].evaluate( point ) + quadrics_[collapse.to].evaluate( point );
+
+                std::size_t removed = 0;
+                for ( auto t = firstTriangles_[collapse.from]; t < firstTriangles_[collapse.from + 1]; ++t ) {
+                    const auto triangle = triangles_[t];
+
+                    bool degenerate = false;
+                    for ( std::size_t k = 0; k < 3; ++k ) {
+                        degenerate = degenerate || position( triangle, k ) == collapse.to;
+                    }
+                    removed += degenerate ? 1 : 0;
+
+                    for ( std::size_t k = 0; k < 3; ++k ) {
+                        auto& corner = corners_[triangle * 3 + k];
+                        if ( wedgePositions_[corner] != collapse.from ) {
+                            continue;
+                        }
+
+                        const auto target = std::lower_bound( scratch.targets.begin(), scratch.targets.end(), std::make_pair( corner, std::uint32_t{0} ) );
+                        corner = target->second;
+                    }
+                }
+
+                for ( const auto& [wedge, target] : scratch.targets ) {
+                    if ( wedge == target ) {
+                        wedgePositions_[wedge] = collapse.to;
+                    }
+                    else {
+                        attributeQuadrics_[target] += attributeQuadrics_[wedge];
+                    }
+                }
+
+                const auto weight = quadrics_[collapse.from].weight + quadrics_[collapse.to].weight;
+                quadrics_[collapse.to] += quadrics_[collapse.from];
+
+                if ( weight > 0.0 ) {
+                    maximumError_ = std::max( maximumError_, distance / weight );
+                }
+
+                return removed;
+            }
+        };
+    }
+
+    Mesh MeshSimplifier::simplify( const Mesh& mesh, const std::size_t targetIndexCount, const SimplifyOptions& options, float& error ) {
+        Simplifier simplifier(mesh, options);
+        simplifier.run( targetIndexCount / 3 );
+
+        error = simplifier.error();
+
+        return simplifier.result( mesh );
+    }
+
+    Mesh MeshSimplifier::simplify( const Mesh& mesh, const std::size_t targetIndexCount ) {
+        float error = 0.0f;
+
+        return simplify( mesh, targetIndexCount, SimplifyOptions{}, error );
+    }
+
+    std::vector<LodLevel> MeshSimplifier::buildLodChain( const Mesh& mesh, const LodOptions& options ) {
+        std::vector<LodLevel> levels{};
+        levels.reserve( options.levelCount );
+
+        for ( std::size_t level = 0; level < options.levelCount; ++level ) {
+            const auto& previous = levels.empty() ? mesh : levels.back().mesh;
+            const auto previousError = levels.empty() ? 0.0f : levels.back().error;
+
+            const auto target = static_cast<std::size_t>(static_cast<double>(previous.indexCount() / 3) * options.reduction) * 3;
+            if ( target == 0 ) {
+                break;
+            }
+
+            float error = 0.0f;
+            auto simplified = simplify( previous, target, options.simplify, error );
+            if ( static_cast<double>(simplified.indexCount()) > static_cast<double>(previous.indexCount()) * MINIMUM_LOD_REDUCTION ) {
+                break;
+            }
+
+            // Chaque niveau est simplifié depuis le précédent : les écarts s’additionnent au pire.
+            levels.push_back( {MeshOptimizer::optimize( simplified ), previousError + error} );
+        }
+
+        return levels;
+    }
+}
@@ -0,0 +1,145 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <optional>
+
+#include <glengine/mesh_buffer.hpp>
+#include <glengine/mesh_pool.hpp>
+#include <glengine/model.hpp>
+#include <glengine/vertex_format.hpp>
+
+namespace gl_engine {
+    struct Model::Shared {
+        /// Buffers propres au modèle, absents si le maillage est rangé dans un gl_engine::MeshPool.
+        std::optional<MeshBuffer> buffer{};
+        Id vertexArray = 0;
+        GLenum indexType = GL_UNSIGNED_INT;
+        std::size_t indexSize = sizeof( GLuint );
+        /// Place du maillage dans le pool, nulle pour des buffers propres.
+        std::int32_t baseVertex = 0;
+        std::uint32_t firstIndex = 0;
+
+        std::vector<SubMesh> subMeshes{};
+        std::vector<Material> materials{};
+        /// Boite englobante et son centre, dans le repère de l’objet.
+        Bounds bounds{};
+        glm::vec3 center{};
+
+        /// Décodage des positions, l’identité si elles ne sont pas quantifiées.
+        glm::vec3 positionOffset{0.0f};
+        glm::vec3 positionScale{1.0f};
+    };
+
+    namespace {
+        RenderPass passOf( const Material* const material ) noexcept {
+            if ( material == nullptr ) {
+                return RenderPass::SOLID;
+            }
+            if ( material->parameters.opacity < 1.0f ) {
+                return RenderPass::BLENDED;
+            }
+
+            return material->texture( TextureSlot::OPACITY ) != nullptr ? RenderPass::CUTOUT : RenderPass::SOLID;
+        }
+    }
+
+    Model::Model( const ComplexObject& object, const Id program )
+    : Model( object, VertexFormat{}, program ) {}
+
+    Model::Model( const ComplexObject& object, const VertexFormat& format, const Id program )
+    : program_(program) {
+        const auto& mesh = object.mesh();
+
+        auto shared = std::make_shared<Shared>();
+        shared->buffer.emplace( mesh, format );
+        shared->vertexArray = shared->buffer->vertexArray();
+        shared->indexType = shared->buffer->indexType();
+        shared->indexSize = static_cast<std::size_t>(shared->buffer->indexSize());
+        shared->subMeshes = mesh.subMeshes();
+        shared->materials = object.materials();
+        shared->bounds = mesh.bounds();
+        shared->center = ( mesh.bounds().min + mesh.bounds().max ) * 0.5f;
+
+        if ( format.quantizePositions ) {
+            shared->positionOffset = VertexFormat::positionOffset( mesh.bounds() );
+            shared->positionScale = VertexFormat::positionScale( mesh.bounds() );
+        }
+
+        shared_ = std::move( shared );
+    }
+
+    Model::Model( const ComplexObject& object, MeshPool& pool, const Id program )
+    : program_(program) {
+        const auto& mesh = object.mesh();
+        const auto range = pool.add( mesh );
+
+        auto shared = std::make_shared<Shared>();
+        shared->vertexArray = pool.vertexArray();
+        shared->baseVertex = range.baseVertex;
+        shared->firstIndex = range.firstIndex;
+        shared->subMeshes = mesh.subMeshes();
+        shared->materials = object.materials();
+        shared->bounds = mesh.bounds();
+        shared->center = ( mesh.bounds().min + mesh.bounds().max ) * 0.5f;
+
+        shared_ = std::move( shared );
+    }
+
+    void Model::submit( RenderQueue& queue, const RenderView& view ) const {
+        const auto& shared = *shared_;
+
+        DrawItem item{};
+        item.program = program_;
+        item.vertexArray = shared.vertexArray;
+        item.indexType = shared.indexType;
+        item.baseVertex = shared.baseVertex;
+        item.model = transform_;
+        item.color = color_;
+        item.depth = glm::length( glm::vec3(transform_ * glm::vec4( shared.center, 1.0f )) - view.eye );
+        item.positionOffset = shared.positionOffset;
+        item.positionScale = shared.positionScale;
+
+        for ( std::size_t i = 0; i < shared.subMeshes.size(); ++i ) {
+            const auto& subMesh = shared.subMeshes[i];
+            if ( subMesh.indexCount == 0 ) {
+                continue;
+            }
+
+            item.material = i < shared.materials.size() ? &shared.materials[i] : nullptr;
+            item.pass = passOf( item.material );
+            item.indexOffset = ( std::size_t{shared.firstIndex} + subMesh.firstIndex ) * shared.indexSize;
+            item.indexCount = subMesh.indexCount;
+
+            queue.submit( item );
+        }
+    }
+
+    std::optional<BoundingVolume> Model::bounds() const noexcept {
+        return BoundingVolume::transform( shared_->bounds, transform_ );
+    }
+
+    std::optional<Occluder> Model::occluder() const noexcept {
+        if ( occluder_ == nullptr ) {
+            return std::nullopt;
+        }
+
+        return Occluder{occluder_, transform_};
+    }
+}
@@ -0,0 +1,243 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <charconv>
+#include <string>
+#include <system_error>
+
+#include <glengine/mtl_parser.hpp>
+
+namespace gl_engine {
+    namespace {
+        constexpr bool isBlank( const char letter ) noexcept {
+            return letter == ' ' || letter == '\t' || letter == '\r';
+        }
+
+        std::string_view trim( std::string_view text ) noexcept {
+            while ( !text.empty() && isBlank( text.front() ) ) {
+                text.remove_prefix( 1 );
+            }
+            while ( !text.empty() && isBlank( text.back() ) ) {
+                text.remove_suffix( 1 );
+            }
+
+            return text;
+        }
+
+        /**
+         * @brief Retire et retourne le premier mot de text.
+         */
+        std::string_view nextWord( std::string_view& text ) noexcept {
+            text = trim( text );
+
+            const auto end = std::min( text.size(), static_cast<std::size_t>(std::find_if( text.cbegin(), text.cend(), isBlank ) - text.cbegin()) );
+            const auto word = text.substr( 0, end );
+            text.remove_prefix( end );
+
+            return word;
+        }
+
+        bool isNumber( const std::string_view word ) noexcept {
+            float value = 0.0f;
+            const auto* const begin = word.data() + ( !word.empty() && word.front() == '+' ? 1 : 0 );
+            const auto [last, error] = std::from_chars( begin, word.data() + word.size(), value );
+
+            return error == std::errc{} && last == word.data() + word.size();
+        }
+
+        /**
+         * @brief Index d’une texture pour un mot-clé, TEXTURE_SLOT_COUNT si le mot-clé n’est pas une texture.
+         */
+        std::size_t textureSlot( const std::string_view keyword ) noexcept {
+            if ( keyword == "map_Ka" ) {
+                return static_cast<std::size_t>(TextureSlot::AMBIENT);
+            }
+            if ( keyword == "map_Kd" ) {
+                return static_cast<std::size_t>(TextureSlot::DIFFUSE);
+            }
+            if ( keyword == "map_Ks" ) {
+                return static_cast<std::size_t>(TextureSlot::SPECULAR);
+            }
+            if ( keyword == "map_Bump" || keyword == "map_bump" || keyword == "bump" || keyword == "norm" ) {
+                return static_cast<std::size_t>(TextureSlot::NORMAL);
+            }
+            if ( keyword == "map_d" ) {
+                return static_cast<std::size_t>(TextureSlot::OPACITY);
+            }
+
+            return TEXTURE_SLOT_COUNT;
+        }
+
+        class Parser final {
+        public:
+            explicit Parser( std::vector<MaterialData>& materials ) noexcept
+            : materials_(materials) {}
+
+            void parseLine( std::string_view line ) {
+                ++line_;
+
+                const auto keyword = nextWord( line );
+                if ( keyword.empty() || keyword.front() == '#' ) {
+                    return;
+                }
+
+                if ( keyword == "newmtl" ) {
+                    const auto name = trim( line );
+                    if ( name.empty() ) {
+                        fail( "Nom de matériau attendu." );
+                    }
+
+                    materials_.push_back( {std::string{name}, {}, {}} );
+                    return;
+                }
+
+                const auto slot = textureSlot( keyword );
+                const auto isProperty = slot != TEXTURE_SLOT_COUNT || keyword == "Ka" || keyword == "Kd" || keyword == "Ks"
+                                        || keyword == "Ke" || keyword == "Ns" || keyword == "d" || keyword == "Tr" || keyword == "illum";
+                if ( !isProperty ) {
+                    return;
+                }
+
+                if ( materials_.empty() ) {
+                    fail( "Propriété de matériau avant 'newmtl'." );
+                }
+
+                auto& material = materials_.back();
+                auto& parameters = material.parameters;
+
+                if ( slot != TEXTURE_SLOT_COUNT ) {
+                    material.textures[slot] = parseTexturePath( line );
+                }
+                else if ( keyword == "Ka" ) {
+                    parseColor( line, parameters.ambient );
+                }
+                else if ( keyword == "Kd" ) {
+                    parseColor( line, parameters.diffuse );
+                }
+                else if ( keyword == "Ks" ) {
+                    parseColor( line, parameters.specular );
+                }
+                else if ( keyword == "Ke" ) {
+                    parseColor( line, parameters.emissive );
+                }
+                else if ( keyword == "Ns" ) {
+                    parameters.shininess = parseFloat( nextWord( line ) );
+                }
+                else if ( keyword == "d" ) {
+                    // Note développeur : L’option '-halo' n’a pas d’équivalent, seul le nombre est lu.
+                    auto word = nextWord( line );
+                    if ( word == "-halo" ) {
+                        word = nextWord( line );
+                    }
+                    parameters.opacity = parseFloat( word );
+                }
+                else if ( keyword == "Tr" ) {
+                    parameters.opacity = 1.0f - parseFloat( nextWord( line ) );
+                }
+                else {
+                    const auto word = nextWord( line );
+                    const auto [last, error] = std::from_chars( word.data(), word.data() + word.size(), parameters.illumination );
+                    if ( error != std::errc{} || last != word.data() + word.size() ) {
+                        fail( "Modèle d’éclairage invalide." );
+                    }
+                }
+            }
+
+        private:
+            std::vector<MaterialData>& materials_;
+            std::size_t line_ = 0;
+
+            [[noreturn]] void fail( const std::string& reason ) const {
+                throw MtlParseError(line_, reason);
+            }
+
+            float parseFloat( const std::string_view word ) const {
+                float value = 0.0f;
+                const auto* const begin = word.data() + ( !word.empty() && word.front() == '+' ? 1 : 0 );
+                const auto [last, error] = std::from_chars( begin, word.data() + word.size(), value );
+
+                if ( word.empty() || error != std::errc{} || last != word.data() + word.size() ) {
+                    fail( "Nombre flottant attendu." );
+                }
+
+                return value;
+            }
+
+            void parseColor( std::string_view line, glm::vec3& color ) const {
+                const auto first = nextWord( line );
+                if ( first == "spectral" || first == "xyz" ) {
+                    return;
+                }
+
+                // 'Ka r' équivaut à 'Ka r r r'.
+                color = glm::vec3{parseFloat( first )};
+
+                const auto green = nextWord( line );
+                if ( !green.empty() ) {
+                    color.g = parseFloat( green );
+                    color.b = parseFloat( nextWord( line ) );
+                }
+            }
+
+            std::string parseTexturePath( std::string_view line ) const {
+                // Les options commencent par '-' et sont suivies de nombres ou de 'on'/'off',
+                // sauf '-imfchan' et '-type' suivies d’un mot.
+                auto rest = trim( line );
+                while ( !rest.empty() && rest.front() == '-' ) {
+                    const auto option = nextWord( rest );
+                    if ( option == "-imfchan" || option == "-type" ) {
+                        nextWord( rest );
+                    }
+
+                    auto lookahead = rest;
+                    for ( auto word = nextWord( lookahead ); isNumber( word ) || word == "on" || word == "off"; word = nextWord( lookahead ) ) {
+                        rest = lookahead;
+                    }
+
+                    rest = trim( rest );
+                }
+
+                if ( rest.empty() ) {
+                    fail( "Chemin de texture attendu." );
+                }
+
+                std::string path{rest};
+                std::replace( path.begin(), path.end(), '\\', '/' );
+
+                return path;
+            }
+        };
+    }
+
+    std::vector<MaterialData> MtlParser::parse( const std::string_view source ) {
+        std::vector<MaterialData> materials{};
+        Parser parser(materials);
+
+        std::size_t begin = 0;
+        while ( begin < source.size() ) {
+            const auto end = std::min( source.find( '\n', begin ), source.size() );
+
+            parser.parseLine( source.substr( begin, end - begin ) );
+
+            begin = end + 1;
+        }
+
+        return materials;
+    }
+}
@@ -0,0 +1,283 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <glengine/normal_generator.hpp>
+#include <glengine/parallel.hpp>
+#include <glengine/simd.hpp>
+
+namespace gl_engine {
+    namespace {
+        /// Triangles traités par tâche, multiple de 4 pour ne pas couper un paquet SIMD.
+        constexpr std::size_t TRIANGLES_PER_TASK = 16384;
+
+        /// Positions traitées par tâche lors de l’accumulation.
+        constexpr std::size_t POSITIONS_PER_TASK = 8192;
+
+        /// Groupe des faces lissées ensemble : faces précédant le premier 's' ou groupes ignorés.
+        constexpr std::uint32_t IMPLICIT_GROUP = NO_INDEX;
+
+        /// Groupe des faces plates.
+        constexpr std::uint32_t FLAT_GROUP = 0;
+
+        std::vector<std::uint32_t> expandGroups( const ObjData& data, const bool useSmoothingGroups ) {
+            if ( !useSmoothingGroups || data.smoothingRanges.empty() ) {
+                return {};
+            }
+
+            std::vector<std::uint32_t> groups(data.triangleCount(), IMPLICIT_GROUP);
+
+            const auto& ranges = data.smoothingRanges;
+            for ( std::size_t i = 0; i < ranges.size(); ++i ) {
+                const auto last = i + 1 < ranges.size() ? ranges[i + 1].firstTriangle : groups.size();
+                std::fill( groups.begin() + ranges[i].firstTriangle, groups.begin() + last, ranges[i].group );
+            }
+
+            return groups;
+        }
+
+        /**
+         * Calcule la contribution de chaque coin des triangles [first, first + count[, count <= 4,
+         * à la normale de son sommet : la normale de la face, pondérée par son aire ou par l’angle du coin.
+         */
+        void computeContributions( const ObjData& data, const NormalWeighting weighting, const std::size_t first,
+                                   const std::size_t count, glm::vec3* const contributions ) noexcept {
+            // [coin][axe][voie], un triangle par voie. Les voies inutilisées répètent le dernier triangle.
+            alignas( 16 ) float gathered[3][3][4];
+            for ( std::size_t lane = 0; lane < 4; ++lane ) {
+                const auto triangle = first + std::min( lane, count - 1 );
+
+                for ( std::size_t corner = 0; corner < 3; ++corner ) {
+                    const auto& position = data.positions[data.corners[triangle * 3 + corner].position];
+
+                    for ( std::size_t axis = 0; axis < 3; ++axis ) {
+                        gathered[corner][axis][lane] = position[static_cast<glm::length_t>(axis)];
+                    }
+                }
+            }
+
+            const auto load = [&gathered]( const std::size_t corner ) noexcept {
+                return simd::Vec3x4{simd::Float4::load( gathered[corner][0] ), simd::Float4::load( gathered[corner][1] ),
+                                    simd::Float4::load( gathered[corner][2] )};
+            };
+
+            const auto p0 = load( 0 );
+            const auto p1 = load( 1 );
+            const auto p2 = load( 2 );
+
+            const auto e01 = p1 - p0;
+            const auto e02 = p2 - p0;
+            const auto e12 = p2 - p1;
+
+            // La norme du produit vectoriel vaut deux fois l’aire du triangle.
+            const auto normal = simd::cross( e01, e02 );
+
+            alignas( 16 ) float nx[4];
+            alignas( 16 ) float ny[4];
+            alignas( 16 ) float nz[4];
+            normal.x.store( nx );
+            normal.y.store( ny );
+            normal.z.store( nz );
+
+            if ( weighting == NormalWeighting::AREA ) {
+                for ( std::size_t lane = 0; lane < count; ++lane ) {
+                    const glm::vec3 weighted{nx[lane], ny[lane], nz[lane]};
+
+                    for ( std::size_t corner = 0; corner < 3; ++corner ) {
+                        contributions[( first + lane ) * 3 + corner] = weighted;
+                    }
+                }
+
+                return;
+            }
+
+            // Les trois angles partagent le même sinus (à la norme près), seul le produit scalaire change :
+            // angle = atan2( |e1 x e2|, e1 . e2 ), plus précis que acos pour les angles très petits.
+            alignas( 16 ) float length[4];
+            alignas( 16 ) float cosines[3][4];
+            simd::sqrt( simd::dot( normal, normal ) ).store( length );
+            simd::dot( e01, e02 ).store( cosines[0] );
+            ( simd::Float4::broadcast( 0.0f ) - simd::dot( e01, e12 ) ).store( cosines[1] );
+            simd::dot( e02, e12 ).store( cosines[2] );
+
+            for ( std::size_t lane = 0; lane < count; ++lane ) {
+                const auto triangle = first + lane;
+
+                if ( !( length[lane] > 0.0f ) ) {
+                    // Triangle dégénéré : aucune direction, aucune contribution.
+                    for ( std::size_t corner = 0; corner < 3; ++corner ) {
+                        contributions[triangle * 3 + corner] = glm::vec3{0.0f};
+                    }
+
+                    continue;
+                }
+
+                const glm::vec3 unit = glm::vec3{nx[lane], ny[lane], nz[lane]} / length[lane];
+                for ( std::size_t corner = 0; corner < 3; ++corner ) {
+                    contributions[triangle * 3 + corner] = unit * std::atan2( length[lane], cosines[corner][lane] );
+                }
+            }
+        }
+
+        glm::vec3 normalizeOrZero( const glm::vec3& vector ) noexcept {
+            const auto length = glm::length( vector );
+            return length > 0.0f ? vector / length : glm::vec3{0.0f};
+        }
+
+        std::size_t taskCount( const std::size_t size, const std::size_t perTask ) noexcept {
+            return ( size + perTask - 1 ) / perTask;
+        }
+    }
+
+    bool NormalGenerator::needsNormals( const ObjData& data ) noexcept {
+        return std::any_of( data.corners.cbegin(), data.corners.cend(), []( const Corner& corner ) {
+            return corner.normal == NO_INDEX;
+        } );
+    }
+
+    void NormalGenerator::generate( ObjData& data ) {
+        generate( data, NormalOptions{} );
+    }
+
+    void NormalGenerator::generate( ObjData& data, const NormalOptions& options ) {
+        const auto triangleCount = data.triangleCount();
+        const auto cornerCount = triangleCount * 3;
+        const auto positionCount = data.positions.size();
+
+        if ( triangleCount == 0 || !needsNormals( data ) ) {
+            return;
+        }
+
+        // 1. Contributions des faces, quatre triangles par paquet SIMD.
+        std::vector<glm::vec3> contributions(cornerCount);
+
+        utility::parallelFor( taskCount( triangleCount, TRIANGLES_PER_TASK ), options.threadCount, [&]( const std::size_t task ) {
+            const auto first = task * TRIANGLES_PER_TASK;
+            const auto last = std::min( first + TRIANGLES_PER_TASK, triangleCount );
+
+            for ( auto triangle = first; triangle < last; triangle += 4 ) {
+                computeContributions( data, options.weighting, triangle, std::min<std::size_t>( 4, last - triangle ),
+                                      contributions.data() );
+            }
+        } );
+
+        // 2. Coins sans normale de chaque position (CSR), dans l’ordre du fichier pour un résultat déterministe.
+        // Un coin dont la normale est lue dans le fichier ne contribue pas et n’ajoute aucune normale.
+        std::vector<std::uint32_t> offsets(positionCount + 1, 0);
+        for ( const auto& corner : data.corners ) {
+            offsets[corner.position + 1] += corner.normal == NO_INDEX ? 1 : 0;
+        }
+        for ( std::size_t i = 0; i < positionCount; ++i ) {
+            offsets[i + 1] += offsets[i];
+        }
+
+        std::vector<std::uint32_t> order(offsets[positionCount]);
+        {
+            std::vector<std::uint32_t> cursor(offsets.cbegin(), offsets.cend() - 1);
+            for ( std::size_t i = 0; i < cornerCount; ++i ) {
+                if ( data.corners[i].normal == NO_INDEX ) {
+                    order[cursor[data.corners[i].position]++] = static_cast<std::uint32_t>(i);
+                }
+            }
+        }
+
+        const auto groups = expandGroups( data, options.useSmoothingGroups );
+        const auto groupOf = [&]( const std::uint32_t entry ) noexcept {
+            return groups.empty() ? IMPLICIT_GROUP : groups[order[entry] / 3];
+        };
+
+        // Une normale par suite de coins d’un même groupe ; les faces plates ont chacune la leur.
+        const auto startsNormal = [&]( const std::uint32_t entry, const std::uint32_t first ) noexcept {
+            const auto group = groupOf( entry );
+            return entry == first || group == FLAT_GROUP || group != groupOf( entry - 1 );
+        };
+
+        // 3. Les coins de chaque position sont triés par groupe : un groupe forme une suite contiguë.
+        // Note développeur : Le numéro du coin départage les égalités, l’ordre du fichier est conservé dans chaque groupe
+        // sans la mémoire temporaire de std::stable_sort.
+        const auto blockCount = taskCount( positionCount, POSITIONS_PER_TASK );
+
+        std::vector<std::uint32_t> blockOffsets(blockCount + 1, 0);
+
+        utility::parallelFor( blockCount, options.threadCount, [&]( const std::size_t block ) {
+            const auto firstPosition = block * POSITIONS_PER_TASK;
+            const auto lastPosition = std::min( firstPosition + POSITIONS_PER_TASK, positionCount );
+
+            std::uint32_t normalCount = 0;
+            for ( auto position = firstPosition; position < lastPosition; ++position ) {
+                const auto first = offsets[position];
+                const auto end = offsets[position + 1];
+
+                if ( !groups.empty() ) {
+                    std::sort( order.begin() + first, order.begin() + end, [&groups]( const std::uint32_t a, const std::uint32_t b ) {
+                        const auto groupA = groups[a / 3];
+                        const auto groupB = groups[b / 3];
+                        return groupA != groupB ? groupA < groupB : a < b;
+                    } );
+                }
+
+                for ( auto entry = first; entry < end; ++entry ) {
+                    normalCount += startsNormal( entry, first ) ? 1 : 0;
+                }
+            }
+
+            blockOffsets[block + 1] = normalCount;
+        } );
+
+        for ( std::size_t block = 0; block < blockCount; ++block ) {
+            blockOffsets[block + 1] += blockOffsets[block];
+        }
+
+        // 4. Chaque suite accumule ses contributions en un seul parcours, les normales sont rangées bloc par bloc.
+        const auto normalBase = static_cast<std::uint32_t>(data.normals.size());
+        data.normals.resize( data.normals.size() + blockOffsets[blockCount] );
+
+        utility::parallelFor( blockCount, options.threadCount, [&]( const std::size_t block ) {
+            const auto firstPosition = block * POSITIONS_PER_TASK;
+            const auto lastPosition = std::min( firstPosition + POSITIONS_PER_TASK, positionCount );
+
+            auto next = normalBase + blockOffsets[block];
+            for ( auto position = firstPosition; position < lastPosition; ++position ) {
+                const auto first = offsets[position];
+                const auto end = offsets[position + 1];
+
+                for ( auto begin = first; begin < end; ) {
+                    auto sum = contributions[order[begin]];
+
+                    auto last = begin + 1;
+                    while ( last < end && !startsNormal( last, first ) ) {
+                        sum += contributions[order[last]];
+                        ++last;
+                    }
+
+                    data.normals[next] = normalizeOrZero( sum );
+                    for ( auto entry = begin; entry < last; ++entry ) {
+                        data.corners[order[entry]].normal = next;
+                    }
+
+                    ++next;
+                    begin = last;
+                }
+            }
+        } );
+    }
+}
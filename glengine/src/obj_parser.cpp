@@ -0,0 +1,1002 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <glengine/obj_parser.hpp>
+#include <glengine/parallel.hpp>
+
+namespace gl_engine {
+    namespace {
+        /**
+         * @brief Taille minimale d’un morceau analysé par un thread, en dessous le découpage coûte plus qu’il ne rapporte.
+         */
+        constexpr std::size_t MINIMUM_CHUNK_SIZE = 64 * 1024;
+
+        constexpr bool isBlank( const char letter ) noexcept {
+            return letter == ' ' || letter == '\t' || letter == '\r';
+        }
+
+        const char* skipBlank( const char* current, const char* const end ) noexcept {
+            while ( current != end && isBlank( *current ) ) {
+                ++current;
+            }
+
+            return current;
+        }
+
+        const char* findEndOfLine( const char* const current, const char* const end ) noexcept {
+            const auto* const newLine = static_cast<const char*>(std::memchr( current, '\n', static_cast<std::size_t>(end - current) ));
+
+            return newLine == nullptr ? end : newLine;
+        }
+
+        /**
+         * @brief Retire les blancs de fin de ligne (notamment '\r' des fichiers Windows).
+         */
+        std::string_view trim( const char* begin, const char* end ) noexcept {
+            begin = skipBlank( begin, end );
+            while ( end != begin && isBlank( *(end - 1) ) ) {
+                --end;
+            }
+
+            return {begin, static_cast<std::size_t>(end - begin)};
+        }
+
+        /**
+         * @brief Convertit un nombre flottant décimal, sans passer par la locale.
+         *
+         * Chemin rapide exact (algorithme de Clinger) : si la mantisse tient sur 24 bits et que l’exposant décimal
+         * est inférieur à 10 en valeur absolue, mantisse et puissance de dix sont représentables exactement
+         * par un float, le résultat d’une seule multiplication ou division est donc correctement arrondi.
+         * Les autres cas (mantisses longues, exposants extrêmes) sont délégués à std::from_chars.
+         *
+         * @return Le pointeur après le nombre, ou nullptr si aucun nombre n’a été reconnu.
+         */
+        const char* parseFloat( const char* const begin, const char* const end, float& value ) noexcept {
+            static constexpr float POWERS_OF_TEN[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+
+            const auto* current = begin;
+
+            const auto negative = current != end && *current == '-';
+            if ( current != end && ( *current == '-' || *current == '+' ) ) {
+                ++current;
+            }
+
+            std::uint64_t mantissa = 0;
+            auto exponent = 0;
+            auto digits = 0;
+            auto significantDigits = 0;
+
+            for ( ; current != end && *current >= '0' && *current <= '9'; ++current, ++digits ) {
+                if ( mantissa != 0 || *current != '0' ) {
+                    ++significantDigits;
+                }
+                mantissa = mantissa * 10 + static_cast<std::uint64_t>(*current - '0');
+            }
+
+            if ( current != end && *current == '.' ) {
+                ++current;
+
+                for ( ; current != end && *current >= '0' && *current <= '9'; ++current, ++digits ) {
+                    if ( mantissa != 0 || *current != '0' ) {
+                        ++significantDigits;
+                    }
+                    mantissa = mantissa * 10 + static_cast<std::uint64_t>(*current - '0');
+                    --exponent;
+                }
+            }
+
+            if ( digits == 0 ) {
+                return nullptr;
+            }
+
+            if ( current != end && ( *current == 'e' || *current == 'E' ) ) {
+                const auto* exponentPart = current + 1;
+
+                auto exponentNegative = false;
+                if ( exponentPart != end && ( *exponentPart == '-' || *exponentPart == '+' ) ) {
+                    exponentNegative = *exponentPart == '-';
+                    ++exponentPart;
+                }
+
+                if ( exponentPart != end && *exponentPart >= '0' && *exponentPart <= '9' ) {
+                    auto explicitExponent = 0;
+                    for ( ; exponentPart != end && *exponentPart >= '0' && *exponentPart <= '9'; ++exponentPart ) {
+                        if ( explicitExponent < 10000 ) {
+                            explicitExponent = explicitExponent * 10 + ( *exponentPart - '0' );
+                        }
+                    }
+
+                    exponent += exponentNegative ? -explicitExponent : explicitExponent;
+                    current = exponentPart;
+                }
+            }
+
+            if ( significantDigits <= 19 && mantissa <= ( 1u << 24 ) && exponent >= -10 && exponent <= 10 ) {
+                auto result = static_cast<float>(mantissa);
+                result = exponent < 0 ? result / POWERS_OF_TEN[-exponent] : result * POWERS_OF_TEN[exponent];
+
+                value = negative ? -result : result;
+
+                return current;
+            }
+
+            // Note développeur : std::from_chars refuse le signe '+' explicite.
+            const auto* const fallbackBegin = ( *begin == '+' ) ? begin + 1 : begin;
+            const auto [last, error] = std::from_chars( fallbackBegin, end, value );
+
+            return error == std::errc{} ? last : nullptr;
+        }
+
+        /**
+         * @brief Compte le nombre d’éléments de chaque type pour réserver les tableaux en une seule allocation.
+         */
+        struct Counts {
+            std::size_t positions = 0;
+            std::size_t texCoords = 0;
+            std::size_t normals = 0;
+            std::size_t faces = 0;
+        };
+
+        Counts count( const char* current, const char* const end ) noexcept {
+            Counts counts{};
+
+            while ( current < end ) {
+                current = skipBlank( current, end );
+
+                if ( end - current > 2 ) {
+                    if ( current[0] == 'v' ) {
+                        if ( isBlank( current[1] ) ) {
+                            ++counts.positions;
+                        }
+                        else if ( current[1] == 't' ) {
+                            ++counts.texCoords;
+                        }
+                        else if ( current[1] == 'n' ) {
+                            ++counts.normals;
+                        }
+                    }
+                    else if ( current[0] == 'f' && isBlank( current[1] ) ) {
+                        ++counts.faces;
+                    }
+                }
+
+                current = findEndOfLine( current, end ) + 1;
+            }
+
+            return counts;
+        }
+
+        /**
+         * @brief Erreur d’analyse d’un morceau, la ligne est relative au début du morceau.
+         */
+        struct LineError {
+            std::size_t line;
+            std::string reason;
+        };
+
+        /**
+         * @brief Indice relatif d’un coin à corriger lors de la fusion des morceaux.
+         *
+         * Un indice négatif d’un morceau autre que le premier dépend du nombre d’éléments déclarés
+         * dans les morceaux précédents, inconnu durant l’analyse.
+         */
+        struct Fixup {
+            enum class Attribute : std::uint8_t {
+                POSITION,
+                TEXTURE,
+                NORMAL
+            };
+
+            std::uint32_t corner;
+            Attribute attribute;
+
+            /// Ligne de la face, relative au début du morceau, pour signaler un indice invalide.
+            std::uint32_t line;
+        };
+
+        /**
+         * @brief Coin lu dans une face, avec les attributs à corriger à la fusion (bit i pour l’attribut i).
+         */
+        struct PendingCorner {
+            Corner corner{};
+            std::uint8_t fixups = 0;
+        };
+
+        /**
+         * @brief Face de plus de trois sommets, émise en éventail puis éventuellement retriangulée.
+         *
+         * Les cornerCount - 2 triangles commencent à firstTriangle et se suivent.
+         */
+        struct Polygon {
+            std::uint32_t firstTriangle;
+            std::uint32_t cornerCount;
+        };
+
+        /**
+         * @brief Résultat de l’analyse d’un morceau du contenu.
+         */
+        struct Chunk {
+            const char* begin = nullptr;
+            const char* end = nullptr;
+
+            ObjData data{};
+            std::vector<Fixup> fixups{};
+            std::vector<Polygon> polygons{};
+            std::optional<LineError> error{};
+        };
+
+        /**
+         * @brief État de l’analyse d’un contenu '.obj', ou d’un morceau de celui-ci.
+         */
+        class Parser final {
+        public:
+            /**
+             * @param fixups Les indices relatifs à corriger, nullptr si le morceau commence au début du contenu.
+             * @param polygons Les faces de plus de trois sommets, à retrianguler une fois les positions connues.
+             */
+            Parser( const char* const begin, const char* const end, ObjData& data, std::vector<Fixup>* const fixups,
+                    std::vector<Polygon>& polygons ) noexcept
+            : current_(begin), end_(end), data_(data), fixups_(fixups), polygons_(polygons) {}
+
+            void run() {
+                while ( current_ < end_ ) {
+                    lineEnd_ = findEndOfLine( current_, end_ );
+
+                    parseLine();
+
+                    current_ = lineEnd_ + 1;
+                    ++line_;
+                }
+            }
+
+        private:
+            const char* current_;
+            const char* const end_;
+            const char* lineEnd_ = nullptr;
+
+            std::size_t line_ = 1;
+
+            ObjData& data_;
+            std::vector<Fixup>* const fixups_;
+            std::vector<Polygon>& polygons_;
+
+            [[noreturn]] void fail( const std::string& reason ) const {
+                throw LineError{line_, reason};
+            }
+
+            bool startsWith( const std::string_view keyword ) const noexcept {
+                const auto remaining = static_cast<std::size_t>(lineEnd_ - current_);
+
+                return remaining > keyword.size()
+                       && std::memcmp( current_, keyword.data(), keyword.size() ) == 0
+                       && isBlank( current_[keyword.size()] );
+            }
+
+            void parseLine() {
+                current_ = skipBlank( current_, lineEnd_ );
+
+                if ( current_ == lineEnd_ ) {
+                    return;
+                }
+
+                switch ( *current_ ) {
+                    case 'v':
+                        if ( startsWith( "v" ) ) {
+                            current_ += 1;
+                            parsePosition();
+                        }
+                        else if ( startsWith( "vt" ) ) {
+                            current_ += 2;
+                            parseTexCoord();
+                        }
+                        else if ( startsWith( "vn" ) ) {
+                            current_ += 2;
+                            parseNormal();
+                        }
+                        break;
+                    case 'f':
+                        if ( startsWith( "f" ) ) {
+                            current_ += 1;
+                            parseFace();
+                        }
+                        break;
+                    case 'm':
+                        if ( startsWith( "mtllib" ) ) {
+                            current_ += 6;
+                            parseMaterialLibraries();
+                        }
+                        break;
+                    case 'u':
+                        if ( startsWith( "usemtl" ) ) {
+                            current_ += 6;
+                            parseUseMaterial();
+                        }
+                        break;
+                    case 's':
+                        if ( startsWith( "s" ) ) {
+                            current_ += 1;
+                            parseSmoothingGroup();
+                        }
+                        break;
+                    default:
+                        // Commentaires, 'o', 'g' et mots-clés inconnus : la ligne est ignorée.
+                        break;
+                }
+            }
+
+            float readFloat() {
+                current_ = skipBlank( current_, lineEnd_ );
+
+                auto value = 0.0f;
+                const auto* const last = parseFloat( current_, lineEnd_, value );
+
+                if ( last == nullptr ) {
+                    fail( "Nombre flottant attendu." );
+                }
+
+                current_ = last;
+
+                return value;
+            }
+
+            void parsePosition() {
+                const auto x = readFloat();
+                const auto y = readFloat();
+                const auto z = readFloat();
+
+                // La composante w et les couleurs par sommet sont ignorées.
+                data_.positions.emplace_back( x, y, z );
+            }
+
+            void parseTexCoord() {
+                const auto u = readFloat();
+
+                // La composante v est optionnelle dans le format.
+                auto v = 0.0f;
+                if ( skipBlank( current_, lineEnd_ ) != lineEnd_ ) {
+                    v = readFloat();
+                }
+
+                data_.texCoords.emplace_back( u, v );
+            }
+
+            void parseNormal() {
+                const auto x = readFloat();
+                const auto y = readFloat();
+                const auto z = readFloat();
+
+                data_.normals.emplace_back( x, y, z );
+            }
+
+            /**
+             * @brief Convertit un indice du fichier (commençant à 1, ou négatif si relatif) en indice commençant à 0.
+             */
+            std::uint32_t readIndex( const std::size_t elementCount, const Fixup::Attribute attribute, std::uint8_t& fixups ) {
+                // Note développeur : Boucle manuelle, std::from_chars sur les entiers est environ 5 fois plus lent ici.
+                const auto negative = current_ != lineEnd_ && *current_ == '-';
+                if ( negative ) {
+                    ++current_;
+                }
+
+                const auto* const digits = current_;
+                std::uint64_t index = 0;
+                while ( current_ != lineEnd_ && *current_ >= '0' && *current_ <= '9' && index <= NO_INDEX ) {
+                    index = index * 10 + static_cast<std::uint64_t>(*current_ - '0');
+                    ++current_;
+                }
+
+                if ( current_ == digits ) {
+                    fail( "Indice entier attendu." );
+                }
+
+                if ( !negative && index > 0 && index <= NO_INDEX ) {
+                    // Les indices positifs sont vérifiés après l’analyse, une face peut référencer un sommet déclaré plus loin.
+                    return static_cast<std::uint32_t>(index - 1);
+                }
+
+                if ( negative && index > 0 && index <= NO_INDEX && fixups_ != nullptr ) {
+                    // Hors du premier morceau, l’indice est relatif au début du morceau, éventuellement négatif
+                    // si l’élément est déclaré dans un morceau précédent : il est complété à la fusion.
+                    fixups |= static_cast<std::uint8_t>(1u << static_cast<unsigned>(attribute));
+
+                    return static_cast<std::uint32_t>(elementCount - index);
+                }
+
+                if ( negative && index > 0 && index <= elementCount ) {
+                    return static_cast<std::uint32_t>(elementCount - index);
+                }
+
+                fail( "Indice " + std::string( digits - negative, current_ ) + " invalide." );
+            }
+
+            PendingCorner readCorner() {
+                PendingCorner pending{};
+                auto& corner = pending.corner;
+
+                corner.position = readIndex( data_.positions.size(), Fixup::Attribute::POSITION, pending.fixups );
+
+                if ( current_ != lineEnd_ && *current_ == '/' ) {
+                    ++current_;
+
+                    if ( current_ != lineEnd_ && *current_ != '/' ) {
+                        corner.texture = readIndex( data_.texCoords.size(), Fixup::Attribute::TEXTURE, pending.fixups );
+                    }
+
+                    if ( current_ != lineEnd_ && *current_ == '/' ) {
+                        ++current_;
+                        corner.normal = readIndex( data_.normals.size(), Fixup::Attribute::NORMAL, pending.fixups );
+                    }
+                }
+
+                if ( current_ != lineEnd_ && !isBlank( *current_ ) ) {
+                    fail( "Coin de face mal formé." );
+                }
+
+                return pending;
+            }
+
+            void emit( const PendingCorner& pending ) {
+                if ( pending.fixups != 0 ) {
+                    // Un coin répété dans plusieurs triangles de l’éventail est corrigé dans chacun d’eux.
+                    const auto slot = static_cast<std::uint32_t>(data_.corners.size());
+
+                    for ( const auto attribute : {Fixup::Attribute::POSITION, Fixup::Attribute::TEXTURE, Fixup::Attribute::NORMAL} ) {
+                        if ( pending.fixups & ( 1u << static_cast<unsigned>(attribute) ) ) {
+                            fixups_->push_back( {slot, attribute, static_cast<std::uint32_t>(line_)} );
+                        }
+                    }
+                }
+
+                data_.corners.push_back( pending.corner );
+            }
+
+            /**
+             * Les triangles sont émis en éventail au fil de la lecture, sans stocker le polygone :
+             * seuls le premier et le précédent coin sont conservés.
+             */
+            void parseFace() {
+                const auto firstTriangle = static_cast<std::uint32_t>(data_.triangleCount());
+
+                PendingCorner first{};
+                PendingCorner previous{};
+                std::uint32_t cornerCount = 0;
+
+                while ( true ) {
+                    current_ = skipBlank( current_, lineEnd_ );
+
+                    if ( current_ == lineEnd_ || *current_ == '#' ) {
+                        break;
+                    }
+
+                    const auto corner = readCorner();
+
+                    if ( ++cornerCount == 1 ) {
+                        first = corner;
+                    }
+                    else if ( cornerCount >= 3 ) {
+                        emit( first );
+                        emit( previous );
+                        emit( corner );
+                    }
+
+                    previous = corner;
+                }
+
+                if ( cornerCount < 3 ) {
+                    fail( "Une face doit avoir au moins trois sommets." );
+                }
+
+                if ( cornerCount > 3 ) {
+                    polygons_.push_back( {firstTriangle, cornerCount} );
+                }
+            }
+
+            void parseMaterialLibraries() {
+                const auto names = trim( current_, lineEnd_ );
+
+                // Plusieurs bibliothèques peuvent être déclarées sur la même ligne.
+                std::size_t begin = 0;
+                while ( begin < names.size() ) {
+                    auto end = begin;
+                    while ( end < names.size() && !isBlank( names[end] ) ) {
+                        ++end;
+                    }
+
+                    data_.materialLibraries.emplace_back( names.substr( begin, end - begin ) );
+
+                    begin = end;
+                    while ( begin < names.size() && isBlank( names[begin] ) ) {
+                        ++begin;
+                    }
+                }
+            }
+
+            void parseUseMaterial() {
+                const auto name = trim( current_, lineEnd_ );
+
+                if ( name.empty() ) {
+                    fail( "Nom de matériau attendu." );
+                }
+
+                auto& materials = data_.materials;
+
+                std::uint32_t material = 0;
+                while ( material < materials.size() && materials[material] != name ) {
+                    ++material;
+                }
+
+                if ( material == materials.size() ) {
+                    materials.emplace_back( name );
+                }
+
+                const auto firstTriangle = static_cast<std::uint32_t>(data_.triangleCount());
+                auto& ranges = data_.materialRanges;
+
+                // Deux 'usemtl' consécutifs sans face : seul le dernier compte.
+                if ( !ranges.empty() && ranges.back().firstTriangle == firstTriangle ) {
+                    ranges.back().material = material;
+                }
+                else {
+                    ranges.push_back( {material, firstTriangle} );
+                }
+            }
+
+            void parseSmoothingGroup() {
+                const auto value = trim( current_, lineEnd_ );
+
+                std::uint32_t group = 0;
+                if ( value != "off" ) {
+                    const auto [last, error] = std::from_chars( value.data(), value.data() + value.size(), group );
+
+                    if ( error != std::errc{} || last != value.data() + value.size() ) {
+                        fail( "Groupe de lissage invalide." );
+                    }
+                }
+
+                const auto firstTriangle = static_cast<std::uint32_t>(data_.triangleCount());
+                auto& ranges = data_.smoothingRanges;
+
+                if ( !ranges.empty() && ranges.back().firstTriangle == firstTriangle ) {
+                    ranges.back().group = group;
+                }
+                else {
+                    ranges.push_back( {group, firstTriangle} );
+                }
+            }
+        };
+
+        /**
+         * @brief Réserve les tableaux puis analyse le contenu de [begin, end[.
+         */
+        void parseRange( const char* const begin, const char* const end, ObjData& data, std::vector<Fixup>* const fixups,
+                         std::vector<Polygon>& polygons ) {
+            const auto counts = count( begin, end );
+            data.positions.reserve( counts.positions );
+            data.texCoords.reserve( counts.texCoords );
+            data.normals.reserve( counts.normals );
+            data.corners.reserve( counts.faces * 3 );
+
+            Parser( begin, end, data, fixups, polygons ).run();
+        }
+
+        /**
+         * @brief Découpe [begin, end[ en morceaux de tailles proches, chacun se terminant après un '\n'.
+         */
+        std::vector<Chunk> split( const char* const begin, const char* const end, const std::size_t chunkCount ) {
+            std::vector<Chunk> chunks{};
+            chunks.reserve( chunkCount );
+
+            const auto size = static_cast<std::size_t>(end - begin);
+
+            const auto* chunkBegin = begin;
+            for ( std::size_t i = 1; i <= chunkCount && chunkBegin < end; ++i ) {
+                const auto* chunkEnd = end;
+                if ( i < chunkCount ) {
+                    chunkEnd = std::max( chunkBegin, begin + size / chunkCount * i );
+                    chunkEnd = std::min( findEndOfLine( chunkEnd, end ) + 1, end );
+                }
+
+                auto& chunk = chunks.emplace_back();
+                chunk.begin = chunkBegin;
+                chunk.end = chunkEnd;
+
+                chunkBegin = chunkEnd;
+            }
+
+            return chunks;
+        }
+
+        /**
+         * @brief Lance l’erreur du premier morceau en erreur, avec sa ligne dans le fichier entier.
+         *
+         * @throws gl_engine::ObjParseError Lancée si un morceau contient une erreur.
+         *
+         * @note La première erreur du fichier est signalée, comme lors d’une analyse séquentielle.
+         */
+        void throwFirstError( const std::vector<Chunk>& chunks ) {
+            for ( const auto& chunk : chunks ) {
+                if ( chunk.error.has_value() ) {
+                    const auto previousLines = static_cast<std::size_t>(std::count( chunks.front().begin, chunk.begin, '\n' ));
+
+                    throw ObjParseError(previousLines + chunk.error->line, chunk.error->reason);
+                }
+            }
+        }
+
+        /**
+         * @brief Assemble les morceaux analysés dans l’ordre du fichier.
+         *
+         * Les décalages de chaque morceau sont les sommes préfixes des tailles des morceaux précédents.
+         * Les tableaux sont ensuite recopiés en parallèle, chaque morceau écrivant dans sa propre plage.
+         *
+         * @throws gl_engine::ObjParseError Lancée avec la première erreur du fichier, d’analyse ou d’indice relatif
+         * précédant le début du fichier.
+         *
+         * @note Un morceau en erreur n’est analysé que jusqu’à sa ligne fautive : les décalages des morceaux suivants sont faux,
+         * mais leurs erreurs ont des lignes plus grandes. Les morceaux qui précèdent le premier morceau en erreur sont complets,
+         * les indices relatifs de celui-ci sont donc vérifiés correctement.
+         */
+        ObjData merge( std::vector<Chunk>& chunks, std::vector<Polygon>& polygons, const unsigned threadCount ) {
+            struct Offsets {
+                std::size_t positions = 0;
+                std::size_t texCoords = 0;
+                std::size_t normals = 0;
+                std::size_t corners = 0;
+                std::size_t polygons = 0;
+            };
+
+            std::vector<Offsets> offsets( chunks.size() + 1 );
+            for ( std::size_t i = 0; i < chunks.size(); ++i ) {
+                const auto& data = chunks[i].data;
+
+                offsets[i + 1].positions = offsets[i].positions + data.positions.size();
+                offsets[i + 1].texCoords = offsets[i].texCoords + data.texCoords.size();
+                offsets[i + 1].normals = offsets[i].normals + data.normals.size();
+                offsets[i + 1].corners = offsets[i].corners + data.corners.size();
+                offsets[i + 1].polygons = offsets[i].polygons + chunks[i].polygons.size();
+            }
+
+            ObjData merged{};
+
+            // Les matériaux et bibliothèques sont peu nombreux, ils sont fusionnés séquentiellement.
+            for ( std::size_t i = 0; i < chunks.size(); ++i ) {
+                auto& data = chunks[i].data;
+
+                for ( auto& library : data.materialLibraries ) {
+                    merged.materialLibraries.push_back( std::move( library ) );
+                }
+
+                std::vector<std::uint32_t> materialMap( data.materials.size() );
+                for ( std::size_t material = 0; material < data.materials.size(); ++material ) {
+                    const auto found = std::find( merged.materials.cbegin(), merged.materials.cend(), data.materials[material] );
+
+                    materialMap[material] = static_cast<std::uint32_t>(found - merged.materials.cbegin());
+                    if ( found == merged.materials.cend() ) {
+                        merged.materials.push_back( std::move( data.materials[material] ) );
+                    }
+                }
+
+                const auto triangleOffset = static_cast<std::uint32_t>(offsets[i].corners / 3);
+                for ( const auto& range : data.materialRanges ) {
+                    const MaterialRange shifted{materialMap[range.material], range.firstTriangle + triangleOffset};
+
+                    auto& ranges = merged.materialRanges;
+                    if ( !ranges.empty() && ranges.back().firstTriangle == shifted.firstTriangle ) {
+                        ranges.back().material = shifted.material;
+                    }
+                    else {
+                        ranges.push_back( shifted );
+                    }
+                }
+
+                for ( const auto& range : data.smoothingRanges ) {
+                    const SmoothingRange shifted{range.group, range.firstTriangle + triangleOffset};
+
+                    auto& ranges = merged.smoothingRanges;
+                    if ( !ranges.empty() && ranges.back().firstTriangle == shifted.firstTriangle ) {
+                        ranges.back().group = shifted.group;
+                    }
+                    else {
+                        ranges.push_back( shifted );
+                    }
+                }
+            }
+
+            const auto& total = offsets.back();
+            merged.positions.resize( total.positions );
+            merged.texCoords.resize( total.texCoords );
+            merged.normals.resize( total.normals );
+            merged.corners.resize( total.corners );
+            polygons.resize( total.polygons );
+
+            utility::parallelFor( chunks.size(), threadCount, [&]( const std::size_t i ) {
+                const auto& data = chunks[i].data;
+                const auto& offset = offsets[i];
+
+                std::copy( data.positions.cbegin(), data.positions.cend(), merged.positions.begin() + offset.positions );
+                std::copy( data.texCoords.cbegin(), data.texCoords.cend(), merged.texCoords.begin() + offset.texCoords );
+                std::copy( data.normals.cbegin(), data.normals.cend(), merged.normals.begin() + offset.normals );
+                std::copy( data.corners.cbegin(), data.corners.cend(), merged.corners.begin() + offset.corners );
+
+                const auto triangleOffset = static_cast<std::uint32_t>(offset.corners / 3);
+                std::transform( chunks[i].polygons.cbegin(), chunks[i].polygons.cend(), polygons.begin() + offset.polygons,
+                                [triangleOffset]( const Polygon& polygon ) noexcept {
+                                    return Polygon{polygon.firstTriangle + triangleOffset, polygon.cornerCount};
+                                } );
+
+                // L’indice stocké est relatif au début du morceau, en complément à deux s’il le précède.
+                // Note développeur : L’erreur est conservée dans le morceau, la première du fichier est signalée après.
+                const auto fix = [&chunk = chunks[i]]( std::uint32_t& index, const std::size_t elementOffset,
+                                                        const Fixup& fixup ) noexcept {
+                    const auto fixed = static_cast<std::int64_t>(elementOffset) + static_cast<std::int32_t>(index);
+                    if ( fixed < 0 ) {
+                        // À ligne égale l’indice relatif l’emporte : son coin a été lu avant l’erreur d’analyse.
+                        if ( !chunk.error.has_value() || fixup.line <= chunk.error->line ) {
+                            chunk.error = LineError{fixup.line, "Une face référence un indice relatif précédant le début du fichier."};
+                        }
+
+                        return;
+                    }
+
+                    index = static_cast<std::uint32_t>(fixed);
+                };
+
+                for ( const auto& fixup : chunks[i].fixups ) {
+                    auto& corner = merged.corners[offset.corners + fixup.corner];
+
+                    switch ( fixup.attribute ) {
+                        case Fixup::Attribute::POSITION:
+                            fix( corner.position, offset.positions, fixup );
+                            break;
+                        case Fixup::Attribute::TEXTURE:
+                            fix( corner.texture, offset.texCoords, fixup );
+                            break;
+                        case Fixup::Attribute::NORMAL:
+                            fix( corner.normal, offset.normals, fixup );
+                            break;
+                    }
+                }
+            } );
+
+            throwFirstError( chunks );
+
+            return merged;
+        }
+
+        void checkIndices( const ObjData& data ) {
+            const auto positions = data.positions.size();
+            const auto texCoords = data.texCoords.size();
+            const auto normals = data.normals.size();
+
+            for ( const auto& corner : data.corners ) {
+                if ( corner.position >= positions
+                     || ( corner.texture != NO_INDEX && corner.texture >= texCoords )
+                     || ( corner.normal != NO_INDEX && corner.normal >= normals ) ) {
+                    throw ObjParseError("Une face référence un sommet, une coordonnée de texture ou une normale inexistante.");
+                }
+            }
+        }
+
+        /**
+         * @brief Polygones retriangulés par tâche.
+         */
+        constexpr std::size_t POLYGONS_PER_TASK = 4096;
+
+        /**
+         * @brief Retourne le coin numéro i d’un polygone émis en éventail : (c0, c1, c2), (c0, c2, c3), ...
+         */
+        const Corner& fanCorner( const Corner* const fan, const std::uint32_t i ) noexcept {
+            return i < 2 ? fan[i] : fan[( i - 2 ) * 3 + 2];
+        }
+
+        /**
+         * @brief Mémoire de travail de l’algorithme des oreilles, réutilisée d’un polygone à l’autre.
+         */
+        struct EarClipping {
+            std::vector<Corner> corners{};
+            std::vector<glm::vec2> points{};
+            std::vector<std::uint32_t> remaining{};
+        };
+
+        float signedArea( const glm::vec2& a, const glm::vec2& b, const glm::vec2& c ) noexcept {
+            return ( b.x - a.x ) * ( c.y - a.y ) - ( b.y - a.y ) * ( c.x - a.x );
+        }
+
+        /**
+         * @brief Remplace l’éventail d’un polygone concave par une triangulation par les oreilles (ear clipping).
+         *
+         * Le polygone est projeté sur le plan des deux axes où sa normale (Newell) est la plus petite,
+         * orienté pour que ses coins convexes aient une aire positive.
+         */
+        void clipEars( const ObjData& data, Corner* const fan, const std::uint32_t cornerCount, const glm::vec3& normal,
+                       EarClipping& scratch ) {
+            const auto absolute = glm::abs( normal );
+            const auto dropped = absolute.x > absolute.y ? ( absolute.x > absolute.z ? 0 : 2 ) : ( absolute.y > absolute.z ? 1 : 2 );
+            const auto u = ( dropped + 1 ) % 3;
+            const auto v = ( dropped + 2 ) % 3;
+            const auto orientation = normal[dropped] < 0.0f ? -1.0f : 1.0f;
+
+            scratch.corners.resize( cornerCount );
+            scratch.points.resize( cornerCount );
+            scratch.remaining.resize( cornerCount );
+            for ( std::uint32_t i = 0; i < cornerCount; ++i ) {
+                scratch.corners[i] = fanCorner( fan, i );
+
+                const auto& position = data.positions[scratch.corners[i].position];
+                scratch.points[i] = {position[u], position[v] * orientation};
+                scratch.remaining[i] = i;
+            }
+
+            auto* output = fan;
+            const auto emitTriangle = [&]( const std::uint32_t a, const std::uint32_t b, const std::uint32_t c ) noexcept {
+                *output++ = scratch.corners[a];
+                *output++ = scratch.corners[b];
+                *output++ = scratch.corners[c];
+            };
+
+            auto& remaining = scratch.remaining;
+            const auto& points = scratch.points;
+            while ( remaining.size() > 3 ) {
+                const auto size = remaining.size();
+
+                auto clipped = false;
+                for ( std::size_t k = 0; k < size && !clipped; ++k ) {
+                    const auto a = remaining[( k + size - 1 ) % size];
+                    const auto b = remaining[k];
+                    const auto c = remaining[( k + 1 ) % size];
+
+                    if ( !( signedArea( points[a], points[b], points[c] ) > 0.0f ) ) {
+                        continue;
+                    }
+
+                    const auto isEar = std::none_of( remaining.cbegin(), remaining.cend(), [&]( const std::uint32_t other ) {
+                        const auto& p = points[other];
+
+                        return other != a && other != b && other != c
+                               && p != points[a] && p != points[b] && p != points[c]
+                               && signedArea( points[a], points[b], p ) >= 0.0f
+                               && signedArea( points[b], points[c], p ) >= 0.0f
+                               && signedArea( points[c], points[a], p ) >= 0.0f;
+                    } );
+
+                    if ( isEar ) {
+                        emitTriangle( a, b, c );
+                        remaining.erase( remaining.begin() + static_cast<std::ptrdiff_t>(k) );
+                        clipped = true;
+                    }
+                }
+
+                if ( !clipped ) {
+                    // Polygone dégénéré ou auto-intersectant : le reste est émis en éventail.
+                    break;
+                }
+            }
+
+            for ( std::size_t k = 1; k + 1 < remaining.size(); ++k ) {
+                emitTriangle( remaining[0], remaining[k], remaining[k + 1] );
+            }
+        }
+
+        /**
+         * @brief Conserve l’éventail des polygones convexes, les polygones concaves sont découpés par les oreilles.
+         *
+         * Le nombre de triangles ne change pas, les plages de matériaux et de lissage restent donc valides.
+         */
+        void triangulateConcavePolygons( ObjData& data, const std::vector<Polygon>& polygons, const unsigned threadCount ) {
+            const auto taskCount = ( polygons.size() + POLYGONS_PER_TASK - 1 ) / POLYGONS_PER_TASK;
+
+            utility::parallelFor( taskCount, threadCount, [&]( const std::size_t task ) {
+                EarClipping scratch{};
+
+                const auto first = task * POLYGONS_PER_TASK;
+                const auto last = std::min( first + POLYGONS_PER_TASK, polygons.size() );
+                for ( auto i = first; i < last; ++i ) {
+                    const auto& polygon = polygons[i];
+                    auto* const fan = data.corners.data() + std::size_t{polygon.firstTriangle} * 3;
+
+                    const auto point = [&]( const std::uint32_t corner ) noexcept -> const glm::vec3& {
+                        return data.positions[fanCorner( fan, corner % polygon.cornerCount ).position];
+                    };
+
+                    // Normale de Newell, robuste pour les polygones concaves ou légèrement non plans.
+                    glm::vec3 normal{0.0f};
+                    for ( std::uint32_t corner = 0; corner < polygon.cornerCount; ++corner ) {
+                        const auto& current = point( corner );
+                        const auto& next = point( corner + 1 );
+
+                        normal.x += ( current.y - next.y ) * ( current.z + next.z );
+                        normal.y += ( current.z - next.z ) * ( current.x + next.x );
+                        normal.z += ( current.x - next.x ) * ( current.y + next.y );
+                    }
+
+                    auto convex = true;
+                    for ( std::uint32_t corner = 0; corner < polygon.cornerCount && convex; ++corner ) {
+                        const auto& previous = point( corner + polygon.cornerCount - 1 );
+                        const auto& current = point( corner );
+                        const auto& next = point( corner + 1 );
+
+                        convex = glm::dot( glm::cross( current - previous, next - current ), normal ) >= 0.0f;
+                    }
+
+                    if ( !convex ) {
+                        clipEars( data, fan, polygon.cornerCount, normal, scratch );
+                    }
+                }
+            } );
+        }
+    }
+
+    ObjData ObjParser::parse( const std::string_view source ) {
+        return parse( source, 1 );
+    }
+
+    ObjData ObjParser::parse( const std::string_view source, const unsigned threadCount ) {
+        const auto* const begin = source.data();
+        const auto* const end = source.data() + source.size();
+
+        const auto threads = utility::resolveThreadCount( threadCount );
+
+        // Quelques morceaux de plus que de threads pour équilibrer la charge entre sommets et faces.
+        const auto chunkCount = threads == 1 ? 1 : std::min<std::size_t>( threads * 4, source.size() / MINIMUM_CHUNK_SIZE );
+
+        ObjData data{};
+        std::vector<Polygon> polygons{};
+
+        if ( chunkCount <= 1 ) {
+            try {
+                parseRange( begin, end, data, nullptr, polygons );
+            }
+            catch ( const LineError& error ) {
+                throw ObjParseError(error.line, error.reason);
+            }
+        }
+        else {
+            auto chunks = split( begin, end, chunkCount );
+
+            utility::parallelFor( chunks.size(), threads, [&chunks]( const std::size_t i ) {
+                auto& chunk = chunks[i];
+
+                try {
+                    parseRange( chunk.begin, chunk.end, chunk.data, i == 0 ? nullptr : &chunk.fixups, chunk.polygons );
+                }
+                catch ( const LineError& error ) {
+                    chunk.error = error;
+                }
+            } );
+
+            // Note développeur : La fusion a lieu même si un morceau est en erreur : une erreur d’indice relatif
+            // d’un morceau précédent, ou du même morceau avant sa ligne fautive, doit être signalée la première.
+            data = merge( chunks, polygons, threads );
+        }
+
+        checkIndices( data );
+        triangulateConcavePolygons( data, polygons, threads );
+
+        return data;
+    }
+}
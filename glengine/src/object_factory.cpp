@@ -0,0 +1,174 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <glengine/mesh_builder.hpp>
+#include <glengine/mesh_cache.hpp>
+#include <glengine/mesh_optimizer.hpp>
+#include <glengine/mesh_simplifier.hpp>
+#include <glengine/mtl_parser.hpp>
+#include <glengine/normal_generator.hpp>
+#include <glengine/object_factory.hpp>
+#include <glengine/obj_parser.hpp>
+
+namespace gl_engine {
+    namespace {
+        Mesh buildMesh( const std::string_view source, const LoadOptions& options ) {
+            auto data = ObjParser::parse( source, options.threadCount );
+            NormalGenerator::generate( data, NormalOptions{options.normalWeighting, options.useSmoothingGroups, options.threadCount} );
+
+            auto mesh = MeshBuilder::build( data );
+
+            if ( options.optimize ) {
+                mesh = MeshOptimizer::optimize( mesh );
+            }
+
+            return mesh;
+        }
+
+        std::vector<LodLevel> buildLods( const Mesh& mesh, const LoadOptions& options ) {
+            if ( options.lodLevelCount == 0 ) {
+                return {};
+            }
+
+            LodOptions lodOptions{};
+            lodOptions.levelCount = options.lodLevelCount;
+            lodOptions.simplify.threadCount = options.threadCount;
+
+            return MeshSimplifier::buildLodChain( mesh, lodOptions );
+        }
+
+        /**
+         * @brief Charge les matériaux des plages du maillage depuis ses fichiers '.mtl', situés dans directory.
+         *
+         * Un fichier '.mtl' ou une texture introuvable ne bloque pas le chargement : le matériau garde
+         * ses valeurs par défaut, ou n’a pas cette texture.
+         */
+        std::vector<Material> loadMaterials( const Mesh& mesh, const std::filesystem::path& directory ) {
+            std::vector<MaterialData> library{};
+            for ( const auto& name : mesh.materialLibraries() ) {
+                try {
+                    const MappedFile file{Path(directory / name)};
+
+                    auto materials = MtlParser::parse( file.view() );
+                    std::move( materials.begin(), materials.end(), std::back_inserter( library ) );
+                }
+                catch ( const IOException& ) {
+                    // Fichier vide ou illisible : ses matériaux gardent leurs valeurs par défaut.
+                }
+                catch ( const InvalidArgument& ) {
+                    // Fichier absent, fréquent lorsqu’un modèle est copié sans son '.mtl'.
+                }
+            }
+
+            std::vector<Material> materials{};
+            materials.reserve( mesh.subMeshes().size() );
+
+            for ( const auto& subMesh : mesh.subMeshes() ) {
+                auto& material = materials.emplace_back();
+                material.name = subMesh.material;
+
+                const auto data = std::find_if( library.cbegin(), library.cend(), [&subMesh]( const MaterialData& candidate ) {
+                    return candidate.name == subMesh.material;
+                } );
+                if ( data == library.cend() ) {
+                    continue;
+                }
+
+                material.parameters = data->parameters;
+
+                for ( std::size_t slot = 0; slot < TEXTURE_SLOT_COUNT; ++slot ) {
+                    if ( data->textures[slot].empty() ) {
+                        continue;
+                    }
+
+                    try {
+                        material.textures[slot] = TextureCache::load( Path(directory / data->textures[slot]) );
+                    }
+                    catch ( const Exception& ) {
+                        // Image absente ou illisible : le matériau est dessiné sans cette texture.
+                    }
+                }
+            }
+
+            return materials;
+        }
+    }
+
+    // Note développeur : Tous les attributs disponibles dans le format obj
+    // http://www.hodge.net.au/sam/blog/wp-content/uploads/obj_format.txt
+
+    std::unique_ptr<Object> ObjectFactory::load( const Content& content ) {
+        return load( content, 1 );
+    }
+
+    std::unique_ptr<Object> ObjectFactory::load( const Path& path ) {
+        return load( path, 1 );
+    }
+
+    std::unique_ptr<Object> ObjectFactory::load( const Content& content, const unsigned threadCount ) {
+        return load( content, LoadOptions{threadCount} );
+    }
+
+    std::unique_ptr<Object> ObjectFactory::load( const Path& path, const unsigned threadCount ) {
+        return load( path, LoadOptions{threadCount} );
+    }
+
+    std::unique_ptr<Object> ObjectFactory::load( const Content& content, const LoadOptions& options ) {
+        auto mesh = buildMesh( content.view(), options );
+        auto lods = buildLods( mesh, options );
+
+        return std::make_unique<ComplexObject>( std::move( mesh ), std::vector<Material>{}, std::move( lods ) );
+    }
+
+    std::unique_ptr<Object> ObjectFactory::load( const Path& path, const LoadOptions& options ) {
+        const auto directory = path.path_.parent_path();
+
+        if ( auto cached = MeshCache::load( path, options.cacheKey() ) ) {
+            auto materials = loadMaterials( cached->mesh, directory );
+            return std::make_unique<ComplexObject>( std::move( cached->mesh ), std::move( materials ), std::move( cached->lods ) );
+        }
+
+        // La date est relevée avant la lecture, une modification pendant l’analyse invalide donc le cache écrit.
+        const auto stamp = MeshCache::stamp( path );
+
+        // Le fichier reste projeté seulement durant l’analyse, les données sont copiées dans le maillage.
+        const MappedFile file(path);
+
+        auto mesh = buildMesh( file.view(), options );
+        auto lods = buildLods( mesh, options );
+
+        if ( stamp ) {
+            try {
+                MeshCache::store( path, *stamp, file.view(), mesh, lods, options.cacheKey() );
+            }
+            catch ( const IOException& ) {
+                // Dossier en lecture seule, disque plein, ... : le cache n’est qu’une optimisation.
+            }
+        }
+
+        auto materials = loadMaterials( mesh, directory );
+        return std::make_unique<ComplexObject>( std::move( mesh ), std::move( materials ), std::move( lods ) );
+    }
+}
@@ -0,0 +1,413 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <glengine/mesh.hpp>
+#include <glengine/occlusion.hpp>
+#include <glengine/simd.hpp>
+
+namespace gl_engine {
+    namespace {
+#ifdef GLENGINE_SIMD_AVX
+        using Lane = simd::Float8;
+        constexpr std::size_t LANE_WIDTH = 8;
+#else
+        using Lane = simd::Float4;
+        constexpr std::size_t LANE_WIDTH = 4;
+#endif
+
+        /// Largeur du tampon multiple de 8 : une ligne se parcourt sans reste avec Float4 comme avec Float8.
+        constexpr std::size_t WIDTH_ALIGNMENT = 8;
+
+        /// Centres des pixels d’un groupe, relatifs à son premier pixel.
+        constexpr std::array<float, 8> PIXEL_CENTERS{0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f};
+
+        /// En dessous, un sommet est considéré sur ou derrière l’œil.
+        constexpr float MINIMUM_W = 1e-5f;
+
+        /// Point du plan proche (z = -w) sur le segment [a, b], a devant et b derrière.
+        glm::vec4 clipNear( const glm::vec4& a, const glm::vec4& b ) noexcept {
+            const auto distanceA = a.z + a.w;
+            const auto distanceB = b.z + b.w;
+
+            return a + ( b - a ) * ( distanceA / ( distanceA - distanceB ) );
+        }
+
+        /// Vrai si les trois sommets sont du même côté extérieur d’un des plans du volume de vue, sauf le proche.
+        bool outside( const glm::vec4& a, const glm::vec4& b, const glm::vec4& c ) noexcept {
+            return ( a.x > a.w && b.x > b.w && c.x > c.w ) || ( a.x < -a.w && b.x < -b.w && c.x < -c.w ) ||
+                   ( a.y > a.w && b.y > b.w && c.y > c.w ) || ( a.y < -a.w && b.y < -b.w && c.y < -c.w ) ||
+                   ( a.z > a.w && b.z > b.w && c.z > c.w );
+        }
+    }
+
+    OccluderMesh OccluderMesh::fromMesh( const Mesh& mesh ) {
+        OccluderMesh occluder{};
+
+        occluder.positions.reserve( mesh.vertexCount() );
+        for ( std::size_t i = 0; i < mesh.vertexCount(); ++i ) {
+            occluder.positions.push_back( mesh.vertices()[i].position );
+        }
+
+        occluder.indices.reserve( mesh.indexCount() );
+        for ( std::size_t i = 0; i < mesh.indexCount(); ++i ) {
+            occluder.indices.push_back( mesh.index( i ) );
+        }
+
+        return occluder;
+    }
+
+    OcclusionBuffer::OcclusionBuffer()
+    : OcclusionBuffer(DEFAULT_WIDTH, DEFAULT_HEIGHT) {}
+
+    OcclusionBuffer::OcclusionBuffer( const std::size_t width, const std::size_t height )
+    : width_(( std::max<std::size_t>( width, 1 ) + WIDTH_ALIGNMENT - 1 ) / WIDTH_ALIGNMENT * WIDTH_ALIGNMENT),
+      height_(std::max<std::size_t>( height, 1 )), depth_(width_ * height_, 1.0f) {
+        auto levelWidth = width_;
+        auto levelHeight = height_;
+
+        while ( levelWidth > 1 || levelHeight > 1 ) {
+            levelWidth = ( levelWidth + 1 ) / 2;
+            levelHeight = ( levelHeight + 1 ) / 2;
+
+            auto& level = levels_.emplace_back();
+            level.width = levelWidth;
+            level.height = levelHeight;
+            level.nearest.assign( levelWidth * levelHeight, 1.0f );
+            level.farthest.assign( levelWidth * levelHeight, 1.0f );
+        }
+    }
+
+    void OcclusionBuffer::render( const std::vector<Occluder>& occluders, const glm::mat4& viewProjection ) {
+        render( occluders, viewProjection, 1 );
+    }
+
+    void OcclusionBuffer::render( const std::vector<Occluder>& occluders, const glm::mat4& viewProjection, const unsigned threadCount ) {
+        viewProjection_ = viewProjection;
+        std::fill( depth_.begin(), depth_.end(), 1.0f );
+
+        try {
+            triangles_.resize( occluders.size() );
+            utility::parallelFor( occluders.size(), threadCount, [&]( const std::size_t i ) {
+                setup( occluders[i], triangles_[i] );
+            } );
+
+            triangleCount_ = 0;
+            for ( std::size_t i = 0; i < occluders.size(); ++i ) {
+                triangleCount_ += triangles_[i].size();
+            }
+
+            // Chaque bande ne touche que ses lignes : aucune synchronisation entre threads.
+            const auto bandCount = ( height_ + BAND_HEIGHT - 1 ) / BAND_HEIGHT;
+            utility::parallelFor( bandCount, threadCount, [&]( const std::size_t band ) {
+                const auto firstRow = static_cast<int>(band * BAND_HEIGHT);
+                const auto lastRow = static_cast<int>(std::min( height_, ( band + 1 ) * BAND_HEIGHT )) - 1;
+
+                for ( std::size_t i = 0; i < occluders.size(); ++i ) {
+                    for ( const auto& triangle : triangles_[i] ) {
+                        if ( triangle.maxY >= firstRow && triangle.minY <= lastRow ) {
+                            rasterize( triangle, firstRow, lastRow );
+                        }
+                    }
+                }
+            } );
+        }
+        catch ( ... ) {
+            std::fill( depth_.begin(), depth_.end(), 1.0f );
+            triangleCount_ = 0;
+            buildHierarchy();
+            throw;
+        }
+
+        buildHierarchy();
+    }
+
+    void OcclusionBuffer::setup( const Occluder& occluder, std::vector<ScreenTriangle>& triangles ) const {
+        triangles.clear();
+        if ( occluder.mesh == nullptr ) {
+            return;
+        }
+
+        const auto& mesh = *occluder.mesh;
+        const auto modelViewProjection = viewProjection_ * occluder.model;
+
+        std::vector<glm::vec4> clip(mesh.positions.size());
+        for ( std::size_t i = 0; i < clip.size(); ++i ) {
+            clip[i] = modelViewProjection * glm::vec4( mesh.positions[i], 1.0f );
+        }
+
+        for ( std::size_t i = 0; i + 2 < mesh.indices.size(); i += 3 ) {
+            const std::array<glm::vec4, 3> vertices{clip[mesh.indices[i]], clip[mesh.indices[i + 1]], clip[mesh.indices[i + 2]]};
+            if ( outside( vertices[0], vertices[1], vertices[2] ) ) {
+                continue;
+            }
+
+            std::array<bool, 3> front{};
+            std::size_t frontCount = 0;
+            for ( std::size_t v = 0; v < 3; ++v ) {
+                front[v] = vertices[v].z >= -vertices[v].w;
+                frontCount += front[v] ? 1 : 0;
+            }
+
+            if ( frontCount == 3 ) {
+                addTriangle( vertices[0], vertices[1], vertices[2], triangles );
+                continue;
+            }
+            if ( frontCount == 0 ) {
+                continue;
+            }
+
+            // Découpage par le plan proche (Sutherland-Hodgman) : 3 ou 4 sommets, rastérisés en éventail.
+            std::array<glm::vec4, 4> polygon{};
+            std::size_t count = 0;
+            for ( std::size_t v = 0; v < 3; ++v ) {
+                const auto next = ( v + 1 ) % 3;
+
+                if ( front[v] ) {
+                    polygon[count++] = vertices[v];
+                }
+                if ( front[v] != front[next] ) {
+                    polygon[count++] = front[v] ? clipNear( vertices[v], vertices[next] ) : clipNear( vertices[next], vertices[v] );
+                }
+            }
+
+            for ( std::size_t v = 1; v + 1 < count; ++v ) {
+                addTriangle( polygon[0], polygon[v], polygon[v + 1], triangles );
+            }
+        }
+    }
+
+    void OcclusionBuffer::addTriangle( const glm::vec4& a, const glm::vec4& b, const glm::vec4& c,
+                                       std::vector<ScreenTriangle>& triangles ) const {
+        if ( a.w < MINIMUM_W || b.w < MINIMUM_W || c.w < MINIMUM_W ) {
+            return;
+        }
+
+        const auto size = glm::vec2(static_cast<float>(width_), static_cast<float>(height_));
+        const auto project = [&]( const glm::vec4& vertex ) noexcept {
+            const auto ndc = glm::vec3(vertex) / vertex.w;
+
+            return glm::vec3(( glm::vec2(ndc) * 0.5f + 0.5f ) * size, ndc.z * 0.5f + 0.5f);
+        };
+
+        auto p0 = project( a );
+        auto p1 = project( b );
+        auto p2 = project( c );
+
+        auto area = ( p1.x - p0.x ) * ( p2.y - p0.y ) - ( p1.y - p0.y ) * ( p2.x - p0.x );
+        if ( std::abs( area ) < 1e-6f ) {
+            return;
+        }
+        // Sens direct : les fonctions d’arêtes sont positives à l’intérieur, quelle que soit l’orientation d’origine.
+        if ( area < 0.0f ) {
+            std::swap( p1, p2 );
+            area = -area;
+        }
+
+        ScreenTriangle triangle{};
+
+        triangle.minX = std::max( 0, static_cast<int>(std::floor( std::min( {p0.x, p1.x, p2.x} ) )) );
+        triangle.maxX = std::min( static_cast<int>(width_) - 1, static_cast<int>(std::floor( std::max( {p0.x, p1.x, p2.x} ) )) );
+        triangle.minY = std::max( 0, static_cast<int>(std::floor( std::min( {p0.y, p1.y, p2.y} ) )) );
+        triangle.maxY = std::min( static_cast<int>(height_) - 1, static_cast<int>(std::floor( std::max( {p0.y, p1.y, p2.y} ) )) );
+        if ( triangle.minX > triangle.maxX || triangle.minY > triangle.maxY ) {
+            return;
+        }
+
+        // Arête de u vers v : E(x, y) = (u.y - v.y) x + (v.x - u.x) y + u.x v.y - u.y v.x, l’arête A fait face à p0.
+        const auto edge = []( const glm::vec3& u, const glm::vec3& v ) noexcept {
+            return glm::vec3(u.y - v.y, v.x - u.x, u.x * v.y - u.y * v.x);
+        };
+
+        triangle.edgeA = edge( p1, p2 );
+        triangle.edgeB = edge( p2, p0 );
+        triangle.edgeC = edge( p0, p1 );
+
+        // Coordonnées barycentriques : les fonctions d’arêtes divisées par l’aire.
+        triangle.depth = ( triangle.edgeA * p0.z + triangle.edgeB * p1.z + triangle.edgeC * p2.z ) / area;
+
+        triangles.push_back( triangle );
+    }
+
+    void OcclusionBuffer::rasterize( const ScreenTriangle& triangle, const int firstRow, const int lastRow ) noexcept {
+        const auto rowBegin = std::max( triangle.minY, firstRow );
+        const auto rowEnd = std::min( triangle.maxY, lastRow );
+        const auto columnBegin = triangle.minX / static_cast<int>(LANE_WIDTH) * static_cast<int>(LANE_WIDTH);
+
+        const auto zero = Lane::broadcast( 0.0f );
+        const auto columns = Lane::broadcast( static_cast<float>(columnBegin) ) + Lane::load( PIXEL_CENTERS.data() );
+        const auto laneWidth = static_cast<float>(LANE_WIDTH);
+
+        const auto aX = Lane::broadcast( triangle.edgeA.x );
+        const auto bX = Lane::broadcast( triangle.edgeB.x );
+        const auto cX = Lane::broadcast( triangle.edgeC.x );
+        const auto zX = Lane::broadcast( triangle.depth.x );
+
+        const auto aStep = Lane::broadcast( triangle.edgeA.x * laneWidth );
+        const auto bStep = Lane::broadcast( triangle.edgeB.x * laneWidth );
+        const auto cStep = Lane::broadcast( triangle.edgeC.x * laneWidth );
+        const auto zStep = Lane::broadcast( triangle.depth.x * laneWidth );
+
+        for ( auto y = rowBegin; y <= rowEnd; ++y ) {
+            const auto centerY = static_cast<float>(y) + 0.5f;
+
+            auto a = aX * columns + Lane::broadcast( triangle.edgeA.y * centerY + triangle.edgeA.z );
+            auto b = bX * columns + Lane::broadcast( triangle.edgeB.y * centerY + triangle.edgeB.z );
+            auto c = cX * columns + Lane::broadcast( triangle.edgeC.y * centerY + triangle.edgeC.z );
+            auto z = zX * columns + Lane::broadcast( triangle.depth.y * centerY + triangle.depth.z );
+
+            auto* row = depth_.data() + static_cast<std::size_t>(y) * width_;
+            for ( auto x = columnBegin; x <= triangle.maxX; x += static_cast<int>(LANE_WIDTH) ) {
+                const auto outsideMask = simd::less( simd::min( a, simd::min( b, c ) ), zero );
+                const auto previous = Lane::load( row + x );
+
+                simd::select( outsideMask, previous, simd::min( previous, z ) ).store( row + x );
+
+                a = a + aStep;
+                b = b + bStep;
+                c = c + cStep;
+                z = z + zStep;
+            }
+        }
+    }
+
+    void OcclusionBuffer::buildHierarchy() noexcept {
+        const auto* nearest = depth_.data();
+        const auto* farthest = depth_.data();
+        auto previousWidth = width_;
+        auto previousHeight = height_;
+
+        for ( auto& level : levels_ ) {
+            for ( std::size_t y = 0; y < level.height; ++y ) {
+                const auto y0 = 2 * y;
+                const auto y1 = std::min( y0 + 1, previousHeight - 1 );
+
+                for ( std::size_t x = 0; x < level.width; ++x ) {
+                    const auto x0 = 2 * x;
+                    const auto x1 = std::min( x0 + 1, previousWidth - 1 );
+
+                    const std::array<std::size_t, 4> texels{y0 * previousWidth + x0, y0 * previousWidth + x1,
+                                                            y1 * previousWidth + x0, y1 * previousWidth + x1};
+
+                    level.nearest[y * level.width + x] = std::min( {nearest[texels[0]], nearest[texels[1]], nearest[texels[2]], nearest[texels[3]]} );
+                    level.farthest[y * level.width + x] = std::max( {farthest[texels[0]], farthest[texels[1]], farthest[texels[2]], farthest[texels[3]]} );
+                }
+            }
+
+            nearest = level.nearest.data();
+            farthest = level.farthest.data();
+            previousWidth = level.width;
+            previousHeight = level.height;
+        }
+    }
+
+    OcclusionBuffer::Coverage OcclusionBuffer::test( const std::size_t level, const int minX, const int minY,
+                                                     const int maxX, const int maxY, const float nearest ) const noexcept {
+        const auto levelWidth = level == 0 ? width_ : levels_[level - 1].width;
+        const auto* nearestDepth = level == 0 ? depth_.data() : levels_[level - 1].nearest.data();
+        const auto* farthestDepth = level == 0 ? depth_.data() : levels_[level - 1].farthest.data();
+
+        auto behind = true;
+        auto front = true;
+
+        for ( auto y = minY; y <= maxY; ++y ) {
+            for ( auto x = minX; x <= maxX; ++x ) {
+                const auto texel = static_cast<std::size_t>(y) * levelWidth + static_cast<std::size_t>(x);
+
+                behind = behind && nearest > farthestDepth[texel];
+                front = front && nearest < nearestDepth[texel];
+
+                if ( !behind && !front ) {
+                    return Coverage::UNKNOWN;
+                }
+            }
+        }
+
+        return behind ? Coverage::OCCLUDED : Coverage::VISIBLE;
+    }
+
+    bool OcclusionBuffer::visible( const Bounds& box ) const noexcept {
+        auto minimum = glm::vec2(std::numeric_limits<float>::max());
+        auto maximum = glm::vec2(std::numeric_limits<float>::lowest());
+        auto nearest = std::numeric_limits<float>::max();
+
+        const auto size = glm::vec2(static_cast<float>(width_), static_cast<float>(height_));
+
+        // Les coins sont le coin minimal plus une combinaison des côtés : leur image aussi, sans produit par coin.
+        const auto size3 = box.max - box.min;
+        const auto origin = viewProjection_ * glm::vec4( box.min, 1.0f );
+        const auto sideX = viewProjection_[0] * size3.x;
+        const auto sideY = viewProjection_[1] * size3.y;
+        const auto sideZ = viewProjection_[2] * size3.z;
+
+        for ( auto corner = 0; corner < 8; ++corner ) {
+            auto clip = origin;
+            clip += ( corner & 1 ) != 0 ? sideX : glm::vec4(0.0f);
+            clip += ( corner & 2 ) != 0 ? sideY : glm::vec4(0.0f);
+            clip += ( corner & 4 ) != 0 ? sideZ : glm::vec4(0.0f);
+
+            // La boite traverse le plan de l’œil : sa projection n’est pas bornée.
+            if ( clip.w < MINIMUM_W || clip.z < -clip.w ) {
+                return true;
+            }
+
+            const auto ndc = glm::vec3(clip) / clip.w;
+            const auto screen = ( glm::vec2(ndc) * 0.5f + 0.5f ) * size;
+
+            minimum = glm::min( minimum, screen );
+            maximum = glm::max( maximum, screen );
+            nearest = std::min( nearest, ndc.z * 0.5f + 0.5f );
+        }
+
+        if ( maximum.x < 0.0f || maximum.y < 0.0f || minimum.x >= size.x || minimum.y >= size.y ) {
+            return true;
+        }
+
+        const auto minX = std::max( 0, static_cast<int>(std::floor( minimum.x )) );
+        const auto minY = std::max( 0, static_cast<int>(std::floor( minimum.y )) );
+        const auto maxX = std::min( static_cast<int>(width_) - 1, static_cast<int>(std::floor( maximum.x )) );
+        const auto maxY = std::min( static_cast<int>(height_) - 1, static_cast<int>(std::floor( maximum.y )) );
+
+        // Niveau le plus fin où la boite couvre au plus 4x4 texels.
+        std::size_t level = 0;
+        while ( level < levels_.size() && ( ( maxX >> level ) - ( minX >> level ) >= 4 || ( maxY >> level ) - ( minY >> level ) >= 4 ) ) {
+            ++level;
+        }
+
+        for ( auto remaining = 3; remaining > 0; --remaining ) {
+            const auto coverage = test( level, minX >> level, minY >> level, maxX >> level, maxY >> level, nearest );
+            if ( coverage != Coverage::UNKNOWN ) {
+                return coverage == Coverage::VISIBLE;
+            }
+            if ( level == 0 ) {
+                break;
+            }
+
+            --level;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,375 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <glengine/parallel.hpp>
+
+namespace gl_engine::utility {
+    namespace {
+        /**
+         * @brief Travail déposé dans la file du pool, exécuté par un ou plusieurs threads.
+         */
+        struct Job {
+            virtual ~Job() noexcept = default;
+
+            /// Appelée par un thread du pool. Un travail déjà terminé retourne aussitôt.
+            virtual void help() noexcept = 0;
+        };
+
+        /**
+         * @brief Threads créés une fois pour toute l’application et partagés par tous les gl_engine::utility::parallelFor.
+         *
+         * Un thread de moins que de cœurs : le thread appelant travaille toujours avec eux.
+         */
+        class WorkerPool final {
+        public:
+            static WorkerPool& instance() {
+                static WorkerPool pool{};
+                return pool;
+            }
+
+            WorkerPool( const WorkerPool& ) noexcept = delete;
+            WorkerPool( WorkerPool&& ) noexcept = delete;
+            WorkerPool& operator=( const WorkerPool& ) noexcept = delete;
+            WorkerPool& operator=( WorkerPool&& ) noexcept = delete;
+
+            ~WorkerPool() noexcept {
+                {
+                    const std::lock_guard<std::mutex> lock(mutex_);
+                    stopping_ = true;
+                }
+                wake_.notify_all();
+
+                for ( auto& worker : workers_ ) {
+                    worker.join();
+                }
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept {
+                return workers_.size();
+            }
+
+            /**
+             * @brief Propose le travail à count threads du pool.
+             */
+            void post( const std::shared_ptr<Job>& job, const std::size_t count ) {
+                {
+                    const std::lock_guard<std::mutex> lock(mutex_);
+                    jobs_.insert( jobs_.end(), count, job );
+                }
+
+                if ( count == 1 ) {
+                    wake_.notify_one();
+                }
+                else {
+                    wake_.notify_all();
+                }
+            }
+
+            /**
+             * @brief Retire les propositions encore en attente, le travail ayant été terminé sans elles.
+             */
+            void withdraw( const Job* const job ) noexcept {
+                const std::lock_guard<std::mutex> lock(mutex_);
+                jobs_.erase( std::remove_if( jobs_.begin(), jobs_.end(), [job]( const std::shared_ptr<Job>& queued ) noexcept {
+                    return queued.get() == job;
+                } ), jobs_.end() );
+            }
+
+        private:
+            std::mutex mutex_{};
+            std::condition_variable wake_{};
+            std::deque<std::shared_ptr<Job>> jobs_{};
+            bool stopping_ = false;
+
+            std::vector<std::thread> workers_{};
+
+            WorkerPool() {
+                const auto count = hardwareThreadCount() - 1;
+                workers_.reserve( count );
+
+                try {
+                    for ( unsigned i = 0; i < count; ++i ) {
+                        workers_.emplace_back( [this]() noexcept {
+                            work();
+                        } );
+                    }
+                }
+                catch ( ... ) {
+                    // Impossible de créer un thread : le pool garde ceux déjà créés.
+                }
+            }
+
+            void work() noexcept {
+                std::unique_lock<std::mutex> lock(mutex_);
+
+                while ( true ) {
+                    wake_.wait( lock, [this]() noexcept {
+                        return stopping_ || !jobs_.empty();
+                    } );
+
+                    if ( stopping_ ) {
+                        return;
+                    }
+
+                    const auto job = std::move( jobs_.front() );
+                    jobs_.pop_front();
+
+                    lock.unlock();
+                    job->help();
+                    lock.lock();
+                }
+            }
+        };
+
+        /**
+         * @brief Boucle partagée entre le thread appelant et les threads du pool venus l’aider.
+         */
+        class ForJob final : public Job {
+        public:
+            ForJob( const std::size_t taskCount, const std::function<void( std::size_t )>& task ) noexcept
+            : taskCount_(taskCount), task_(task) {}
+
+            void help() noexcept override {
+                {
+                    const std::lock_guard<std::mutex> lock(mutex_);
+                    ++helpers_;
+                }
+
+                run();
+
+                {
+                    const std::lock_guard<std::mutex> lock(mutex_);
+                    --helpers_;
+                }
+                done_.notify_all();
+            }
+
+            /**
+             * @brief Exécute des tâches sur le thread appelant, puis attend les threads du pool encore occupés.
+             */
+            void runAndWait() {
+                run();
+
+                std::unique_lock<std::mutex> lock(mutex_);
+                done_.wait( lock, [this]() noexcept {
+                    return helpers_ == 0;
+                } );
+
+                if ( error_ != nullptr ) {
+                    std::rethrow_exception( error_ );
+                }
+            }
+
+        private:
+            const std::size_t taskCount_;
+            // Note développeur : N’est lue que pour un indice valide, donc jamais après le retour de parallelFor.
+            const std::function<void( std::size_t )>& task_;
+
+            std::atomic<std::size_t> next_{0};
+
+            std::mutex mutex_{};
+            std::condition_variable done_{};
+            std::size_t helpers_ = 0;
+            std::exception_ptr error_ = nullptr;
+
+            void run() noexcept {
+                try {
+                    for ( auto i = next_.fetch_add( 1 ); i < taskCount_; i = next_.fetch_add( 1 ) ) {
+                        task_( i );
+                    }
+                }
+                catch ( ... ) {
+                    const std::lock_guard<std::mutex> lock(mutex_);
+                    if ( error_ == nullptr ) {
+                        error_ = std::current_exception();
+                    }
+
+                    // Les autres threads s’arrêtent à leur prochaine tâche.
+                    next_.store( taskCount_ );
+                }
+            }
+        };
+    }
+
+    unsigned hardwareThreadCount() noexcept {
+        return std::max( 1u, std::thread::hardware_concurrency() );
+    }
+
+    unsigned resolveThreadCount( const unsigned threadCount ) noexcept {
+        return threadCount == AUTOMATIC_THREAD_COUNT ? hardwareThreadCount() : threadCount;
+    }
+
+    void parallelFor( const std::size_t taskCount, const unsigned threadCount, const std::function<void( std::size_t )>& task ) {
+        const auto workerCount = static_cast<std::size_t>(std::min<std::size_t>( resolveThreadCount( threadCount ), taskCount ));
+
+        auto& pool = WorkerPool::instance();
+        const auto helperCount = workerCount > 1 ? std::min( workerCount - 1, pool.size() ) : 0;
+
+        if ( helperCount == 0 ) {
+            for ( std::size_t i = 0; i < taskCount; ++i ) {
+                task( i );
+            }
+
+            return;
+        }
+
+        const auto job = std::make_shared<ForJob>( taskCount, task );
+
+        try {
+            pool.post( job, helperCount );
+        }
+        catch ( ... ) {
+            // File du pool pleine : le thread appelant fait tout le travail.
+        }
+
+        // Note développeur : Seuls les threads du pool ayant déjà commencé sont attendus. Un appel imbriqué
+        // depuis une tâche ne bloque donc jamais, même si tous les threads du pool sont occupés.
+        job->runAndWait();
+        pool.withdraw( job.get() );
+    }
+
+
+    /**
+     * @brief Tâche proposée à un seul thread du pool, exécutée par celui qui la réclame en premier.
+     */
+    class AsyncTask::State final : public Job {
+    public:
+        explicit State( std::function<void()> task ) noexcept
+        : task_(std::move(task)) {}
+
+        void help() noexcept override {
+            if ( !claimed_.exchange( true ) ) {
+                execute();
+            }
+        }
+
+        /**
+         * @brief Exécute la tâche si aucun thread du pool ne l’a réclamée, sinon attend qu’il la termine.
+         */
+        void wait() {
+            if ( !claimed_.exchange( true ) ) {
+                WorkerPool::instance().withdraw( this );
+                execute();
+            }
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            finished_.wait( lock, [this]() noexcept {
+                return done_;
+            } );
+
+            if ( error_ != nullptr ) {
+                std::rethrow_exception( error_ );
+            }
+        }
+
+    private:
+        std::function<void()> task_;
+        std::atomic<bool> claimed_{false};
+
+        std::mutex mutex_{};
+        std::condition_variable finished_{};
+        bool done_ = false;
+        std::exception_ptr error_ = nullptr;
+
+        void execute() noexcept {
+            std::exception_ptr error = nullptr;
+
+            try {
+                task_();
+            }
+            catch ( ... ) {
+                error = std::current_exception();
+            }
+
+            {
+                const std::lock_guard<std::mutex> lock(mutex_);
+                error_ = std::move( error );
+                done_ = true;
+            }
+            finished_.notify_all();
+        }
+    };
+
+    AsyncTask::AsyncTask( std::shared_ptr<State> state ) noexcept
+    : state_(std::move(state)) {}
+
+    AsyncTask& AsyncTask::operator=( AsyncTask&& other ) noexcept {
+        if ( this != &other ) {
+            if ( valid() ) {
+                try {
+                    wait();
+                }
+                catch ( ... ) {
+                    // Comme à la destruction, l’exception d’une tâche jamais attendue est perdue.
+                }
+            }
+
+            state_ = std::move( other.state_ );
+        }
+
+        return *this;
+    }
+
+    AsyncTask::~AsyncTask() noexcept {
+        if ( valid() ) {
+            try {
+                wait();
+            }
+            catch ( ... ) {
+                // Une exception ne peut pas sortir d’un destructeur, celle de la tâche est perdue.
+            }
+        }
+    }
+
+    bool AsyncTask::valid() const noexcept {
+        return state_ != nullptr;
+    }
+
+    void AsyncTask::wait() {
+        const auto state = std::move( state_ );
+        state_ = nullptr;
+
+        state->wait();
+    }
+
+    AsyncTask runAsync( std::function<void()> task ) {
+        auto state = std::make_shared<AsyncTask::State>( std::move( task ) );
+
+        auto& pool = WorkerPool::instance();
+        if ( pool.size() > 0 ) {
+            try {
+                pool.post( state, 1 );
+            }
+            catch ( ... ) {
+                // File du pool pleine : la tâche sera exécutée par AsyncTask::wait().
+            }
+        }
+
+        return AsyncTask{std::move( state )};
+    }
+}
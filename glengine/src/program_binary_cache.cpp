@@ -0,0 +1,221 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <glengine/hash.hpp>
+#include <glengine/program_binary_cache.hpp>
+
+namespace gl_engine {
+    namespace {
+        constexpr char MAGIC[8] = {'G', 'L', 'P', 'R', 'O', 'G', '\0', '\0'};
+
+        // Note développeur : Comme pour gl_engine::MeshCache, un fichier d’une machine de boutisme différent est ignoré.
+        constexpr std::uint32_t ENDIANNESS_MARK = 0x01020304;
+
+        // Note développeur : Constantes d’OpenGL 4.1, absentes du chargeur glad du moteur.
+        constexpr GLenum PROGRAM_BINARY_RETRIEVABLE_HINT = 0x8257;
+        constexpr GLenum NUM_PROGRAM_BINARY_FORMATS = 0x87FE;
+        constexpr GLenum PROGRAM_BINARY_FORMATS = 0x87FF;
+
+        /**
+         * @brief En-tête du fichier, suivi du binaire.
+         */
+        struct Header {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t byteOrder;
+
+            std::uint64_t key;
+            std::uint64_t driver;
+
+            std::uint32_t format;
+            std::uint32_t size;
+            std::uint64_t binaryHash;
+        };
+
+        static_assert( sizeof( Header ) == 48, "L’en-tête du cache ne doit pas contenir de remplissage." );
+
+        std::string_view glString( const GLenum name ) noexcept {
+            const auto* const text = reinterpret_cast<const char*>(glGetString( name ));
+
+            return text == nullptr ? std::string_view{} : std::string_view{text};
+        }
+    }
+
+    ProgramBinaryCache::ProgramBinaryCache( std::filesystem::path directory )
+    : directory_(std::move(directory)) {
+        driver_ = utility::fnv1a( "GL_Engine program binary" );
+        for ( const auto name : {GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION} ) {
+            driver_ = utility::combine( driver_, utility::fnv1a( glString( name ) ) );
+        }
+
+        if ( open_gl::hasProgramBinary() ) {
+            GLint formatCount = 0;
+            glGetIntegerv( NUM_PROGRAM_BINARY_FORMATS, &formatCount );
+
+            std::vector<GLint> formats(static_cast<std::size_t>(std::max( formatCount, 0 )));
+            if ( !formats.empty() ) {
+                glGetIntegerv( PROGRAM_BINARY_FORMATS, formats.data() );
+            }
+
+            formats_.assign( formats.begin(), formats.end() );
+        }
+    }
+
+    std::uint64_t ProgramBinaryCache::key( const std::initializer_list<std::string_view> sources ) const noexcept {
+        auto hash = utility::combine( driver_, VERSION );
+
+        // Chaque étage est haché séparément : déplacer du code d’un étage à l’autre change la clé.
+        for ( const auto source : sources ) {
+            hash = utility::combine( hash, utility::hashBytes( source.data(), source.size() ) );
+        }
+
+        return utility::combine( hash, sources.size() );
+    }
+
+    std::filesystem::path ProgramBinaryCache::cachePath( const std::uint64_t key ) const {
+        char name[17] = {};
+        std::snprintf( name, sizeof( name ), "%016llx", static_cast<unsigned long long>(key) );
+
+        auto path = directory_ / name;
+        path += EXTENSION;
+
+        return path;
+    }
+
+    void ProgramBinaryCache::prepare( const Id program ) const noexcept {
+        if ( enabled() ) {
+            open_gl::programParameter( program, PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE );
+        }
+    }
+
+    bool ProgramBinaryCache::load( const Id program, const std::uint64_t key ) const {
+        if ( !enabled() ) {
+            return false;
+        }
+
+        const auto path = cachePath( key );
+
+        std::error_code error{};
+        if ( !std::filesystem::is_regular_file( path, error ) || error ) {
+            return false;
+        }
+
+        std::optional<MappedFile> file{};
+        try {
+            file.emplace( Path(path) );
+        }
+        catch ( const Exception& ) {
+            // Fichier vide ou illisible : le programme sera simplement compilé.
+            return false;
+        }
+
+        Header header{};
+        if ( file->size() < sizeof( Header ) ) {
+            return false;
+        }
+        std::memcpy( &header, file->data(), sizeof( Header ) );
+
+        const auto* const binary = file->data() + sizeof( Header );
+        if ( std::memcmp( header.magic, MAGIC, sizeof( MAGIC ) ) != 0
+             || header.version != VERSION
+             || header.byteOrder != ENDIANNESS_MARK
+             || header.key != key
+             || header.driver != driver_
+             || std::find( formats_.begin(), formats_.end(), header.format ) == formats_.end()
+             || header.size != file->size() - sizeof( Header )
+             || header.binaryHash != utility::hashBytes( binary, header.size ) ) {
+            return false;
+        }
+
+        // Le pilote peut encore refuser un binaire d’un format connu (version interne), l’édition des liens le dit.
+        open_gl::programBinary( program, header.format, binary, static_cast<Size>(header.size) );
+
+        GLint linked = GL_FALSE;
+        glGetProgramiv( program, GL_LINK_STATUS, &linked );
+
+        return linked == GL_TRUE;
+    }
+
+    void ProgramBinaryCache::store( const Id program, const std::uint64_t key ) const {
+        if ( !enabled() ) {
+            return;
+        }
+
+        GLenum format = 0;
+        const auto binary = open_gl::getProgramBinary( program, format );
+        if ( binary.empty() ) {
+            return;
+        }
+
+        Header header{};
+        std::memcpy( header.magic, MAGIC, sizeof( MAGIC ) );
+        header.version = VERSION;
+        header.byteOrder = ENDIANNESS_MARK;
+        header.key = key;
+        header.driver = driver_;
+        header.format = format;
+        header.size = static_cast<std::uint32_t>(binary.size());
+        header.binaryHash = utility::hashBytes( binary.data(), binary.size() );
+
+        const auto path = cachePath( key );
+
+        std::error_code error{};
+        std::filesystem::create_directories( directory_, error );
+        if ( error ) {
+            throw utility::ErrorWritingFile(directory_.string());
+        }
+
+        auto temporaryPath = path;
+        temporaryPath += ".tmp";
+
+        {
+            std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+            if ( !stream.is_open() ) {
+                throw utility::ErrorWritingFile(temporaryPath.string());
+            }
+
+            stream.write( reinterpret_cast<const char*>(&header), sizeof( Header ) );
+            stream.write( binary.data(), static_cast<std::streamsize>(binary.size()) );
+
+            stream.close();
+            if ( !stream ) {
+                std::filesystem::remove( temporaryPath, error );
+                throw utility::ErrorWritingFile(temporaryPath.string());
+            }
+        }
+
+        // Le renommage remplace atomiquement un ancien fichier, un autre processus ne lit jamais un binaire partiel.
+        std::filesystem::rename( temporaryPath, path, error );
+        if ( error ) {
+            std::filesystem::remove( temporaryPath, error );
+            throw utility::ErrorWritingFile(path.string());
+        }
+    }
+}
@@ -0,0 +1,477 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+#include <glengine/gl_state.hpp>
+#include <glengine/render_queue.hpp>
+#include <glengine/vertex_format.hpp>
+
+namespace gl_engine {
+    namespace {
+        /// Cible des commandes indirectes (OpenGL 4.0), absente du chargeur glad OpenGL 3.3 du moteur.
+        constexpr GLenum DRAW_INDIRECT_BUFFER = 0x8F3F;
+
+        /// Alignement des instances dans le buffer d’envoi, celui d’un vec4.
+        constexpr std::size_t INSTANCE_ALIGNMENT = 16;
+
+        /// Taille minimale d’une région du buffer d’envoi : 800 instances.
+        constexpr std::size_t MINIMUM_STREAM_SIZE = std::size_t{64} << 10;
+
+        constexpr std::uint64_t mask( const unsigned bits ) noexcept {
+            return ( std::uint64_t{1} << bits ) - 1;
+        }
+
+        /**
+         * @brief Retourne les 24 bits de poids fort de l’écriture d’un flottant positif, croissants avec lui.
+         */
+        std::uint64_t depthBits( const float depth ) noexcept {
+            const auto positive = depth > 0.0f ? depth : 0.0f;
+
+            std::uint32_t bits = 0;
+            std::memcpy( &bits, &positive, sizeof( bits ) );
+
+            // Bit de signe nul : les 31 bits restants sont réduits à DrawKey::DEPTH_BITS.
+            return bits >> ( 31 - DrawKey::DEPTH_BITS );
+        }
+
+        template<typename Key>
+        std::uint32_t number( std::unordered_map<Key, std::uint32_t>& table, const Key& key ) {
+            return table.try_emplace( key, static_cast<std::uint32_t>(table.size()) ).first->second;
+        }
+    }
+
+    std::uint64_t DrawKey::make( const RenderPass pass, const std::uint32_t program, const std::uint32_t material,
+                                 const std::uint32_t vertexArray, const float depth ) noexcept {
+        const auto state = ( ( program & mask( PROGRAM_BITS ) ) << ( MATERIAL_BITS + VERTEX_ARRAY_BITS ) )
+                           | ( ( material & mask( MATERIAL_BITS ) ) << VERTEX_ARRAY_BITS )
+                           | ( vertexArray & mask( VERTEX_ARRAY_BITS ) );
+        const auto head = static_cast<std::uint64_t>(pass) << ( 64 - PASS_BITS );
+
+        if ( pass == RenderPass::BLENDED || pass == RenderPass::OVERLAY ) {
+            const auto backToFront = mask( DEPTH_BITS ) - depthBits( depth );
+            return head | ( backToFront << ( PROGRAM_BITS + MATERIAL_BITS + VERTEX_ARRAY_BITS ) ) | state;
+        }
+
+        return head | ( state << DEPTH_BITS ) | depthBits( depth );
+    }
+
+    void RenderQueue::clear() noexcept {
+        items_.clear();
+        entries_.clear();
+        ++frame_;
+
+        // Note développeur : Un numéro trop grand pour son champ de la clé serait tronqué et confondu avec un autre.
+        // Une table pleine est donc vidée au début de l’image, les numéros sont redonnés aux seuls objets encore soumis.
+        // Le matériau nul prend le numéro 0, les autres sont décalés d’un.
+        if ( materials_.size() >= mask( DrawKey::MATERIAL_BITS ) ) {
+            materials_.clear();
+        }
+        if ( vertexArrays_.size() > mask( DrawKey::VERTEX_ARRAY_BITS ) ) {
+            vertexArrays_.clear();
+            instancedVertexArrays_.clear();
+        }
+        if ( programs_.size() > mask( DrawKey::PROGRAM_BITS ) ) {
+            programs_.clear();
+        }
+
+        statistics_ = RenderStatistics{};
+    }
+
+    RenderQueue::ProgramSlot& RenderQueue::programSlot( const Id program ) {
+        const auto [slot, inserted] = programs_.try_emplace( program );
+        if ( inserted ) {
+            slot->second.number = static_cast<std::uint32_t>(programs_.size() - 1);
+        }
+
+        return slot->second;
+    }
+
+    void RenderQueue::submit( const DrawItem& item ) {
+        const auto program = programSlot( item.program ).number;
+        const auto material = item.material != nullptr ? number( materials_, item.material ) + 1 : 0;
+        const auto vertexArray = number( vertexArrays_, item.vertexArray );
+
+        entries_.push_back( {DrawKey::make( item.pass, program, material, vertexArray, item.depth ),
+                             static_cast<std::uint32_t>(items_.size())} );
+
+        try {
+            items_.push_back( item );
+        }
+        catch ( ... ) {
+            entries_.pop_back();
+            throw;
+        }
+    }
+
+    void RenderQueue::sort() {
+        const auto start = std::chrono::steady_clock::now();
+
+        scratch_.resize( entries_.size() );
+
+        // Tri par base, octet de poids faible d’abord. Chaque passe est stable, le tri complet l’est donc aussi.
+        for ( unsigned shift = 0; shift < 64; shift += 8 ) {
+            std::array<std::size_t, 256> counts{};
+            for ( const auto& entry : entries_ ) {
+                ++counts[( entry.key >> shift ) & 0xff];
+            }
+
+            // Octet identique pour toutes les clés : la passe ne changerait rien.
+            if ( entries_.empty() || counts[( entries_.front().key >> shift ) & 0xff] == entries_.size() ) {
+                continue;
+            }
+
+            std::size_t offset = 0;
+            for ( auto& count : counts ) {
+                offset += std::exchange( count, offset );
+            }
+
+            for ( const auto& entry : entries_ ) {
+                scratch_[counts[( entry.key >> shift ) & 0xff]++] = entry;
+            }
+            entries_.swap( scratch_ );
+        }
+
+        statistics_.sortMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    RenderQueue::ProgramSlot& RenderQueue::resolvedProgramSlot( const Id program ) {
+        auto& slot = programSlot( program );
+        if ( !slot.resolved ) {
+            slot.model = glGetUniformLocation( program, "model" );
+            slot.view = glGetUniformLocation( program, "view" );
+            slot.projection = glGetUniformLocation( program, "projection" );
+            slot.color = glGetUniformLocation( program, "color" );
+            slot.positionOffset = glGetUniformLocation( program, VertexFormat::POSITION_OFFSET_UNIFORM.data() );
+            slot.positionScale = glGetUniformLocation( program, VertexFormat::POSITION_SCALE_UNIFORM.data() );
+            slot.instanced = glGetAttribLocation( program, "instanceModel" ) == static_cast<GLint>(INSTANCE_MODEL_LOCATION);
+
+            // L’association d’un bloc à son point de liaison est conservée par le programme : une fois suffit.
+            slot.cameraBlock = open_gl::bindUniformBlock<CameraBlock>( program );
+            open_gl::bindUniformBlock<FrameBlock>( program );
+
+            slot.resolved = true;
+        }
+
+        return slot;
+    }
+
+    void RenderQueue::batch() {
+        batches_.clear();
+        instances_.clear();
+        commands_.clear();
+
+        // Un programme détruit peut avoir cédé son identifiant à un autre : les emplacements sont de nouveau lus.
+        if ( const auto deletions = open_gl::programDeletions(); deletions != programDeletions_ ) {
+            for ( auto& [program, slot] : programs_ ) {
+                slot = ProgramSlot{slot.number};
+            }
+            programDeletions_ = deletions;
+        }
+
+        Id currentProgram = 0;
+        const ProgramSlot* slot = nullptr;
+
+        for ( std::size_t first = 0; first < entries_.size(); ) {
+            const auto& item = items_[entries_[first].item];
+
+            if ( item.program != currentProgram || slot == nullptr ) {
+                slot = &resolvedProgramSlot( item.program );
+                currentProgram = item.program;
+            }
+
+            if ( !slot->instanced ) {
+                batches_.push_back( {static_cast<std::uint32_t>(first), 1, NO_INSTANCE} );
+                ++first;
+                continue;
+            }
+
+            // Même passe et même clé d’état : le tri a rendu voisins tous les éléments dessinables ensemble.
+            auto last = first + 1;
+            while ( last < entries_.size() ) {
+                const auto& next = items_[entries_[last].item];
+                if ( next.pass != item.pass || next.program != item.program || next.vertexArray != item.vertexArray
+                     || next.material != item.material || next.indexType != item.indexType ) {
+                    break;
+                }
+                ++last;
+            }
+
+            const auto indexSize = item.indexType == GL_UNSIGNED_SHORT ? sizeof( std::uint16_t ) : sizeof( std::uint32_t );
+
+            Batch batch{static_cast<std::uint32_t>(first), static_cast<std::uint32_t>(last - first),
+                        static_cast<std::uint32_t>(instances_.size()), static_cast<std::uint32_t>(commands_.size()), 0};
+
+            // Une commande par suite d’éléments de même plage : les copies d’un maillage deviennent ses instances.
+            for ( ; first < last; ++first ) {
+                const auto& instance = items_[entries_[first].item];
+                const auto firstIndex = static_cast<std::uint32_t>(instance.indexOffset / indexSize);
+
+                auto* const command = batch.commandCount > 0 ? &commands_.back() : nullptr;
+                if ( command != nullptr && command->firstIndex == firstIndex && command->count == instance.indexCount
+                     && command->baseVertex == instance.baseVertex ) {
+                    ++command->instanceCount;
+                }
+                else {
+                    commands_.push_back( {instance.indexCount, 1, firstIndex, instance.baseVertex,
+                                          static_cast<std::uint32_t>(instances_.size())} );
+                    ++batch.commandCount;
+                }
+
+                instances_.push_back( {instance.model, instance.color} );
+            }
+
+            batches_.push_back( batch );
+        }
+    }
+
+    void RenderQueue::upload() {
+        if ( instances_.empty() ) {
+            return;
+        }
+
+        const auto instanceBytes = instances_.size() * sizeof( Instance );
+        const auto commandBytes = open_gl::hasMultiDrawIndirect() ? commands_.size() * sizeof( DrawElementsIndirectCommand ) : 0;
+        const auto required = instanceBytes + commandBytes + INSTANCE_ALIGNMENT;
+
+        if ( !stream_.has_value() || stream_->regionSize() < required ) {
+            stream_.emplace( std::max( required + required / 2, MINIMUM_STREAM_SIZE ) );
+        }
+
+        stream_->beginFrame();
+
+        const auto instances = stream_->allocate( instanceBytes, INSTANCE_ALIGNMENT );
+        std::memcpy( instances.data, instances_.data(), instanceBytes );
+        instanceOffset_ = instances.offset;
+
+        if ( commandBytes > 0 ) {
+            const auto commands = stream_->allocate( commandBytes, alignof( DrawElementsIndirectCommand ) );
+            std::memcpy( commands.data, commands_.data(), commandBytes );
+            commandOffset_ = commands.offset;
+        }
+
+        stream_->flush();
+    }
+
+    void RenderQueue::bindInstances( const Id vertexArray, const std::uint32_t instance ) {
+        open_gl::bindBuffer( GL_ARRAY_BUFFER, stream_->buffer() );
+
+        // Les attributs activés et leurs diviseurs font partie du VAO : une fois par image suffit.
+        auto& frame = instancedVertexArrays_[vertexArray];
+        if ( frame != frame_ ) {
+            for ( GLuint column = 0; column < 4; ++column ) {
+                glEnableVertexAttribArray( INSTANCE_MODEL_LOCATION + column );
+                glVertexAttribDivisor( INSTANCE_MODEL_LOCATION + column, 1 );
+            }
+            glEnableVertexAttribArray( INSTANCE_COLOR_LOCATION );
+            glVertexAttribDivisor( INSTANCE_COLOR_LOCATION, 1 );
+
+            frame = frame_;
+        }
+
+        // Note développeur : OpenGL 3.3 n’a pas de glDrawElementsInstancedBaseInstance, les pointeurs sont
+        // donc décalés jusqu’à la première instance du lot.
+        const auto base = instanceOffset_ + std::size_t{instance} * sizeof( Instance );
+        for ( GLuint column = 0; column < 4; ++column ) {
+            glVertexAttribPointer( INSTANCE_MODEL_LOCATION + column, 4, GL_FLOAT, GL_FALSE, sizeof( Instance ),
+                                   reinterpret_cast<const void*>(base + offsetof( Instance, model ) + column * sizeof( glm::vec4 )) );
+        }
+        glVertexAttribPointer( INSTANCE_COLOR_LOCATION, 4, GL_FLOAT, GL_FALSE, sizeof( Instance ),
+                               reinterpret_cast<const void*>(base + offsetof( Instance, color )) );
+    }
+
+    void RenderQueue::updateBlocks( const RenderView& view ) {
+        if ( !cameraBlock_.has_value() ) {
+            frameBlock_.emplace( FrameBlock::Layout::SIZE );
+            cameraBlock_.emplace( CameraBlock::Layout::SIZE );
+            previousTime_ = view.time;
+        }
+
+        const FrameBlock frame{view.time, view.time - previousTime_, static_cast<std::uint32_t>(frame_)};
+        const CameraBlock camera{view.view, view.projection, view.projection * view.view, view.eye};
+        previousTime_ = view.time;
+
+        statistics_.uniformBlockUpdates += frameBlock_->update( frame ) ? 1 : 0;
+        statistics_.uniformBlockUpdates += cameraBlock_->update( camera ) ? 1 : 0;
+
+        frameBlock_->bind( FrameBlock::BINDING );
+        cameraBlock_->bind( CameraBlock::BINDING );
+    }
+
+    void RenderQueue::execute( const RenderView& view ) {
+        auto& statistics = statistics_;
+        const auto sortMilliseconds = statistics.sortMilliseconds;
+        statistics = RenderStatistics{};
+        statistics.sortMilliseconds = sortMilliseconds;
+
+        updateBlocks( view );
+        batch();
+        upload();
+
+        const auto multiDraw = open_gl::hasMultiDrawIndirect();
+
+        std::array<const Texture*, TEXTURE_SLOT_COUNT> boundTextures{};
+        boundTextures.fill( nullptr );
+
+        std::size_t currentPass = static_cast<std::size_t>(-1);
+        Id currentProgram = 0;
+        Id currentVertexArray = 0;
+        const Material* currentMaterial = nullptr;
+        bool materialBound = false;
+        bool decoderChanged = true;
+        const ProgramSlot* slot = nullptr;
+
+        for ( const auto& batch : batches_ ) {
+            const auto& item = items_[entries_[batch.first].item];
+
+            const auto pass = static_cast<std::size_t>(item.pass);
+            if ( pass != currentPass ) {
+                const auto blended = item.pass == RenderPass::BLENDED || item.pass == RenderPass::OVERLAY;
+                if ( blended ) {
+                    open_gl::enable( GL_BLEND );
+                    open_gl::blendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+                    open_gl::depthMask( false );
+                }
+                else {
+                    open_gl::disable( GL_BLEND );
+                    open_gl::depthMask( true );
+                }
+
+                currentPass = pass;
+                ++statistics.passChanges;
+            }
+
+            if ( item.program != currentProgram || slot == nullptr ) {
+                auto& programSlot = this->programSlot( item.program );
+
+                open_gl::useProgram( item.program );
+                currentProgram = item.program;
+                slot = &programSlot;
+                ++statistics.programChanges;
+                decoderChanged = true;
+
+                // Un programme sans bloc 'Camera' reçoit 'view' et 'projection' une seule fois par image.
+                if ( !programSlot.cameraBlock && programSlot.frame != frame_ ) {
+                    programSlot.frame = frame_;
+                    glUniformMatrix4fv( slot->view, 1, GL_FALSE, &view.view[0][0] );
+                    glUniformMatrix4fv( slot->projection, 1, GL_FALSE, &view.projection[0][0] );
+                }
+            }
+
+            if ( item.vertexArray != currentVertexArray ) {
+                open_gl::bindVertexArray( item.vertexArray );
+                currentVertexArray = item.vertexArray;
+                ++statistics.vertexArrayChanges;
+                decoderChanged = true;
+            }
+
+            // Les positions quantifiées sont relatives à la boite du maillage : une fois par VAO et par programme.
+            if ( decoderChanged && slot->positionOffset >= 0 ) {
+                glUniform3fv( slot->positionOffset, 1, &item.positionOffset[0] );
+                glUniform3fv( slot->positionScale, 1, &item.positionScale[0] );
+            }
+            decoderChanged = false;
+
+            // Un élément sans matériau, ou un emplacement sans texture, ne doit pas échantillonner la texture du matériau précédent.
+            if ( item.material != currentMaterial || !materialBound ) {
+                for ( std::size_t unit = 0; unit < TEXTURE_SLOT_COUNT; ++unit ) {
+                    const auto* const texture = item.material != nullptr ? item.material->textures[unit].get() : nullptr;
+                    if ( texture == nullptr ) {
+                        // Le cache d’états évite l’appel si aucune texture n’était liée à l’unité.
+                        open_gl::bindTexture( static_cast<unsigned>(unit), GL_TEXTURE_2D, 0 );
+                        boundTextures[unit] = nullptr;
+                        continue;
+                    }
+                    if ( texture == boundTextures[unit] ) {
+                        continue;
+                    }
+
+                    item.material->textures[unit]->bind( static_cast<unsigned>(unit) );
+                    boundTextures[unit] = texture;
+                    ++statistics.textureBinds;
+                }
+
+                currentMaterial = item.material;
+                materialBound = true;
+                ++statistics.materialChanges;
+            }
+
+            if ( batch.instance == NO_INSTANCE ) {
+                glUniformMatrix4fv( slot->model, 1, GL_FALSE, &item.model[0][0] );
+                if ( slot->color >= 0 ) {
+                    glUniform4fv( slot->color, 1, &item.color[0] );
+                }
+
+                const auto* const indices = reinterpret_cast<const void*>(item.indexOffset);
+                if ( item.baseVertex != 0 ) {
+                    glDrawElementsBaseVertex( GL_TRIANGLES, static_cast<GLsizei>(item.indexCount), item.indexType, indices, item.baseVertex );
+                }
+                else {
+                    glDrawElements( GL_TRIANGLES, static_cast<GLsizei>(item.indexCount), item.indexType, indices );
+                }
+                ++statistics.drawCount;
+
+                continue;
+            }
+
+            statistics.instanceCount += batch.count;
+
+            if ( multiDraw && batch.commandCount > 1 ) {
+                // Chaque commande lit ses instances à partir de son baseInstance : les pointeurs restent sur la première de l’image.
+                bindInstances( item.vertexArray, 0 );
+                open_gl::bindBuffer( DRAW_INDIRECT_BUFFER, stream_->buffer() );
+                open_gl::multiDrawElementsIndirect( GL_TRIANGLES, item.indexType,
+                                                    reinterpret_cast<const void*>(commandOffset_ + std::size_t{batch.command} * sizeof( DrawElementsIndirectCommand )),
+                                                    static_cast<GLsizei>(batch.commandCount), 0 );
+
+                ++statistics.multiDrawCount;
+                statistics.commandCount += batch.commandCount;
+                ++statistics.drawCount;
+
+                continue;
+            }
+
+            const auto indexSize = item.indexType == GL_UNSIGNED_SHORT ? sizeof( std::uint16_t ) : sizeof( std::uint32_t );
+            for ( std::uint32_t i = 0; i < batch.commandCount; ++i ) {
+                const auto& command = commands_[batch.command + i];
+
+                bindInstances( item.vertexArray, command.baseInstance );
+                glDrawElementsInstancedBaseVertex( GL_TRIANGLES, static_cast<GLsizei>(command.count), item.indexType,
+                                                   reinterpret_cast<const void*>(std::size_t{command.firstIndex} * indexSize),
+                                                   static_cast<GLsizei>(command.instanceCount), command.baseVertex );
+
+                ++statistics.instancedDrawCount;
+                ++statistics.drawCount;
+            }
+        }
+
+        if ( !instances_.empty() ) {
+            stream_->endFrame();
+        }
+
+        open_gl::disable( GL_BLEND );
+        open_gl::depthMask( true );
+        open_gl::bindVertexArray( 0 );
+    }
+}
@@ -17,6 +17,15 @@
 
 #include <glad/glad.h>
 
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#ifndef NDEBUG
+#include <iostream>
+#endif
+
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
@@ -29,6 +38,10 @@
 
 
 namespace gl_engine {
+    namespace {
+        /// Suffixe du nom sous lequel OpenGL liste un tableau d’uniformes.
+        constexpr std::string_view FIRST_ELEMENT = "[0]";
+    }
 
 // Constructor
     ShaderProgram::ShaderProgram() {
@@ -37,32 +50,86 @@ namespace gl_engine {
         // Vérifier création prgm
     }
 
+    // Note développeur : Les shaders sont attachés par attachShader, qui édite les liens dès que le programme est complet.
+    // Les copier ne coûte qu’un compteur de références, voir gl_engine::AbstractShader.
+    // Les constructeurs délèguent au constructeur par défaut : si l’édition des liens lance une exception,
+    // l’objet est déjà construit et son destructeur supprime le programme.
     ShaderProgram::ShaderProgram( VertexShader vertex, FragmentShader fragment, GeometryShader geometry )
-    : vertex_(std::move(vertex)), fragment_(std::move(fragment)), geometry_(std::move(geometry)) {
-        compile();
+    : ShaderProgram() {
+        attachShader( std::move(vertex), std::move(fragment), std::move(geometry) );
     }
 
     ShaderProgram::ShaderProgram( VertexShader vertex )
-    : vertex_(std::move(vertex)) {}
+    : ShaderProgram() {
+        attachShader( std::move(vertex) );
+    }
 
     ShaderProgram::ShaderProgram( FragmentShader fragment )
-    : fragment_(std::move(fragment)) {}
+    : ShaderProgram() {
+        attachShader( std::move(fragment) );
+    }
 
     ShaderProgram::ShaderProgram( GeometryShader geometry )
-    : geometry_(std::move(geometry)) {}
+    : ShaderProgram() {
+        attachShader( std::move(geometry) );
+    }
 
     ShaderProgram::ShaderProgram( VertexShader vertex, FragmentShader fragment )
-    : vertex_(std::move(vertex)), fragment_(std::move(fragment)) {
-        compile();
+    : ShaderProgram() {
+        attachShader( std::move(vertex) );
+        attachShader( std::move(fragment) );
+    }
+
+    ShaderProgram::ShaderProgram( const Content& vertex, const Content& fragment, const ProgramBinaryCache& cache )
+    : ShaderProgram() {
+        compile( vertex, fragment, nullptr, cache );
+    }
+
+    ShaderProgram::ShaderProgram( const Content& vertex, const Content& fragment, const Content& geometry,
+                                  const ProgramBinaryCache& cache )
+    : ShaderProgram() {
+        compile( vertex, fragment, &geometry, cache );
+    }
+
+    ShaderProgram::ShaderProgram( const Id linked, const bool fromCache )
+    : id_(linked), compiled_(true), fromCache_(fromCache) {
+        reflectUniforms();
+    }
+
+
+    ShaderProgram::ShaderProgram( ShaderProgram&& other ) noexcept
+    : id_(std::exchange(other.id_, 0)), compiled_(std::exchange(other.compiled_, false)), fromCache_(other.fromCache_),
+      vertex_(std::move(other.vertex_)), fragment_(std::move(other.fragment_)), geometry_(std::move(other.geometry_)),
+      uniformLocation_(std::move(other.uniformLocation_)), uniforms_(std::move(other.uniforms_)),
+      uniformIds_(std::move(other.uniformIds_)) {}
+
+    ShaderProgram& ShaderProgram::operator=( ShaderProgram&& other ) noexcept {
+        if ( &other != this ) {
+            if ( id_ != 0 ) {
+                open_gl::deleteProgram( id_ );
+            }
+
+            id_ = std::exchange( other.id_, 0 );
+            compiled_ = std::exchange( other.compiled_, false );
+            fromCache_ = other.fromCache_;
+            vertex_ = std::move( other.vertex_ );
+            fragment_ = std::move( other.fragment_ );
+            geometry_ = std::move( other.geometry_ );
+            uniformLocation_ = std::move( other.uniformLocation_ );
+            uniforms_ = std::move( other.uniforms_ );
+            uniformIds_ = std::move( other.uniformIds_ );
+        }
+
+        return *this;
     }
 
 
 // Destructor
     ShaderProgram::~ShaderProgram() noexcept {
-        // https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glUseProgram.xhtml
-        // TODO Vérifier erreur GL
-        open_gl::deleteProgram( id_ );
-        // TODO Vérifier erreur GL
+        // Note développeur : Un programme déplacé n’a plus d’identifiant, il ne doit pas détruire celui qu’il a cédé.
+        if ( id_ != 0 ) {
+            open_gl::deleteProgram( id_ );
+        }
     }
 
 // Utilities
@@ -175,6 +242,8 @@ namespace gl_engine {
         // Vérifier erreurs finales
 
         uniformLocation_.clear();
+        uniforms_.clear();
+        uniformIds_.clear();
     }
 
     void ShaderProgram::detachShader( Shader_t type) {
@@ -219,10 +288,11 @@ namespace gl_engine {
         // Vérifier erreurs finales
 
         uniformLocation_.clear();
+        uniforms_.clear();
+        uniformIds_.clear();
     }
 
     void gl_engine::ShaderProgram::compile() {
-        // TODO Déterminer comment gérer un programme non compilé en cas d'exception
         // https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glLinkProgram.xhtml
 
         if (!compiled_) {
@@ -236,15 +306,93 @@ namespace gl_engine {
 
             open_gl::linkProgram( id_ );
 
-            // TODO Checker les erreurs
+            // Un programme dont l’édition des liens échoue reste non compilé : use() le refuse.
+            GLint linked = GL_FALSE;
+            glGetProgramiv( id_, GL_LINK_STATUS, &linked );
+
+            if ( linked != GL_TRUE ) {
+                GLint size = 0;
+                glGetProgramiv( id_, GL_INFO_LOG_LENGTH, &size );
+
+                std::string log(static_cast<std::size_t>(size > 0 ? size : 0), '\0');
+                if ( size > 0 ) {
+                    glGetProgramInfoLog( id_, size, nullptr, log.data() );
+                    log.resize( log.size() - 1 );
+                }
+
+                throw LinkError(log);
+            }
 
             compiled_ = true;
+
+            reflectUniforms();
         }
 
         uniformLocation_.clear();
     }
 
 
+    void ShaderProgram::compile( const Content& vertex, const Content& fragment, const Content* const geometry,
+                                 const ProgramBinaryCache& cache ) {
+        const auto key = geometry != nullptr
+                         ? cache.key( {vertex.view(), geometry->view(), fragment.view()} )
+                         : cache.key( {vertex.view(), fragment.view()} );
+
+        if ( cache.load( id_, key ) ) {
+            compiled_ = true;
+            fromCache_ = true;
+
+            reflectUniforms();
+
+            return;
+        }
+
+        cache.prepare( id_ );
+
+        // Note développeur : Attacher le fragment shader après le vertex shader édite les liens, voir attachShader.
+        // Une édition des liens ratée lance gl_engine::ShaderProgram::LinkError : rien n’est alors écrit dans le cache.
+        if ( geometry != nullptr ) {
+            attachShader( GeometryShader(*geometry) );
+        }
+        attachShader( VertexShader(vertex) );
+        attachShader( FragmentShader(fragment) );
+
+        try {
+            cache.store( id_, key );
+        }
+        catch ( const utility::ErrorWritingFile& ) {
+            // Le cache n’est qu’une accélération : le programme compilé reste utilisable.
+        }
+    }
+
+
+    UniformBlockLayout ShaderProgram::uniformBlockLayout( const std::string& name ) const {
+        if ( !compiled_ ) {
+            throw ProgramNotCompiled("Pour lire la disposition d’un bloc d’uniformes, il est nécessaire que le programme soit compilé.");
+        }
+
+        auto layout = open_gl::uniformBlockLayout( id_, name );
+        if ( !layout.found() ) {
+            throw UniformBlockNotFound(name);
+        }
+
+        return layout;
+    }
+
+    void ShaderProgram::bindUniformBlock( const std::string& name, const GLuint binding ) {
+        if ( !compiled_ ) {
+            throw ProgramNotCompiled("Le programme doit être compilé pour pouvoir lier un bloc d’uniformes.");
+        }
+
+        const auto index = glGetUniformBlockIndex( id_, name.c_str() );
+        if ( index == GL_INVALID_INDEX ) {
+            throw UniformBlockNotFound(name);
+        }
+
+        open_gl::uniformBlockBinding( id_, index, binding );
+    }
+
+
     GLint ShaderProgram::getUniformLocation( std::string name ) {
         if ( !compiled_ ) {
             throw ProgramNotCompiled("Pour récupérer la localisation des uniformes d’un programme, il est nécessaire que le programme soit compilé.");
@@ -272,13 +420,149 @@ namespace gl_engine {
     }
 
 
+    UniformHandle ShaderProgram::uniform( const std::string_view name ) const {
+        if ( !compiled_ ) {
+            throw ProgramNotCompiled("Pour récupérer la localisation des uniformes d’un programme, il est nécessaire que le programme soit compilé.");
+        }
+
+        const auto found = std::lower_bound( uniforms_.cbegin(), uniforms_.cend(), name,
+                                             []( const ActiveUniform& uniform, const std::string_view key ) noexcept {
+                                                 return uniform.name < key;
+                                             } );
+
+        if ( found != uniforms_.cend() && found->name == name ) {
+            return UniformHandle(found->location);
+        }
+
+        // Note développeur : Les éléments d’un tableau autres que le premier ('lights[2]') ne sont pas listés
+        // par glGetActiveUniform, OpenGL est alors interrogé directement.
+        const auto location = open_gl::getUniformLocation( id_, std::string(name) );
+
+        if ( location < 0 ) {
+            throw UniformNotFound(std::string(name));
+        }
+
+        return UniformHandle(location);
+    }
+
+    UniformHandle ShaderProgram::uniform( const UniformId id ) const {
+        if ( !compiled_ ) {
+            throw ProgramNotCompiled("Pour récupérer la localisation des uniformes d’un programme, il est nécessaire que le programme soit compilé.");
+        }
+
+        const auto found = std::lower_bound( uniformIds_.cbegin(), uniformIds_.cend(), id.hash(),
+                                             []( const UniformSlot& slot, const std::uint64_t key ) noexcept {
+                                                 return slot.id < key;
+                                             } );
+
+        if ( found == uniformIds_.cend() || found->id != id.hash() ) {
+            throw UniformNotFound("d’identifiant " + std::to_string( id.hash() ));
+        }
+
+        return UniformHandle(found->location);
+    }
+
+    void ShaderProgram::reflectUniforms() {
+        uniforms_.clear();
+
+        GLint count = 0;
+        glGetProgramiv( id_, GL_ACTIVE_UNIFORMS, &count );
+
+        GLint maxLength = 0;
+        glGetProgramiv( id_, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength );
+
+        std::string name(static_cast<std::size_t>(std::max( maxLength, 1 )), '\0');
+        uniforms_.reserve( static_cast<std::size_t>(count) );
+
+        for ( GLint index = 0; index < count; ++index ) {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = GL_NONE;
+            glGetActiveUniform( id_, static_cast<GLuint>(index), static_cast<GLsizei>(name.size()), &length, &size, &type, name.data() );
+
+            // Les membres des blocs d’uniformes n’ont pas de localisation, voir gl_engine::UniformBlockLayout.
+            const auto location = glGetUniformLocation( id_, name.c_str() );
+            if ( location < 0 ) {
+                continue;
+            }
+
+            // Un tableau est listé sous le nom de son premier élément ('lights[0]'), il est retrouvé sous les deux noms.
+            std::string_view uniformName(name.data(), static_cast<std::size_t>(length));
+            const auto array = uniformName.size() > FIRST_ELEMENT.size() &&
+                               uniformName.substr( uniformName.size() - FIRST_ELEMENT.size() ) == FIRST_ELEMENT;
+            if ( array ) {
+                uniformName.remove_suffix( FIRST_ELEMENT.size() );
+            }
+
+            uniforms_.push_back( {std::string(uniformName), location, type, size, array} );
+        }
+
+        std::sort( uniforms_.begin(), uniforms_.end(), []( const ActiveUniform& a, const ActiveUniform& b ) noexcept {
+            return a.name < b.name;
+        } );
+
+        reflectUniformIds();
+    }
+
+    void ShaderProgram::reflectUniformIds() {
+        // Note développeur : L’indice de l’uniforme accompagne l’identifiant, pour retrouver les noms d’une collision.
+        struct Entry {
+            std::uint64_t id;
+            std::size_t uniform;
+        };
+
+        std::vector<Entry> entries{};
+        entries.reserve( uniforms_.size() * 2 );
+
+        for ( std::size_t i = 0; i < uniforms_.size(); ++i ) {
+            const auto& uniform = uniforms_[i];
+
+            entries.push_back( {UniformId(uniform.name).hash(), i} );
+            if ( uniform.array ) {
+                entries.push_back( {UniformId(uniform.name + std::string(FIRST_ELEMENT)).hash(), i} );
+            }
+        }
+
+        std::sort( entries.begin(), entries.end(), []( const Entry& a, const Entry& b ) noexcept {
+            return a.id < b.id;
+        } );
+
+        uniformIds_.clear();
+        uniformIds_.reserve( entries.size() );
+
+        for ( auto first = entries.cbegin(); first != entries.cend(); ) {
+            auto last = std::next( first );
+            while ( last != entries.cend() && last->id == first->id ) {
+                ++last;
+            }
+
+            if ( std::distance( first, last ) == 1 ) {
+                uniformIds_.push_back( {first->id, uniforms_[first->uniform].location} );
+            }
+#ifndef NDEBUG
+            else {
+                std::cerr << "[GL_Engine] Collision d’identifiants d’uniformes (programme " << id_ << ") :";
+                for ( auto it = first; it != last; ++it ) {
+                    std::cerr << ' ' << uniforms_[it->uniform].name;
+                }
+                std::cerr << ", UniformId ne les désigne pas." << std::endl;
+            }
+#endif
+
+            first = last;
+        }
+    }
+
+
     void ShaderProgram::setUniformFloat( std::string name, const float* value, size_t size ) {
+        setUniformFloat( getUniformLocation(std::move(name)), value, size );
+    }
+
+    void ShaderProgram::setUniformFloat( const GLint location, const float* value, size_t size ) {
         if ( !compiled_ ) {
             throw ProgramNotCompiled("Le programme doit être compilé pour pouvoir modifier la valeur d’un uniforme.");
         }
 
-        const auto location = getUniformLocation(name);
-
         switch ( size ) {
             case 1:
                 glUniform1fv(location, 1, value);
@@ -308,13 +592,15 @@ namespace gl_engine {
     }
 
 
-    void ShaderProgram::setUniformInt( std::string name, const int* value, size_t size) {
+    void ShaderProgram::setUniformInt( std::string name, const int* value, size_t size ) {
+        setUniformInt( getUniformLocation(std::move(name)), value, size );
+    }
+
+    void ShaderProgram::setUniformInt( const GLint location, const int* value, size_t size ) {
         if ( !compiled_ ) {
             throw ProgramNotCompiled("Le programme doit être compilé pour pouvoir modifier la valeur d’un uniforme.");
         }
 
-        const auto location = getUniformLocation(name);
-
         switch ( size ) {
             case 1:
                 glUniform1iv(location, 1, value);
@@ -344,13 +630,15 @@ namespace gl_engine {
     }
 
 
-    void ShaderProgram::setUniformUnsigned( std::string name, const unsigned int* value, size_t size) {
+    void ShaderProgram::setUniformUnsigned( std::string name, const unsigned int* value, size_t size ) {
+        setUniformUnsigned( getUniformLocation(std::move(name)), value, size );
+    }
+
+    void ShaderProgram::setUniformUnsigned( const GLint location, const unsigned int* value, size_t size ) {
         if ( !compiled_ ) {
             throw ProgramNotCompiled("Le programme doit être compilé pour pouvoir modifier la valeur d’un uniforme.");
         }
 
-        const auto location = getUniformLocation(name);
-
         switch ( size ) {
             case 1:
                 glUniform1uiv(location, 1, value);
@@ -428,7 +716,13 @@ namespace gl_engine {
 
 
     void ShaderProgram::setUniformFloatMatrix( std::string name, const float* value, size_t sizeX, size_t sizeY, bool transpose ) {
-        const auto location = getUniformLocation(std::move(name));
+        setUniformFloatMatrix( getUniformLocation(std::move(name)), value, sizeX, sizeY, transpose );
+    }
+
+    void ShaderProgram::setUniformFloatMatrix( const GLint location, const float* value, size_t sizeX, size_t sizeY, bool transpose ) {
+        if ( !compiled_ ) {
+            throw ProgramNotCompiled("Le programme doit être compilé pour pouvoir modifier la valeur d’un uniforme.");
+        }
 
         switch ( sizeX ) {
             case 2:
@@ -551,4 +845,138 @@ namespace gl_engine {
         setUniformFloatMatrix(std::move(name), glm::value_ptr(convertedValue), 4,3, utility::to_underlying(transpose) );
     }
 
+    // region UniformHandle
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::vec2 value ) {
+        setUniformFloat( uniform.location_, glm::value_ptr(value) , 2);
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::vec3 value ) {
+        setUniformFloat( uniform.location_, glm::value_ptr(value) , 3);
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::vec4 value ) {
+        setUniformFloat( uniform.location_, glm::value_ptr(value) , 4);
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::ivec2 value ) {
+        setUniformInt( uniform.location_, glm::value_ptr(value), 2);
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::ivec3 value ) {
+        setUniformInt( uniform.location_, glm::value_ptr(value), 3);
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::ivec4 value ) {
+        setUniformInt( uniform.location_, glm::value_ptr(value), 4);
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::uvec2 value ) {
+        setUniformUnsigned(uniform.location_, glm::value_ptr(value), 2);
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::uvec3 value ) {
+        setUniformUnsigned(uniform.location_, glm::value_ptr(value), 3);
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::uvec4 value ) {
+        setUniformUnsigned(uniform.location_, glm::value_ptr(value), 4);
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::dvec2 value ) {
+        const auto convertedValue = static_cast<glm::vec2>(value);
+        setUniformFloat(uniform.location_, glm::value_ptr(convertedValue), 2);
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::dvec3 value ) {
+        const auto convertedValue = static_cast<glm::vec3>(value);
+        setUniformFloat(uniform.location_, glm::value_ptr(convertedValue), 3);
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::dvec4 value ) {
+        const auto convertedValue = static_cast<glm::vec4>(value);
+        setUniformFloat(uniform.location_, glm::value_ptr(convertedValue), 4);
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::bvec2 value ) {
+        const auto convertedValue = static_cast<glm::ivec2>(value);
+        setUniformInt(uniform.location_, glm::value_ptr(convertedValue), 2);
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::bvec3 value ) {
+        const auto convertedValue = static_cast<glm::ivec3>(value);
+        setUniformInt(uniform.location_, glm::value_ptr(convertedValue), 3);
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::bvec4 value ) {
+        const auto convertedValue = static_cast<glm::ivec4>(value);
+        setUniformInt(uniform.location_, glm::value_ptr(convertedValue), 4);
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, int value ) {
+        setUniformInt(uniform.location_, &value, 1 );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, float value ) {
+        setUniformFloat(uniform.location_, &value, 1 );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, bool value ) {
+        const auto convertedValue = static_cast<int>(value);
+        setUniformInt(uniform.location_, &convertedValue, 1 );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, double value ) {
+        const auto convertedValue = static_cast<float>(value);
+        setUniformFloat(uniform.location_, &convertedValue, 1 );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, unsigned int value ) {
+        setUniformUnsigned(uniform.location_, &value, 1 );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::mat2 value, TRANSPOSE transpose ) {
+        setUniformFloatMatrix(uniform.location_, glm::value_ptr(value), 2, 2, utility::to_underlying(transpose) );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::mat2x3 value, TRANSPOSE transpose ) {
+        setUniformFloatMatrix(uniform.location_, glm::value_ptr(value), 2, 3, utility::to_underlying(transpose) );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::mat2x4 value, TRANSPOSE transpose ) {
+        setUniformFloatMatrix(uniform.location_, glm::value_ptr(value), 2, 4, utility::to_underlying(transpose) );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::mat3 value, TRANSPOSE transpose ) {
+        setUniformFloatMatrix(uniform.location_, glm::value_ptr(value), 3, 3, utility::to_underlying(transpose) );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::mat3x2 value, TRANSPOSE transpose ) {
+        setUniformFloatMatrix(uniform.location_, glm::value_ptr(value), 3, 2, utility::to_underlying(transpose) );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::mat3x4 value, TRANSPOSE transpose ) {
+        setUniformFloatMatrix(uniform.location_, glm::value_ptr(value), 3, 4, utility::to_underlying(transpose) );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::mat4 value, TRANSPOSE transpose ) {
+        setUniformFloatMatrix(uniform.location_, glm::value_ptr(value), 4, 4, utility::to_underlying(transpose) );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::mat4x2 value, TRANSPOSE transpose ) {
+        setUniformFloatMatrix(uniform.location_, glm::value_ptr(value), 4, 2, utility::to_underlying(transpose) );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::mat4x3 value, TRANSPOSE transpose ) {
+        setUniformFloatMatrix(uniform.location_, glm::value_ptr(value), 4, 3, utility::to_underlying(transpose) );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::dmat2 value, TRANSPOSE transpose ) {
+        const auto convertedValue = static_cast<glm::mat2>( value );
+        setUniformFloatMatrix(uniform.location_, glm::value_ptr(convertedValue), 2,2, utility::to_underlying(transpose) );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::dmat2x3 value, TRANSPOSE transpose ) {
+        const auto convertedValue = static_cast<glm::mat2x3>( value );
+        setUniformFloatMatrix(uniform.location_, glm::value_ptr(convertedValue), 2,3, utility::to_underlying(transpose) );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::dmat2x4 value, TRANSPOSE transpose ) {
+        const auto convertedValue = static_cast<glm::mat2x4>( value );
+        setUniformFloatMatrix(uniform.location_, glm::value_ptr(convertedValue), 2,4, utility::to_underlying(transpose) );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::dmat3 value, TRANSPOSE transpose ) {
+        const auto convertedValue = static_cast<glm::mat3>( value );
+        setUniformFloatMatrix(uniform.location_, glm::value_ptr(convertedValue), 3,3, utility::to_underlying(transpose) );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::dmat3x2 value, TRANSPOSE transpose ) {
+        const auto convertedValue = static_cast<glm::mat3x2>( value );
+        setUniformFloatMatrix(uniform.location_, glm::value_ptr(convertedValue), 3,2, utility::to_underlying(transpose) );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::dmat3x4 value, TRANSPOSE transpose ) {
+        const auto convertedValue = static_cast<glm::mat3x4>( value );
+        setUniformFloatMatrix(uniform.location_, glm::value_ptr(convertedValue), 3,4, utility::to_underlying(transpose) );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::dmat4 value, TRANSPOSE transpose ) {
+        const auto convertedValue = static_cast<glm::mat4>( value );
+        setUniformFloatMatrix(uniform.location_, glm::value_ptr(convertedValue), 4,4, utility::to_underlying(transpose) );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::dmat4x2 value, TRANSPOSE transpose ) {
+        const auto convertedValue = static_cast<glm::mat4x2>( value );
+        setUniformFloatMatrix(uniform.location_, glm::value_ptr(convertedValue), 4,2, utility::to_underlying(transpose) );
+    }
+    void ShaderProgram::setUniform( const UniformHandle uniform, glm::dmat4x3 value, TRANSPOSE transpose ) {
+        const auto convertedValue = static_cast<glm::mat4x3>( value );
+        setUniformFloatMatrix(uniform.location_, glm::value_ptr(convertedValue), 4,3, utility::to_underlying(transpose) );
+    }
+    // endregion
+
 }
@@ -0,0 +1,237 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <glad/glad.h>
+
+#include <array>
+#include <string>
+#include <utility>
+
+#include <glengine/shader_compiler.hpp>
+
+namespace gl_engine {
+    namespace {
+        // Note développeur : Constante de GL_KHR_parallel_shader_compile, absente du chargeur glad du moteur.
+        constexpr GLenum COMPLETION_STATUS = 0x91B1;
+
+        /// Demande au pilote autant de threads de compilation qu’il le souhaite.
+        constexpr GLuint ALL_COMPILER_THREADS = 0xFFFFFFFF;
+
+        constexpr std::array<GLenum, 3> STAGE_TYPES = {GL_VERTEX_SHADER, GL_GEOMETRY_SHADER, GL_FRAGMENT_SHADER};
+        constexpr std::array<const char*, 3> STAGE_NAMES = {"vertex", "geometry", "fragment"};
+
+        std::string shaderLog( const Id shader ) {
+            GLint size = 0;
+            glGetShaderiv( shader, GL_INFO_LOG_LENGTH, &size );
+
+            std::string log(static_cast<std::size_t>(size > 0 ? size : 0), '\0');
+            if ( size > 0 ) {
+                glGetShaderInfoLog( shader, size, nullptr, log.data() );
+                log.resize( log.size() - 1 );
+            }
+
+            return log;
+        }
+
+        std::string programLog( const Id program ) {
+            GLint size = 0;
+            glGetProgramiv( program, GL_INFO_LOG_LENGTH, &size );
+
+            std::string log(static_cast<std::size_t>(size > 0 ? size : 0), '\0');
+            if ( size > 0 ) {
+                glGetProgramInfoLog( program, size, nullptr, log.data() );
+                log.resize( log.size() - 1 );
+            }
+
+            return log;
+        }
+
+        /**
+         * @brief Retourne le message d’erreur d’un programme non lié : le journal du premier shader qui ne compile pas,
+         * ou celui de l’édition des liens.
+         */
+        std::string errorMessage( const Id program, const std::array<Id, 3>& shaders ) {
+            for ( std::size_t stage = 0; stage < shaders.size(); ++stage ) {
+                if ( shaders[stage] == 0 ) {
+                    continue;
+                }
+
+                GLint compiled = GL_FALSE;
+                glGetShaderiv( shaders[stage], GL_COMPILE_STATUS, &compiled );
+
+                if ( compiled != GL_TRUE ) {
+                    return std::string("Erreur de compilation du ") + STAGE_NAMES[stage] + " shader :\n" + shaderLog( shaders[stage] );
+                }
+            }
+
+            return "Erreur durant l’édition des liens du programme :\n" + programLog( program );
+        }
+    }
+
+    ProgramFuture::ProgramFuture( ProgramFuture&& other ) noexcept
+    : shaders_(std::exchange( other.shaders_, {} )), program_(std::exchange( other.program_, 0 )),
+      cache_(std::exchange( other.cache_, nullptr )), key_(other.key_), parallel_(other.parallel_), fromCache_(other.fromCache_) {}
+
+    ProgramFuture& ProgramFuture::operator=( ProgramFuture&& other ) noexcept {
+        if ( &other != this ) {
+            release();
+
+            shaders_ = std::exchange( other.shaders_, {} );
+            program_ = std::exchange( other.program_, 0 );
+            cache_ = std::exchange( other.cache_, nullptr );
+            key_ = other.key_;
+            parallel_ = other.parallel_;
+            fromCache_ = other.fromCache_;
+        }
+
+        return *this;
+    }
+
+    ProgramFuture::~ProgramFuture() noexcept {
+        release();
+    }
+
+    void ProgramFuture::release() noexcept {
+        for ( auto& shader : shaders_ ) {
+            if ( shader != 0 ) {
+                open_gl::deleteShader( std::exchange( shader, 0 ) );
+            }
+        }
+
+        if ( program_ != 0 ) {
+            open_gl::deleteProgram( std::exchange( program_, 0 ) );
+        }
+    }
+
+    bool ProgramFuture::ready() const noexcept {
+        if ( !parallel_ || fromCache_ ) {
+            return true;
+        }
+
+        // L’édition des liens suit la compilation de tous les shaders : elle seule est interrogée.
+        GLint completed = GL_FALSE;
+        glGetProgramiv( program_, COMPLETION_STATUS, &completed );
+
+        return completed == GL_TRUE;
+    }
+
+    ShaderProgram ProgramFuture::get() {
+        // Le futur ne garde plus rien : le programme est rendu, ou supprimé par ce futur local en cas d’exception.
+        ProgramFuture pending(std::move( *this ));
+
+        if ( !pending.fromCache_ ) {
+            // Première lecture d’état : c’est ici que le thread attend le pilote, si la compilation n’est pas finie.
+            GLint linked = GL_FALSE;
+            glGetProgramiv( pending.program_, GL_LINK_STATUS, &linked );
+
+            if ( linked != GL_TRUE ) {
+                throw ShaderCompiler::CompileError(errorMessage( pending.program_, pending.shaders_ ));
+            }
+        }
+
+        // Un programme lié n’a plus besoin de ses shaders.
+        for ( auto& shader : pending.shaders_ ) {
+            if ( shader != 0 ) {
+                open_gl::detachShader( pending.program_, shader );
+                open_gl::deleteShader( std::exchange( shader, 0 ) );
+            }
+        }
+
+        if ( pending.cache_ != nullptr ) {
+            try {
+                pending.cache_->store( pending.program_, pending.key_ );
+            }
+            catch ( const utility::ErrorWritingFile& ) {
+                // Le cache n’est qu’une accélération : le programme compilé reste utilisable.
+            }
+        }
+
+        return ShaderProgram(std::exchange( pending.program_, 0 ), pending.fromCache_);
+    }
+
+    ShaderCompiler::ShaderCompiler() noexcept
+    : parallel_(open_gl::hasParallelShaderCompile()) {
+        if ( parallel_ ) {
+            open_gl::maxShaderCompilerThreads( ALL_COMPILER_THREADS );
+        }
+    }
+
+    ProgramFuture ShaderCompiler::submit( const Content& vertex, const Content& fragment ) const {
+        return launch( vertex, fragment, nullptr, nullptr );
+    }
+
+    ProgramFuture ShaderCompiler::submit( const Content& vertex, const Content& fragment, const Content& geometry ) const {
+        return launch( vertex, fragment, &geometry, nullptr );
+    }
+
+    ProgramFuture ShaderCompiler::submit( const Content& vertex, const Content& fragment, const ProgramBinaryCache& cache ) const {
+        return launch( vertex, fragment, nullptr, &cache );
+    }
+
+    ProgramFuture ShaderCompiler::submit( const Content& vertex, const Content& fragment, const Content& geometry,
+                                          const ProgramBinaryCache& cache ) const {
+        return launch( vertex, fragment, &geometry, &cache );
+    }
+
+    ProgramFuture ShaderCompiler::launch( const Content& vertex, const Content& fragment, const Content* const geometry,
+                                          const ProgramBinaryCache* const cache ) const {
+        ProgramFuture future{};
+        future.parallel_ = parallel_;
+        future.program_ = open_gl::createProgram();
+
+        if ( cache != nullptr ) {
+            // Même clé que gl_engine::ShaderProgram : les deux chemins partagent leurs binaires.
+            future.key_ = geometry != nullptr
+                          ? cache->key( {vertex.view(), geometry->view(), fragment.view()} )
+                          : cache->key( {vertex.view(), fragment.view()} );
+
+            if ( cache->load( future.program_, future.key_ ) ) {
+                future.fromCache_ = true;
+
+                return future;
+            }
+
+            cache->prepare( future.program_ );
+            future.cache_ = cache;
+        }
+
+        const std::array<const Content*, 3> sources = {&vertex, geometry, &fragment};
+
+        // Aucune lecture d’état entre les appels : le pilote peut tout mettre en file et rendre la main.
+        for ( std::size_t stage = 0; stage < sources.size(); ++stage ) {
+            if ( sources[stage] == nullptr ) {
+                continue;
+            }
+
+            const auto source = sources[stage]->view();
+            const auto* text = source.data();
+            const auto length = static_cast<Length>(source.size());
+
+            const auto shader = open_gl::createShader( STAGE_TYPES[stage] );
+            future.shaders_[stage] = shader;
+
+            open_gl::shaderSource( shader, 1, &text, &length );
+            open_gl::compileShader( shader );
+            open_gl::attachShader( future.program_, shader );
+        }
+
+        open_gl::linkProgram( future.program_ );
+
+        return future;
+    }
+}
@@ -0,0 +1,203 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include <glengine/gl_state.hpp>
+#include <glengine/streaming_buffer.hpp>
+
+namespace gl_engine {
+    namespace {
+        // Note développeur : Constantes d’OpenGL 4.4, absentes du chargeur glad OpenGL 3.3 du moteur.
+        constexpr GLbitfield MAP_PERSISTENT_BIT = 0x0040;
+        constexpr GLbitfield MAP_COHERENT_BIT = 0x0080;
+
+        /// Plus grand alignement demandé par les pilotes pour les décalages d’UBO et de SSBO.
+        constexpr std::size_t MAXIMUM_ALIGNMENT = 256;
+
+        /// Attente maximale d’une barrière avant de la tester de nouveau, en nanosecondes.
+        constexpr GLuint64 FENCE_TIMEOUT = 1'000'000'000;
+
+        constexpr std::size_t alignUp( const std::size_t value, const std::size_t alignment ) noexcept {
+            return ( value + alignment - 1 ) & ~( alignment - 1 );
+        }
+
+        GLsync toSync( void* const fence ) noexcept {
+            return static_cast<GLsync>(fence);
+        }
+    }
+
+    StreamingBuffer::StreamingBuffer( const std::size_t regionSize, const std::size_t regionCount )
+    : regionSize_(alignUp( std::max( regionSize, std::size_t{1} ), MAXIMUM_ALIGNMENT )),
+      regionCount_(std::max( regionCount, std::size_t{1} )), persistent_(open_gl::hasBufferStorage()),
+      fences_(regionCount_, nullptr) {
+        // La dernière région est celle de l’image précédente : la première image commence par la région 0.
+        region_ = regionCount_ - 1;
+
+        glGenBuffers( 1, &buffer_ );
+        open_gl::bindBuffer( GL_COPY_WRITE_BUFFER, buffer_ );
+
+        if ( persistent_ ) {
+            const auto total = regionSize_ * regionCount_;
+            constexpr auto flags = GL_MAP_WRITE_BIT | MAP_PERSISTENT_BIT | MAP_COHERENT_BIT;
+
+            open_gl::bufferStorage( GL_COPY_WRITE_BUFFER, static_cast<std::ptrdiff_t>(total), nullptr, flags );
+            mapping_ = static_cast<unsigned char*>(glMapBufferRange( GL_COPY_WRITE_BUFFER, 0, static_cast<GLsizeiptr>(total), flags ));
+        }
+        else {
+            // Une seule région : le stockage est remplacé à chaque image.
+            regionCount_ = 1;
+            region_ = 0;
+            glBufferData( GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(regionSize_), nullptr, GL_STREAM_DRAW );
+        }
+    }
+
+    StreamingBuffer::StreamingBuffer( const std::size_t regionSize )
+    : StreamingBuffer( regionSize, DEFAULT_REGION_COUNT ) {}
+
+    StreamingBuffer::StreamingBuffer( StreamingBuffer&& other ) noexcept
+    : buffer_(std::exchange(other.buffer_, 0)), regionSize_(other.regionSize_), regionCount_(other.regionCount_),
+      region_(other.region_), cursor_(other.cursor_), persistent_(other.persistent_),
+      mapping_(std::exchange(other.mapping_, nullptr)), fences_(std::move(other.fences_)) {}
+
+    StreamingBuffer& StreamingBuffer::operator=( StreamingBuffer&& other ) noexcept {
+        if ( &other != this ) {
+            release();
+
+            buffer_ = std::exchange( other.buffer_, 0 );
+            regionSize_ = other.regionSize_;
+            regionCount_ = other.regionCount_;
+            region_ = other.region_;
+            cursor_ = other.cursor_;
+            persistent_ = other.persistent_;
+            mapping_ = std::exchange( other.mapping_, nullptr );
+            fences_ = std::move( other.fences_ );
+        }
+
+        return *this;
+    }
+
+    StreamingBuffer::~StreamingBuffer() noexcept {
+        release();
+    }
+
+    void StreamingBuffer::beginFrame() noexcept {
+        region_ = ( region_ + 1 ) % regionCount_;
+        cursor_ = 0;
+
+        if ( !persistent_ ) {
+            // Orphelin : glBufferData donne un nouveau stockage, l’ancien est libéré quand la carte ne le lit plus.
+            open_gl::bindBuffer( GL_COPY_WRITE_BUFFER, buffer_ );
+            glBufferData( GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(regionSize_), nullptr, GL_STREAM_DRAW );
+            mapping_ = static_cast<unsigned char*>(glMapBufferRange( GL_COPY_WRITE_BUFFER, 0, static_cast<GLsizeiptr>(regionSize_),
+                                                                     GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT ));
+            return;
+        }
+
+        auto& fence = fences_[region_];
+        if ( fence == nullptr ) {
+            return;
+        }
+
+        // Le premier test vide la file de commandes : la barrière finira par être atteinte.
+        auto flags = GLbitfield{GL_SYNC_FLUSH_COMMANDS_BIT};
+        while ( true ) {
+            const auto status = glClientWaitSync( toSync( fence ), flags, FENCE_TIMEOUT );
+            if ( status != GL_TIMEOUT_EXPIRED ) {
+                break;
+            }
+            flags = 0;
+        }
+
+        glDeleteSync( toSync( fence ) );
+        fence = nullptr;
+    }
+
+    StreamAllocation StreamingBuffer::allocate( const std::size_t size, const std::size_t alignment ) {
+        const auto base = persistent_ ? region_ * regionSize_ : 0;
+        const auto offset = alignUp( base + cursor_, std::max( alignment, std::size_t{1} ) );
+
+        if ( offset + size > base + regionSize_ || mapping_ == nullptr ) {
+            throw std::length_error( "gl_engine::StreamingBuffer : la région de l’image est pleine." );
+        }
+
+        cursor_ = offset + size - base;
+
+        // Note développeur : Sans persistance, seule la région de l’image est projetée et base vaut 0.
+        return {mapping_ + offset, offset, size};
+    }
+
+    StreamAllocation StreamingBuffer::allocate( const std::size_t size ) {
+        return allocate( size, uniformOffsetAlignment() );
+    }
+
+    void StreamingBuffer::flush() noexcept {
+        if ( persistent_ || mapping_ == nullptr ) {
+            return;
+        }
+
+        open_gl::bindBuffer( GL_COPY_WRITE_BUFFER, buffer_ );
+        glUnmapBuffer( GL_COPY_WRITE_BUFFER );
+        mapping_ = nullptr;
+    }
+
+    void StreamingBuffer::endFrame() noexcept {
+        flush();
+
+        if ( persistent_ ) {
+            fences_[region_] = glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+        }
+    }
+
+    std::size_t StreamingBuffer::uniformOffsetAlignment() noexcept {
+        static const auto alignment = []() noexcept {
+            GLint value = 0;
+            glGetIntegerv( GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &value );
+
+            return value > 0 ? static_cast<std::size_t>(value) : MAXIMUM_ALIGNMENT;
+        }();
+
+        return alignment;
+    }
+
+    void StreamingBuffer::release() noexcept {
+        for ( auto& fence : fences_ ) {
+            if ( fence != nullptr ) {
+                glDeleteSync( toSync( fence ) );
+                fence = nullptr;
+            }
+        }
+
+        if ( buffer_ == 0 ) {
+            return;
+        }
+
+        if ( mapping_ != nullptr ) {
+            open_gl::bindBuffer( GL_COPY_WRITE_BUFFER, buffer_ );
+            glUnmapBuffer( GL_COPY_WRITE_BUFFER );
+            mapping_ = nullptr;
+        }
+
+        open_gl::deleteBuffer( buffer_ );
+        buffer_ = 0;
+    }
+}
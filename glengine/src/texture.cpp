@@ -0,0 +1,157 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <filesystem>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+
+#include <glad/glad.h>
+
+#include <glengine/gl_state.hpp>
+#include <glengine/texture.hpp>
+
+namespace gl_engine {
+    namespace {
+        struct TextureFormat {
+            GLint internalFormat;
+            GLenum format;
+        };
+
+        TextureFormat textureFormat( const int channels ) noexcept {
+            switch ( channels ) {
+                case 1:
+                    return {GL_R8, GL_RED};
+                case 2:
+                    return {GL_RG8, GL_RG};
+                case 3:
+                    return {GL_RGB8, GL_RGB};
+                default:
+                    return {GL_RGBA8, GL_RGBA};
+            }
+        }
+
+        /**
+         * @brief État du cache, construit au premier appel.
+         */
+        struct CacheState {
+            std::mutex mutex{};
+            std::unordered_map<std::string, std::weak_ptr<Texture>> textures{};
+        };
+
+        CacheState& cacheState() {
+            static CacheState state{};
+            return state;
+        }
+    }
+
+    Texture::Texture( const Path& path )
+    : image_(std::in_place, path) {
+        width_ = image_->width();
+        height_ = image_->height();
+    }
+
+    Texture::~Texture() noexcept {
+        if ( texture_ != 0 ) {
+            open_gl::deleteTexture( texture_ );
+        }
+    }
+
+    void Texture::bind( const unsigned unit ) noexcept {
+        if ( texture_ == 0 ) {
+            upload( unit );
+        }
+        else {
+            open_gl::bindTexture( unit, GL_TEXTURE_2D, texture_ );
+        }
+    }
+
+    void Texture::upload( const unsigned unit ) noexcept {
+        glGenTextures( 1, &texture_ );
+        open_gl::bindTexture( unit, GL_TEXTURE_2D, texture_ );
+
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+
+        const auto format = textureFormat( image_->channels() );
+
+        // Les lignes d’une image à 1 ou 3 composantes ne sont pas alignées sur 4 octets.
+        glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+        glTexImage2D( GL_TEXTURE_2D, 0, format.internalFormat, width_, height_, 0, format.format, GL_UNSIGNED_BYTE, image_->data() );
+        glPixelStorei( GL_UNPACK_ALIGNMENT, 4 );
+
+        glGenerateMipmap( GL_TEXTURE_2D );
+
+        // Les pixels sont maintenant dans la mémoire de la carte graphique.
+        image_.reset();
+    }
+
+    std::shared_ptr<Texture> TextureCache::load( const Path& path ) {
+        std::error_code error{};
+        auto canonical = std::filesystem::canonical( path.path_, error );
+        if ( error ) {
+            canonical = std::filesystem::absolute( path.path_ ).lexically_normal();
+        }
+
+        const auto key = canonical.string();
+
+        auto& state = cacheState();
+
+        // Note développeur : Le verrou est conservé pendant le décodage, une image demandée par deux threads
+        // à la fois n’est ainsi décodée qu’une fois. Les chargements sont rares comparés aux rendus.
+        const std::lock_guard<std::mutex> lock(state.mutex);
+
+        const auto found = state.textures.find( key );
+        if ( found != state.textures.end() ) {
+            if ( auto texture = found->second.lock() ) {
+                return texture;
+            }
+        }
+
+        // L’entrée n’est insérée qu’une fois l’image décodée : un échec ne laisse aucune entrée vide dans le cache.
+        auto texture = std::make_shared<Texture>( path );
+        state.textures[key] = texture;
+
+        return texture;
+    }
+
+    std::size_t TextureCache::size() noexcept {
+        auto& state = cacheState();
+        const std::lock_guard<std::mutex> lock(state.mutex);
+
+        std::size_t count = 0;
+        for ( const auto& [key, texture] : state.textures ) {
+            count += texture.expired() ? 0 : 1;
+        }
+
+        return count;
+    }
+
+    void TextureCache::purge() noexcept {
+        auto& state = cacheState();
+        const std::lock_guard<std::mutex> lock(state.mutex);
+
+        for ( auto it = state.textures.begin(); it != state.textures.end(); ) {
+            it = it->second.expired() ? state.textures.erase( it ) : std::next( it );
+        }
+    }
+}
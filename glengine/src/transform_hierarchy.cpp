@@ -0,0 +1,385 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <glengine/simd.hpp>
+#include <glengine/transform_hierarchy.hpp>
+
+namespace gl_engine {
+    namespace {
+#ifdef GLENGINE_SIMD_AVX
+        using Lane = simd::Float8;
+        constexpr std::size_t LANE_WIDTH = 8;
+#else
+        using Lane = simd::Float4;
+        constexpr std::size_t LANE_WIDTH = 4;
+#endif
+
+        /// Retourne v réordonné : l’élément s passe à l’emplacement target[s]. Les éléments de bourrage sont conservés.
+        template<typename T>
+        std::vector<T> permute( const std::vector<T>& v, const std::vector<std::uint32_t>& target ) {
+            std::vector<T> result(v);
+
+            for ( std::size_t s = 0; s < target.size(); ++s ) {
+                result[target[s]] = v[s];
+            }
+
+            return result;
+        }
+
+        /// Agrandit v d’un élément sans allocation si possible, avec une croissance géométrique sinon.
+        template<typename T>
+        void reserveOneMore( std::vector<T>& v ) {
+            if ( v.size() == v.capacity() ) {
+                v.reserve( std::max<std::size_t>( 16, v.capacity() * 2 ) );
+            }
+        }
+    }
+
+    TransformHierarchy::Node TransformHierarchy::add( const Node parent, const glm::vec3& translation, const glm::quat& rotation,
+                                                      const glm::vec3& scale ) {
+        if ( parent != NO_PARENT && parent >= slots_.size() ) {
+            throw UnknownNode( "Le parent du nœud n’appartient pas à la hiérarchie." );
+        }
+
+        // Toutes les allocations avant la première modification : les redimensionnements suivants ne lancent rien.
+        for ( auto& component : components_ ) {
+            reserveOneMore( component );
+        }
+        reserveOneMore( parents_ );
+        reserveOneMore( depths_ );
+        reserveOneMore( worlds_ );
+        reserveOneMore( dirty_ );
+        reserveOneMore( changed_ );
+        reserveOneMore( slots_ );
+        reserveOneMore( nodes_ );
+
+        const auto node = static_cast<Node>(slots_.size());
+        const auto slot = static_cast<std::uint32_t>(nodes_.size());
+        const auto normalized = glm::normalize( rotation );
+        const std::array<float, COMPONENT_COUNT> values{
+            translation.x, translation.y, translation.z,
+            normalized.x, normalized.y, normalized.z, normalized.w,
+            scale.x, scale.y, scale.z
+        };
+
+        for ( std::size_t c = 0; c < COMPONENT_COUNT; ++c ) {
+            components_[c].resize( slot + 1 + PADDING, 0.0f );
+            components_[c][slot] = values[c];
+        }
+
+        const auto parentSlot = parent == NO_PARENT ? NO_PARENT : slots_[parent];
+
+        parents_.push_back( parentSlot );
+        depths_.push_back( parent == NO_PARENT ? 0 : depths_[parentSlot] + 1 );
+        worlds_.emplace_back( 1.0f );
+        dirty_.resize( slot + 1 + PADDING, 0 );
+        dirty_[slot] = 1;
+        changed_.resize( slot + 1 + PADDING, 0 );
+        slots_.push_back( slot );
+        nodes_.push_back( node );
+
+        // Un nœud plus profond que le dernier garde le tri, mais les plages des niveaux sont à refaire.
+        sorted_ = false;
+
+        return node;
+    }
+
+    void TransformHierarchy::clear() noexcept {
+        for ( auto& component : components_ ) {
+            component.clear();
+        }
+        parents_.clear();
+        depths_.clear();
+        worlds_.clear();
+        dirty_.clear();
+        changed_.clear();
+        slots_.clear();
+        nodes_.clear();
+        levels_.clear();
+        sorted_ = true;
+    }
+
+    void TransformHierarchy::reserve( const std::size_t count ) {
+        for ( auto& component : components_ ) {
+            component.reserve( count + PADDING );
+        }
+        parents_.reserve( count );
+        depths_.reserve( count );
+        worlds_.reserve( count );
+        dirty_.reserve( count + PADDING );
+        changed_.reserve( count + PADDING );
+        slots_.reserve( count );
+        nodes_.reserve( count );
+    }
+
+    TransformHierarchy::Node TransformHierarchy::parent( const Node node ) const noexcept {
+        const auto parentSlot = parents_[slots_[node]];
+
+        return parentSlot == NO_PARENT ? NO_PARENT : nodes_[parentSlot];
+    }
+
+    glm::vec3 TransformHierarchy::translation( const Node node ) const noexcept {
+        const auto slot = slots_[node];
+
+        return {components_[TRANSLATION_X][slot], components_[TRANSLATION_Y][slot], components_[TRANSLATION_Z][slot]};
+    }
+
+    glm::quat TransformHierarchy::rotation( const Node node ) const noexcept {
+        const auto slot = slots_[node];
+
+        return {components_[ROTATION_W][slot], components_[ROTATION_X][slot], components_[ROTATION_Y][slot],
+                components_[ROTATION_Z][slot]};
+    }
+
+    glm::vec3 TransformHierarchy::scale( const Node node ) const noexcept {
+        const auto slot = slots_[node];
+
+        return {components_[SCALE_X][slot], components_[SCALE_Y][slot], components_[SCALE_Z][slot]};
+    }
+
+    void TransformHierarchy::setTranslation( const Node node, const glm::vec3& translation ) noexcept {
+        const auto slot = slots_[node];
+
+        components_[TRANSLATION_X][slot] = translation.x;
+        components_[TRANSLATION_Y][slot] = translation.y;
+        components_[TRANSLATION_Z][slot] = translation.z;
+        dirty_[slot] = 1;
+    }
+
+    void TransformHierarchy::setRotation( const Node node, const glm::quat& rotation ) noexcept {
+        const auto slot = slots_[node];
+        const auto normalized = glm::normalize( rotation );
+
+        components_[ROTATION_X][slot] = normalized.x;
+        components_[ROTATION_Y][slot] = normalized.y;
+        components_[ROTATION_Z][slot] = normalized.z;
+        components_[ROTATION_W][slot] = normalized.w;
+        dirty_[slot] = 1;
+    }
+
+    void TransformHierarchy::setScale( const Node node, const glm::vec3& scale ) noexcept {
+        const auto slot = slots_[node];
+
+        components_[SCALE_X][slot] = scale.x;
+        components_[SCALE_Y][slot] = scale.y;
+        components_[SCALE_Z][slot] = scale.z;
+        dirty_[slot] = 1;
+    }
+
+    std::size_t TransformHierarchy::update( const unsigned threadCount ) {
+        if ( !sorted_ ) {
+            sortByDepth();
+        }
+
+        // Les parents précèdent leurs enfants : une seule passe propage les marques à tous les descendants.
+        const auto count = size();
+        std::size_t updated = 0;
+
+        for ( std::size_t s = 0; s < count; ++s ) {
+            if ( parents_[s] != NO_PARENT ) {
+                dirty_[s] |= dirty_[parents_[s]];
+            }
+            updated += dirty_[s];
+        }
+
+        changed_.swap( dirty_ );
+        std::fill( dirty_.begin(), dirty_.end(), std::uint8_t{0} );
+
+        if ( updated == 0 ) {
+            return 0;
+        }
+
+        // Les nœuds d’un niveau ne lisent que les matrices du niveau précédent, déjà à jour.
+        const auto threads = utility::resolveThreadCount( threadCount );
+
+        for ( std::size_t level = 0; level + 1 < levels_.size(); ++level ) {
+            const std::size_t first = levels_[level];
+            const std::size_t last = levels_[level + 1];
+
+            if ( last - first < PARALLEL_THRESHOLD || threads <= 1 ) {
+                updateRange( first, last );
+                continue;
+            }
+
+            const auto chunkCount = ( last - first + CHUNK_SIZE - 1 ) / CHUNK_SIZE;
+            utility::parallelFor( chunkCount, threads, [&]( const std::size_t chunk ) {
+                const auto begin = first + chunk * CHUNK_SIZE;
+                updateRange( begin, std::min( begin + CHUNK_SIZE, last ) );
+            } );
+        }
+
+        return updated;
+    }
+
+    void TransformHierarchy::sortByDepth() {
+        const auto count = size();
+
+        std::uint32_t maximumDepth = 0;
+        auto ordered = true;
+        for ( std::size_t s = 0; s < count; ++s ) {
+            maximumDepth = std::max( maximumDepth, depths_[s] );
+            ordered = ordered && ( s == 0 || depths_[s - 1] <= depths_[s] );
+        }
+
+        // Tri par dénombrement stable : à profondeur égale, l’ordre de création est conservé.
+        std::vector<std::uint32_t> levels(std::size_t{maximumDepth} + 2, 0);
+        for ( std::size_t s = 0; s < count; ++s ) {
+            ++levels[depths_[s] + 1];
+        }
+        for ( std::size_t depth = 1; depth < levels.size(); ++depth ) {
+            levels[depth] += levels[depth - 1];
+        }
+
+        if ( !ordered ) {
+            std::vector<std::uint32_t> target(count);
+            auto cursors = levels;
+            for ( std::size_t s = 0; s < count; ++s ) {
+                target[s] = cursors[depths_[s]]++;
+            }
+
+            // Note développeur : tout est alloué avant le premier échange, une exception laisse la hiérarchie intacte.
+            std::array<std::vector<float>, COMPONENT_COUNT> components{};
+            for ( std::size_t c = 0; c < COMPONENT_COUNT; ++c ) {
+                components[c] = permute( components_[c], target );
+            }
+
+            auto parents = permute( parents_, target );
+            for ( auto& parentSlot : parents ) {
+                if ( parentSlot != NO_PARENT ) {
+                    parentSlot = target[parentSlot];
+                }
+            }
+
+            auto depths = permute( depths_, target );
+            auto worlds = permute( worlds_, target );
+            auto dirty = permute( dirty_, target );
+            auto nodes = permute( nodes_, target );
+
+            components_.swap( components );
+            parents_.swap( parents );
+            depths_.swap( depths );
+            worlds_.swap( worlds );
+            dirty_.swap( dirty );
+            nodes_.swap( nodes );
+
+            for ( std::size_t s = 0; s < count; ++s ) {
+                slots_[nodes_[s]] = static_cast<std::uint32_t>(s);
+            }
+        }
+
+        levels_.swap( levels );
+        sorted_ = true;
+    }
+
+    void TransformHierarchy::updateRange( const std::size_t first, const std::size_t last ) noexcept {
+        using simd::Float4;
+
+        const auto& c = components_;
+
+        for ( auto i = first; i < last; i += LANE_WIDTH ) {
+            std::array<std::uint8_t, LANE_WIDTH> flags{};
+            std::memcpy( flags.data(), changed_.data() + i, LANE_WIDTH );
+            if ( std::all_of( flags.begin(), flags.end(), []( const std::uint8_t flag ) noexcept { return flag == 0; } ) ) {
+                continue;
+            }
+
+            // Matrice locale T * R * S de LANE_WIDTH nœuds, la rotation venant d’un quaternion normé.
+            const auto x = Lane::load( c[ROTATION_X].data() + i );
+            const auto y = Lane::load( c[ROTATION_Y].data() + i );
+            const auto z = Lane::load( c[ROTATION_Z].data() + i );
+            const auto w = Lane::load( c[ROTATION_W].data() + i );
+
+            const auto x2 = x + x;
+            const auto y2 = y + y;
+            const auto z2 = z + z;
+            const auto xx = x * x2;
+            const auto yy = y * y2;
+            const auto zz = z * z2;
+            const auto xy = x * y2;
+            const auto xz = x * z2;
+            const auto yz = y * z2;
+            const auto wx = w * x2;
+            const auto wy = w * y2;
+            const auto wz = w * z2;
+
+            const auto one = Lane::broadcast( 1.0f );
+            const auto sx = Lane::load( c[SCALE_X].data() + i );
+            const auto sy = Lane::load( c[SCALE_Y].data() + i );
+            const auto sz = Lane::load( c[SCALE_Z].data() + i );
+
+            // local[k] : ligne k de la partie 3x3, colonne après colonne, puis la translation.
+            std::array<std::array<float, LANE_WIDTH>, 12> local{};
+            ( ( one - ( yy + zz ) ) * sx ).store( local[0].data() );
+            ( ( xy + wz ) * sx ).store( local[1].data() );
+            ( ( xz - wy ) * sx ).store( local[2].data() );
+            ( ( xy - wz ) * sy ).store( local[3].data() );
+            ( ( one - ( xx + zz ) ) * sy ).store( local[4].data() );
+            ( ( yz + wx ) * sy ).store( local[5].data() );
+            ( ( xz + wy ) * sz ).store( local[6].data() );
+            ( ( yz - wx ) * sz ).store( local[7].data() );
+            ( ( one - ( xx + yy ) ) * sz ).store( local[8].data() );
+            Lane::load( c[TRANSLATION_X].data() + i ).store( local[9].data() );
+            Lane::load( c[TRANSLATION_Y].data() + i ).store( local[10].data() );
+            Lane::load( c[TRANSLATION_Z].data() + i ).store( local[11].data() );
+
+            const auto lanes = std::min( LANE_WIDTH, last - i );
+            for ( std::size_t lane = 0; lane < lanes; ++lane ) {
+                if ( flags[lane] == 0 ) {
+                    continue;
+                }
+
+                const auto slot = i + lane;
+                auto* const world = &worlds_[slot][0][0];
+
+                if ( parents_[slot] == NO_PARENT ) {
+                    for ( std::size_t column = 0; column < 3; ++column ) {
+                        Float4::set( local[column * 3][lane], local[column * 3 + 1][lane], local[column * 3 + 2][lane], 0.0f )
+                            .store( world + column * 4 );
+                    }
+                    Float4::set( local[9][lane], local[10][lane], local[11][lane], 1.0f ).store( world + 12 );
+                    continue;
+                }
+
+                // Monde = parent * local, une colonne de résultat par combinaison des colonnes du parent.
+                const auto* const parent = &worlds_[parents_[slot]][0][0];
+                const auto p0 = Float4::load( parent );
+                const auto p1 = Float4::load( parent + 4 );
+                const auto p2 = Float4::load( parent + 8 );
+                const auto p3 = Float4::load( parent + 12 );
+
+                for ( std::size_t column = 0; column < 4; ++column ) {
+                    auto result = p0 * Float4::broadcast( local[column * 3][lane] )
+                                  + p1 * Float4::broadcast( local[column * 3 + 1][lane] )
+                                  + p2 * Float4::broadcast( local[column * 3 + 2][lane] );
+                    if ( column == 3 ) {
+                        result = result + p3;
+                    }
+                    result.store( world + column * 4 );
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,156 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glengine/gl_state.hpp>
+#include <glengine/uniform_block.hpp>
+
+namespace gl_engine {
+    UniformBuffer::UniformBuffer( const std::size_t size )
+    : contents_(size) {
+        glGenBuffers( 1, &buffer_ );
+        open_gl::bindBuffer( GL_UNIFORM_BUFFER, buffer_ );
+        glBufferData( GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_DYNAMIC_DRAW );
+    }
+
+    UniformBuffer::UniformBuffer( UniformBuffer&& other ) noexcept
+    : buffer_(std::exchange(other.buffer_, 0)), contents_(std::move(other.contents_)),
+      initialized_(std::exchange(other.initialized_, false)) {}
+
+    UniformBuffer& UniformBuffer::operator=( UniformBuffer&& other ) noexcept {
+        if ( &other != this ) {
+            release();
+
+            buffer_ = std::exchange( other.buffer_, 0 );
+            contents_ = std::move( other.contents_ );
+            initialized_ = std::exchange( other.initialized_, false );
+        }
+
+        return *this;
+    }
+
+    UniformBuffer::~UniformBuffer() noexcept {
+        release();
+    }
+
+    bool UniformBuffer::update( const void* const data ) noexcept {
+        // Comparer quelques centaines d’octets coûte moins qu’un envoi au pilote, qui peut devoir copier ou attendre.
+        if ( initialized_ && std::memcmp( contents_.data(), data, contents_.size() ) == 0 ) {
+            return false;
+        }
+
+        std::memcpy( contents_.data(), data, contents_.size() );
+        initialized_ = true;
+
+        open_gl::bindBuffer( GL_UNIFORM_BUFFER, buffer_ );
+        glBufferSubData( GL_UNIFORM_BUFFER, 0, static_cast<GLsizeiptr>(contents_.size()), data );
+
+        return true;
+    }
+
+    void UniformBuffer::bind( const GLuint binding ) const noexcept {
+        open_gl::bindBufferBase( GL_UNIFORM_BUFFER, binding, buffer_ );
+    }
+
+    void UniformBuffer::release() noexcept {
+        if ( buffer_ != 0 ) {
+            open_gl::deleteBuffer( buffer_ );
+            buffer_ = 0;
+        }
+    }
+
+    namespace open_gl {
+        UniformBlockLayout uniformBlockLayout( const Id program, const std::string& name ) {
+            UniformBlockLayout layout{};
+
+            layout.index = glGetUniformBlockIndex( program, name.c_str() );
+            if ( layout.index == GL_INVALID_INDEX ) {
+                return layout;
+            }
+
+            GLint size = 0;
+            glGetActiveUniformBlockiv( program, layout.index, GL_UNIFORM_BLOCK_DATA_SIZE, &size );
+            layout.size = static_cast<std::size_t>(size);
+
+            GLint memberCount = 0;
+            glGetActiveUniformBlockiv( program, layout.index, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS, &memberCount );
+            if ( memberCount <= 0 ) {
+                return layout;
+            }
+
+            std::vector<GLint> indices(static_cast<std::size_t>(memberCount));
+            glGetActiveUniformBlockiv( program, layout.index, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, indices.data() );
+
+            const std::vector<GLuint> uniforms(indices.cbegin(), indices.cend());
+            std::vector<GLint> offsets(uniforms.size());
+            glGetActiveUniformsiv( program, memberCount, uniforms.data(), GL_UNIFORM_OFFSET, offsets.data() );
+
+            GLint nameLength = 0;
+            glGetProgramiv( program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &nameLength );
+            std::vector<GLchar> buffer(static_cast<std::size_t>(std::max( nameLength, 1 )));
+
+            layout.members.reserve( uniforms.size() );
+            for ( std::size_t i = 0; i < uniforms.size(); ++i ) {
+                GLsizei length = 0;
+                GLint arraySize = 0;
+                GLenum type = 0;
+                glGetActiveUniform( program, uniforms[i], static_cast<GLsizei>(buffer.size()), &length, &arraySize, &type, buffer.data() );
+
+                layout.members.push_back( {std::string(buffer.data(), static_cast<std::size_t>(length)), static_cast<std::size_t>(offsets[i])} );
+            }
+
+            std::sort( layout.members.begin(), layout.members.end(), []( const auto& left, const auto& right ) noexcept {
+                return left.offset < right.offset;
+            } );
+
+            return layout;
+        }
+
+        void checkUniformBlock( const UniformBlockLayout& layout, const std::string& name,
+                                const std::size_t* const offsets, const std::size_t memberCount, const std::size_t size ) {
+            if ( layout.size != size ) {
+                throw UniformBlockMismatch("Le bloc d’uniformes '" + name + "' occupe " + std::to_string( layout.size )
+                                           + " octets dans le programme, " + std::to_string( size ) + " sont attendus.");
+            }
+
+            if ( layout.members.size() != memberCount ) {
+                throw UniformBlockMismatch("Le bloc d’uniformes '" + name + "' a " + std::to_string( layout.members.size() )
+                                           + " membres dans le programme, " + std::to_string( memberCount ) + " sont attendus.");
+            }
+
+            for ( std::size_t i = 0; i < memberCount; ++i ) {
+                if ( layout.members[i].offset != offsets[i] ) {
+                    throw UniformBlockMismatch("Le membre '" + layout.members[i].name + "' du bloc d’uniformes '" + name
+                                               + "' est au décalage " + std::to_string( layout.members[i].offset ) + ", "
+                                               + std::to_string( offsets[i] ) + " est attendu. Le bloc est-il déclaré std140 ?");
+                }
+            }
+        }
+
+        void uniformBlockBinding( const Id program, const GLuint index, const GLuint binding ) noexcept {
+            glUniformBlockBinding( program, index, binding );
+        }
+    }
+}
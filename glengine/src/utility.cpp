@@ -18,8 +18,10 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <string>
 #include <string_view>
@@ -28,6 +30,18 @@
 #include <istream>
 #include <fstream>
 
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <glengine/utility.hpp>
 
 namespace gl_engine::open_gl {
@@ -68,13 +82,7 @@ namespace gl_engine::open_gl {
         return glCreateProgram();
     }
 
-    void useProgram( const Id id ) {
-        glUseProgram(id);
-    }
-
-    void deleteProgram( const Id id ) {
-        glDeleteProgram(id);
-    }
+    // Note développeur : useProgram et deleteProgram passent par le cache d’états, voir gl_state.cpp.
 
     void detachShader( const Id idProgram, const Id idShader ) {
         glDetachShader( idProgram, idShader );
@@ -124,6 +132,169 @@ namespace gl_engine::open_gl {
         }
     }
     // endregion
+
+    // region Draw
+    namespace {
+        using MultiDrawElementsIndirect = void (APIENTRYP)( GLenum mode, GLenum type, const void* indirect, GLsizei drawCount, GLsizei stride );
+
+        MultiDrawElementsIndirect multiDrawFunction() noexcept {
+            static const auto function = []() noexcept -> MultiDrawElementsIndirect {
+                if ( GLVersion.major < 4 || ( GLVersion.major == 4 && GLVersion.minor < 3 ) ) {
+                    return nullptr;
+                }
+
+                return reinterpret_cast<MultiDrawElementsIndirect>(glfwGetProcAddress( "glMultiDrawElementsIndirect" ));
+            }();
+
+            return function;
+        }
+    }
+
+    bool hasMultiDrawIndirect() noexcept {
+        return multiDrawFunction() != nullptr;
+    }
+
+    void multiDrawElementsIndirect( const GLenum mode, const GLenum type, const void* const indirect,
+                                    const Size drawCount, const Size stride ) noexcept {
+        multiDrawFunction()( mode, type, indirect, drawCount, stride );
+    }
+    // endregion
+
+    // region Buffer
+    namespace {
+        using BufferStorage = void (APIENTRYP)( GLenum target, GLsizeiptr size, const void* data, GLbitfield flags );
+
+        BufferStorage bufferStorageFunction() noexcept {
+            static const auto function = []() noexcept -> BufferStorage {
+                if ( GLVersion.major < 4 || ( GLVersion.major == 4 && GLVersion.minor < 4 ) ) {
+                    return nullptr;
+                }
+
+                return reinterpret_cast<BufferStorage>(glfwGetProcAddress( "glBufferStorage" ));
+            }();
+
+            return function;
+        }
+    }
+
+    bool hasBufferStorage() noexcept {
+        return bufferStorageFunction() != nullptr;
+    }
+
+    void bufferStorage( const GLenum target, const std::ptrdiff_t size, const void* const data, const GLbitfield flags ) noexcept {
+        bufferStorageFunction()( target, static_cast<GLsizeiptr>(size), data, flags );
+    }
+    // endregion
+
+    // region ProgramBinary
+    namespace {
+        // Note développeur : Constante d’OpenGL 4.1, absente du chargeur glad du moteur.
+        constexpr GLenum PROGRAM_BINARY_LENGTH = 0x8741;
+
+        using ProgramParameteri = void (APIENTRYP)( GLuint program, GLenum name, GLint value );
+        using GetProgramBinary = void (APIENTRYP)( GLuint program, GLsizei bufferSize, GLsizei* length, GLenum* format, void* binary );
+        using ProgramBinary = void (APIENTRYP)( GLuint program, GLenum format, const void* binary, GLsizei length );
+
+        /**
+         * @brief Les trois fonctions des binaires de programme, toutes nulles si le contexte ne les fournit pas.
+         */
+        struct ProgramBinaryFunctions {
+            ProgramParameteri parameter = nullptr;
+            GetProgramBinary get = nullptr;
+            ProgramBinary load = nullptr;
+        };
+
+        const ProgramBinaryFunctions& programBinaryFunctions() noexcept {
+            static const auto functions = []() noexcept -> ProgramBinaryFunctions {
+                if ( GLVersion.major < 4 || ( GLVersion.major == 4 && GLVersion.minor < 1 ) ) {
+                    return {};
+                }
+
+                ProgramBinaryFunctions result{
+                    reinterpret_cast<ProgramParameteri>(glfwGetProcAddress( "glProgramParameteri" )),
+                    reinterpret_cast<GetProgramBinary>(glfwGetProcAddress( "glGetProgramBinary" )),
+                    reinterpret_cast<ProgramBinary>(glfwGetProcAddress( "glProgramBinary" ))
+                };
+
+                if ( result.parameter == nullptr || result.get == nullptr || result.load == nullptr ) {
+                    return {};
+                }
+
+                return result;
+            }();
+
+            return functions;
+        }
+    }
+
+    bool hasProgramBinary() noexcept {
+        return programBinaryFunctions().load != nullptr;
+    }
+
+    void programParameter( const Id id, const GLenum name, const GLint value ) noexcept {
+        programBinaryFunctions().parameter( id, name, value );
+    }
+
+    std::vector<char> getProgramBinary( const Id id, GLenum& format ) {
+        GLint length = 0;
+        glGetProgramiv( id, PROGRAM_BINARY_LENGTH, &length );
+
+        std::vector<char> binary(static_cast<std::size_t>(std::max( length, 0 )));
+        if ( binary.empty() ) {
+            return binary;
+        }
+
+        GLsizei written = 0;
+        programBinaryFunctions().get( id, length, &written, &format, binary.data() );
+        binary.resize( static_cast<std::size_t>(std::max( written, 0 )) );
+
+        return binary;
+    }
+
+    void programBinary( const Id id, const GLenum format, const void* const binary, const Size size ) noexcept {
+        programBinaryFunctions().load( id, format, binary, size );
+    }
+    // endregion
+
+    // region ParallelShaderCompile
+    namespace {
+        using MaxShaderCompilerThreads = void (APIENTRYP)( GLuint count );
+
+        MaxShaderCompilerThreads maxShaderCompilerThreadsFunction() noexcept {
+            static const auto function = []() noexcept -> MaxShaderCompilerThreads {
+                GLint extensionCount = 0;
+                glGetIntegerv( GL_NUM_EXTENSIONS, &extensionCount );
+
+                for ( GLint i = 0; i < extensionCount; ++i ) {
+                    const auto* const name = reinterpret_cast<const char*>(glGetStringi( GL_EXTENSIONS, static_cast<GLuint>(i) ));
+                    if ( name == nullptr ) {
+                        continue;
+                    }
+
+                    const std::string_view extension{name};
+                    if ( extension == "GL_KHR_parallel_shader_compile" ) {
+                        return reinterpret_cast<MaxShaderCompilerThreads>(glfwGetProcAddress( "glMaxShaderCompilerThreadsKHR" ));
+                    }
+                    if ( extension == "GL_ARB_parallel_shader_compile" ) {
+                        return reinterpret_cast<MaxShaderCompilerThreads>(glfwGetProcAddress( "glMaxShaderCompilerThreadsARB" ));
+                    }
+                }
+
+                return nullptr;
+            }();
+
+            return function;
+        }
+    }
+
+    bool hasParallelShaderCompile() noexcept {
+        return maxShaderCompilerThreadsFunction() != nullptr;
+    }
+
+    void maxShaderCompilerThreads( const GLuint count ) noexcept {
+        maxShaderCompilerThreadsFunction()( count );
+    }
+    // endregion
 }
 
 
@@ -268,4 +439,115 @@ namespace gl_engine::utility {
         }
     }
 
+
+    MappedFile::MappedFile( const Path& path ) {
+        const auto& filePath = path.path_;
+
+#ifdef _WIN32
+        const auto file = ::CreateFileW( filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                         OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+        if ( file == INVALID_HANDLE_VALUE ) {
+            throw ErrorOpeningFile(filePath.string());
+        }
+
+        LARGE_INTEGER fileSize{};
+        if ( ::GetFileSizeEx( file, &fileSize ) == 0 ) {
+            ::CloseHandle( file );
+            throw ErrorReadingFile(filePath.string());
+        }
+
+        if ( fileSize.QuadPart == 0 ) {
+            ::CloseHandle( file );
+            throw EmptySource(filePath.string());
+        }
+
+        // Note développeur : Le fichier peut être fermé dès que le mapping existe, ce dernier garde une référence.
+        const auto mapping = ::CreateFileMappingW( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        ::CloseHandle( file );
+
+        if ( mapping == nullptr ) {
+            throw ErrorReadingFile(filePath.string());
+        }
+
+        const auto* const view = ::MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+        if ( view == nullptr ) {
+            ::CloseHandle( mapping );
+            throw ErrorReadingFile(filePath.string());
+        }
+
+        handle_ = mapping;
+        data_ = static_cast<const char*>(view);
+        size_ = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+        const auto file = ::open( filePath.c_str(), O_RDONLY );
+        if ( file < 0 ) {
+            throw ErrorOpeningFile(filePath.string());
+        }
+
+        struct stat status{};
+        if ( ::fstat( file, &status ) != 0 ) {
+            ::close( file );
+            throw ErrorReadingFile(filePath.string());
+        }
+
+        if ( status.st_size == 0 ) {
+            ::close( file );
+            throw EmptySource(filePath.string());
+        }
+
+        const auto size = static_cast<std::size_t>(status.st_size);
+
+        // Note développeur : Le descripteur peut être fermé dès que la projection existe.
+        auto* const view = ::mmap( nullptr, size, PROT_READ, MAP_PRIVATE, file, 0 );
+        ::close( file );
+
+        if ( view == MAP_FAILED ) {
+            throw ErrorReadingFile(filePath.string());
+        }
+
+        // Le contenu est lu de façon séquentielle, cela permet au noyau de lire en avance.
+        ::madvise( view, size, MADV_SEQUENTIAL );
+
+        data_ = static_cast<const char*>(view);
+        size_ = size;
+#endif
+    }
+
+    MappedFile::MappedFile( MappedFile&& other ) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)),
+      handle_(std::exchange(other.handle_, nullptr)) {}
+
+    MappedFile& MappedFile::operator=( MappedFile&& other ) noexcept {
+        if ( &other != this ) {
+            release();
+
+            data_ = std::exchange( other.data_, nullptr );
+            size_ = std::exchange( other.size_, 0 );
+            handle_ = std::exchange( other.handle_, nullptr );
+        }
+
+        return *this;
+    }
+
+    MappedFile::~MappedFile() noexcept {
+        release();
+    }
+
+    void MappedFile::release() noexcept {
+        if ( data_ == nullptr ) {
+            return;
+        }
+
+#ifdef _WIN32
+        ::UnmapViewOfFile( data_ );
+        ::CloseHandle( handle_ );
+#else
+        ::munmap( const_cast<char*>(data_), size_ );
+#endif
+
+        data_ = nullptr;
+        size_ = 0;
+        handle_ = nullptr;
+    }
+
 }
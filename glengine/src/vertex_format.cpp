@@ -0,0 +1,138 @@
+/*
+ * PEM_GL - Copyright © 2022 DAVID Axel
+ * Mail to:
+ * axel.david@etu.univ-amu.fr
+ *
+ * PEM_GL is free software: you can redistribute it and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * PEM_GL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <glm/gtc/packing.hpp>
+
+#include <glengine/mesh_buffer.hpp>
+#include <glengine/vertex_format.hpp>
+
+namespace gl_engine {
+    namespace {
+        std::uint16_t quantize( const float value, const float minimum, const float extent ) noexcept {
+            if ( extent <= 0.0f ) {
+                return 0;
+            }
+
+            const auto normalized = std::clamp( ( value - minimum ) / extent, 0.0f, 1.0f );
+
+            return static_cast<std::uint16_t>(std::lround( normalized * 65535.0f ));
+        }
+
+        std::uint32_t packNormal( const glm::vec3& normal ) noexcept {
+            // Renormalisée avant l’arrondi, une normale nulle (absente du fichier) reste nulle.
+            const auto length = glm::length( normal );
+            const auto unit = length > 0.0f ? normal / length : normal;
+
+            return glm::packSnorm3x10_1x2( glm::vec4(unit, 0.0f) );
+        }
+    }
+
+    std::vector<std::uint8_t> VertexFormat::encode( const Mesh& mesh ) const {
+        const auto vertexStride = stride();
+        std::vector<std::uint8_t> bytes( mesh.vertexCount() * vertexStride );
+
+        const auto offset = positionOffset( mesh.bounds() );
+        const auto scale = positionScale( mesh.bounds() );
+
+        for ( std::size_t i = 0; i < mesh.vertexCount(); ++i ) {
+            const auto& vertex = mesh.vertices()[i];
+            auto* const destination = bytes.data() + i * vertexStride;
+
+            if ( quantizePositions ) {
+                const std::uint16_t position[4] = {quantize( vertex.position.x, offset.x, scale.x ),
+                                                   quantize( vertex.position.y, offset.y, scale.y ),
+                                                   quantize( vertex.position.z, offset.z, scale.z ), 0};
+                std::memcpy( destination + positionOffset(), position, sizeof( position ) );
+            }
+            else {
+                std::memcpy( destination + positionOffset(), &vertex.position, sizeof( vertex.position ) );
+            }
+
+            if ( packNormals ) {
+                const auto normal = packNormal( vertex.normal );
+                std::memcpy( destination + normalOffset(), &normal, sizeof( normal ) );
+            }
+            else {
+                std::memcpy( destination + normalOffset(), &vertex.normal, sizeof( vertex.normal ) );
+            }
+
+            if ( halfTexCoords ) {
+                const std::uint16_t texCoord[2] = {glm::packHalf1x16( vertex.texCoord.x ), glm::packHalf1x16( vertex.texCoord.y )};
+                std::memcpy( destination + texCoordOffset(), texCoord, sizeof( texCoord ) );
+            }
+            else {
+                std::memcpy( destination + texCoordOffset(), &vertex.texCoord, sizeof( vertex.texCoord ) );
+            }
+        }
+
+        return bytes;
+    }
+
+    std::string VertexFormat::glslDecoder() const {
+        const auto location = []( const GLuint value ) {
+            return "layout (location = " + std::to_string( value ) + ") in ";
+        };
+
+        // Note développeur : Certains pilotes refusent les caractères non ASCII, même dans les commentaires GLSL.
+        std::string source = "// gl_engine::VertexFormat::glslDecoder\n";
+
+        source += location( MeshBuffer::POSITION_LOCATION ) + "vec3 glengine_position;\n";
+        source += location( MeshBuffer::NORMAL_LOCATION ) + "vec3 glengine_normal;\n";
+        source += location( MeshBuffer::TEXCOORD_LOCATION ) + "vec2 glengine_texCoord;\n";
+
+        if ( quantizePositions ) {
+            source += "uniform vec3 " + std::string( POSITION_OFFSET_UNIFORM ) + ";\n";
+            source += "uniform vec3 " + std::string( POSITION_SCALE_UNIFORM ) + ";\n";
+            source += "vec3 meshPosition() { return " + std::string( POSITION_OFFSET_UNIFORM )
+                      + " + glengine_position * " + std::string( POSITION_SCALE_UNIFORM ) + "; }\n";
+        }
+        else {
+            source += "vec3 meshPosition() { return glengine_position; }\n";
+        }
+
+        // Les normales compressées et les demi-flottants sont convertis par le matériel lors de la lecture des attributs.
+        source += "vec3 meshNormal() { return glengine_normal; }\n";
+        source += "vec2 meshTexCoord() { return glengine_texCoord; }\n";
+
+        return source;
+    }
+
+    std::string VertexFormat::injectDecoder( const std::string_view vertexSource ) const {
+        std::string source(vertexSource);
+
+        auto position = std::string::size_type{0};
+
+        const auto version = source.find( "#version" );
+        if ( version != std::string::npos ) {
+            const auto endOfLine = source.find( '\n', version );
+            position = endOfLine == std::string::npos ? source.size() : endOfLine + 1;
+
+            if ( endOfLine == std::string::npos ) {
+                source += '\n';
+                ++position;
+            }
+        }
+
+        source.insert( position, glslDecoder() );
+
+        return source;
+    }
+}
@@ -38,7 +38,7 @@ gl_engine::Window::Window( Dimension dimension, std::string title, Window_t type
     handle_ = std::move( window );
 }
 
-void gl_engine::Window::render() const {
+void gl_engine::Window::render() {
     if (scene_.has_value()) {
         scene_->render();
     }
@@ -46,7 +46,7 @@ void gl_engine::Window::render() const {
 
 void gl_engine::Window::addScene( Scene scene ) {
     if ( !scene_.has_value() ) {
-        scene_ = scene;
+        scene_.emplace( std::move( scene ) );
     }
     else {
         throw std::logic_error("erreur");